@@ -0,0 +1,43 @@
+﻿#include <FeCore/Base/Base.h>
+#include <FeCore/Base/PlatformInclude.h>
+
+namespace FE::Platform
+{
+    void AssertionReport(const SourceLocation sourceLocation, const char* message, const uint32_t messageSize, const bool crash)
+    {
+        //
+        // NOTE: We cannot allocate any memory here: the Platform::AssertionReport function might have been called
+        // from the memory management code, which means that an allocation can lead to infinite recursion or memory corruption.
+        // So we write directly to stderr using a stack buffer.
+        //
+
+        char lineBuffer[32];
+        const int32_t lineLength = snprintf(lineBuffer, sizeof(lineBuffer), "(%u): ", sourceLocation.m_lineNumber);
+
+        const auto writeStderr = [](const char* data, const size_t size) {
+            size_t bytesWritten = 0;
+            while (bytesWritten < size)
+            {
+                const ssize_t result = write(STDERR_FILENO, data + bytesWritten, size - bytesWritten);
+                if (result <= 0)
+                    return;
+
+                bytesWritten += static_cast<size_t>(result);
+            }
+        };
+
+        if (sourceLocation.m_fileName)
+            writeStderr(sourceLocation.m_fileName, strlen(sourceLocation.m_fileName));
+        if (lineLength > 0)
+            writeStderr(lineBuffer, static_cast<size_t>(lineLength));
+
+        writeStderr(message, messageSize);
+        writeStderr("\n", 1);
+
+        if (crash)
+        {
+            FE_DebugBreak();
+            abort();
+        }
+    }
+} // namespace FE::Platform
@@ -1,67 +1,74 @@
 #include <FeCore/Base/PlatformInclude.h>
 #include <FeCore/Base/StackTrace.h>
 #include <FeCore/Base/StackTracePrivate.h>
-#include <FeCore/Containers/SegmentedVector.h>
 #include <FeCore/Memory/LinearAllocator.h>
 #include <FeCore/Memory/Memory.h>
 #include <FeCore/Modules/Environment.h>
-#include <festd/unordered_map.h>
+#include <atomic>
 
 #if FE_DEVELOPMENT
-#    include <DbgHelp.h>
 #    include <xxhash.h>
-#    pragma comment(lib, "dbghelp.lib")
+
+#    if FE_PLATFORM_WINDOWS
+#        include <DbgHelp.h>
+#        pragma comment(lib, "dbghelp.lib")
+#    elif FE_PLATFORM_LINUX
+#        include <cxxabi.h>
+#        include <execinfo.h>
+#    endif
 
 namespace FE::Trace
 {
     namespace
     {
+        void** AllocateFrames(const uint32_t frameCount)
+        {
+            // We want stack frames to always be available, so we can use linear allocator
+            std::pmr::memory_resource* allocator = Env::GetStaticAllocator(Memory::StaticAllocatorType::kLinear);
+            void* memory = allocator->allocate(sizeof(void*) * frameCount);
+            return static_cast<void**>(memory);
+        }
+
+
+        constexpr uint32_t kCallStackTableShift = 20;
+        constexpr uint32_t kCallStackTableSize = 1 << kCallStackTableShift;
+
+        // The first slot is reserved for the empty call stack.
+        constexpr uint32_t kEmptyCallStackIndex = 0;
+
+
         //
         // We cannot use the default allocator here since the primary usage of stack traces is to
         // track down memory leaks. So we might end up with a recursive allocation.
         //
-        // Instead, we allocate virtual memory directly to avoid this issue.
-        // The purpose of this proxy allocator is to align allocation size to the page size,
-        // so we don't trigger assertions in our AllocateVirtual() function.
+        // Instead, we allocate the table directly from virtual memory. It has a fixed size, so it never has to be
+        // reallocated and can be accessed without locks: a call stack is identified by the index of the slot
+        // that stores its hash.
         //
-        struct StackCacheAllocator final : public std::pmr::memory_resource
+        struct StackTraceStorage final
         {
-        private:
-            void* do_allocate(const size_t byteSize, const size_t byteAlignment) override
-            {
-                const size_t granularity = Memory::GetPlatformSpec().m_granularity;
-                return Memory::AllocateVirtual(AlignUp(byteSize, granularity), AlignUp(byteAlignment, granularity));
-            }
+            std::atomic<uint64_t>* m_hashes = nullptr;
+            std::atomic<void**>* m_frames = nullptr;
+            void* m_emptyFrames[1] = { nullptr };
 
-            void do_deallocate(void* ptr, const size_t byteSize, const size_t byteAlignment) override
+            StackTraceStorage()
             {
-                FE_Unused(byteAlignment);
-                const size_t granularity = Memory::GetPlatformSpec().m_granularity;
-                Memory::FreeVirtual(ptr, AlignUp(byteSize, granularity));
+                m_hashes = static_cast<std::atomic<uint64_t>*>(Memory::AllocateVirtual(kHashTableByteSize));
+                m_frames = static_cast<std::atomic<void**>*>(Memory::AllocateVirtual(kFrameTableByteSize));
+
+                m_hashes[kEmptyCallStackIndex].store(Constants::kMaxU64, std::memory_order_relaxed);
+                m_frames[kEmptyCallStackIndex].store(m_emptyFrames, std::memory_order_release);
             }
 
-            [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            ~StackTraceStorage()
             {
-                return this == &other;
+                Memory::FreeVirtual(m_frames, kFrameTableByteSize);
+                Memory::FreeVirtual(m_hashes, kHashTableByteSize);
             }
-        };
 
-
-        void** AllocateFrames(const uint32_t frameCount)
-        {
-            // We want stack frames to always be available, so we can use linear allocator
-            std::pmr::memory_resource* allocator = Env::GetStaticAllocator(Memory::StaticAllocatorType::kLinear);
-            void* memory = allocator->allocate(sizeof(void*) * frameCount);
-            return static_cast<void**>(memory);
-        }
-
-
-        struct StackTraceStorage final
-        {
-            Threading::SpinLock m_lock;
-            StackCacheAllocator m_cacheAllocator;
-            festd::pmr::segmented_unordered_dense_map<uint64_t, CallStack> m_callstackMap{ &m_cacheAllocator };
-            SegmentedVector<void**, 64 * 1024> m_callstacks{ &m_cacheAllocator };
+        private:
+            static constexpr size_t kHashTableByteSize = kCallStackTableSize * sizeof(std::atomic<uint64_t>);
+            static constexpr size_t kFrameTableByteSize = kCallStackTableSize * sizeof(std::atomic<void**>);
         };
 
         StackTraceStorage* GStorage = nullptr;
@@ -73,14 +80,17 @@ namespace FE::Trace
         FE_CoreAssert(GStorage == nullptr, "Stack trace already initialized");
         GStorage = Memory::New<StackTraceStorage>(allocator);
 
+#    if FE_PLATFORM_WINDOWS
         SymSetOptions(SYMOPT_ALLOW_ABSOLUTE_SYMBOLS | SYMOPT_ALLOW_ZERO_ADDRESS | SYMOPT_AUTO_PUBLICS | SYMOPT_DEBUG
                       | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES | SYMOPT_NO_PROMPTS);
 
         SymInitialize(GetCurrentProcess(), nullptr, TRUE);
-
-        // Due to the way we allocate memory for this map, it's better to reserve and reduce the number of reallocations
-        // as much as possible.
-        GStorage->m_callstackMap.reserve(64 * 1024);
+#    elif FE_PLATFORM_LINUX
+        // The first call to backtrace() loads libgcc_s and allocates memory. Do it here,
+        // so that it doesn't happen in the middle of an allocation later.
+        void* warmupFrames[1];
+        backtrace(warmupFrames, 1);
+#    endif
     }
 
 
@@ -90,7 +100,9 @@ namespace FE::Trace
         GStorage->~StackTraceStorage();
         GStorage = nullptr;
 
+#    if FE_PLATFORM_WINDOWS
         FE_Verify(SymCleanup(GetCurrentProcess()));
+#    endif
     }
 
 
@@ -99,6 +111,7 @@ namespace FE::Trace
         SymbolInfo symbolInfo;
         symbolInfo.m_address = reinterpret_cast<uintptr_t>(ptr);
 
+#    if FE_PLATFORM_WINDOWS
         auto* winSymbolInfo = FE_StackAlloc(SYMBOL_INFO, sizeof(SYMBOL_INFO) + sizeof(symbolInfo.m_symbolName));
         winSymbolInfo->MaxNameLen = sizeof(symbolInfo.m_symbolName) - 1;
         winSymbolInfo->SizeOfStruct = sizeof(SYMBOL_INFO);
@@ -125,6 +138,35 @@ namespace FE::Trace
             memcpy(symbolInfo.m_fileName, lineInfo.FileName, fileNameLength);
             symbolInfo.m_fileName[fileNameLength] = '\0';
         }
+#    elif FE_PLATFORM_LINUX
+        // dladdr() only provides exported symbols and no line information, it is enough to see
+        // where the leaked memory came from. Use addr2line with the module-relative address for more details.
+        Dl_info dlInfo;
+        if (dladdr(ptr, &dlInfo) != 0)
+        {
+            if (dlInfo.dli_fname)
+            {
+                const char* moduleName = strrchr(dlInfo.dli_fname, '/');
+                moduleName = moduleName ? moduleName + 1 : dlInfo.dli_fname;
+                const size_t moduleNameLength = Math::Min(strlen(moduleName), sizeof(symbolInfo.m_moduleName) - 1);
+                memcpy(symbolInfo.m_moduleName, moduleName, moduleNameLength);
+                symbolInfo.m_moduleName[moduleNameLength] = '\0';
+            }
+
+            if (dlInfo.dli_sname)
+            {
+                // __cxa_demangle() returns a buffer allocated with malloc(), it doesn't go through our memory manager.
+                int32_t status = 0;
+                char* demangledName = abi::__cxa_demangle(dlInfo.dli_sname, nullptr, nullptr, &status);
+                const char* symbolName = status == 0 ? demangledName : dlInfo.dli_sname;
+
+                const size_t symbolNameLength = Math::Min(strlen(symbolName), sizeof(symbolInfo.m_symbolName) - 1);
+                memcpy(symbolInfo.m_symbolName, symbolName, symbolNameLength);
+                symbolInfo.m_symbolName[symbolNameLength] = '\0';
+                free(demangledName);
+            }
+        }
+#    endif
 
         return symbolInfo;
     }
@@ -134,33 +176,76 @@ namespace FE::Trace
     {
         void** tempFrames = FE_StackAlloc(void*, maxFrames);
 
+#    if FE_PLATFORM_WINDOWS
         const WORD frameCount = RtlCaptureStackBackTrace(skipFrames, maxFrames, tempFrames, nullptr);
-        const uint64_t hash = XXH3_64bits(tempFrames, frameCount * sizeof(void*));
-
+#    elif FE_PLATFORM_LINUX
+        const int32_t capturedFrameCount = backtrace(tempFrames, static_cast<int32_t>(maxFrames));
+        const uint32_t frameCount = Math::Max(static_cast<uint32_t>(capturedFrameCount), skipFrames) - skipFrames;
+        memmove(tempFrames, tempFrames + skipFrames, frameCount * sizeof(void*));
+#    endif
+        // Zero marks empty slots in the table.
+        const uint64_t frameHash = XXH3_64bits(tempFrames, frameCount * sizeof(void*));
+        const uint64_t hash = frameHash ? frameHash : 1;
+
+        constexpr uint32_t kIndexMask = kCallStackTableSize - 1;
+        uint32_t index = static_cast<uint32_t>(hash) & kIndexMask;
+        for (uint32_t probeIndex = 0; probeIndex < kCallStackTableSize; ++probeIndex, index = (index + 1) & kIndexMask)
         {
-            std::lock_guard lock{ GStorage->m_lock };
-
-            const auto it = GStorage->m_callstackMap.find(hash);
-            if (it != GStorage->m_callstackMap.end())
-                return it->second;
+            if (index == kEmptyCallStackIndex)
+                continue;
 
-            void** frames = AllocateFrames(frameCount + 1);
-            memcpy(frames, tempFrames, frameCount * sizeof(void*));
-            frames[frameCount] = nullptr;
+            uint64_t slotHash = GStorage->m_hashes[index].load(std::memory_order_acquire);
+            if (slotHash == 0)
+            {
+                if (GStorage->m_hashes[index].compare_exchange_strong(slotHash, hash, std::memory_order_acq_rel))
+                {
+                    void** frames = AllocateFrames(frameCount + 1);
+                    memcpy(frames, tempFrames, frameCount * sizeof(void*));
+                    frames[frameCount] = nullptr;
+                    GStorage->m_frames[index].store(frames, std::memory_order_release);
+
+                    CallStack callStack;
+                    callStack.m_value = index;
+                    return callStack;
+                }
+
+                // Another thread has taken the slot, slotHash now contains its hash.
+            }
 
-            CallStack callStack;
-            callStack.m_value = GStorage->m_callstacks.size();
-            GStorage->m_callstacks.push_back(frames);
-            GStorage->m_callstackMap[hash] = callStack;
-            return callStack;
+            if (slotHash == hash)
+            {
+                CallStack callStack;
+                callStack.m_value = index;
+                return callStack;
+            }
         }
+
+        // The table is full, we can't record any more unique call stacks.
+        return GetEmpty();
+    }
+
+
+    CallStack CallStack::GetEmpty()
+    {
+        CallStack callStack;
+        callStack.m_value = kEmptyCallStackIndex;
+        return callStack;
     }
 
 
     void** CallStack::GetFrames() const
     {
-        FE_Assert(m_value < GStorage->m_callstacks.size());
-        return GStorage->m_callstacks[m_value];
+        FE_Assert(m_value < kCallStackTableSize);
+
+        // The frames are stored right after the slot is taken, another thread might still be copying them.
+        void** frames = GStorage->m_frames[m_value].load(std::memory_order_acquire);
+        while (frames == nullptr)
+        {
+            _mm_pause();
+            frames = GStorage->m_frames[m_value].load(std::memory_order_acquire);
+        }
+
+        return frames;
     }
 } // namespace FE::Trace
 
@@ -175,6 +260,12 @@ namespace FE::Trace
     {
         return CallStack();
     }
+
+
+    CallStack CallStack::GetEmpty()
+    {
+        return CallStack();
+    }
 } // namespace FE::Trace
 
 #endif
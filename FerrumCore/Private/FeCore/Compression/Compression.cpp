@@ -1,5 +1,6 @@
 #include <FeCore/Compression/Compression.h>
 #include <FeCore/Compression/CompressionPrivate.h>
+#include <FeCore/Compression/LZ4.h>
 #include <FeCore/Memory/Memory.h>
 #include <festd/vector.h>
 
@@ -9,13 +10,48 @@ namespace FE::Compression
 {
     namespace
     {
+        //! @brief A compressor or a decompressor context, linked into the free lists when not in use.
+        struct ContextNode final
+        {
+            // Can be read by a thread that lost the race for the node, so it's accessed atomically.
+            std::atomic<ContextNode*> m_next = nullptr;
+            void* m_impl = nullptr;
+            uint32_t m_kind = 0;
+        };
+
+
+        // Every compression level of the deflate methods, the LZ4 compressor and every deflate decompression method
+        // have their own free lists. LZ4 decompression doesn't need a context.
+        constexpr uint32_t kMaxCompressionLevel = 12;
+        constexpr uint32_t kLZ4CompressorKind = 2 * kMaxCompressionLevel;
+        constexpr uint32_t kCompressorKindCount = kLZ4CompressorKind + 1;
+        constexpr uint32_t kKindCount = kCompressorKindCount + 2;
+
+        //! @brief The number of contexts of each kind that a thread keeps for itself before returning them to the shared list.
+        constexpr uint32_t kMaxThreadCachedContextCount = 2;
+
+        constexpr uint64_t kNodePointerMask = (UINT64_C(1) << 48) - 1;
+        constexpr uint64_t kNodeTagIncrement = UINT64_C(1) << 48;
+
+
+        struct alignas(Memory::kCacheLineSize) ThreadContextCache final
+        {
+            ContextNode* m_heads[kKindCount];
+            uint8_t m_counts[kKindCount];
+        };
+
+
+        //! @brief Lock-free stack of contexts, the pointer is tagged to avoid the ABA problem.
+        struct alignas(Memory::kCacheLineSize) SharedContextList final
+        {
+            std::atomic<uint64_t> m_head = 0;
+        };
+
+
         struct CompressionState final
         {
-            Threading::SpinLock m_lock;
-            festd::array<festd::vector<void*>, 12> m_compressorCache;
-            festd::array<festd::vector<void*>, 12> m_gDeflateCompressorCache;
-            festd::vector<void*> m_decompressorCache;
-            festd::vector<void*> m_gDeflateDecompressorCache;
+            ThreadContextCache m_threadCaches[Memory::Internal::kMaxThreadSlotCount] = {};
+            SharedContextList m_sharedLists[kKindCount];
         };
 
         CompressionState* GCompressionState;
@@ -27,79 +63,174 @@ namespace FE::Compression
         }
 
 
-        void* AllocateCompressorImpl(const int32_t level)
+        uint32_t GetCompressorKind(const Method method, const int32_t level)
         {
-            std::unique_lock lock{ GCompressionState->m_lock };
-            auto& cache = GCompressionState->m_compressorCache[level - 1];
-            if (cache.empty())
+            if (method == Method::kLZ4)
+                return kLZ4CompressorKind;
+
+            FE_AssertDebug(level > 0 && level <= static_cast<int32_t>(kMaxCompressionLevel));
+            const uint32_t methodOffset = method == Method::kGDeflate ? kMaxCompressionLevel : 0;
+            return methodOffset + static_cast<uint32_t>(level - 1);
+        }
+
+
+        uint32_t GetDecompressorKind(const Method method)
+        {
+            return kCompressorKindCount + (method == Method::kGDeflate ? 1 : 0);
+        }
+
+
+        void* CreateContextImpl(const uint32_t kind)
+        {
+            if (kind >= kCompressorKindCount)
+            {
+                if (kind == kCompressorKindCount)
+                    return libdeflate_alloc_decompressor();
+
+                return libdeflate_alloc_gdeflate_decompressor();
+            }
+
+            if (kind == kLZ4CompressorKind)
+                return Memory::DefaultNew<LZ4::Context>();
+
+            const int32_t level = static_cast<int32_t>(kind % kMaxCompressionLevel) + 1;
+            if (kind < kMaxCompressionLevel)
                 return libdeflate_alloc_compressor(level);
 
-            void* impl = cache.back();
-            cache.pop_back();
-            return impl;
+            return libdeflate_alloc_gdeflate_compressor(level);
+        }
+
+
+        void DestroyContext(ContextNode* node)
+        {
+            if (node->m_kind >= kCompressorKindCount)
+            {
+                if (node->m_kind == kCompressorKindCount)
+                    libdeflate_free_decompressor(static_cast<libdeflate_decompressor*>(node->m_impl));
+                else
+                    libdeflate_free_gdeflate_decompressor(static_cast<libdeflate_gdeflate_decompressor*>(node->m_impl));
+            }
+            else if (node->m_kind == kLZ4CompressorKind)
+            {
+                Memory::DefaultDelete(static_cast<LZ4::Context*>(node->m_impl));
+            }
+            else if (node->m_kind < kMaxCompressionLevel)
+            {
+                libdeflate_free_compressor(static_cast<libdeflate_compressor*>(node->m_impl));
+            }
+            else
+            {
+                libdeflate_free_gdeflate_compressor(static_cast<libdeflate_gdeflate_compressor*>(node->m_impl));
+            }
+
+            Memory::DefaultDelete(node);
         }
 
 
-        void* AllocateGDeflateCompressorImpl(const int32_t level)
+        ContextNode* PopShared(SharedContextList& list)
         {
-            std::unique_lock lock{ GCompressionState->m_lock };
-            auto& cache = GCompressionState->m_gDeflateCompressorCache[level - 1];
-            if (cache.empty())
-                return libdeflate_alloc_gdeflate_compressor(level);
-
-            void* impl = cache.back();
-            cache.pop_back();
-            return impl;
+            uint64_t head = list.m_head.load(std::memory_order_acquire);
+            while (head & kNodePointerMask)
+            {
+                // The nodes are only freed on shutdown, so it is safe to read the next pointer even if we lose the race.
+                auto* node = reinterpret_cast<ContextNode*>(head & kNodePointerMask);
+                ContextNode* next = node->m_next.load(std::memory_order_relaxed);
+                const uint64_t newHead = reinterpret_cast<uint64_t>(next) | ((head & ~kNodePointerMask) + kNodeTagIncrement);
+                if (list.m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire))
+                    return node;
+            }
+
+            return nullptr;
         }
 
 
-        void* AllocateDecompressorImpl()
+        void PushShared(SharedContextList& list, ContextNode* node)
         {
-            std::unique_lock lock{ GCompressionState->m_lock };
-            auto& cache = GCompressionState->m_decompressorCache;
-            if (cache.empty())
-                return libdeflate_alloc_decompressor();
-
-            void* impl = cache.back();
-            cache.pop_back();
-            return impl;
+            uint64_t head = list.m_head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                node->m_next.store(reinterpret_cast<ContextNode*>(head & kNodePointerMask), std::memory_order_relaxed);
+                const uint64_t newHead = reinterpret_cast<uint64_t>(node) | ((head & ~kNodePointerMask) + kNodeTagIncrement);
+                if (list.m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+            }
         }
 
 
-        void* AllocateGDeflateDecompressorImpl()
+        //! @brief Get a context from the calling thread's cache, the shared list or create a new one.
+        ContextNode* AcquireContext(const uint32_t kind)
         {
-            std::unique_lock lock{ GCompressionState->m_lock };
-            auto& cache = GCompressionState->m_gDeflateDecompressorCache;
-            if (cache.empty())
-                return libdeflate_alloc_gdeflate_decompressor();
+            // The thread caches are only accessed by the threads that own the slots, so they don't need synchronization.
+            const uint32_t slot = Memory::Internal::GetThreadSlot();
+            if (slot != kInvalidIndex)
+            {
+                ThreadContextCache& cache = GCompressionState->m_threadCaches[slot];
+                if (ContextNode* node = cache.m_heads[kind])
+                {
+                    cache.m_heads[kind] = node->m_next.load(std::memory_order_relaxed);
+                    --cache.m_counts[kind];
+                    return node;
+                }
+            }
 
-            void* impl = cache.back();
-            cache.pop_back();
-            return impl;
+            if (ContextNode* node = PopShared(GCompressionState->m_sharedLists[kind]))
+                return node;
+
+            auto* node = Memory::DefaultNew<ContextNode>();
+            FE_CoreAssert((reinterpret_cast<uintptr_t>(node) & ~kNodePointerMask) == 0);
+            node->m_impl = CreateContextImpl(kind);
+            node->m_kind = kind;
+            return node;
+        }
+
+
+        void ReleaseContext(ContextNode* node)
+        {
+            const uint32_t kind = node->m_kind;
+            const uint32_t slot = Memory::Internal::GetThreadSlot();
+            if (slot != kInvalidIndex)
+            {
+                ThreadContextCache& cache = GCompressionState->m_threadCaches[slot];
+                if (cache.m_counts[kind] < kMaxThreadCachedContextCount)
+                {
+                    node->m_next.store(cache.m_heads[kind], std::memory_order_relaxed);
+                    cache.m_heads[kind] = node;
+                    ++cache.m_counts[kind];
+                    return;
+                }
+            }
+
+            PushShared(GCompressionState->m_sharedLists[kind], node);
         }
 
 
         libdeflate_compressor* CastCompressor(void* impl)
         {
-            return static_cast<libdeflate_compressor*>(impl);
+            return static_cast<libdeflate_compressor*>(static_cast<ContextNode*>(impl)->m_impl);
         }
 
 
         libdeflate_gdeflate_compressor* CastGCompressor(void* impl)
         {
-            return static_cast<libdeflate_gdeflate_compressor*>(impl);
+            return static_cast<libdeflate_gdeflate_compressor*>(static_cast<ContextNode*>(impl)->m_impl);
+        }
+
+
+        LZ4::Context* CastLZ4Compressor(void* impl)
+        {
+            return static_cast<LZ4::Context*>(static_cast<ContextNode*>(impl)->m_impl);
         }
 
 
         libdeflate_decompressor* CastDecompressor(void* impl)
         {
-            return static_cast<libdeflate_decompressor*>(impl);
+            return static_cast<libdeflate_decompressor*>(static_cast<ContextNode*>(impl)->m_impl);
         }
 
 
         libdeflate_gdeflate_decompressor* CastGDecompressor(void* impl)
         {
-            return static_cast<libdeflate_gdeflate_decompressor*>(impl);
+            return static_cast<libdeflate_gdeflate_decompressor*>(static_cast<ContextNode*>(impl)->m_impl);
         }
     } // namespace
 
@@ -115,30 +246,24 @@ namespace FE::Compression
 
     void Internal::Shutdown()
     {
-        for (auto& cache : GCompressionState->m_compressorCache)
+        for (ThreadContextCache& cache : GCompressionState->m_threadCaches)
         {
-            for (void* impl : cache)
-                libdeflate_free_compressor(static_cast<libdeflate_compressor*>(impl));
-
-            cache.clear();
+            for (ContextNode*& head : cache.m_heads)
+            {
+                while (ContextNode* node = head)
+                {
+                    head = node->m_next.load(std::memory_order_relaxed);
+                    DestroyContext(node);
+                }
+            }
         }
 
-        for (auto& cache : GCompressionState->m_gDeflateCompressorCache)
+        for (SharedContextList& list : GCompressionState->m_sharedLists)
         {
-            for (void* impl : cache)
-                libdeflate_free_gdeflate_compressor(static_cast<libdeflate_gdeflate_compressor*>(impl));
-
-            cache.clear();
+            while (ContextNode* node = PopShared(list))
+                DestroyContext(node);
         }
 
-        for (void* impl : GCompressionState->m_decompressorCache)
-            libdeflate_free_decompressor(static_cast<libdeflate_decompressor*>(impl));
-        GCompressionState->m_decompressorCache.clear();
-
-        for (void* impl : GCompressionState->m_gDeflateDecompressorCache)
-            libdeflate_free_gdeflate_decompressor(static_cast<libdeflate_gdeflate_decompressor*>(impl));
-        GCompressionState->m_gDeflateDecompressorCache.clear();
-
         GCompressionState->~CompressionState();
         GCompressionState = nullptr;
     }
@@ -149,13 +274,7 @@ namespace FE::Compression
         if (!m_impl)
             return;
 
-        std::unique_lock lock{ GCompressionState->m_lock };
-
-        if (m_method == Method::kGDeflate)
-            GCompressionState->m_gDeflateCompressorCache[m_level - 1].push_back(m_impl);
-        else
-            GCompressionState->m_compressorCache[m_level - 1].push_back(m_impl);
-
+        ReleaseContext(static_cast<ContextNode*>(m_impl));
         m_impl = nullptr;
     }
 
@@ -191,6 +310,14 @@ namespace FE::Compression
                 const size_t bound = libdeflate_gdeflate_compress_bound(CastGCompressor(m_impl), uncompressedSize, &pageCount);
                 return bound + perBlockMetadataSize + sizeof(PageHeader) * pageCount;
             }
+
+        case Method::kLZ4:
+            {
+                const size_t pageCount = Math::Max<size_t>(Math::CeilDivide(uncompressedSize, kLZ4PageSize), 1);
+                const size_t bound = LZ4::GetPageBounds(kLZ4PageSize) * (pageCount - 1)
+                    + LZ4::GetPageBounds(uncompressedSize - (pageCount - 1) * kLZ4PageSize);
+                return bound + perBlockMetadataSize + sizeof(PageHeader) * pageCount;
+            }
         }
     }
 
@@ -315,6 +442,42 @@ namespace FE::Compression
 
                 return true;
             }
+
+        case Method::kLZ4:
+            {
+                Memory::BlockWriter writer{ dst, dstSize };
+                writer.Write(BlockHeader{ EncodeBlockMagic(m_method), kLZ4PageSize });
+
+                // Unlike GDeflate, the pages are compressed one by one, so they are written without gaps.
+                const auto* srcBytes = static_cast<const std::byte*>(src);
+                const size_t pageCount = Math::Max<size_t>(Math::CeilDivide(srcSize, kLZ4PageSize), 1);
+                size_t tailPageSize = 0;
+                for (size_t pageIndex = 0; pageIndex < pageCount; ++pageIndex)
+                {
+                    if (sizeof(PageHeader) > writer.AvailableSpace())
+                        return false;
+
+                    PageHeader& pageHeader = writer.Write<PageHeader>();
+
+                    const size_t pageOffset = pageIndex * kLZ4PageSize;
+                    const size_t pageSize = Math::Min<size_t>(srcSize - pageOffset, kLZ4PageSize);
+                    const size_t compressedBytes = LZ4::CompressPage(
+                        CastLZ4Compressor(m_impl), srcBytes + pageOffset, pageSize, writer.m_ptr, writer.AvailableSpace());
+                    if (compressedBytes == 0)
+                        return false;
+
+                    writer.m_ptr += compressedBytes;
+                    pageHeader.m_compressedSize = static_cast<uint32_t>(compressedBytes);
+                    pageHeader.m_nextPageOffset = pageIndex + 1 == pageCount ? kInvalidIndex : pageHeader.m_compressedSize;
+                    tailPageSize = pageSize;
+                }
+
+                if (sizeof(BlockFooter) > writer.AvailableSpace())
+                    return false;
+
+                writer.Write(BlockFooter{ static_cast<uint32_t>(tailPageSize), crc.Update(src, srcSize) });
+                return true;
+            }
         }
     }
 
@@ -332,10 +495,11 @@ namespace FE::Compression
             return Compressor{ method, level, nullptr };
 
         case Method::kDeflate:
-            return Compressor{ method, level, AllocateCompressorImpl(level) };
+            return Compressor{ method, level, AcquireContext(GetCompressorKind(method, level)) };
 
         case Method::kGDeflate:
-            return Compressor{ method, level, AllocateGDeflateCompressorImpl(level) };
+        case Method::kLZ4:
+            return Compressor{ method, level, AcquireContext(GetCompressorKind(method, level)) };
         }
     }
 
@@ -345,13 +509,7 @@ namespace FE::Compression
         if (!m_impl)
             return;
 
-        std::unique_lock lock{ GCompressionState->m_lock };
-
-        if (m_method == Method::kGDeflate)
-            GCompressionState->m_gDeflateDecompressorCache.push_back(m_impl);
-        else
-            GCompressionState->m_decompressorCache.push_back(m_impl);
-
+        ReleaseContext(static_cast<ContextNode*>(m_impl));
         m_impl = nullptr;
     }
 
@@ -424,6 +582,9 @@ namespace FE::Compression
 
                 return DecompressionResult{ ResultCode::kSuccess, dstSize };
             }
+
+        case Method::kLZ4:
+            return LZ4::DecompressPage(static_cast<const std::byte*>(src), srcSize, static_cast<std::byte*>(dst), dstSize);
         }
     }
 
@@ -438,13 +599,14 @@ namespace FE::Compression
             [[fallthrough]];
 
         case Method::kNone:
+        case Method::kLZ4:
             return Decompressor{ method, nullptr };
 
         case Method::kDeflate:
-            return Decompressor{ method, AllocateDecompressorImpl() };
+            return Decompressor{ method, AcquireContext(GetDecompressorKind(method)) };
 
         case Method::kGDeflate:
-            return Decompressor{ method, AllocateGDeflateDecompressorImpl() };
+            return Decompressor{ method, AcquireContext(GetDecompressorKind(method)) };
         }
     }
 } // namespace FE::Compression
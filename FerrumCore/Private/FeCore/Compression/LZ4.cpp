@@ -0,0 +1,242 @@
+#include <FeCore/Compression/LZ4.h>
+
+namespace FE::Compression
+{
+    namespace
+    {
+        constexpr uint32_t kMinMatchLength = 4;
+
+        //! @brief The last match must start at least this many bytes before the end of the page.
+        constexpr uint32_t kMatchFindLimit = 12;
+
+        //! @brief The last bytes of a page are always literals.
+        constexpr uint32_t kLastLiteralCount = 5;
+
+        constexpr uint32_t kMaxOffset = 65535;
+        constexpr uint32_t kRunMask = 15;
+
+
+        FE_FORCE_INLINE uint32_t Read32(const std::byte* ptr)
+        {
+            uint32_t value;
+            memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+
+        FE_FORCE_INLINE uint32_t Hash(const uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - Math::FloorLog2(LZ4::kHashTableSize));
+        }
+
+
+        //! @brief Write the remainder of a length that didn't fit into the token.
+        FE_FORCE_INLINE bool WriteLength(std::byte*& dst, const std::byte* dstEnd, size_t length)
+        {
+            const size_t extraByteCount = length / 255 + 1;
+            if (static_cast<size_t>(dstEnd - dst) < extraByteCount)
+                return false;
+
+            for (; length >= 255; length -= 255)
+                *dst++ = std::byte{ 255 };
+
+            *dst++ = static_cast<std::byte>(length);
+            return true;
+        }
+
+
+        FE_FORCE_INLINE bool ReadLength(const std::byte*& src, const std::byte* srcEnd, size_t& length)
+        {
+            for (;;)
+            {
+                if (src == srcEnd)
+                    return false;
+
+                const auto value = static_cast<uint32_t>(*src++);
+                length += value;
+                if (value != 255)
+                    return true;
+            }
+        }
+
+
+        //! @brief Write a sequence: a run of literals optionally followed by a match.
+        bool WriteSequence(std::byte*& dst, const std::byte* dstEnd, const std::byte* literals, const size_t literalCount,
+                           const uint32_t offset, const size_t matchLength)
+        {
+            if (dst == dstEnd)
+                return false;
+
+            std::byte& token = *dst++;
+            const uint32_t literalToken = static_cast<uint32_t>(Math::Min<size_t>(literalCount, kRunMask));
+            if (literalCount >= kRunMask && !WriteLength(dst, dstEnd, literalCount - kRunMask))
+                return false;
+
+            if (static_cast<size_t>(dstEnd - dst) < literalCount)
+                return false;
+
+            memcpy(dst, literals, literalCount);
+            dst += literalCount;
+
+            if (matchLength == 0)
+            {
+                token = static_cast<std::byte>(literalToken << 4);
+                return true;
+            }
+
+            if (dstEnd - dst < 2)
+                return false;
+
+            *dst++ = static_cast<std::byte>(offset & 0xff);
+            *dst++ = static_cast<std::byte>(offset >> 8);
+
+            const size_t matchCode = matchLength - kMinMatchLength;
+            const uint32_t matchToken = static_cast<uint32_t>(Math::Min<size_t>(matchCode, kRunMask));
+            if (matchCode >= kRunMask && !WriteLength(dst, dstEnd, matchCode - kRunMask))
+                return false;
+
+            token = static_cast<std::byte>((literalToken << 4) | matchToken);
+            return true;
+        }
+    } // namespace
+
+
+    size_t LZ4::CompressPage(Context* context, const std::byte* src, const size_t srcSize, std::byte* dst, const size_t dstSize)
+    {
+        FE_AssertDebug(srcSize <= kLZ4PageSize);
+
+        std::byte* dstPtr = dst;
+        const std::byte* dstEnd = dst + dstSize;
+
+        size_t anchor = 0;
+        if (srcSize > kMatchFindLimit)
+        {
+            // The positions are stored incremented by one, so that zero means an empty entry.
+            memset(context->m_hashTable, 0, sizeof(context->m_hashTable));
+
+            const size_t matchFindLimit = srcSize - kMatchFindLimit;
+            const size_t matchLengthLimit = srcSize - kLastLiteralCount;
+
+            size_t position = 0;
+            uint32_t missCount = 0;
+            while (position < matchFindLimit)
+            {
+                const uint32_t sequence = Read32(src + position);
+                uint32_t& entry = context->m_hashTable[Hash(sequence)];
+                const uint32_t candidate = entry;
+                entry = static_cast<uint32_t>(position) + 1;
+
+                if (candidate == 0 || position - (candidate - 1) > kMaxOffset || Read32(src + candidate - 1) != sequence)
+                {
+                    // Skip faster through the data that doesn't compress.
+                    position += 1 + (missCount++ >> 6);
+                    continue;
+                }
+
+                size_t matchPosition = candidate - 1;
+                size_t matchLength = kMinMatchLength;
+                while (position + matchLength < matchLengthLimit && src[position + matchLength] == src[matchPosition + matchLength])
+                    ++matchLength;
+
+                // Extend the match backwards into the pending literals.
+                while (position > anchor && matchPosition > 0 && src[position - 1] == src[matchPosition - 1])
+                {
+                    --position;
+                    --matchPosition;
+                    ++matchLength;
+                }
+
+                const auto offset = static_cast<uint32_t>(position - matchPosition);
+                if (!WriteSequence(dstPtr, dstEnd, src + anchor, position - anchor, offset, matchLength))
+                    return 0;
+
+                position += matchLength;
+                anchor = position;
+                missCount = 0;
+
+                if (position < matchFindLimit)
+                    context->m_hashTable[Hash(Read32(src + position - 2))] = static_cast<uint32_t>(position - 2) + 1;
+            }
+        }
+
+        if (!WriteSequence(dstPtr, dstEnd, src + anchor, srcSize - anchor, 0, 0))
+            return 0;
+
+        return static_cast<size_t>(dstPtr - dst);
+    }
+
+
+    DecompressionResult LZ4::DecompressPage(const std::byte* src, const size_t srcSize, std::byte* dst, const size_t dstSize)
+    {
+        const std::byte* srcEnd = src + srcSize;
+        std::byte* dstPtr = dst;
+        const std::byte* dstEnd = dst + dstSize;
+
+        for (;;)
+        {
+            if (src == srcEnd)
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            const auto token = static_cast<uint32_t>(*src++);
+
+            size_t literalCount = token >> 4;
+            if (literalCount == kRunMask && !ReadLength(src, srcEnd, literalCount))
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            if (static_cast<size_t>(srcEnd - src) < literalCount)
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            if (static_cast<size_t>(dstEnd - dstPtr) < literalCount)
+                return DecompressionResult{ ResultCode::kInsufficientSpace, 0 };
+
+            memcpy(dstPtr, src, literalCount);
+            dstPtr += literalCount;
+            src += literalCount;
+
+            // The last sequence only contains literals.
+            if (src == srcEnd)
+                break;
+
+            if (srcEnd - src < 2)
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            const uint32_t offset = static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8);
+            src += 2;
+
+            if (offset == 0 || offset > static_cast<size_t>(dstPtr - dst))
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            size_t matchLength = token & kRunMask;
+            if (matchLength == kRunMask && !ReadLength(src, srcEnd, matchLength))
+                return DecompressionResult{ ResultCode::kInvalidFormat, 0 };
+
+            matchLength += kMinMatchLength;
+            if (static_cast<size_t>(dstEnd - dstPtr) < matchLength)
+                return DecompressionResult{ ResultCode::kInsufficientSpace, 0 };
+
+            const std::byte* match = dstPtr - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(dstPtr, match, matchLength);
+                dstPtr += matchLength;
+            }
+            else if (offset >= 8)
+            {
+                // The chunks don't overlap, but each chunk can read the bytes written by the previous one.
+                std::byte* matchEnd = dstPtr + matchLength;
+                for (; matchEnd - dstPtr >= 8; dstPtr += 8, match += 8)
+                    memcpy(dstPtr, match, 8);
+
+                while (dstPtr < matchEnd)
+                    *dstPtr++ = *match++;
+            }
+            else
+            {
+                for (size_t byteIndex = 0; byteIndex < matchLength; ++byteIndex)
+                    *dstPtr++ = *match++;
+            }
+        }
+
+        return DecompressionResult{ ResultCode::kSuccess, static_cast<size_t>(dstPtr - dst) };
+    }
+} // namespace FE::Compression
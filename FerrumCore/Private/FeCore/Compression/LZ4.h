@@ -0,0 +1,37 @@
+#pragma once
+#include <FeCore/Compression/Compression.h>
+
+namespace FE::Compression::LZ4
+{
+    //! @brief The number of entries in the match finder's hash table.
+    constexpr uint32_t kHashTableSize = 4096;
+
+
+    //! @brief Compression state, too large to be kept on a fiber stack.
+    struct Context final
+    {
+        uint32_t m_hashTable[kHashTableSize];
+    };
+
+
+    //! @brief Calculate the maximum size of a compressed page.
+    constexpr size_t GetPageBounds(const size_t uncompressedSize)
+    {
+        return uncompressedSize + uncompressedSize / 255 + 16;
+    }
+
+
+    //! @brief Compress a single page into the LZ4 block format.
+    //!
+    //! @param context The compression state.
+    //! @param src     The source data, must not be larger than kLZ4PageSize.
+    //! @param srcSize The size of the source data in bytes.
+    //! @param dst     The buffer to write the compressed data to.
+    //! @param dstSize The size of the destination buffer in bytes.
+    //!
+    //! @return The size of the compressed data or zero if it doesn't fit into the destination buffer.
+    size_t CompressPage(Context* context, const std::byte* src, size_t srcSize, std::byte* dst, size_t dstSize);
+
+    //! @brief Decompress a single page in the LZ4 block format. Never reads or writes outside the provided buffers.
+    DecompressionResult DecompressPage(const std::byte* src, size_t srcSize, std::byte* dst, size_t dstSize);
+} // namespace FE::Compression::LZ4
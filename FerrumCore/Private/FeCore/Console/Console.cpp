@@ -1,7 +1,10 @@
 ﻿#include <FeCore/Base/PlatformInclude.h>
 #include <FeCore/Console/Console.h>
 #include <FeCore/Console/ConsolePrivate.h>
-#include <FeCore/Platform/Windows/Common.h>
+
+#if FE_PLATFORM_WINDOWS
+#    include <FeCore/Platform/Windows/Common.h>
+#endif
 
 namespace FE::Console
 {
@@ -11,9 +14,13 @@ namespace FE::Console
         {
             static constexpr uint32_t kBufferSize = 4096;
 
+#if FE_PLATFORM_WINDOWS
             void* m_consoleHandle = nullptr;
             uint16_t m_defaultAttributes = 0;
             bool m_isExclusive = false;
+#else
+            bool m_isTerminal = false;
+#endif
 
             std::byte m_buffer[kBufferSize];
             std::byte* m_bufferPointer = nullptr;
@@ -39,6 +46,7 @@ namespace FE::Console
         static_assert(sizeof(BufferRecordHeader) == 1);
 
 
+#if FE_PLATFORM_WINDOWS
         void SetTextColorImpl(Color color)
         {
             if (color == Color::kDefault)
@@ -52,6 +60,59 @@ namespace FE::Console
         }
 
 
+        void WriteTextImpl(const festd::string_view text)
+        {
+            const Platform::WideString wideText{ text };
+            WriteConsoleW(GConsoleState->m_consoleHandle, wideText.data(), wideText.size(), nullptr, nullptr);
+
+            if (IsDebuggerPresent())
+            {
+                OutputDebugStringW(wideText.data());
+            }
+        }
+#else
+        void WriteTextImpl(const festd::string_view text)
+        {
+            const char* data = text.data();
+            size_t bytesLeft = text.size();
+            while (bytesLeft > 0)
+            {
+                const ssize_t result = write(STDOUT_FILENO, data, bytesLeft);
+                if (result < 0 && errno == EINTR)
+                    continue;
+                if (result <= 0)
+                    return;
+
+                data += result;
+                bytesLeft -= static_cast<size_t>(result);
+            }
+        }
+
+
+        void SetTextColorImpl(Color color)
+        {
+            if (!GConsoleState->m_isTerminal)
+                return;
+
+            if (color == Color::kDefault)
+            {
+                WriteTextImpl("\x1b[0m");
+                return;
+            }
+
+            // Color values follow the Windows console attribute layout: bit 0 is blue, bit 1 is green,
+            // bit 2 is red and bit 3 is intensity. ANSI escape codes have red and blue swapped.
+            const uint32_t colorBits = static_cast<uint32_t>(color);
+            const uint32_t ansiColor = ((colorBits & 0x4) >> 2) | (colorBits & 0x2) | ((colorBits & 0x1) << 2);
+            const uint32_t ansiBase = (colorBits & 0x8) ? 90 : 30;
+
+            char sequence[8];
+            const int32_t length = snprintf(sequence, sizeof(sequence), "\x1b[%um", ansiBase + ansiColor);
+            WriteTextImpl({ sequence, static_cast<uint32_t>(length) });
+        }
+#endif
+
+
         struct BufferWriter final
         {
             BufferWriter()
@@ -113,15 +174,7 @@ namespace FE::Console
                     const uint32_t payloadSize = *reinterpret_cast<uint32_t*>(pointer);
                     pointer += sizeof(uint32_t);
 
-                    const festd::string_view payload{ reinterpret_cast<const char*>(pointer), payloadSize };
-                    const Platform::WideString wideText{ payload };
-                    WriteConsoleW(m_state->m_consoleHandle, wideText.data(), wideText.size(), nullptr, nullptr);
-
-                    if (IsDebuggerPresent())
-                    {
-                        OutputDebugStringW(wideText.data());
-                    }
-
+                    WriteTextImpl({ reinterpret_cast<const char*>(pointer), payloadSize });
                     pointer += payloadSize;
                 }
 
@@ -143,13 +196,14 @@ namespace FE::Console
     {
         FE_CoreAssert(GConsoleState == nullptr, "Console already initialized");
         GConsoleState = Memory::New<ConsoleState>(allocator);
+        GConsoleState->m_bufferPointer = GConsoleState->m_buffer;
 
+#if FE_PLATFORM_WINDOWS
         GConsoleState->m_consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
 
         CONSOLE_SCREEN_BUFFER_INFO info;
         GetConsoleScreenBufferInfo(GConsoleState->m_consoleHandle, &info);
         GConsoleState->m_defaultAttributes = info.wAttributes;
-        GConsoleState->m_bufferPointer = GConsoleState->m_buffer;
 
         DWORD consoleProcessIds[2];
         const DWORD processCount = GetConsoleProcessList(consoleProcessIds, 2);
@@ -163,6 +217,9 @@ namespace FE::Console
             SetConsoleTitleW(L"Ferrum3D Console");
             ShowWindow(GetConsoleWindow(), SW_HIDE);
         }
+#else
+        GConsoleState->m_isTerminal = isatty(STDOUT_FILENO) != 0;
+#endif
     }
 
 
@@ -2,9 +2,10 @@
 #include <FeCore/DI/Registry.h>
 
 #include <FeCore/IO/AsyncStreamIO.h>
-#include <FeCore/IO/StreamFactory.h>
+#include <FeCore/IO/PakStreamFactory.h>
 #include <FeCore/Jobs/JobSystem.h>
 #include <FeCore/Logging/Logger.h>
+#include <FeCore/Memory/FrameAllocator.h>
 
 namespace FE::DI
 {
@@ -26,8 +27,9 @@ namespace FE::DI
     {
         builder.Bind<IJobSystem>().To<JobSystem>().InSingletonScope();
         builder.Bind<Logger>().ToSelf().InSingletonScope();
-        builder.Bind<IO::IStreamFactory>().To<IO::FileStreamFactory>().InSingletonScope();
+        builder.Bind<IO::IStreamFactory>().To<IO::PakStreamFactory>().InSingletonScope();
         builder.Bind<IO::IAsyncStreamIO>().To<IO::AsyncStreamIO>().InSingletonScope();
+        builder.Bind<Memory::FrameAllocator>().ToSelf().InSingletonScope();
     }
 
 
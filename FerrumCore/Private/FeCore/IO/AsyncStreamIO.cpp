@@ -1,9 +1,11 @@
 ﻿#include <FeCore/Containers/SegmentedVector.h>
 #include <FeCore/IO/AsyncStreamIO.h>
+#include <FeCore/IO/Platform/PlatformFile.h>
 #include <FeCore/Jobs/Job.h>
 #include <FeCore/Logging/Trace.h>
 #include <FeCore/Memory/FiberTempAllocator.h>
 #include <FeCore/Memory/SegmentedBuffer.h>
+#include <algorithm>
 
 namespace FE::IO
 {
@@ -36,6 +38,10 @@ namespace FE::IO
                     return;
                 }
 
+                // The page is still hot in the cache, the block job combines the page CRCs.
+                if (m_computeCrc)
+                    m_crc = Crc32::Compute(m_destinationBuffer, m_decompressedSize);
+
                 m_success = true;
             }
 
@@ -43,6 +49,8 @@ namespace FE::IO
             std::byte* m_destinationBuffer = nullptr;
             size_t m_decompressedSize = 0;
             Compression::Method m_method = Compression::Method::kInvalid;
+            uint32_t m_crc = 0;
+            bool m_computeCrc = false;
             bool m_success = false;
         };
 
@@ -76,6 +84,7 @@ namespace FE::IO
                     job.m_destinationBuffer = readPtr;
                     job.m_decompressedSize = decompressedSize;
                     job.m_method = m_method;
+                    job.m_computeCrc = request.m_verifyIntegrity;
                     job.ScheduleBackground(m_jobSystem, completionWaitGroup.Get(), request.m_decompressionPriority);
 
                     readPtr += decompressedSize;
@@ -83,20 +92,37 @@ namespace FE::IO
 
                 completionWaitGroup->Wait();
 
-                m_entry->m_status.store(AsyncOperationStatus::kSucceeded, std::memory_order_release);
-
-                bool success = true;
+                ResultCode blockResult = ResultCode::kSuccess;
+                uint32_t crc = m_crcSeed;
                 for (const PageDecompressJob& job : childJobs)
                 {
                     if (!job.m_success)
                     {
-                        success = false;
+                        blockResult = ResultCode::kDecompressionError;
                         break;
                     }
+
+                    if (job.m_computeCrc)
+                        crc = Crc32::Combine(crc, job.m_crc, job.m_decompressedSize);
+                }
+
+                if (blockResult == ResultCode::kSuccess && request.m_verifyIntegrity && crc != m_expectedCrc)
+                    blockResult = ResultCode::kIntegrityViolation;
+
+                // A failed block marks the whole request as failed, the other blocks never overwrite that.
+                // The success is only reported by the last block, after all the others have been verified.
+                if (blockResult != ResultCode::kSuccess)
+                {
+                    m_entry->m_lastResult.store(blockResult, std::memory_order_release);
+                    m_entry->m_status.store(AsyncOperationStatus::kFailed, std::memory_order_release);
                 }
 
-                m_entry->m_status.store(success ? AsyncOperationStatus::kSucceeded : AsyncOperationStatus::kFailed,
-                                        std::memory_order_release);
+                const uint32_t blockCount = m_entry->m_decompressedBlockCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+                if (blockCount == request.m_blockCount
+                    && m_entry->m_lastResult.load(std::memory_order_acquire) == ResultCode::kSuccess)
+                {
+                    m_entry->m_status.store(AsyncOperationStatus::kSucceeded, std::memory_order_release);
+                }
 
                 m_pageBuffer.Free();
 
@@ -105,24 +131,159 @@ namespace FE::IO
                 result.m_request = &request;
                 result.m_bytesRead = readPtr - request.m_readBuffer - blockOffset;
                 result.m_blockIndex = m_blockIndex;
+                result.m_result = blockResult;
                 request.m_callback->AsyncIOCallback(result);
 
-                if (m_entry->m_remainingBlockCount.fetch_sub(1, std::memory_order_release) == 1)
-                    Memory::Delete(m_entryAllocator, m_entry);
+                if (m_entry->m_referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    Memory::Delete(m_allocator, m_entry);
 
-                Memory::Delete(m_jobAllocator, this);
+                Memory::Delete(m_allocator, this);
             }
 
             IJobSystem* m_jobSystem;
             AsyncBlockReadRequestQueueEntry* m_entry;
-            Memory::SpinLockedPoolAllocator* m_entryAllocator;
-            Memory::SpinLockedPoolAllocator* m_jobAllocator;
+            Memory::ThreadCachedPoolAllocator* m_allocator;
             uint32_t m_pageDecompressedSize;
             uint32_t m_tailPageDecompressedSize;
             Compression::Method m_method;
             uint32_t m_blockIndex;
+            uint32_t m_crcSeed;
+            uint32_t m_expectedCrc;
             Memory::SegmentedBuffer m_pageBuffer;
         };
+
+
+        enum class BlockParseResult
+        {
+            kSuccess,
+            kIncomplete,
+            kInvalidFormat,
+        };
+
+
+        //! @brief Calculate the size of a compressed block stored in memory without reading past the end of the provided data.
+        BlockParseResult MeasureBlock(const std::byte* data, const size_t byteSize, uint32_t& blockByteSize)
+        {
+            size_t offset = sizeof(Compression::BlockHeader);
+            if (byteSize < offset)
+                return BlockParseResult::kIncomplete;
+
+            for (;;)
+            {
+                if (byteSize - offset < sizeof(Compression::PageHeader))
+                    return BlockParseResult::kIncomplete;
+
+                Compression::PageHeader pageHeader;
+                memcpy(&pageHeader, data + offset, sizeof(Compression::PageHeader));
+                offset += sizeof(Compression::PageHeader);
+
+                if (pageHeader.m_nextPageOffset == kInvalidIndex)
+                {
+                    if (byteSize - offset < pageHeader.m_compressedSize)
+                        return BlockParseResult::kIncomplete;
+
+                    offset += pageHeader.m_compressedSize;
+                    break;
+                }
+
+                if (pageHeader.m_nextPageOffset < pageHeader.m_compressedSize)
+                    return BlockParseResult::kInvalidFormat;
+
+                if (byteSize - offset < pageHeader.m_nextPageOffset)
+                    return BlockParseResult::kIncomplete;
+
+                offset += pageHeader.m_nextPageOffset;
+            }
+
+            if (byteSize - offset < sizeof(Compression::BlockFooter))
+                return BlockParseResult::kIncomplete;
+
+            blockByteSize = static_cast<uint32_t>(offset + sizeof(Compression::BlockFooter));
+            return BlockParseResult::kSuccess;
+        }
+
+
+        //! @brief Call the provided function for every page of a block previously validated by MeasureBlock().
+        //!
+        //! @return Pointer to the block footer.
+        template<class TFunctor>
+        const std::byte* ForEachPage(const std::byte* block, TFunctor functor)
+        {
+            const std::byte* page = block + sizeof(Compression::BlockHeader);
+            for (;;)
+            {
+                Compression::PageHeader pageHeader;
+                memcpy(&pageHeader, page, sizeof(Compression::PageHeader));
+                functor(page, pageHeader);
+
+                page += sizeof(Compression::PageHeader);
+                if (pageHeader.m_nextPageOffset == kInvalidIndex)
+                    return page + pageHeader.m_compressedSize;
+
+                page += pageHeader.m_nextPageOffset;
+            }
+        }
+
+
+        bool CompareQueueEntries(const AsyncRequestQueueEntry* lhs, const AsyncRequestQueueEntry* rhs)
+        {
+            // The queue is a max-heap: higher priority requests go first, requests with the same priority are FIFO.
+            if (lhs->m_priority != rhs->m_priority)
+                return lhs->m_priority < rhs->m_priority;
+
+            return lhs->m_sequenceNumber > rhs->m_sequenceNumber;
+        }
+
+
+        //! @brief If the request's stream is memory-mapped, hint the OS to start reading the range that the request will access.
+        //!
+        //! @param request  The request to prefetch the data for.
+        //! @param byteSize The expected number of bytes to read, zero means until the end of the stream.
+        void PrefetchMappedRange(const AsyncOperationRequest& request, const uint64_t byteSize)
+        {
+            if (request.m_stream == nullptr)
+                return;
+
+            const festd::span<const std::byte> mappedData = request.m_stream->GetMappedData();
+            const uint64_t offset = static_cast<uint64_t>(request.m_offset);
+            if (offset >= mappedData.size())
+                return;
+
+            const uint64_t remainingBytes = mappedData.size() - offset;
+            const uint64_t prefetchBytes = byteSize == 0 ? remainingBytes : Math::Min(byteSize, remainingBytes);
+            Platform::PrefetchMappedFile(mappedData.data() + offset, prefetchBytes);
+        }
+
+
+        //! @brief Keeps a memory-mapped stream open while the caller holds a zero-copy buffer that points into the mapping.
+        //!
+        //! The resource never allocates. Deallocating the buffer closes the stream and destroys the resource.
+        struct MappedBufferResource final : public std::pmr::memory_resource
+        {
+            explicit MappedBufferResource(Rc<IStream> stream)
+                : m_stream(std::move(stream))
+            {
+            }
+
+        private:
+            Rc<IStream> m_stream;
+
+            void* do_allocate(size_t, size_t) override
+            {
+                FE_DebugBreak();
+                return nullptr;
+            }
+
+            void do_deallocate(void*, size_t, size_t) override
+            {
+                Memory::DefaultDelete(this);
+            }
+
+            bool do_is_equal(const memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
     } // namespace
 
 
@@ -133,13 +294,106 @@ namespace FE::IO
         if (m_queue.empty())
             return nullptr;
 
+        // Block reads need a staging slot. If there are none, wait instead of letting lower priority requests overtake.
         AsyncRequestQueueEntry* entry = m_queue.front();
-        m_queue.erase(m_queue.begin());
+        if (entry->m_type == AsyncRequestQueueEntry::Type::kReadBlock && m_freeStagingSlotMask == 0)
+            return nullptr;
+
+        std::pop_heap(m_queue.begin(), m_queue.end(), &CompareQueueEntries);
+        m_queue.pop_back();
         return entry;
     }
 
 
-    void AsyncStreamIO::ProcessRequest(AsyncReadRequestQueueEntry* entry, AsyncOperationStatus status)
+    std::byte* AsyncStreamIO::GetStagingSlot(const uint32_t slotIndex) const
+    {
+        FE_AssertDebug(slotIndex < kStagingSlotCount);
+        return m_stagingMemory + slotIndex * kStagingSlotSize;
+    }
+
+
+    void AsyncStreamIO::AddOperation(AsyncRequestQueueEntry* entry, const uint64_t offset, std::byte* buffer,
+                                     const uint32_t byteSize, const bool registeredBuffer)
+    {
+        const IStream* stream = entry->m_requestPtr->m_stream.Get();
+
+        Platform::AsyncReadOperation* operation = m_operationPool.New();
+        operation->m_fileHandle = stream->GetNativeHandle();
+        operation->m_offset = operation->m_fileHandle ? stream->GetNativeOffset() + offset : offset;
+        operation->m_buffer = buffer;
+        operation->m_byteSize = byteSize;
+        operation->m_registeredBuffer = registeredBuffer;
+        operation->m_userData = reinterpret_cast<uintptr_t>(entry);
+
+        ++entry->m_pendingOperationCount;
+        m_pendingOperations.PushBack(operation);
+    }
+
+
+    void AsyncStreamIO::SubmitPendingOperations()
+    {
+        FE_PROFILER_ZONE();
+
+        while (Platform::AsyncReadOperation* operation = m_pendingOperations.PopFront())
+        {
+            if (!operation->m_fileHandle)
+            {
+                auto* entry = reinterpret_cast<AsyncRequestQueueEntry*>(operation->m_userData);
+                IStream* stream = entry->m_requestPtr->m_stream.Get();
+
+                operation->m_bytesRead = 0;
+                operation->m_result = ResultCode::kSuccess;
+
+                const festd::span<const std::byte> mappedData = stream->GetMappedData();
+                if (!mappedData.empty())
+                {
+                    // Memory-mapped streams are read with a plain copy without any system calls.
+                    // The pages are prefetched by PrefetchMappedRange() ahead of time.
+                    if (operation->m_offset < mappedData.size())
+                    {
+                        const uint64_t remainingBytes = mappedData.size() - operation->m_offset;
+                        const uint32_t bytesRead =
+                            static_cast<uint32_t>(Math::Min<uint64_t>(operation->m_byteSize, remainingBytes));
+                        memcpy(operation->m_buffer, mappedData.data() + operation->m_offset, bytesRead);
+                        operation->m_bytesRead = bytesRead;
+                    }
+
+                    m_completedOperations.PushBack(operation);
+                    continue;
+                }
+
+                // The stream is not backed by a file that we can read from directly, e.g. it is an in-memory stream.
+                // Fall back to the generic stream interface, such streams usually don't block on I/O anyway.
+                operation->m_result = stream->Seek(static_cast<intptr_t>(operation->m_offset), SeekMode::kBegin);
+                if (operation->m_result == ResultCode::kSuccess)
+                {
+                    const size_t bytesRead = stream->ReadToBuffer(operation->m_buffer, operation->m_byteSize);
+                    operation->m_bytesRead = static_cast<uint32_t>(bytesRead);
+                }
+
+                m_completedOperations.PushBack(operation);
+                continue;
+            }
+
+            if (!m_readQueue->Submit(operation))
+            {
+                m_pendingOperations.PushFront(operation);
+                break;
+            }
+
+            ++m_inFlightOperationCount;
+        }
+    }
+
+
+    void AsyncStreamIO::ReleaseBlockReadReference(AsyncBlockReadRequestQueueEntry* entry)
+    {
+        if (entry->m_referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Memory::Delete(&m_requestAllocator, entry);
+    }
+
+
+    void AsyncStreamIO::StartRequest(AsyncReadRequestQueueEntry* entry, const AsyncOperationStatus status)
     {
         FE_PROFILER_ZONE_NAMED("AsyncReadRequest");
 
@@ -148,48 +402,90 @@ namespace FE::IO
         if (request.m_allocator == nullptr)
             request.m_allocator = std::pmr::get_default_resource();
 
-        AsyncReadResult result{};
-        result.m_controller = entry->m_controller.Get();
-        result.m_request = &request;
-
-        auto deferCallback = festd::defer([&] {
-            entry->m_status.store(status, std::memory_order_release);
-            request.m_callback->AsyncIOCallback(result);
-            Memory::Delete(&m_requestPools[festd::to_underlying(AsyncReadRequestQueueEntry::Type::kRead)], entry);
-        });
-
         if (status == AsyncOperationStatus::kFailed || status == AsyncOperationStatus::kCanceled)
-            return;
-
-        if (request.m_offset > 0)
         {
-            const ResultCode seekResult = request.m_stream->Seek(request.m_offset, SeekMode::kBegin);
-            if (seekResult != ResultCode::kSuccess)
-            {
-                status = AsyncOperationStatus::kFailed;
-                entry->m_lastResult.store(seekResult, std::memory_order_release);
-                ZoneColor(kFailureColor);
-                return;
-            }
+            FinishRequest(entry, status);
+            return;
         }
 
         if (request.m_readBufferSize == 0)
             request.m_readBufferSize = static_cast<uint32_t>(request.m_stream->Length() - request.m_offset);
 
+        const festd::span<const std::byte> mappedData = request.m_stream->GetMappedData();
+        if (request.m_zeroCopy && request.m_readBuffer == nullptr && !mappedData.empty())
+        {
+            // Hand out the mapped memory directly. The entry is deleted right after the callback, so the buffer's
+            // allocator holds a reference to the stream to keep the file mapped until FreeData() is called.
+            const uint64_t offset = Math::Min<uint64_t>(request.m_offset, mappedData.size());
+            const uint64_t byteSize = Math::Min<uint64_t>(request.m_readBufferSize, mappedData.size() - offset);
+            request.m_allocator = Memory::DefaultNew<MappedBufferResource>(request.m_stream);
+            request.m_readBuffer = const_cast<std::byte*>(mappedData.data() + offset);
+            entry->m_bytesRead = static_cast<size_t>(byteSize);
+            PrefetchMappedRange(request, byteSize);
+            FinishRequest(entry, AsyncOperationStatus::kSucceeded);
+            return;
+        }
+
         if (request.m_readBuffer == nullptr)
         {
             const uint32_t allocBytes = request.m_readBufferSize + request.m_overallocateBytes;
             request.m_readBuffer = static_cast<std::byte*>(request.m_allocator->allocate(allocBytes, Memory::kDefaultAlignment));
         }
 
-        result.m_bytesRead = request.m_stream->ReadToBuffer(request.m_readBuffer, request.m_readBufferSize);
-        request.m_offset += result.m_bytesRead;
-        status = AsyncOperationStatus::kSucceeded;
-        ZoneColor(kSuccessColor);
+        if (request.m_readBufferSize == 0)
+        {
+            FinishRequest(entry, AsyncOperationStatus::kSucceeded);
+            return;
+        }
+
+        // Reads from a file handle are split into chunks, so that the device can process them in parallel.
+        const bool hasNativeHandle = request.m_stream->GetNativeHandle().IsValid();
+        const uint32_t chunkSize = hasNativeHandle ? kReadChunkSize : request.m_readBufferSize;
+        for (uint32_t chunkOffset = 0; chunkOffset < request.m_readBufferSize; chunkOffset += chunkSize)
+        {
+            const uint32_t byteSize = Math::Min(chunkSize, request.m_readBufferSize - chunkOffset);
+            const uint64_t fileOffset = static_cast<uint64_t>(request.m_offset) + chunkOffset;
+            AddOperation(entry, fileOffset, request.m_readBuffer + chunkOffset, byteSize, false);
+        }
+    }
+
+
+    void AsyncStreamIO::CompleteOperation(AsyncReadRequestQueueEntry* entry, Platform::AsyncReadOperation* operation)
+    {
+        entry->m_bytesRead += operation->m_bytesRead;
+        if (operation->m_result != ResultCode::kSuccess)
+            entry->m_lastResult.store(operation->m_result, std::memory_order_release);
+
+        m_operationPool.Delete(operation);
+
+        if (--entry->m_pendingOperationCount > 0)
+            return;
+
+        const bool failed = entry->m_lastResult.load(std::memory_order_relaxed) != ResultCode::kSuccess;
+        FinishRequest(entry, failed ? AsyncOperationStatus::kFailed : AsyncOperationStatus::kSucceeded);
     }
 
 
-    void AsyncStreamIO::ProcessRequest(AsyncBlockReadRequestQueueEntry* entry, AsyncOperationStatus status)
+    void AsyncStreamIO::FinishRequest(AsyncReadRequestQueueEntry* entry, const AsyncOperationStatus status)
+    {
+        FE_PROFILER_ZONE_NAMED("FinishAsyncReadRequest");
+        ZoneColor(status == AsyncOperationStatus::kSucceeded ? kSuccessColor : kFailureColor);
+
+        AsyncReadRequest& request = entry->m_request;
+        request.m_offset += static_cast<intptr_t>(entry->m_bytesRead);
+
+        AsyncReadResult result{};
+        result.m_controller = entry->m_controller.Get();
+        result.m_request = &request;
+        result.m_bytesRead = entry->m_bytesRead;
+
+        entry->m_status.store(status, std::memory_order_release);
+        request.m_callback->AsyncIOCallback(result);
+        Memory::Delete(&m_requestAllocator, entry);
+    }
+
+
+    void AsyncStreamIO::StartRequest(AsyncBlockReadRequestQueueEntry* entry, const AsyncOperationStatus status)
     {
         FE_PROFILER_ZONE_NAMED("AsyncBlockReadRequest");
 
@@ -200,239 +496,265 @@ namespace FE::IO
         if (request.m_allocator == nullptr)
             request.m_allocator = std::pmr::get_default_resource();
 
-        AsyncBlockReadResult result{};
-        result.m_controller = entry->m_controller.Get();
-        result.m_request = &request;
-
-        auto deferCallback = festd::defer([&] {
-            entry->m_status.store(status, std::memory_order_release);
-            request.m_callback->AsyncIOCallback(result);
-            Memory::Delete(&m_requestPools[festd::to_underlying(AsyncBlockReadRequestQueueEntry::Type::kReadBlock)], entry);
-        });
+        // The I/O thread holds a reference until it reads the last block.
+        entry->m_referenceCount.store(1, std::memory_order_relaxed);
 
         if (status == AsyncOperationStatus::kFailed || status == AsyncOperationStatus::kCanceled)
+        {
+            FinishRequest(entry, status);
             return;
+        }
 
-        if (request.m_offset > 0)
+        if (request.m_decompress && request.m_readBuffer == nullptr)
         {
-            const ResultCode seekResult = request.m_stream->Seek(request.m_offset, SeekMode::kBegin);
-            if (seekResult != ResultCode::kSuccess)
-            {
-                status = AsyncOperationStatus::kFailed;
-                entry->m_lastResult.store(seekResult, std::memory_order_release);
-                ZoneColor(kFailureColor);
-                return;
-            }
+            const uint32_t allocBytes = Compression::kBlockSize * request.m_blockCount;
+            request.m_readBuffer = static_cast<std::byte*>(request.m_allocator->allocate(allocBytes, Memory::kDefaultAlignment));
         }
 
-        festd::inline_vector<BlockDecompressJob*, 64> jobs;
+        // The compressed size is only known after the headers are read, the decompressed size is a good estimate.
+        PrefetchMappedRange(request, static_cast<uint64_t>(request.m_blockCount) * Compression::kBlockSize);
+
+        entry->m_streamLength = request.m_stream->Length();
+        entry->m_stagingSlot = static_cast<uint32_t>(Bit::CountTrailingZeros(m_freeStagingSlotMask));
+        m_freeStagingSlotMask &= ~(1u << entry->m_stagingSlot);
+
+        ReadNextBlocks(entry);
+    }
 
-        auto deleteJobsIfFailed = festd::defer([&] {
-            for (auto* job : jobs)
-                Memory::Delete(&m_blockDecompressionJobPool, job);
-        });
 
-        for (uint32_t blockIndex = 0; blockIndex < request.m_blockCount; ++blockIndex)
+    void AsyncStreamIO::ReadNextBlocks(AsyncBlockReadRequestQueueEntry* entry)
+    {
+        const AsyncBlockReadRequest& request = entry->m_request;
+
+        const uint64_t readOffset = static_cast<uint64_t>(request.m_offset) + entry->m_stagingByteSize;
+        if (readOffset >= entry->m_streamLength)
         {
-            FE_PROFILER_ZONE_NAMED("ProcessBlock");
+            // The stream has ended in the middle of a block.
+            entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
+            FinishRequest(entry, AsyncOperationStatus::kFailed);
+            return;
+        }
 
-            Compression::BlockHeader blockHeader;
-            if (!request.m_stream->Read(blockHeader))
-            {
-                status = AsyncOperationStatus::kFailed;
-                entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                ZoneColor(kFailureColor);
-                return;
-            }
+        const uint64_t remainingStreamBytes = entry->m_streamLength - readOffset;
+        const uint32_t freeSlotBytes = kStagingSlotSize - entry->m_stagingByteSize;
+        const uint32_t byteSize = static_cast<uint32_t>(Math::Min<uint64_t>(freeSlotBytes, remainingStreamBytes));
 
-            request.m_offset += sizeof(Compression::BlockHeader);
+        std::byte* slot = GetStagingSlot(entry->m_stagingSlot);
+        AddOperation(entry, readOffset, slot + entry->m_stagingByteSize, byteSize, true);
+    }
 
-            if (request.m_decompress)
-            {
-                const Compression::Method method = Compression::DecodeMagic(blockHeader.m_magic);
-                if (method == Compression::Method::kInvalid)
-                {
-                    status = AsyncOperationStatus::kFailed;
-                    entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                    ZoneColor(kFailureColor);
-                    return;
-                }
 
-                if (request.m_readBuffer == nullptr)
-                {
-                    const uint32_t allocBytes = Compression::kBlockSize * request.m_blockCount;
-                    request.m_readBuffer =
-                        static_cast<std::byte*>(request.m_allocator->allocate(allocBytes, Memory::kDefaultAlignment));
-                }
+    bool AsyncStreamIO::ScheduleBlockDecompression(AsyncBlockReadRequestQueueEntry* entry, const std::byte* block)
+    {
+        FE_PROFILER_ZONE();
 
-                Memory::SegmentedBufferManualBuilder pageBufferBuilder{ std::pmr::get_default_resource() };
-                for (;;)
-                {
-                    Compression::PageHeader pageHeader;
-                    if (!request.m_stream->Read(pageHeader))
-                    {
-                        status = AsyncOperationStatus::kFailed;
-                        entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                        ZoneColor(kFailureColor);
-                        return;
-                    }
+        AsyncBlockReadRequest& request = entry->m_request;
 
-                    request.m_offset += sizeof(Compression::PageHeader);
+        Compression::BlockHeader blockHeader;
+        memcpy(&blockHeader, block, sizeof(Compression::BlockHeader));
 
-                    const uint32_t segmentSize = pageHeader.m_compressedSize + sizeof(Compression::PageHeader);
-                    std::byte* segment = pageBufferBuilder.AllocateSegment(segmentSize);
-                    memcpy(segment, &pageHeader, sizeof(Compression::PageHeader));
-                    segment += sizeof(Compression::PageHeader);
-                    if (request.m_stream->ReadToBuffer(segment, pageHeader.m_compressedSize) != pageHeader.m_compressedSize)
-                    {
-                        status = AsyncOperationStatus::kFailed;
-                        entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                        ZoneColor(kFailureColor);
-                        return;
-                    }
+        const Compression::Method method = Compression::DecodeMagic(blockHeader.m_magic);
+        if (method == Compression::Method::kInvalid)
+            return false;
 
-                    request.m_offset += pageHeader.m_compressedSize;
+        Memory::SegmentedBufferManualBuilder pageBufferBuilder{ std::pmr::get_default_resource() };
+        const std::byte* footer = ForEachPage(block, [&](const std::byte* page, const Compression::PageHeader& pageHeader) {
+            const uint32_t segmentSize = pageHeader.m_compressedSize + sizeof(Compression::PageHeader);
+            memcpy(pageBufferBuilder.AllocateSegment(segmentSize), page, segmentSize);
+        });
 
-                    if (pageHeader.m_nextPageOffset == kInvalidIndex)
-                        break;
+        Compression::BlockFooter blockFooter;
+        memcpy(&blockFooter, footer, sizeof(Compression::BlockFooter));
+
+        auto* decompressionJob = Memory::New<BlockDecompressJob>(&m_requestAllocator);
+        decompressionJob->m_jobSystem = m_jobSystem;
+        decompressionJob->m_entry = entry;
+        decompressionJob->m_allocator = &m_requestAllocator;
+        decompressionJob->m_pageDecompressedSize = blockHeader.m_uncompressedPageSize;
+        decompressionJob->m_tailPageDecompressedSize = blockFooter.m_tailPageUncompressedSize;
+        decompressionJob->m_method = method;
+        decompressionJob->m_blockIndex = entry->m_blockIndex;
+        decompressionJob->m_crcSeed = request.m_crc32.m_current;
+        decompressionJob->m_expectedCrc = blockFooter.m_crc32;
+        decompressionJob->m_pageBuffer = pageBufferBuilder.Build();
+
+        // The CRC is chained through the blocks. Seeding the next block with the stored value rather than the computed one
+        // lets all the blocks be verified in parallel, a corrupted footer is still caught by its own block's check.
+        request.m_crc32.m_current = blockFooter.m_crc32;
+
+        entry->m_referenceCount.fetch_add(1, std::memory_order_relaxed);
+        decompressionJob->ScheduleBackground(m_jobSystem, nullptr, request.m_decompressionPriority);
+        return true;
+    }
 
-                    if (pageHeader.m_nextPageOffset != pageHeader.m_compressedSize)
-                    {
-                        if (pageHeader.m_nextPageOffset < pageHeader.m_compressedSize)
-                        {
-                            status = AsyncOperationStatus::kFailed;
-                            entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                            ZoneColor(kFailureColor);
-                            return;
-                        }
-
-                        request.m_stream->Seek(pageHeader.m_nextPageOffset - pageHeader.m_compressedSize, SeekMode::kCurrent);
-                    }
-                }
 
-                Compression::BlockFooter blockFooter;
-                if (!request.m_stream->Read(blockFooter))
-                {
-                    status = AsyncOperationStatus::kFailed;
-                    entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                    ZoneColor(kFailureColor);
-                    return;
-                }
+    void AsyncStreamIO::CompleteOperation(AsyncBlockReadRequestQueueEntry* entry, Platform::AsyncReadOperation* operation)
+    {
+        FE_PROFILER_ZONE_NAMED("ProcessBlocks");
+
+        AsyncBlockReadRequest& request = entry->m_request;
+
+        const ResultCode readResult = operation->m_result;
+        const uint32_t bytesRead = operation->m_bytesRead;
+        m_operationPool.Delete(operation);
+        --entry->m_pendingOperationCount;
+
+        if (readResult != ResultCode::kSuccess)
+        {
+            entry->m_lastResult.store(readResult, std::memory_order_release);
+            FinishRequest(entry, AsyncOperationStatus::kFailed);
+            return;
+        }
+
+        std::byte* slot = GetStagingSlot(entry->m_stagingSlot);
+        const uint32_t availableByteSize = entry->m_stagingByteSize + bytesRead;
+        uint32_t consumedByteSize = 0;
+
+        // Every complete block in the staging slot is sent to decompression right away, while the rest is still being read.
+        while (entry->m_blockIndex < request.m_blockCount)
+        {
+            const std::byte* block = slot + consumedByteSize;
+
+            uint32_t blockByteSize = 0;
+            const BlockParseResult parseResult = MeasureBlock(block, availableByteSize - consumedByteSize, blockByteSize);
+            if (parseResult == BlockParseResult::kIncomplete)
+                break;
 
-                request.m_offset += sizeof(Compression::BlockFooter);
-
-                auto* decompressionJob = Memory::New<BlockDecompressJob>(&m_blockDecompressionJobPool);
-                decompressionJob->m_jobSystem = m_jobSystem;
-                decompressionJob->m_entry = entry;
-                decompressionJob->m_entryAllocator =
-                    &m_requestPools[festd::to_underlying(AsyncBlockReadRequestQueueEntry::Type::kReadBlock)];
-                decompressionJob->m_jobAllocator = &m_blockDecompressionJobPool;
-                decompressionJob->m_pageDecompressedSize = blockHeader.m_uncompressedPageSize;
-                decompressionJob->m_tailPageDecompressedSize = blockFooter.m_tailPageUncompressedSize;
-                decompressionJob->m_method = method;
-                decompressionJob->m_blockIndex = blockIndex;
-                decompressionJob->m_pageBuffer = pageBufferBuilder.Build();
-
-                jobs.push_back(decompressionJob);
+            if (parseResult == BlockParseResult::kInvalidFormat
+                || (request.m_decompress && !ScheduleBlockDecompression(entry, block)))
+            {
+                entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
+                FinishRequest(entry, AsyncOperationStatus::kFailed);
+                return;
             }
-            else
+
+            if (!request.m_decompress)
             {
                 FE_Assert(request.m_readBuffer != nullptr || request.m_readBufferSize == 0,
                           "When not decompressing, the read buffer cannot be allocated automatically");
 
+                // Copy the block to the user's buffer, skipping the gaps between the pages.
                 Memory::BlockWriter writer{ request.m_readBuffer, request.m_readBufferSize };
-                writer.Write(blockHeader);
+                FE_Verify(writer.WriteBytes(block, sizeof(Compression::BlockHeader)), "Insufficient space");
 
-                for (;;)
-                {
-                    Compression::PageHeader pageHeader;
-                    if (!request.m_stream->Read(pageHeader))
-                    {
-                        status = AsyncOperationStatus::kFailed;
-                        entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                        ZoneColor(kFailureColor);
-                        return;
-                    }
+                const auto copyPage = [&](const std::byte* page, const Compression::PageHeader& pageHeader) {
+                    const uint32_t pageByteSize = pageHeader.m_compressedSize + sizeof(Compression::PageHeader);
+                    FE_Verify(writer.WriteBytes(page, pageByteSize), "Insufficient space");
+                };
 
-                    request.m_offset += sizeof(Compression::PageHeader);
+                const std::byte* footer = ForEachPage(block, copyPage);
 
-                    writer.Write(pageHeader);
+                FE_Verify(writer.WriteBytes(footer, sizeof(Compression::BlockFooter)), "Insufficient space");
 
-                    if (request.m_stream->ReadToBuffer(writer.AllocateSpan(pageHeader.m_compressedSize))
-                        != pageHeader.m_compressedSize)
-                    {
-                        status = AsyncOperationStatus::kFailed;
-                        entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                        ZoneColor(kFailureColor);
-                        return;
-                    }
+                AsyncBlockReadResult result{};
+                result.m_controller = entry->m_controller.Get();
+                result.m_request = &request;
+                result.m_bytesRead = writer.m_ptr - request.m_readBuffer;
+                result.m_blockIndex = entry->m_blockIndex;
+                request.m_callback->AsyncIOCallback(result);
+            }
 
-                    request.m_offset += pageHeader.m_compressedSize;
+            consumedByteSize += blockByteSize;
+            request.m_offset += blockByteSize;
+            ++entry->m_blockIndex;
+        }
 
-                    if (pageHeader.m_nextPageOffset == kInvalidIndex)
-                        break;
+        if (entry->m_blockIndex == request.m_blockCount)
+        {
+            FinishRequest(entry, AsyncOperationStatus::kSucceeded);
+            return;
+        }
 
-                    if (pageHeader.m_nextPageOffset != pageHeader.m_compressedSize)
-                    {
-                        if (pageHeader.m_nextPageOffset < pageHeader.m_compressedSize)
-                        {
-                            status = AsyncOperationStatus::kFailed;
-                            entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                            ZoneColor(kFailureColor);
-                            return;
-                        }
-
-                        request.m_stream->Seek(pageHeader.m_nextPageOffset - pageHeader.m_compressedSize, SeekMode::kCurrent);
-                    }
-                }
+        // If a full staging slot doesn't contain a single block, the block is either corrupted or too large.
+        if (bytesRead == 0 || (consumedByteSize == 0 && availableByteSize == kStagingSlotSize))
+        {
+            entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
+            FinishRequest(entry, AsyncOperationStatus::kFailed);
+            return;
+        }
 
-                Compression::BlockFooter blockFooter;
-                if (!request.m_stream->Read(blockFooter))
-                {
-                    status = AsyncOperationStatus::kFailed;
-                    entry->m_lastResult.store(ResultCode::kInvalidFormat, std::memory_order_release);
-                    ZoneColor(kFailureColor);
-                    return;
-                }
+        // Move the beginning of the incomplete block to the start of the slot and read the rest of it.
+        entry->m_stagingByteSize = availableByteSize - consumedByteSize;
+        memmove(slot, slot + consumedByteSize, entry->m_stagingByteSize);
+        ReadNextBlocks(entry);
+    }
 
-                request.m_offset += sizeof(Compression::BlockFooter);
 
-                writer.Write(blockFooter);
+    void AsyncStreamIO::FinishRequest(AsyncBlockReadRequestQueueEntry* entry, const AsyncOperationStatus status)
+    {
+        FE_PROFILER_ZONE_NAMED("FinishAsyncBlockReadRequest");
+        ZoneColor(status == AsyncOperationStatus::kSucceeded ? kSuccessColor : kFailureColor);
 
-                result.m_bytesRead = writer.m_ptr - request.m_readBuffer;
-                result.m_blockIndex = blockIndex;
-                request.m_callback->AsyncIOCallback(result);
-            }
+        AsyncBlockReadRequest& request = entry->m_request;
+
+        if (entry->m_stagingSlot != kInvalidIndex)
+        {
+            m_freeStagingSlotMask |= 1u << entry->m_stagingSlot;
+            entry->m_stagingSlot = kInvalidIndex;
         }
 
-        // If we have reached this point, the request processing has been successful so far.
-        // Which means we can schedule the jobs, and they will call the callbacks when done.
-        deferCallback.dismiss();
+        if (status != AsyncOperationStatus::kSucceeded)
+        {
+            // When the request succeeds, the callback is called for each block separately.
+            AsyncBlockReadResult result{};
+            result.m_controller = entry->m_controller.Get();
+            result.m_request = &request;
+            result.m_blockIndex = entry->m_blockIndex;
+            result.m_result = entry->m_lastResult.load(std::memory_order_acquire);
 
-        // They will also delete themselves.
-        deleteJobsIfFailed.dismiss();
+            // The callbacks check the per-block result, so it must not report success for a canceled request.
+            if (result.m_result == ResultCode::kSuccess)
+                result.m_result = status == AsyncOperationStatus::kCanceled ? ResultCode::kCanceled : ResultCode::kUnknownError;
 
-        entry->m_remainingBlockCount = jobs.size();
+            entry->m_status.store(status, std::memory_order_release);
+            request.m_callback->AsyncIOCallback(result);
+        }
+        else if (!request.m_decompress)
+        {
+            // With decompression enabled the final status is set by the decompression jobs.
+            entry->m_status.store(status, std::memory_order_release);
+        }
 
-        for (auto* job : jobs)
+        ReleaseBlockReadReference(entry);
+    }
+
+
+    void AsyncStreamIO::CompleteOperation(Platform::AsyncReadOperation* operation)
+    {
+        auto* entry = reinterpret_cast<AsyncRequestQueueEntry*>(operation->m_userData);
+        switch (entry->m_type)
         {
-            job->ScheduleBackground(m_jobSystem, nullptr, request.m_decompressionPriority);
+        default:
+        case AsyncRequestQueueEntry::Type::kCount:
+            FE_DebugBreak();
+            [[fallthrough]];
+
+        case AsyncRequestQueueEntry::Type::kRead:
+            CompleteOperation(static_cast<AsyncReadRequestQueueEntry*>(entry), operation);
+            break;
+        case AsyncRequestQueueEntry::Type::kReadBlock:
+            CompleteOperation(static_cast<AsyncBlockReadRequestQueueEntry*>(entry), operation);
+            break;
         }
     }
 
 
-    void AsyncStreamIO::ProcessGenericRequest(AsyncRequestQueueEntry* entry)
+    void AsyncStreamIO::StartGenericRequest(AsyncRequestQueueEntry* entry)
     {
-        FE_PROFILER_ZONE_NAMED("ProcessRequest");
+        FE_PROFILER_ZONE_NAMED("StartRequest");
 
-        auto status = AsyncOperationStatus::kSucceeded;
-        if (entry->m_status.load(std::memory_order_relaxed) == AsyncOperationStatus::kCanceled)
+        auto status = AsyncOperationStatus::kRunning;
+        if (entry->m_cancellationRequested.load(std::memory_order_acquire))
             status = AsyncOperationStatus::kCanceled;
 
+        entry->m_status.store(status, std::memory_order_release);
+
         AsyncOperationRequest& request = *entry->m_requestPtr;
         if (request.m_stream == nullptr && status != AsyncOperationStatus::kCanceled)
         {
-            if (const auto openResult = m_streamFactory->OpenFileStream(request.m_path, OpenMode::kReadOnly))
+            const auto openResult = request.m_memoryMapped ? m_streamFactory->OpenMappedFileStream(request.m_path)
+                                                           : m_streamFactory->OpenFileStream(request.m_path, OpenMode::kReadOnly);
+            if (openResult)
             {
                 request.m_stream = openResult.value();
                 const festd::string_view zoneText = request.m_stream->GetName();
@@ -449,7 +771,7 @@ namespace FE::IO
             }
         }
 
-        if (request.m_path.empty())
+        if (request.m_path.empty() && request.m_stream)
             request.m_path = request.m_stream->GetName();
 
         switch (entry->m_type)
@@ -460,10 +782,10 @@ namespace FE::IO
             [[fallthrough]];
 
         case AsyncRequestQueueEntry::Type::kRead:
-            ProcessRequest(static_cast<AsyncReadRequestQueueEntry*>(entry), status);
+            StartRequest(static_cast<AsyncReadRequestQueueEntry*>(entry), status);
             break;
         case AsyncRequestQueueEntry::Type::kReadBlock:
-            ProcessRequest(static_cast<AsyncBlockReadRequestQueueEntry*>(entry), status);
+            StartRequest(static_cast<AsyncBlockReadRequestQueueEntry*>(entry), status);
             break;
         }
     }
@@ -471,38 +793,49 @@ namespace FE::IO
 
     void AsyncStreamIO::ReaderThread()
     {
+        Platform::AsyncReadOperation* completions[kQueueDepth];
+
         while (true)
         {
-            if (m_exitRequested)
-                break;
-
-            m_queueEvent.Wait();
-
-            if (m_exitRequested)
-                break;
+            // Start new requests only while the read queue has free space. This way a high priority request
+            // that comes later doesn't have to wait until everything we have already dequeued is submitted.
+            while (true)
+            {
+                SubmitPendingOperations();
+                if (!m_pendingOperations.Empty() || m_exitRequested.load(std::memory_order_acquire))
+                    break;
 
-            AsyncRequestQueueEntry* entry;
+                AsyncRequestQueueEntry* entry;
 
-            {
-                std::lock_guard lk{ m_queueLock };
-                entry = TryDequeue();
-                if (entry == nullptr)
                 {
-                    m_queueEvent.Reset();
-                    continue;
+                    std::lock_guard lk{ m_queueLock };
+                    entry = TryDequeue();
                 }
-            }
 
-            if (entry->m_cancellationRequested.load(std::memory_order_acquire))
-            {
-                entry->m_status.store(AsyncOperationStatus::kCanceled, std::memory_order_release);
+                if (entry == nullptr)
+                    break;
+
+                StartGenericRequest(entry);
             }
-            else
+
+            m_readQueue->Flush();
+
+            if (!m_completedOperations.Empty())
             {
-                entry->m_status.store(AsyncOperationStatus::kRunning, std::memory_order_release);
+                while (Platform::AsyncReadOperation* operation = m_completedOperations.PopFront())
+                    CompleteOperation(operation);
+
+                continue;
             }
 
-            ProcessGenericRequest(entry);
+            if (m_exitRequested.load(std::memory_order_acquire) && m_inFlightOperationCount == 0)
+                break;
+
+            const uint32_t completionCount = m_readQueue->WaitForCompletions(completions);
+            m_inFlightOperationCount -= completionCount;
+
+            for (uint32_t completionIndex = 0; completionIndex < completionCount; ++completionIndex)
+                CompleteOperation(completions[completionIndex]);
         }
     }
 
@@ -512,82 +845,88 @@ namespace FE::IO
         , m_jobSystem(jobSystem)
         , m_streamFactory(streamFactory)
     {
-        m_requestPools[festd::to_underlying(AsyncReadRequestQueueEntry::Type::kRead)].Initialize(
-            "AsyncReadRequestPool", sizeof(AsyncReadRequestQueueEntry));
-        m_requestPools[festd::to_underlying(AsyncBlockReadRequestQueueEntry::Type::kReadBlock)].Initialize(
-            "AsyncBlockReadRequestPool", sizeof(AsyncBlockReadRequestQueueEntry));
+        constexpr uint32_t kStagingMemorySize = kStagingSlotSize * kStagingSlotCount;
+        m_stagingMemory = static_cast<std::byte*>(Memory::AllocateVirtual(kStagingMemorySize));
+        m_freeStagingSlotMask = (1u << kStagingSlotCount) - 1;
 
-        m_blockDecompressionJobPool.Initialize("AsyncBlockDecompressionJobPool", sizeof(BlockDecompressJob));
+        m_readQueue = Platform::CreateAsyncReadQueue(std::pmr::get_default_resource(), kQueueDepth);
+        m_readQueue->RegisterBuffer({ m_stagingMemory, kStagingMemorySize });
 
         const auto threadFunc = [](const uintptr_t userData) {
             reinterpret_cast<AsyncStreamIO*>(userData)->ReaderThread();
         };
 
         m_thread = Threading::CreateThread("Async IO Thread", threadFunc, reinterpret_cast<uintptr_t>(this));
-        m_queueEvent = Threading::Event::CreateManualReset();
     }
 
 
     AsyncStreamIO::~AsyncStreamIO()
     {
-        m_exitRequested = true;
-        m_queueEvent.Send();
+        m_exitRequested.store(true, std::memory_order_release);
+        m_readQueue->Wake();
         Threading::CloseThread(m_thread);
+
+        Memory::Delete(std::pmr::get_default_resource(), m_readQueue);
+        Memory::FreeVirtual(m_stagingMemory, kStagingSlotSize * kStagingSlotCount);
     }
 
 
     void AsyncStreamIO::ReadAsync(const AsyncReadRequest& request, const Priority priority, IAsyncController** ppController)
     {
-        std::lock_guard lk{ m_queueLock };
+        {
+            std::lock_guard lk{ m_queueLock };
 
-        constexpr uint32_t poolIndex = festd::to_underlying(AsyncReadRequestQueueEntry::Type::kRead);
-        auto* entry = Memory::New<AsyncReadRequestQueueEntry>(&m_requestPools[poolIndex]);
-        auto* controller = Rc<AsyncController>::New(&m_controllerPool, entry);
-        entry->m_type = AsyncRequestQueueEntry::Type::kRead;
-        entry->m_priority = priority;
-        entry->m_request = request;
-        entry->m_requestPtr = &entry->m_request;
-        entry->m_controller = controller;
+            auto* entry = Memory::New<AsyncReadRequestQueueEntry>(&m_requestAllocator);
+            auto* controller = Rc<AsyncController>::New(&m_requestAllocator, entry);
+            entry->m_type = AsyncRequestQueueEntry::Type::kRead;
+            entry->m_priority = priority;
+            entry->m_request = request;
+            entry->m_requestPtr = &entry->m_request;
+            entry->m_controller = controller;
 
-        EnqueueImpl(priority, entry);
+            EnqueueImpl(priority, entry);
 
-        if (ppController)
-            *ppController = controller;
+            if (ppController)
+                *ppController = controller;
+        }
 
-        m_queueEvent.Send();
+        // Let the OS read the mapped pages while the request is waiting in the queue.
+        PrefetchMappedRange(request, request.m_readBufferSize);
+        m_readQueue->Wake();
     }
 
 
     void AsyncStreamIO::ReadAsync(const AsyncBlockReadRequest& request, const Priority priority, IAsyncController** ppController)
     {
-        std::lock_guard lk{ m_queueLock };
-
         FE_Assert(request.m_blockCount > 0);
 
-        constexpr uint32_t poolIndex = festd::to_underlying(AsyncBlockReadRequestQueueEntry::Type::kReadBlock);
-        auto* entry = Memory::New<AsyncBlockReadRequestQueueEntry>(&m_requestPools[poolIndex]);
-        auto* controller = Rc<AsyncController>::New(&m_controllerPool, entry);
-        entry->m_type = AsyncRequestQueueEntry::Type::kReadBlock;
-        entry->m_priority = priority;
-        entry->m_request = request;
-        entry->m_requestPtr = &entry->m_request;
-        entry->m_controller = controller;
+        {
+            std::lock_guard lk{ m_queueLock };
 
-        EnqueueImpl(priority, entry);
+            auto* entry = Memory::New<AsyncBlockReadRequestQueueEntry>(&m_requestAllocator);
+            auto* controller = Rc<AsyncController>::New(&m_requestAllocator, entry);
+            entry->m_type = AsyncRequestQueueEntry::Type::kReadBlock;
+            entry->m_priority = priority;
+            entry->m_request = request;
+            entry->m_requestPtr = &entry->m_request;
+            entry->m_controller = controller;
 
-        if (ppController)
-            *ppController = controller;
+            EnqueueImpl(priority, entry);
 
-        m_queueEvent.Send();
+            if (ppController)
+                *ppController = controller;
+        }
+
+        PrefetchMappedRange(request, static_cast<uint64_t>(request.m_blockCount) * Compression::kBlockSize);
+        m_readQueue->Wake();
     }
 
 
     void AsyncStreamIO::EnqueueImpl(const Priority priority, AsyncRequestQueueEntry* entry)
     {
-        const auto iter = festd::upper_bound(m_queue, priority, [](const Priority lhs, const AsyncRequestQueueEntry* rhs) {
-            return lhs < rhs->m_priority;
-        });
-
-        m_queue.insert(iter, entry);
+        entry->m_priority = priority;
+        entry->m_sequenceNumber = m_sequenceNumber++;
+        m_queue.push_back(entry);
+        std::push_heap(m_queue.begin(), m_queue.end(), &CompareQueueEntries);
     }
 } // namespace FE::IO
@@ -1,8 +1,9 @@
 ﻿#pragma once
 #include <FeCore/IO/IAsyncStreamIO.h>
+#include <FeCore/IO/Platform/PlatformAsyncRead.h>
 #include <FeCore/Logging/Logger.h>
 #include <FeCore/Memory/PoolAllocator.h>
-#include <FeCore/Threading/Event.h>
+#include <FeCore/Memory/ThreadCachedPoolAllocator.h>
 #include <FeCore/Threading/Thread.h>
 #include <festd/vector.h>
 
@@ -22,11 +23,13 @@ namespace FE::IO
 
         Type m_type;
         Priority m_priority;
+        uint64_t m_sequenceNumber = 0;
         std::atomic<bool> m_cancellationRequested = false;
         Rc<AsyncController> m_controller;
         std::atomic<AsyncOperationStatus> m_status = AsyncOperationStatus::kQueued;
         std::atomic<ResultCode> m_lastResult = ResultCode::kSuccess;
         AsyncOperationRequest* m_requestPtr = nullptr;
+        uint32_t m_pendingOperationCount = 0;
     };
 
 
@@ -63,13 +66,24 @@ namespace FE::IO
     struct AsyncReadRequestQueueEntry : public AsyncRequestQueueEntry
     {
         AsyncReadRequest m_request;
+        size_t m_bytesRead = 0;
     };
 
 
     struct AsyncBlockReadRequestQueueEntry : public AsyncRequestQueueEntry
     {
         AsyncBlockReadRequest m_request;
-        std::atomic<uint32_t> m_remainingBlockCount = 0;
+
+        //! @brief One reference per scheduled decompression job plus one held by the I/O thread until the last block is read.
+        std::atomic<uint32_t> m_referenceCount = 0;
+
+        //! @brief The number of blocks whose decompression has finished, the last one sets the final status.
+        std::atomic<uint32_t> m_decompressedBlockCount = 0;
+
+        size_t m_streamLength = 0;
+        uint32_t m_blockIndex = 0;
+        uint32_t m_stagingSlot = kInvalidIndex;
+        uint32_t m_stagingByteSize = 0; //!< The number of bytes left in the staging slot after the last parsed block.
     };
 
 
@@ -84,28 +98,65 @@ namespace FE::IO
         void ReadAsync(const AsyncBlockReadRequest& request, Priority priority, IAsyncController** ppController) override;
 
     private:
+        //! @brief The maximum number of reads in flight.
+        static constexpr uint32_t kQueueDepth = 64;
+
+        //! @brief Plain reads are split into chunks of this size, so that a single large file can saturate the queue.
+        static constexpr uint32_t kReadChunkSize = 512 * 1024;
+
+        //! @brief Block reads go through staging slots, each slot is large enough to hold at least one compressed block.
+        static constexpr uint32_t kStagingSlotSize = 2 * Compression::kBlockSize;
+        static constexpr uint32_t kStagingSlotCount = 16;
+
+        static_assert(kStagingSlotCount <= 32, "Free staging slots are tracked using a 32-bit mask");
+
         Threading::ThreadHandle m_thread;
-        Threading::Event m_queueEvent;
         Logger* m_logger = nullptr;
-        std::atomic<bool> m_exitRequested;
+        std::atomic<bool> m_exitRequested = false;
 
         IJobSystem* m_jobSystem = nullptr;
         IStreamFactory* m_streamFactory = nullptr;
 
         TracyLockable(Threading::SpinLock, m_queueLock);
         festd::vector<AsyncRequestQueueEntry*> m_queue;
+        uint64_t m_sequenceNumber = 0;
 
-        Memory::SpinLockedPoolAllocator m_blockDecompressionJobPool;
-        Memory::SpinLockedPoolAllocator m_requestPools[festd::to_underlying(AsyncRequestQueueEntry::Type::kCount)];
-        Memory::SpinLockedPoolAllocator m_controllerPool{ "AsyncControllerPool", sizeof(AsyncController) };
+        Platform::AsyncReadQueue* m_readQueue = nullptr;
+        Memory::Pool<Platform::AsyncReadOperation> m_operationPool{ "AsyncReadOperationPool" };
+        Platform::AsyncReadOperationList m_pendingOperations;
+        Platform::AsyncReadOperationList m_completedOperations;
+        uint32_t m_inFlightOperationCount = 0;
+
+        std::byte* m_stagingMemory = nullptr;
+        uint32_t m_freeStagingSlotMask = 0;
+
+        // Requests and controllers are created by the callers and freed on the IO thread or by the decompression jobs.
+        Memory::ThreadCachedPoolAllocator m_requestAllocator{ "AsyncRequestAllocator", Memory::Tag::kIO, 16 * 1024 * 1024 };
 
         void EnqueueImpl(Priority priority, AsyncRequestQueueEntry* entry);
 
         AsyncRequestQueueEntry* TryDequeue();
-        void ProcessGenericRequest(AsyncRequestQueueEntry* entry);
+        void StartGenericRequest(AsyncRequestQueueEntry* entry);
+
+        void StartRequest(AsyncReadRequestQueueEntry* entry, AsyncOperationStatus status);
+        void StartRequest(AsyncBlockReadRequestQueueEntry* entry, AsyncOperationStatus status);
+
+        void CompleteOperation(Platform::AsyncReadOperation* operation);
+        void CompleteOperation(AsyncReadRequestQueueEntry* entry, Platform::AsyncReadOperation* operation);
+        void CompleteOperation(AsyncBlockReadRequestQueueEntry* entry, Platform::AsyncReadOperation* operation);
+
+        void FinishRequest(AsyncReadRequestQueueEntry* entry, AsyncOperationStatus status);
+        void FinishRequest(AsyncBlockReadRequestQueueEntry* entry, AsyncOperationStatus status);
+
+        void ReadNextBlocks(AsyncBlockReadRequestQueueEntry* entry);
+        bool ScheduleBlockDecompression(AsyncBlockReadRequestQueueEntry* entry, const std::byte* block);
+
+        void AddOperation(AsyncRequestQueueEntry* entry, uint64_t offset, std::byte* buffer, uint32_t byteSize,
+                          bool registeredBuffer);
+        void SubmitPendingOperations();
 
-        void ProcessRequest(AsyncReadRequestQueueEntry* entry, AsyncOperationStatus status);
-        void ProcessRequest(AsyncBlockReadRequestQueueEntry* entry, AsyncOperationStatus status);
+        std::byte* GetStagingSlot(uint32_t slotIndex) const;
+        void ReleaseBlockReadReference(AsyncBlockReadRequestQueueEntry* entry);
 
         void ReaderThread();
     };
@@ -43,6 +43,8 @@ namespace FE::IO
             return "Invalid file format";
         case ResultCode::kDecompressionError:
             return "Block file decompression failed";
+        case ResultCode::kIntegrityViolation:
+            return "Data integrity check failed";
         case ResultCode::kUnknownError:
         default:
             return "Unknown error";
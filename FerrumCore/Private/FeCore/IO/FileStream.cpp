@@ -69,6 +69,12 @@ namespace FE::IO
     }
 
 
+    Platform::FileHandle FileStream::GetNativeHandle() const
+    {
+        return m_handle;
+    }
+
+
     void FileStream::Close()
     {
         if (m_handle)
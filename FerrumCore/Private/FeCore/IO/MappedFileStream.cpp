@@ -0,0 +1,168 @@
+﻿#include <FeCore/IO/MappedFileStream.h>
+#include <FeCore/IO/Platform/PlatformFile.h>
+
+namespace FE::IO
+{
+    festd::span<const std::byte> MappedFileStream::GetView(const size_t offset, const size_t byteSize) const
+    {
+        const size_t length = Length();
+        if (offset >= length)
+            return {};
+
+        return { m_data + offset, static_cast<uint32_t>(Math::Min(byteSize, length - offset)) };
+    }
+
+
+    festd::span<const std::byte> MappedFileStream::ReadView(const size_t byteSize)
+    {
+        const festd::span view = GetView(m_position, byteSize);
+        m_position += view.size();
+        return view;
+    }
+
+
+    void MappedFileStream::Prefetch(const size_t offset, const size_t byteSize) const
+    {
+        const festd::span view = GetView(offset, byteSize);
+        if (!view.empty())
+            Platform::PrefetchMappedFile(view.data(), view.size());
+    }
+
+
+    bool MappedFileStream::SeekAllowed() const
+    {
+        return true;
+    }
+
+
+    bool MappedFileStream::IsOpen() const
+    {
+        return m_isOpen;
+    }
+
+
+    ResultCode MappedFileStream::Seek(const intptr_t offset, const SeekMode seekMode)
+    {
+        intptr_t base = 0;
+        switch (seekMode)
+        {
+        case SeekMode::kBegin:
+            base = 0;
+            break;
+        case SeekMode::kCurrent:
+            base = static_cast<intptr_t>(m_position);
+            break;
+        case SeekMode::kEnd:
+            base = static_cast<intptr_t>(Length());
+            break;
+        default:
+            return ResultCode::kInvalidArgument;
+        }
+
+        const intptr_t position = base + offset;
+        if (position < 0 || position > static_cast<intptr_t>(Length()))
+            return ResultCode::kInvalidSeek;
+
+        m_position = static_cast<uintptr_t>(position);
+        return ResultCode::kSuccess;
+    }
+
+
+    uintptr_t MappedFileStream::Tell() const
+    {
+        return m_position;
+    }
+
+
+    size_t MappedFileStream::Length() const
+    {
+        return m_stats.m_byteSize;
+    }
+
+
+    size_t MappedFileStream::ReadToBuffer(void* buffer, const size_t byteSize)
+    {
+        const festd::span view = ReadView(byteSize);
+        memcpy(buffer, view.data(), view.size());
+        return view.size();
+    }
+
+
+    size_t MappedFileStream::WriteFromBuffer(const void*, const size_t)
+    {
+        FE_Assert(false, "Mapped file streams are read-only");
+        return 0;
+    }
+
+
+    festd::string_view MappedFileStream::GetName()
+    {
+        return m_name;
+    }
+
+
+    OpenMode MappedFileStream::GetOpenMode() const
+    {
+        return m_isOpen ? OpenMode::kReadOnly : OpenMode::kNone;
+    }
+
+
+    FileStats MappedFileStream::GetStats() const
+    {
+        return m_stats;
+    }
+
+
+    festd::span<const std::byte> MappedFileStream::GetMappedData() const
+    {
+        return { m_data, static_cast<uint32_t>(Length()) };
+    }
+
+
+    void MappedFileStream::Close()
+    {
+        if (m_data)
+            Platform::UnmapFile(m_data, Length());
+
+        m_data = nullptr;
+        m_position = 0;
+        m_stats = {};
+        m_isOpen = false;
+    }
+
+
+    ResultCode MappedFileStream::Open(const festd::string_view fileName)
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", fileName.size(), fileName.data());
+
+        Close();
+
+        Platform::FileHandle handle;
+        ResultCode result = Platform::OpenFile(fileName, OpenMode::kReadOnly, handle);
+        if (result != ResultCode::kSuccess)
+            return result;
+
+        result = Platform::GetFileStats(handle, m_stats);
+
+        // The mapped data is exposed through spans, which are limited to 32-bit sizes.
+        if (result == ResultCode::kSuccess && m_stats.m_byteSize > Constants::kMaxU32)
+            result = ResultCode::kFileTooLarge;
+
+        // Empty files cannot be mapped, but they are still valid streams.
+        if (result == ResultCode::kSuccess && m_stats.m_byteSize > 0)
+            result = Platform::MapFile(handle, m_stats.m_byteSize, m_data);
+
+        // The mapping doesn't need the file handle to stay open.
+        Platform::CloseFile(handle);
+        if (result != ResultCode::kSuccess)
+        {
+            m_data = nullptr;
+            m_stats = {};
+            return result;
+        }
+
+        m_name = fileName;
+        m_isOpen = true;
+        return ResultCode::kSuccess;
+    }
+} // namespace FE::IO
@@ -0,0 +1,389 @@
+﻿#include <FeCore/IO/FileStream.h>
+#include <FeCore/IO/PakArchive.h>
+#include <FeCore/IO/Platform/PlatformFile.h>
+#include <FeCore/IO/StreamBase.h>
+#include <algorithm>
+
+namespace FE::IO
+{
+    namespace
+    {
+        constexpr uint32_t kCopyBufferSize = 1024 * 1024;
+
+
+        uint64_t HashEntryName(const festd::string_view name)
+        {
+            return DefaultHash(name.data(), name.size());
+        }
+
+
+        bool CompareEntries(const Pak::Entry& lhs, const Pak::Entry& rhs)
+        {
+            return lhs.m_nameHash < rhs.m_nameHash;
+        }
+    } // namespace
+
+
+    struct PakEntryStream final : public StreamBase
+    {
+        PakEntryStream(PakArchive* archive, const Pak::Entry* entry, const bool memoryMapped)
+            : m_archive(archive)
+            , m_offset(entry->m_offset)
+            , m_byteSize(entry->m_byteSize)
+            , m_name(archive->GetEntryName(*entry))
+            , m_memoryMapped(memoryMapped)
+        {
+        }
+
+        bool SeekAllowed() const override
+        {
+            return true;
+        }
+
+        bool IsOpen() const override
+        {
+            return m_archive != nullptr;
+        }
+
+        ResultCode Seek(const intptr_t offset, const SeekMode seekMode) override
+        {
+            intptr_t base = 0;
+            switch (seekMode)
+            {
+            case SeekMode::kBegin:
+                base = 0;
+                break;
+            case SeekMode::kCurrent:
+                base = static_cast<intptr_t>(m_position);
+                break;
+            case SeekMode::kEnd:
+                base = static_cast<intptr_t>(m_byteSize);
+                break;
+            default:
+                return ResultCode::kInvalidArgument;
+            }
+
+            const intptr_t position = base + offset;
+            if (position < 0 || position > static_cast<intptr_t>(m_byteSize))
+                return ResultCode::kInvalidSeek;
+
+            m_position = static_cast<uint64_t>(position);
+            return ResultCode::kSuccess;
+        }
+
+        uintptr_t Tell() const override
+        {
+            return m_position;
+        }
+
+        size_t Length() const override
+        {
+            return m_byteSize;
+        }
+
+        size_t ReadToBuffer(void* buffer, const size_t byteSize) override
+        {
+            const size_t bytesToRead = static_cast<size_t>(Math::Min<uint64_t>(byteSize, m_byteSize - m_position));
+            if (bytesToRead == 0)
+                return 0;
+
+            size_t bytesRead = bytesToRead;
+            if (m_memoryMapped)
+                memcpy(buffer, m_archive->m_mappedData + m_offset + m_position, bytesToRead);
+            else
+                FE_IO_ASSERT(Platform::ReadFileAt(m_archive->m_handle, m_offset + m_position, buffer, bytesToRead, bytesRead));
+
+            m_position += bytesRead;
+            return bytesRead;
+        }
+
+        size_t WriteFromBuffer(const void*, const size_t) override
+        {
+            FE_Assert(false, "Pak archive streams are read-only");
+            return 0;
+        }
+
+        festd::string_view GetName() override
+        {
+            return m_name;
+        }
+
+        OpenMode GetOpenMode() const override
+        {
+            return OpenMode::kReadOnly;
+        }
+
+        FileStats GetStats() const override
+        {
+            FileStats stats = m_archive->m_stats;
+            stats.m_byteSize = m_byteSize;
+            return stats;
+        }
+
+        Platform::FileHandle GetNativeHandle() const override
+        {
+            return m_memoryMapped ? Platform::FileHandle{} : m_archive->m_handle;
+        }
+
+        uint64_t GetNativeOffset() const override
+        {
+            return m_memoryMapped ? 0 : m_offset;
+        }
+
+        festd::span<const std::byte> GetMappedData() const override
+        {
+            if (!m_memoryMapped)
+                return {};
+
+            return { m_archive->m_mappedData + m_offset, static_cast<uint32_t>(m_byteSize) };
+        }
+
+        void Close() override
+        {
+            m_archive.Reset();
+        }
+
+    private:
+        Rc<PakArchive> m_archive;
+        uint64_t m_offset = 0;
+        uint64_t m_byteSize = 0;
+        uint64_t m_position = 0;
+        Path m_name;
+        bool m_memoryMapped = false;
+    };
+
+
+    void PakWriter::AddFile(const festd::string_view entryName, const festd::string_view sourcePath)
+    {
+        SourceFile& file = m_files.push_back();
+        file.m_entryName = Pak::NormalizeEntryName(entryName);
+        file.m_sourcePath = sourcePath;
+    }
+
+
+    ResultCode PakWriter::Write(const festd::string_view outputPath) const
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", outputPath.size(), outputPath.data());
+
+        festd::vector<Pak::Entry> entries;
+        festd::vector<char> nameTable;
+        entries.reserve(m_files.size());
+
+        for (const SourceFile& file : m_files)
+        {
+            FileStream source;
+            const ResultCode result = source.Open(file.m_sourcePath, OpenMode::kReadOnly);
+            if (result != ResultCode::kSuccess)
+                return result;
+
+            Pak::Entry& entry = entries.push_back();
+            entry.m_nameHash = HashEntryName(file.m_entryName);
+            entry.m_offset = 0;
+            entry.m_byteSize = source.Length();
+            entry.m_nameOffset = nameTable.size();
+            entry.m_nameSize = file.m_entryName.size();
+            nameTable.insert(nameTable.end(), file.m_entryName.data(), file.m_entryName.data() + file.m_entryName.size());
+        }
+
+        // The data goes after the table of contents in the order the files were added.
+        const uint64_t tocByteSize = sizeof(Pak::Header) + entries.size() * sizeof(Pak::Entry) + nameTable.size();
+        uint64_t dataOffset = AlignUp<uint64_t>(tocByteSize, Pak::kDataAlignment);
+        for (Pak::Entry& entry : entries)
+        {
+            entry.m_offset = dataOffset;
+            dataOffset = AlignUp<uint64_t>(dataOffset + entry.m_byteSize, Pak::kDataAlignment);
+        }
+
+        festd::vector<Pak::Entry> sortedEntries = entries;
+        std::sort(sortedEntries.begin(), sortedEntries.end(), &CompareEntries);
+
+        for (uint32_t entryIndex = 1; entryIndex < sortedEntries.size(); ++entryIndex)
+        {
+            const Pak::Entry& previous = sortedEntries[entryIndex - 1];
+            const Pak::Entry& current = sortedEntries[entryIndex];
+            if (previous.m_nameHash != current.m_nameHash || previous.m_nameSize != current.m_nameSize)
+                continue;
+
+            if (memcmp(nameTable.data() + previous.m_nameOffset, nameTable.data() + current.m_nameOffset, current.m_nameSize)
+                == 0)
+                return ResultCode::kFileExists;
+        }
+
+        FileStream output;
+        ResultCode result = output.Open(outputPath, OpenMode::kCreate);
+        if (result != ResultCode::kSuccess)
+            return result;
+
+        Pak::Header header;
+        header.m_magic = Pak::kMagic;
+        header.m_version = Pak::kVersion;
+        header.m_entryCount = sortedEntries.size();
+        header.m_nameTableSize = nameTable.size();
+
+        const size_t entriesByteSize = sortedEntries.size() * sizeof(Pak::Entry);
+        if (!output.Write(header))
+            return ResultCode::kIOError;
+        if (output.WriteFromBuffer(sortedEntries.data(), entriesByteSize) != entriesByteSize)
+            return ResultCode::kIOError;
+        if (output.WriteFromBuffer(nameTable.data(), nameTable.size()) != nameTable.size())
+            return ResultCode::kIOError;
+
+        const std::byte padding[Pak::kDataAlignment] = {};
+        festd::vector<std::byte> copyBuffer(kCopyBufferSize);
+
+        uint64_t position = tocByteSize;
+        for (uint32_t fileIndex = 0; fileIndex < m_files.size(); ++fileIndex)
+        {
+            const Pak::Entry& entry = entries[fileIndex];
+            const size_t paddingByteSize = static_cast<size_t>(entry.m_offset - position);
+            if (output.WriteFromBuffer(padding, paddingByteSize) != paddingByteSize)
+                return ResultCode::kIOError;
+
+            FileStream source;
+            result = source.Open(m_files[fileIndex].m_sourcePath, OpenMode::kReadOnly);
+            if (result != ResultCode::kSuccess)
+                return result;
+
+            for (uint64_t copiedBytes = 0; copiedBytes < entry.m_byteSize;)
+            {
+                const uint64_t remainingBytes = entry.m_byteSize - copiedBytes;
+                const size_t chunkSize = static_cast<size_t>(Math::Min<uint64_t>(kCopyBufferSize, remainingBytes));
+                if (source.ReadToBuffer(copyBuffer.data(), chunkSize) != chunkSize)
+                    return ResultCode::kIOError;
+
+                if (output.WriteFromBuffer(copyBuffer.data(), chunkSize) != chunkSize)
+                    return ResultCode::kIOError;
+                copiedBytes += chunkSize;
+            }
+
+            position = entry.m_offset + entry.m_byteSize;
+        }
+
+        return ResultCode::kSuccess;
+    }
+
+
+    PakArchive::~PakArchive()
+    {
+        Close();
+    }
+
+
+    ResultCode PakArchive::Open(const festd::string_view path)
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", path.size(), path.data());
+
+        Close();
+
+        ResultCode result = Platform::OpenFile(path, OpenMode::kReadOnly, m_handle);
+        if (result != ResultCode::kSuccess)
+            return result;
+
+        const auto readAt = [this](const uint64_t offset, void* buffer, const size_t byteSize) {
+            size_t bytesRead;
+            const ResultCode readResult = Platform::ReadFileAt(m_handle, offset, buffer, byteSize, bytesRead);
+            if (readResult != ResultCode::kSuccess)
+                return readResult;
+
+            return bytesRead == byteSize ? ResultCode::kSuccess : ResultCode::kInvalidFormat;
+        };
+
+        Pak::Header header;
+        result = Platform::GetFileStats(m_handle, m_stats);
+        if (result == ResultCode::kSuccess)
+            result = readAt(0, &header, sizeof(header));
+        if (result == ResultCode::kSuccess && (header.m_magic != Pak::kMagic || header.m_version != Pak::kVersion))
+            result = ResultCode::kInvalidFormat;
+
+        if (result == ResultCode::kSuccess)
+        {
+            m_entries.resize(header.m_entryCount);
+            m_nameTable.resize(header.m_nameTableSize);
+
+            const uint64_t entriesByteSize = static_cast<uint64_t>(header.m_entryCount) * sizeof(Pak::Entry);
+            result = readAt(sizeof(header), m_entries.data(), entriesByteSize);
+            if (result == ResultCode::kSuccess)
+                result = readAt(sizeof(header) + entriesByteSize, m_nameTable.data(), m_nameTable.size());
+        }
+
+        if (result == ResultCode::kSuccess)
+        {
+            for (const Pak::Entry& entry : m_entries)
+            {
+                const bool validName = static_cast<uint64_t>(entry.m_nameOffset) + entry.m_nameSize <= m_nameTable.size();
+                const bool validData =
+                    entry.m_offset <= m_stats.m_byteSize && entry.m_byteSize <= m_stats.m_byteSize - entry.m_offset;
+                if (!validName || !validData)
+                {
+                    result = ResultCode::kInvalidFormat;
+                    break;
+                }
+            }
+        }
+
+        if (result != ResultCode::kSuccess)
+        {
+            Close();
+            return result;
+        }
+
+        // The mapping is optional, the entries can always be read through the file handle.
+        if (m_stats.m_byteSize > 0 && Platform::MapFile(m_handle, m_stats.m_byteSize, m_mappedData) != ResultCode::kSuccess)
+            m_mappedData = nullptr;
+
+        m_path = path;
+        return ResultCode::kSuccess;
+    }
+
+
+    const Pak::Entry* PakArchive::FindEntry(const festd::string_view name) const
+    {
+        const Path normalizedName = Pak::NormalizeEntryName(name);
+
+        Pak::Entry key{};
+        key.m_nameHash = HashEntryName(normalizedName);
+
+        // Different names can share a hash, so check all the entries with the same hash.
+        auto iter = std::lower_bound(m_entries.begin(), m_entries.end(), key, &CompareEntries);
+        for (; iter != m_entries.end() && iter->m_nameHash == key.m_nameHash; ++iter)
+        {
+            if (GetEntryName(*iter) == festd::string_view{ normalizedName })
+                return iter;
+        }
+
+        return nullptr;
+    }
+
+
+    festd::string_view PakArchive::GetEntryName(const Pak::Entry& entry) const
+    {
+        return { m_nameTable.data() + entry.m_nameOffset, entry.m_nameSize };
+    }
+
+
+    Rc<IStream> PakArchive::OpenEntryStream(const Pak::Entry* entry, bool memoryMapped)
+    {
+        FE_Assert(entry >= m_entries.begin() && entry < m_entries.end(), "The entry doesn't belong to this archive");
+
+        // The mapped data is exposed through spans, which are limited to 32-bit sizes.
+        memoryMapped = memoryMapped && m_mappedData != nullptr && entry->m_byteSize <= Constants::kMaxU32;
+        return Rc<PakEntryStream>::DefaultNew(this, entry, memoryMapped);
+    }
+
+
+    void PakArchive::Close()
+    {
+        if (m_mappedData)
+            Platform::UnmapFile(m_mappedData, m_stats.m_byteSize);
+
+        if (m_handle)
+            Platform::CloseFile(m_handle);
+
+        m_handle = {};
+        m_mappedData = nullptr;
+        m_stats = {};
+        m_entries.clear();
+        m_nameTable.clear();
+        m_path.clear();
+    }
+} // namespace FE::IO
@@ -0,0 +1,132 @@
+﻿#include <FeCore/IO/PakStreamFactory.h>
+#include <FeCore/Strings/Utils.h>
+
+namespace FE::IO
+{
+    PakStreamFactory::PakStreamFactory(Logger* logger, Env::Configuration* pConfig)
+    {
+        m_fileStreamFactory = Rc<FileStreamFactory>::DefaultNew(pConfig);
+        m_assetDirectory = NormalizePath(Directory::GetCurrentDirectory());
+
+        const festd::string_view archives = pConfig->GetString("AssetArchives", {});
+        for (const festd::string_view archivePath : Str::SplitFixed<16>(archives, ';'))
+        {
+            if (archivePath.empty())
+                continue;
+
+            const ResultCode result = Mount(archivePath);
+            if (result != ResultCode::kSuccess)
+                logger->LogError("Failed to mount pak archive {}: {}", archivePath, GetResultDesc(result));
+        }
+    }
+
+
+    ResultCode PakStreamFactory::Mount(const festd::string_view archivePath)
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", archivePath.size(), archivePath.data());
+
+        // The file stream factory changes the current directory to the asset directory, so relative paths work here.
+        const Rc archive = Rc<PakArchive>::DefaultNew();
+        const ResultCode result = archive->Open(archivePath);
+        if (result != ResultCode::kSuccess)
+            return result;
+
+        m_archives.push_back(archive);
+        return ResultCode::kSuccess;
+    }
+
+
+    festd::expected<Rc<IStream>, ResultCode> PakStreamFactory::OpenFileStream(const festd::string_view filename,
+                                                                              const OpenMode openMode)
+    {
+        PakArchive* archive;
+        if (openMode == OpenMode::kReadOnly)
+        {
+            if (const Pak::Entry* entry = FindEntry(filename, archive))
+                return archive->OpenEntryStream(entry);
+        }
+
+        return m_fileStreamFactory->OpenFileStream(filename, openMode);
+    }
+
+
+    festd::expected<Rc<IStream>, ResultCode> PakStreamFactory::OpenUnbufferedFileStream(const festd::string_view filename,
+                                                                                        const OpenMode openMode)
+    {
+        // The archive streams are unbuffered anyway.
+        PakArchive* archive;
+        if (openMode == OpenMode::kReadOnly)
+        {
+            if (const Pak::Entry* entry = FindEntry(filename, archive))
+                return archive->OpenEntryStream(entry);
+        }
+
+        return m_fileStreamFactory->OpenUnbufferedFileStream(filename, openMode);
+    }
+
+
+    festd::expected<Rc<IStream>, ResultCode> PakStreamFactory::OpenMappedFileStream(const festd::string_view filename)
+    {
+        PakArchive* archive;
+        if (const Pak::Entry* entry = FindEntry(filename, archive))
+            return archive->OpenEntryStream(entry, true);
+
+        return m_fileStreamFactory->OpenMappedFileStream(filename);
+    }
+
+
+    bool PakStreamFactory::FileExists(const festd::string_view filename)
+    {
+        PakArchive* archive;
+        return FindEntry(filename, archive) != nullptr || m_fileStreamFactory->FileExists(filename);
+    }
+
+
+    FileAttributeFlags PakStreamFactory::GetFileAttributeFlags(const festd::string_view filename)
+    {
+        PakArchive* archive;
+        if (FindEntry(filename, archive))
+            return FileAttributeFlags::kReadOnly;
+
+        return m_fileStreamFactory->GetFileAttributeFlags(filename);
+    }
+
+
+    const Pak::Entry* PakStreamFactory::FindEntry(const festd::string_view filename, PakArchive*& archive) const
+    {
+        if (m_archives.empty())
+            return nullptr;
+
+        // The asset managers open files by their absolute paths, but the archives store the paths relative
+        // to the asset directory.
+        const Path normalizedName = NormalizePath(filename);
+        festd::string_view entryName = normalizedName;
+        if (PathParser::IsAbsolutePath(entryName.data(), entryName.size()))
+        {
+            const festd::string_view assetDirectory = m_assetDirectory;
+            if (!entryName.starts_with(assetDirectory))
+                return nullptr;
+
+            const char* relativeName = entryName.data() + assetDirectory.size();
+            const char* nameEnd = entryName.data() + entryName.size();
+
+            // The asset directory must match whole path segments.
+            if (relativeName < nameEnd && !PathParser::IsPathSeparator(*relativeName) && !assetDirectory.ends_with("/"))
+                return nullptr;
+
+            relativeName = PathParser::SkipSeparators(relativeName, static_cast<uint32_t>(nameEnd - relativeName));
+            entryName = festd::string_view{ relativeName, static_cast<uint32_t>(nameEnd - relativeName) };
+        }
+
+        for (auto iter = m_archives.rbegin(); iter != m_archives.rend(); ++iter)
+        {
+            if (const Pak::Entry* entry = (*iter)->FindEntry(entryName))
+            {
+                archive = iter->Get();
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+} // namespace FE::IO
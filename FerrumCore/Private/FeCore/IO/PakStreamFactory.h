@@ -0,0 +1,37 @@
+﻿#pragma once
+#include <FeCore/IO/PakArchive.h>
+#include <FeCore/IO/StreamFactory.h>
+#include <FeCore/Logging/Logger.h>
+
+namespace FE::IO
+{
+    //! @brief Stream factory that serves files from mounted pak archives and falls back to the loose files.
+    //!
+    //! The archives listed in the "AssetArchives" configuration value (separated with semicolons) are mounted on creation.
+    //! The archives mounted later take precedence, so they can be used to patch the earlier ones.
+    //! The archives that fail to mount are logged and skipped, their files are served from the loose files.
+    //! The entries are looked up by their paths relative to the asset directory, absolute paths under it work as well.
+    struct PakStreamFactory final : public IStreamFactory
+    {
+        FE_RTTI_Class(PakStreamFactory, "8C2D7E54-3B1A-4F69-A0D2-5E7C9B14F3A6");
+
+        PakStreamFactory(Logger* logger, Env::Configuration* pConfig);
+
+        //! @brief Mount a pak archive. Not thread-safe, must be called before any streams are opened.
+        ResultCode Mount(festd::string_view archivePath);
+
+        festd::expected<Rc<IStream>, ResultCode> OpenFileStream(festd::string_view filename, OpenMode openMode) override;
+        festd::expected<Rc<IStream>, ResultCode> OpenUnbufferedFileStream(festd::string_view filename,
+                                                                          OpenMode openMode) override;
+        festd::expected<Rc<IStream>, ResultCode> OpenMappedFileStream(festd::string_view filename) override;
+        bool FileExists(festd::string_view filename) override;
+        FileAttributeFlags GetFileAttributeFlags(festd::string_view filename) override;
+
+    private:
+        Rc<FileStreamFactory> m_fileStreamFactory;
+        festd::vector<Rc<PakArchive>> m_archives;
+        Path m_assetDirectory;
+
+        const Pak::Entry* FindEntry(festd::string_view filename, PakArchive*& archive) const;
+    };
+} // namespace FE::IO
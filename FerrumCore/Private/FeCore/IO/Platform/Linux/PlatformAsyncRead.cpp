@@ -0,0 +1,328 @@
+﻿#include <FeCore/IO/Platform/PlatformAsyncRead.h>
+#include <FeCore/IO/ThreadPoolReadQueue.h>
+#include <FeCore/Logging/Trace.h>
+#include <FeCore/Platform/Linux/Common.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+namespace FE::Platform
+{
+    namespace
+    {
+        // Completions with this user data belong to the eventfd read used to interrupt the waits.
+        constexpr uint64_t kWakeUserData = 0;
+
+
+        int32_t IoUringSetup(const uint32_t entryCount, io_uring_params* params)
+        {
+            return static_cast<int32_t>(syscall(__NR_io_uring_setup, entryCount, params));
+        }
+
+
+        int32_t IoUringEnter(const int32_t ringDescriptor, const uint32_t submitCount, const uint32_t minCompleteCount,
+                             const uint32_t flags)
+        {
+            return static_cast<int32_t>(
+                syscall(__NR_io_uring_enter, ringDescriptor, submitCount, minCompleteCount, flags, nullptr, 0));
+        }
+
+
+        int32_t IoUringRegister(const int32_t ringDescriptor, const uint32_t opcode, const void* args, const uint32_t argCount)
+        {
+            return static_cast<int32_t>(syscall(__NR_io_uring_register, ringDescriptor, opcode, args, argCount));
+        }
+
+
+        bool IsReadOperationSupported(const int32_t ringDescriptor)
+        {
+            // IORING_REGISTER_PROBE was added in the same kernel version as IORING_OP_READ (5.6),
+            // so on older kernels the probe itself fails.
+            constexpr uint32_t kProbeOpCount = IORING_OP_READ + 1;
+            constexpr size_t kProbeByteSize = sizeof(io_uring_probe) + kProbeOpCount * sizeof(io_uring_probe_op);
+            alignas(io_uring_probe) std::byte probeStorage[kProbeByteSize] = {};
+            auto* probe = reinterpret_cast<io_uring_probe*>(probeStorage);
+
+            if (IoUringRegister(ringDescriptor, IORING_REGISTER_PROBE, probe, kProbeOpCount) < 0)
+                return false;
+
+            return probe->ops_len > IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+        }
+
+
+        //! @brief AsyncReadQueue implementation based on io_uring.
+        //!
+        //! The queue talks to the kernel via raw system calls, so that we don't depend on liburing.
+        //! All the reads are batched into a single io_uring_enter call per Flush(). Wake() writes to an eventfd
+        //! that always has a pending read in the ring, so waiting for completions and for new requests
+        //! is a single blocking call.
+        struct IoUringReadQueue final : public AsyncReadQueue
+        {
+            ~IoUringReadQueue() override
+            {
+                if (m_submissionEntries)
+                    munmap(m_submissionEntries, m_submissionEntriesByteSize);
+                if (m_ring)
+                    munmap(m_ring, m_ringByteSize);
+                if (m_ringDescriptor >= 0)
+                    close(m_ringDescriptor);
+                if (m_wakeDescriptor >= 0)
+                    close(m_wakeDescriptor);
+            }
+
+            bool Initialize(const uint32_t queueDepth)
+            {
+                FE_PROFILER_ZONE();
+
+                static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+                static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+                m_queueDepth = queueDepth;
+
+                // Reserve one extra entry for the wake-up read.
+                io_uring_params params = {};
+                m_ringDescriptor = IoUringSetup(queueDepth + 1, &params);
+                if (m_ringDescriptor < 0)
+                    return false;
+
+                // We need IORING_OP_READ, which implies IORING_FEAT_SINGLE_MMAP, so the rings are mapped only once.
+                if (!IsReadOperationSupported(m_ringDescriptor) || (params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+                    return false;
+
+                const size_t submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+                const size_t completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                m_ringByteSize = Math::Max(submissionRingSize, completionRingSize);
+
+                constexpr int32_t kProtection = PROT_READ | PROT_WRITE;
+                constexpr int32_t kFlags = MAP_SHARED | MAP_POPULATE;
+
+                void* ring = mmap(nullptr, m_ringByteSize, kProtection, kFlags, m_ringDescriptor, IORING_OFF_SQ_RING);
+                if (ring == MAP_FAILED)
+                    return false;
+
+                m_ring = static_cast<std::byte*>(ring);
+
+                m_submissionEntriesByteSize = params.sq_entries * sizeof(io_uring_sqe);
+                void* submissionEntries =
+                    mmap(nullptr, m_submissionEntriesByteSize, kProtection, kFlags, m_ringDescriptor, IORING_OFF_SQES);
+                if (submissionEntries == MAP_FAILED)
+                    return false;
+
+                m_submissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+                m_submissionHead = reinterpret_cast<std::atomic<uint32_t>*>(m_ring + params.sq_off.head);
+                m_submissionTail = reinterpret_cast<std::atomic<uint32_t>*>(m_ring + params.sq_off.tail);
+                m_submissionMask = *reinterpret_cast<const uint32_t*>(m_ring + params.sq_off.ring_mask);
+                m_submissionArray = reinterpret_cast<uint32_t*>(m_ring + params.sq_off.array);
+                m_completionHead = reinterpret_cast<std::atomic<uint32_t>*>(m_ring + params.cq_off.head);
+                m_completionTail = reinterpret_cast<std::atomic<uint32_t>*>(m_ring + params.cq_off.tail);
+                m_completionMask = *reinterpret_cast<const uint32_t*>(m_ring + params.cq_off.ring_mask);
+                m_completionEntries = reinterpret_cast<const io_uring_cqe*>(m_ring + params.cq_off.cqes);
+
+                m_submissionLocalTail = m_submissionTail->load(std::memory_order_relaxed);
+
+                m_wakeDescriptor = eventfd(0, EFD_CLOEXEC);
+                if (m_wakeDescriptor < 0)
+                    return false;
+
+                PrepareWakeRead();
+                Flush();
+                return true;
+            }
+
+            void RegisterBuffer(const festd::span<std::byte> buffer) override
+            {
+                FE_PROFILER_ZONE();
+
+                iovec bufferVector;
+                bufferVector.iov_base = buffer.data();
+                bufferVector.iov_len = buffer.size();
+
+                // This can fail if the buffer exceeds RLIMIT_MEMLOCK, in which case we just use regular reads.
+                m_buffersRegistered = IoUringRegister(m_ringDescriptor, IORING_REGISTER_BUFFERS, &bufferVector, 1) == 0;
+            }
+
+            bool Submit(AsyncReadOperation* operation) override
+            {
+                if (m_inFlightCount >= m_queueDepth)
+                    return false;
+
+                operation->m_bytesRead = 0;
+                PrepareRead(operation);
+                ++m_inFlightCount;
+                return true;
+            }
+
+            void Flush() override
+            {
+                if (m_pendingSubmitCount > 0)
+                    Enter(0);
+            }
+
+            uint32_t WaitForCompletions(const festd::span<AsyncReadOperation*> completions) override
+            {
+                FE_PROFILER_ZONE();
+
+                while (true)
+                {
+                    uint32_t completionCount = 0;
+                    bool woken = false;
+
+                    uint32_t head = m_completionHead->load(std::memory_order_relaxed);
+                    const uint32_t tail = m_completionTail->load(std::memory_order_acquire);
+                    for (; head != tail && completionCount < completions.size(); ++head)
+                    {
+                        const io_uring_cqe& completionEntry = m_completionEntries[head & m_completionMask];
+                        if (completionEntry.user_data == kWakeUserData)
+                        {
+                            woken = true;
+                            continue;
+                        }
+
+                        auto* operation = reinterpret_cast<AsyncReadOperation*>(completionEntry.user_data);
+                        if (completionEntry.res < 0)
+                        {
+                            operation->m_result = ConvertErrnoIOError(-completionEntry.res);
+                            operation->m_bytesRead = 0;
+                        }
+                        else
+                        {
+                            // A read can complete partially, e.g. if it has been interrupted by a signal.
+                            // Submit the rest again unless we've reached the end of the file.
+                            operation->m_bytesRead += static_cast<uint32_t>(completionEntry.res);
+                            if (completionEntry.res > 0 && operation->m_bytesRead < operation->m_byteSize)
+                            {
+                                PrepareRead(operation);
+                                continue;
+                            }
+
+                            operation->m_result = IO::ResultCode::kSuccess;
+                        }
+
+                        completions[completionCount++] = operation;
+                    }
+
+                    m_completionHead->store(head, std::memory_order_release);
+                    m_inFlightCount -= completionCount;
+
+                    if (woken)
+                        PrepareWakeRead();
+
+                    if (completionCount > 0 || woken)
+                    {
+                        Flush();
+                        return completionCount;
+                    }
+
+                    Enter(1);
+                }
+            }
+
+            void Wake() override
+            {
+                const uint64_t value = 1;
+                [[maybe_unused]] const ssize_t result = write(m_wakeDescriptor, &value, sizeof(value));
+            }
+
+        private:
+            int32_t m_ringDescriptor = -1;
+            int32_t m_wakeDescriptor = -1;
+            uint64_t m_wakeValue = 0;
+
+            std::byte* m_ring = nullptr;
+            size_t m_ringByteSize = 0;
+            io_uring_sqe* m_submissionEntries = nullptr;
+            size_t m_submissionEntriesByteSize = 0;
+
+            std::atomic<uint32_t>* m_submissionHead = nullptr;
+            std::atomic<uint32_t>* m_submissionTail = nullptr;
+            uint32_t* m_submissionArray = nullptr;
+            uint32_t m_submissionMask = 0;
+            uint32_t m_submissionLocalTail = 0;
+            uint32_t m_pendingSubmitCount = 0;
+
+            std::atomic<uint32_t>* m_completionHead = nullptr;
+            std::atomic<uint32_t>* m_completionTail = nullptr;
+            const io_uring_cqe* m_completionEntries = nullptr;
+            uint32_t m_completionMask = 0;
+
+            uint32_t m_queueDepth = 0;
+            uint32_t m_inFlightCount = 0;
+            bool m_buffersRegistered = false;
+
+            io_uring_sqe* AllocateSubmissionEntry()
+            {
+                // The submission queue has one more entry than the queue depth, so it can never overflow.
+                const uint32_t index = m_submissionLocalTail & m_submissionMask;
+                io_uring_sqe* entry = &m_submissionEntries[index];
+                memset(entry, 0, sizeof(io_uring_sqe));
+                m_submissionArray[index] = index;
+                ++m_submissionLocalTail;
+                ++m_pendingSubmitCount;
+                return entry;
+            }
+
+            //! @brief Add a submission entry that reads the part of the operation that hasn't been read yet.
+            //!
+            //! The operation stays in flight, so the submission queue still has enough space for it.
+            void PrepareRead(AsyncReadOperation* operation)
+            {
+                const uint32_t bytesRead = operation->m_bytesRead;
+
+                io_uring_sqe* entry = AllocateSubmissionEntry();
+                entry->opcode = IORING_OP_READ;
+                entry->fd = DescriptorCast(operation->m_fileHandle);
+                entry->off = operation->m_offset + bytesRead;
+                entry->addr = reinterpret_cast<uint64_t>(operation->m_buffer + bytesRead);
+                entry->len = operation->m_byteSize - bytesRead;
+                entry->user_data = reinterpret_cast<uint64_t>(operation);
+
+                if (operation->m_registeredBuffer && m_buffersRegistered)
+                {
+                    entry->opcode = IORING_OP_READ_FIXED;
+                    entry->buf_index = 0;
+                }
+            }
+
+            void PrepareWakeRead()
+            {
+                io_uring_sqe* entry = AllocateSubmissionEntry();
+                entry->opcode = IORING_OP_READ;
+                entry->fd = m_wakeDescriptor;
+                entry->addr = reinterpret_cast<uint64_t>(&m_wakeValue);
+                entry->len = sizeof(m_wakeValue);
+                entry->user_data = kWakeUserData;
+            }
+
+            void Enter(const uint32_t minCompleteCount)
+            {
+                m_submissionTail->store(m_submissionLocalTail, std::memory_order_release);
+
+                const uint32_t flags = minCompleteCount > 0 ? IORING_ENTER_GETEVENTS : 0;
+                const int32_t result = IoUringEnter(m_ringDescriptor, m_pendingSubmitCount, minCompleteCount, flags);
+                if (result >= 0)
+                {
+                    m_pendingSubmitCount -= static_cast<uint32_t>(result);
+                    return;
+                }
+
+                // EAGAIN and EBUSY mean that the kernel is temporarily out of resources or the completion queue is full.
+                // In both cases the entries stay in the ring and will be submitted on the next call.
+                const int32_t error = errno;
+                FE_AssertMsg(error == EINTR || error == EAGAIN || error == EBUSY, "io_uring_enter failed: {}", error);
+            }
+        };
+    } // namespace
+
+
+    AsyncReadQueue* CreateAsyncReadQueue(std::pmr::memory_resource* allocator, const uint32_t queueDepth)
+    {
+        auto* ioUringQueue = Memory::New<IoUringReadQueue>(allocator);
+        if (ioUringQueue->Initialize(queueDepth))
+            return ioUringQueue;
+
+        // io_uring can be unavailable on old kernels or disabled by the system configuration.
+        Memory::Delete(allocator, ioUringQueue, sizeof(IoUringReadQueue));
+        return Memory::New<IO::ThreadPoolReadQueue>(allocator, queueDepth);
+    }
+} // namespace FE::Platform
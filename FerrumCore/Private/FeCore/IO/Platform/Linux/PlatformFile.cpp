@@ -0,0 +1,273 @@
+﻿#include <FeCore/IO/Path.h>
+#include <FeCore/IO/Platform/PlatformFile.h>
+#include <FeCore/Platform/Linux/Common.h>
+
+namespace FE::Platform
+{
+    namespace
+    {
+        int32_t GetFileOpenFlags(const IO::OpenMode openMode)
+        {
+            switch (openMode)
+            {
+            case IO::OpenMode::kReadOnly:
+                return O_RDONLY;
+            case IO::OpenMode::kWriteOnly:
+                return O_WRONLY;
+            case IO::OpenMode::kCreate:
+                return O_WRONLY | O_CREAT | O_TRUNC;
+            case IO::OpenMode::kCreateNew:
+                return O_WRONLY | O_CREAT | O_EXCL;
+            case IO::OpenMode::kAppend:
+                return O_RDWR | O_APPEND;
+            case IO::OpenMode::kTruncate:
+                return O_RDWR | O_TRUNC;
+            case IO::OpenMode::kReadWrite:
+                return O_RDWR;
+            case IO::OpenMode::kNone:
+            default:
+                return -1;
+            }
+        }
+
+
+        int32_t GetFileSeekMode(const IO::SeekMode seekMode)
+        {
+            switch (seekMode)
+            {
+            case IO::SeekMode::kBegin:
+                return SEEK_SET;
+            case IO::SeekMode::kCurrent:
+                return SEEK_CUR;
+            case IO::SeekMode::kEnd:
+                return SEEK_END;
+            default:
+                return SEEK_SET;
+            }
+        }
+    } // namespace
+
+
+    FileHandle GetStandardFile(const IO::StandardDescriptor descriptor)
+    {
+        switch (descriptor)
+        {
+        case IO::StandardDescriptor::kStdin:
+            return FileHandle::FromDescriptor(STDIN_FILENO);
+        case IO::StandardDescriptor::kStdout:
+            return FileHandle::FromDescriptor(STDOUT_FILENO);
+        case IO::StandardDescriptor::kStderr:
+            return FileHandle::FromDescriptor(STDERR_FILENO);
+        default:
+            return FileHandle{};
+        }
+    }
+
+
+    IO::ResultCode OpenFile(const festd::string_view filePath, const IO::OpenMode openMode, FileHandle& handle)
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", filePath.size(), filePath.data());
+
+        const int32_t openFlags = GetFileOpenFlags(openMode);
+        if (filePath.empty() || openFlags == -1)
+            return IO::ResultCode::kInvalidArgument;
+
+        const IO::Path nativePath{ filePath };
+        const int32_t descriptor = open(nativePath.data(), openFlags | O_CLOEXEC, 0644);
+        if (descriptor == -1)
+            return ConvertErrnoIOError(errno);
+
+        handle = FileHandle::FromDescriptor(descriptor);
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode GetFileStats(const FileHandle fileHandle, IO::FileStats& result)
+    {
+        FE_PROFILER_ZONE();
+
+        struct stat fileStat;
+        if (fstat(DescriptorCast(fileHandle), &fileStat) != 0)
+            return ConvertErrnoIOError(errno);
+
+        // Linux doesn't store the file creation time in struct stat, the status change time is the closest thing.
+        result.m_creationTime = DateTime<TZ::UTC>::FromUnixTime(ConvertTimespecToUnixSeconds(fileStat.st_ctim));
+        result.m_accessTime = DateTime<TZ::UTC>::FromUnixTime(ConvertTimespecToUnixSeconds(fileStat.st_atim));
+        result.m_modificationTime = DateTime<TZ::UTC>::FromUnixTime(ConvertTimespecToUnixSeconds(fileStat.st_mtim));
+        result.m_byteSize = static_cast<uint64_t>(fileStat.st_size);
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::FileAttributeFlags GetFileAttributeFlags(const festd::string_view filePath)
+    {
+        FE_PROFILER_ZONE_TEXT("%.*s", filePath.size(), filePath.data());
+
+        if (filePath.empty())
+            return IO::FileAttributeFlags::kInvalid;
+
+        const IO::Path nativePath{ filePath };
+
+        struct stat fileStat;
+        if (stat(nativePath.data(), &fileStat) != 0)
+            return IO::FileAttributeFlags::kInvalid;
+
+        const festd::string_view fileName = IO::PathView{ nativePath }.filename();
+        return ConvertFileAttributeFlags(fileName, fileStat);
+    }
+
+
+    bool FileExists(const festd::string_view filePath)
+    {
+        FE_PROFILER_ZONE();
+        const IO::FileAttributeFlags attributes = GetFileAttributeFlags(filePath);
+        return attributes != IO::FileAttributeFlags::kInvalid && !Bit::AnySet(attributes, IO::FileAttributeFlags::kDirectory);
+    }
+
+
+    void CloseFile(const FileHandle fileHandle)
+    {
+        FE_PROFILER_ZONE();
+        close(DescriptorCast(fileHandle));
+    }
+
+
+    IO::ResultCode ReadFile(const FileHandle fileHandle, void* buffer, const size_t byteSize, size_t& bytesRead)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        bytesRead = 0;
+        while (bytesRead < byteSize)
+        {
+            const ssize_t result =
+                read(DescriptorCast(fileHandle), static_cast<std::byte*>(buffer) + bytesRead, byteSize - bytesRead);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return ConvertErrnoIOError(errno);
+            }
+
+            if (result == 0)
+                break;
+
+            bytesRead += static_cast<size_t>(result);
+        }
+
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode ReadFileAt(const FileHandle fileHandle, const uint64_t offset, void* buffer, const size_t byteSize,
+                              size_t& bytesRead)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        bytesRead = 0;
+        while (bytesRead < byteSize)
+        {
+            const ssize_t result = pread(DescriptorCast(fileHandle),
+                                         static_cast<std::byte*>(buffer) + bytesRead,
+                                         byteSize - bytesRead,
+                                         static_cast<off_t>(offset + bytesRead));
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return ConvertErrnoIOError(errno);
+            }
+
+            if (result == 0)
+                break;
+
+            bytesRead += static_cast<size_t>(result);
+        }
+
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode WriteFile(const FileHandle fileHandle, const void* buffer, const size_t byteSize, size_t& bytesWritten)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        bytesWritten = 0;
+        while (bytesWritten < byteSize)
+        {
+            const ssize_t result =
+                write(DescriptorCast(fileHandle), static_cast<const std::byte*>(buffer) + bytesWritten, byteSize - bytesWritten);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return ConvertErrnoIOError(errno);
+            }
+
+            bytesWritten += static_cast<size_t>(result);
+        }
+
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode SeekFile(const FileHandle fileHandle, const intptr_t offset, const IO::SeekMode seekMode)
+    {
+        FE_PROFILER_ZONE();
+
+        if (lseek(DescriptorCast(fileHandle), static_cast<off_t>(offset), GetFileSeekMode(seekMode)) == -1)
+            return ConvertErrnoIOError(errno);
+
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode TellFile(const FileHandle fileHandle, uintptr_t& position)
+    {
+        FE_PROFILER_ZONE();
+
+        const off_t result = lseek(DescriptorCast(fileHandle), 0, SEEK_CUR);
+        if (result == -1)
+            return ConvertErrnoIOError(errno);
+
+        position = static_cast<uintptr_t>(result);
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    IO::ResultCode MapFile(const FileHandle fileHandle, const size_t byteSize, const std::byte*& data)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        if (byteSize == 0)
+            return IO::ResultCode::kInvalidArgument;
+
+        void* result = mmap(nullptr, byteSize, PROT_READ, MAP_PRIVATE, DescriptorCast(fileHandle), 0);
+        if (result == MAP_FAILED)
+            return ConvertErrnoIOError(errno);
+
+        data = static_cast<const std::byte*>(result);
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    void UnmapFile(const std::byte* data, const size_t byteSize)
+    {
+        FE_PROFILER_ZONE();
+        munmap(const_cast<std::byte*>(data), byteSize);
+    }
+
+
+    void PrefetchMappedFile(const std::byte* data, const size_t byteSize)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        // madvise() requires a page-aligned address.
+        const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(pageSize - 1);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(data) + byteSize;
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+} // namespace FE::Platform
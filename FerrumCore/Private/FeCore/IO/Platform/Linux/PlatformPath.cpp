@@ -0,0 +1,102 @@
+﻿#include <FeCore/IO/Platform/PlatformPath.h>
+#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Strings/Utils.h>
+
+namespace FE::Platform
+{
+    IO::Path GetCurrentDirectory()
+    {
+        FE_PROFILER_ZONE();
+
+        char buffer[IO::kMaxPathLength + 1];
+        if (getcwd(buffer, sizeof(buffer)) == nullptr)
+            return {};
+
+        return IO::Path{ buffer };
+    }
+
+
+    void SetCurrentDirectory(const festd::string_view path)
+    {
+        FE_PROFILER_ZONE();
+
+        const IO::Path nativePath{ path };
+        FE_Verify(chdir(nativePath.data()) == 0);
+    }
+
+
+    IO::Path GetExecutablePath()
+    {
+        FE_PROFILER_ZONE();
+
+        char buffer[IO::kMaxPathLength + 1];
+        const ssize_t pathLength = readlink("/proc/self/exe", buffer, IO::kMaxPathLength);
+        FE_Verify(pathLength > 0);
+        return IO::Path{ buffer, static_cast<uint32_t>(pathLength) };
+    }
+
+
+    IO::ResultCode IterateDirectoryRecursively(const DirectoryIterationParams& params)
+    {
+        festd::inline_vector<IO::Path, 4> directoryStack;
+        directoryStack.push_back(params.m_path);
+
+        const auto patterns = Str::SplitFixed<8>(params.m_pattern, ';');
+
+        while (!directoryStack.empty())
+        {
+            const IO::Path currentDirectory = directoryStack.back();
+            directoryStack.pop_back();
+
+            DIR* directory = opendir(currentDirectory.data());
+            if (directory == nullptr)
+                return ConvertErrnoIOError(errno);
+
+            const auto deferClose = festd::defer([directory] {
+                closedir(directory);
+            });
+
+            errno = 0;
+            while (const dirent* directoryEntry = readdir(directory))
+            {
+                const festd::string_view filename{ directoryEntry->d_name };
+                if (filename == "." || filename == "..")
+                    continue;
+
+                const IO::Path fullFilename = currentDirectory / filename;
+
+                struct stat fileStat;
+                if (stat(fullFilename.data(), &fileStat) != 0)
+                    return ConvertErrnoIOError(errno);
+
+                const IO::FileAttributeFlags attributeFlags = ConvertFileAttributeFlags(filename, fileStat);
+                if (!Bit::AnySet(attributeFlags, IO::FileAttributeFlags::kDirectory))
+                {
+                    if (!Str::MatchAny(filename, patterns))
+                        continue;
+                }
+
+                IO::DirectoryEntry entry;
+                entry.m_path = IO::PathView{ fullFilename };
+                entry.m_attributes = attributeFlags;
+                entry.m_stats.m_byteSize = static_cast<uint64_t>(fileStat.st_size);
+                const TimeValue modificationTime = ConvertTimespecToUnixSeconds(fileStat.st_mtim);
+                entry.m_stats.m_creationTime = DateTime<TZ::UTC>::FromUnixTime(ConvertTimespecToUnixSeconds(fileStat.st_ctim));
+                entry.m_stats.m_accessTime = DateTime<TZ::UTC>::FromUnixTime(ConvertTimespecToUnixSeconds(fileStat.st_atim));
+                entry.m_stats.m_modificationTime = DateTime<TZ::UTC>::FromUnixTime(modificationTime);
+                if (!params.m_callback(params.m_callbackData, entry))
+                    return IO::ResultCode::kCanceled;
+
+                if (Bit::AllSet(attributeFlags, IO::FileAttributeFlags::kDirectory))
+                    directoryStack.push_back(fullFilename);
+
+                errno = 0;
+            }
+
+            if (errno != 0)
+                return ConvertErrnoIOError(errno);
+        }
+
+        return IO::ResultCode::kSuccess;
+    }
+} // namespace FE::Platform
@@ -0,0 +1,130 @@
+﻿#pragma once
+#include <FeCore/IO/BaseIO.h>
+#include <FeCore/Memory/Memory.h>
+#include <festd/span.h>
+
+namespace FE::Platform
+{
+    //! @brief A single positional read submitted to an AsyncReadQueue.
+    struct AsyncReadOperation
+    {
+        FileHandle m_fileHandle;
+        uint64_t m_offset = 0;
+        std::byte* m_buffer = nullptr;
+        uint32_t m_byteSize = 0;
+        bool m_registeredBuffer = false; //!< True if m_buffer points into the memory passed to RegisterBuffer().
+        uintptr_t m_userData = 0;
+
+        IO::ResultCode m_result = IO::ResultCode::kSuccess; //!< Written by the queue when the operation completes.
+        uint32_t m_bytesRead = 0;                           //!< Written by the queue when the operation completes.
+
+        AsyncReadOperation* m_next = nullptr; //!< Used by the queue and its owner to chain operations.
+    };
+
+
+    //! @brief Intrusive FIFO list of AsyncReadOperation objects linked through AsyncReadOperation::m_next.
+    struct AsyncReadOperationList final
+    {
+        AsyncReadOperation* m_head = nullptr;
+        AsyncReadOperation* m_tail = nullptr;
+        uint32_t m_size = 0;
+
+        [[nodiscard]] bool Empty() const
+        {
+            return m_head == nullptr;
+        }
+
+        void PushBack(AsyncReadOperation* operation)
+        {
+            operation->m_next = nullptr;
+            if (m_tail)
+                m_tail->m_next = operation;
+            else
+                m_head = operation;
+
+            m_tail = operation;
+            ++m_size;
+        }
+
+        void PushFront(AsyncReadOperation* operation)
+        {
+            operation->m_next = m_head;
+            m_head = operation;
+            if (m_tail == nullptr)
+                m_tail = operation;
+
+            ++m_size;
+        }
+
+        AsyncReadOperation* PopFront()
+        {
+            AsyncReadOperation* operation = m_head;
+            if (operation == nullptr)
+                return nullptr;
+
+            m_head = operation->m_next;
+            if (m_head == nullptr)
+                m_tail = nullptr;
+
+            operation->m_next = nullptr;
+            --m_size;
+            return operation;
+        }
+
+        void Append(AsyncReadOperationList& other)
+        {
+            if (other.m_head == nullptr)
+                return;
+
+            if (m_tail)
+                m_tail->m_next = other.m_head;
+            else
+                m_head = other.m_head;
+
+            m_tail = other.m_tail;
+            m_size += other.m_size;
+            other = {};
+        }
+    };
+
+
+    //! @brief Submission/completion queue of positional file reads.
+    //!
+    //! Operations are submitted in batches and can complete in any order. Submit(), Flush() and WaitForCompletions()
+    //! must all be called from a single thread, Wake() can be called from any thread.
+    struct AsyncReadQueue
+    {
+        virtual ~AsyncReadQueue() = default;
+
+        //! @brief Register a memory region that will be used for the reads with AsyncReadOperation::m_registeredBuffer set.
+        //!
+        //! The backends that support it will pin the memory once to avoid mapping the pages on every read.
+        //! Must be called before the first submission.
+        virtual void RegisterBuffer(festd::span<std::byte> buffer) = 0;
+
+        //! @brief Add an operation to the current batch. The batch is not started until Flush() is called.
+        //!
+        //! @return False if the queue is full, the operation must be submitted again after some of the operations complete.
+        [[nodiscard]] virtual bool Submit(AsyncReadOperation* operation) = 0;
+
+        //! @brief Start all the operations submitted since the last call.
+        virtual void Flush() = 0;
+
+        //! @brief Wait until at least one operation completes or Wake() is called.
+        //!
+        //! @param completions The array that receives the completed operations.
+        //!
+        //! @return The number of completed operations written to the array, can be zero if the queue has been woken up.
+        virtual uint32_t WaitForCompletions(festd::span<AsyncReadOperation*> completions) = 0;
+
+        //! @brief Interrupt WaitForCompletions() called on a different thread.
+        virtual void Wake() = 0;
+    };
+
+
+    //! @brief Create the most efficient AsyncReadQueue implementation supported by the platform.
+    //!
+    //! @param allocator  The allocator to allocate the queue with. The queue must be destroyed with Memory::Delete().
+    //! @param queueDepth The maximum number of operations that can be in flight at the same time.
+    AsyncReadQueue* CreateAsyncReadQueue(std::pmr::memory_resource* allocator, uint32_t queueDepth);
+} // namespace FE::Platform
@@ -17,9 +17,27 @@ namespace FE::Platform
 
     IO::ResultCode ReadFile(FileHandle fileHandle, void* buffer, size_t byteSize, size_t& bytesRead);
 
+    //! @brief Read from the file at the specified offset.
+    //!
+    //! Unlike ReadFile(), this function is safe to call concurrently on the same file handle.
+    //! The file position after the call is unspecified.
+    IO::ResultCode ReadFileAt(FileHandle fileHandle, uint64_t offset, void* buffer, size_t byteSize, size_t& bytesRead);
+
     IO::ResultCode WriteFile(FileHandle fileHandle, const void* buffer, size_t byteSize, size_t& bytesWritten);
 
     IO::ResultCode SeekFile(FileHandle fileHandle, intptr_t offset, IO::SeekMode seekMode);
 
     IO::ResultCode TellFile(FileHandle fileHandle, uintptr_t& position);
+
+    //! @brief Map the first byteSize bytes of the file into the address space of the process as read-only memory.
+    //!
+    //! The mapping stays valid after the file handle is closed and must be released with UnmapFile().
+    IO::ResultCode MapFile(FileHandle fileHandle, size_t byteSize, const std::byte*& data);
+
+    void UnmapFile(const std::byte* data, size_t byteSize);
+
+    //! @brief Hint the OS that the specified range of a mapped file is going to be accessed soon.
+    //!
+    //! The pages are read ahead asynchronously, the function doesn't wait for the I/O to complete.
+    void PrefetchMappedFile(const std::byte* data, size_t byteSize);
 } // namespace FE::Platform
@@ -0,0 +1,11 @@
+﻿#include <FeCore/IO/Platform/PlatformAsyncRead.h>
+#include <FeCore/IO/ThreadPoolReadQueue.h>
+
+namespace FE::Platform
+{
+    AsyncReadQueue* CreateAsyncReadQueue(std::pmr::memory_resource* allocator, const uint32_t queueDepth)
+    {
+        // Windows uses the thread pool queue, IoRing needs Windows 11.
+        return Memory::New<IO::ThreadPoolReadQueue>(allocator, queueDepth);
+    }
+} // namespace FE::Platform
@@ -211,6 +211,45 @@ namespace FE::Platform
     }
 
 
+    IO::ResultCode ReadFileAt(const FileHandle fileHandle, const uint64_t offset, void* buffer, const size_t byteSize,
+                              size_t& bytesRead)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        bytesRead = 0;
+        while (bytesRead < byteSize)
+        {
+            const size_t bytesToRead = Math::Min<size_t>(byteSize - bytesRead, Constants::kMaxValue<DWORD>);
+            const uint64_t currentOffset = offset + bytesRead;
+
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(currentOffset & Constants::kMaxU32);
+            overlapped.OffsetHigh = static_cast<DWORD>(currentOffset >> 32);
+
+            DWORD dwBytesRead = 0;
+            if (!::ReadFile(HandleCast(fileHandle),
+                            static_cast<std::byte*>(buffer) + bytesRead,
+                            static_cast<DWORD>(bytesToRead),
+                            &dwBytesRead,
+                            &overlapped))
+            {
+                const DWORD error = GetLastError();
+                if (error == ERROR_HANDLE_EOF)
+                    break;
+
+                return ConvertWin32IOError(error);
+            }
+
+            if (dwBytesRead == 0)
+                break;
+
+            bytesRead += dwBytesRead;
+        }
+
+        return IO::ResultCode::kSuccess;
+    }
+
+
     IO::ResultCode WriteFile(const FileHandle fileHandle, const void* buffer, const size_t byteSize, size_t& bytesWritten)
     {
         FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
@@ -265,4 +304,45 @@ namespace FE::Platform
 
         return IO::ResultCode::kSuccess;
     }
+
+
+    IO::ResultCode MapFile(const FileHandle fileHandle, const size_t byteSize, const std::byte*& data)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        if (byteSize == 0)
+            return IO::ResultCode::kInvalidArgument;
+
+        const HANDLE mapping = CreateFileMappingW(HandleCast(fileHandle), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            return ConvertWin32IOError(GetLastError());
+
+        // The view keeps a reference to the mapping object, so we don't need to keep the handle.
+        const void* result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, byteSize);
+        const DWORD error = GetLastError();
+        CloseHandle(mapping);
+        if (result == nullptr)
+            return ConvertWin32IOError(error);
+
+        data = static_cast<const std::byte*>(result);
+        return IO::ResultCode::kSuccess;
+    }
+
+
+    void UnmapFile(const std::byte* data, [[maybe_unused]] const size_t byteSize)
+    {
+        FE_PROFILER_ZONE();
+        UnmapViewOfFile(data);
+    }
+
+
+    void PrefetchMappedFile(const std::byte* data, const size_t byteSize)
+    {
+        FE_PROFILER_ZONE_TEXT("%" PRIu64, byteSize);
+
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<std::byte*>(data);
+        range.NumberOfBytes = byteSize;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
 } // namespace FE::Platform
@@ -1,4 +1,5 @@
 ﻿#include <FeCore/IO/FileStream.h>
+#include <FeCore/IO/MappedFileStream.h>
 #include <FeCore/IO/Platform/PlatformFile.h>
 #include <FeCore/IO/StreamFactory.h>
 
@@ -6,6 +7,7 @@ namespace FE::IO
 {
     FileStreamFactory::FileStreamFactory(Env::Configuration* pConfig)
         : m_fileStreamPool("IO/FileStream", sizeof(FileStream), 64 * 1024)
+        , m_mappedFileStreamPool("IO/MappedFileStream", sizeof(MappedFileStream), 16 * 1024)
     {
         const Path currentDirectory = Directory::GetCurrentDirectory();
         m_parentDirectory = pConfig->GetString("AssetDirectory", currentDirectory);
@@ -45,6 +47,20 @@ namespace FE::IO
     }
 
 
+    festd::expected<Rc<IStream>, ResultCode> FileStreamFactory::OpenMappedFileStream(const festd::string_view filename)
+    {
+        FE_PROFILER_ZONE();
+
+        const Rc fileStream = Rc<MappedFileStream>::New(&m_mappedFileStreamPool);
+        const Path fullPath = m_parentDirectory / filename;
+        const ResultCode result = fileStream->Open(fullPath);
+        if (result != ResultCode::kSuccess)
+            return festd::unexpected(result);
+
+        return static_pointer_cast<IStream>(fileStream);
+    }
+
+
     bool FileStreamFactory::FileExists(const festd::string_view filename)
     {
         const Path fullPath = m_parentDirectory / filename;
@@ -14,11 +14,13 @@ namespace FE::IO
         festd::expected<Rc<IStream>, ResultCode> OpenFileStream(festd::string_view filename, OpenMode openMode) override;
         festd::expected<Rc<IStream>, ResultCode> OpenUnbufferedFileStream(festd::string_view filename,
                                                                           OpenMode openMode) override;
+        festd::expected<Rc<IStream>, ResultCode> OpenMappedFileStream(festd::string_view filename) override;
         bool FileExists(festd::string_view filename) override;
         FileAttributeFlags GetFileAttributeFlags(festd::string_view filename) override;
 
     private:
         Path m_parentDirectory;
         Memory::LockedMemoryResource<Memory::PoolAllocator, Threading::SpinLock> m_fileStreamPool;
+        Memory::LockedMemoryResource<Memory::PoolAllocator, Threading::SpinLock> m_mappedFileStreamPool;
     };
 } // namespace FE::IO
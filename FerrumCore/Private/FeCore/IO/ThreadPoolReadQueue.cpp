@@ -0,0 +1,140 @@
+﻿#include <FeCore/IO/Platform/PlatformFile.h>
+#include <FeCore/IO/ThreadPoolReadQueue.h>
+#include <FeCore/Logging/Trace.h>
+#include <FeCore/Strings/Format.h>
+
+namespace FE::IO
+{
+    ThreadPoolReadQueue::ThreadPoolReadQueue(const uint32_t queueDepth)
+        : m_queueDepth(queueDepth)
+    {
+        m_completionEvent = Threading::Event::CreateAutoReset();
+
+        const auto threadFunc = [](const uintptr_t userData) {
+            reinterpret_cast<ThreadPoolReadQueue*>(userData)->ReaderThread();
+        };
+
+        for (uint32_t threadIndex = 0; threadIndex < kReaderThreadCount; ++threadIndex)
+        {
+            const auto threadName = Fmt::FixedFormat("Async IO Reader {}", threadIndex);
+            m_threads[threadIndex] = Threading::CreateThread(threadName, threadFunc, reinterpret_cast<uintptr_t>(this));
+        }
+    }
+
+
+    ThreadPoolReadQueue::~ThreadPoolReadQueue()
+    {
+        m_exitRequested.store(true, std::memory_order_release);
+        m_submissionSemaphore.Release(kReaderThreadCount);
+
+        for (Threading::ThreadHandle& thread : m_threads)
+            Threading::CloseThread(thread);
+    }
+
+
+    void ThreadPoolReadQueue::RegisterBuffer(festd::span<std::byte>)
+    {
+        // Blocking reads don't benefit from pre-registered memory.
+    }
+
+
+    bool ThreadPoolReadQueue::Submit(Platform::AsyncReadOperation* operation)
+    {
+        if (m_inFlightCount + m_batch.m_size >= m_queueDepth)
+            return false;
+
+        m_batch.PushBack(operation);
+        return true;
+    }
+
+
+    void ThreadPoolReadQueue::Flush()
+    {
+        const uint32_t batchSize = m_batch.m_size;
+        if (batchSize == 0)
+            return;
+
+        m_inFlightCount += batchSize;
+
+        {
+            std::lock_guard lk{ m_lock };
+            m_submitted.Append(m_batch);
+        }
+
+        m_submissionSemaphore.Release(batchSize);
+    }
+
+
+    uint32_t ThreadPoolReadQueue::WaitForCompletions(const festd::span<Platform::AsyncReadOperation*> completions)
+    {
+        FE_PROFILER_ZONE();
+
+        while (true)
+        {
+            uint32_t completionCount = 0;
+
+            {
+                std::lock_guard lk{ m_lock };
+                while (completionCount < completions.size())
+                {
+                    Platform::AsyncReadOperation* operation = m_completed.PopFront();
+                    if (operation == nullptr)
+                        break;
+
+                    completions[completionCount++] = operation;
+                }
+            }
+
+            m_inFlightCount -= completionCount;
+
+            if (m_wakeRequested.exchange(false, std::memory_order_acq_rel) || completionCount > 0)
+                return completionCount;
+
+            m_completionEvent.Wait();
+        }
+    }
+
+
+    void ThreadPoolReadQueue::Wake()
+    {
+        m_wakeRequested.store(true, std::memory_order_release);
+        m_completionEvent.Send();
+    }
+
+
+    void ThreadPoolReadQueue::ReaderThread()
+    {
+        while (true)
+        {
+            m_submissionSemaphore.Acquire();
+
+            if (m_exitRequested.load(std::memory_order_acquire))
+                break;
+
+            Platform::AsyncReadOperation* operation;
+
+            {
+                std::lock_guard lk{ m_lock };
+                operation = m_submitted.PopFront();
+            }
+
+            FE_Assert(operation != nullptr);
+
+            {
+                FE_PROFILER_ZONE_NAMED("ReadFileAt");
+
+                size_t bytesRead = 0;
+                operation->m_result = Platform::ReadFileAt(
+                    operation->m_fileHandle, operation->m_offset, operation->m_buffer, operation->m_byteSize, bytesRead);
+                operation->m_bytesRead = static_cast<uint32_t>(bytesRead);
+            }
+
+            {
+                std::lock_guard lk{ m_lock };
+                m_completed.PushBack(operation);
+            }
+
+            m_completionEvent.Send();
+        }
+    }
+} // namespace FE::IO
@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <FeCore/IO/Platform/PlatformAsyncRead.h>
+#include <FeCore/Threading/Event.h>
+#include <FeCore/Threading/Semaphore.h>
+#include <FeCore/Threading/Thread.h>
+
+namespace FE::IO
+{
+    //! @brief Portable AsyncReadQueue implementation that runs blocking positional reads on a small pool of threads.
+    //!
+    //! Used on the platforms that don't have a native completion-based file I/O API and as a fallback
+    //! when the native API is not available at runtime.
+    struct ThreadPoolReadQueue final : public Platform::AsyncReadQueue
+    {
+        static constexpr uint32_t kReaderThreadCount = 4;
+
+        explicit ThreadPoolReadQueue(uint32_t queueDepth);
+        ~ThreadPoolReadQueue() override;
+
+        void RegisterBuffer(festd::span<std::byte> buffer) override;
+        bool Submit(Platform::AsyncReadOperation* operation) override;
+        void Flush() override;
+        uint32_t WaitForCompletions(festd::span<Platform::AsyncReadOperation*> completions) override;
+        void Wake() override;
+
+    private:
+        Threading::ThreadHandle m_threads[kReaderThreadCount];
+        Threading::Semaphore m_submissionSemaphore;
+        Threading::Event m_completionEvent;
+        std::atomic<bool> m_exitRequested = false;
+        std::atomic<bool> m_wakeRequested = false;
+
+        uint32_t m_queueDepth = 0;
+        uint32_t m_inFlightCount = 0;
+        Platform::AsyncReadOperationList m_batch;
+
+        Threading::SpinLock m_lock;
+        Platform::AsyncReadOperationList m_submitted;
+        Platform::AsyncReadOperationList m_completed;
+
+        void ReaderThread();
+    };
+} // namespace FE::IO
@@ -0,0 +1,52 @@
+﻿#include <FeCore/Jobs/FiberEvent.h>
+
+namespace FE
+{
+    void FiberEvent::Send()
+    {
+        m_lock.lock();
+
+        FiberWaitEntry* waiters;
+        if (m_manualReset)
+        {
+            m_signaled.store(true, std::memory_order_release);
+            waiters = m_waiters.PopAll();
+        }
+        else
+        {
+            // Either wake up a single waiter or stay signaled until someone calls Wait().
+            waiters = m_waiters.Pop();
+            if (waiters == nullptr)
+                m_signaled.store(true, std::memory_order_release);
+        }
+
+        m_lock.unlock();
+        FiberWaitQueue::Resume(waiters);
+    }
+
+
+    void FiberEvent::Reset()
+    {
+        std::lock_guard lock{ m_lock };
+        m_signaled.store(false, std::memory_order_release);
+    }
+
+
+    void FiberEvent::Wait()
+    {
+        if (m_manualReset && m_signaled.load(std::memory_order_acquire))
+            return;
+
+        m_lock.lock();
+        if (m_signaled.load(std::memory_order_relaxed))
+        {
+            if (!m_manualReset)
+                m_signaled.store(false, std::memory_order_relaxed);
+
+            m_lock.unlock();
+            return;
+        }
+
+        m_waiters.Wait(m_lock);
+    }
+} // namespace FE
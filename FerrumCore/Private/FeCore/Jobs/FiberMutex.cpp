@@ -0,0 +1,135 @@
+﻿#include <FeCore/Jobs/FiberMutex.h>
+
+namespace FE
+{
+    void FiberMutex::lock()
+    {
+        m_lock.lock();
+        if (!m_locked)
+        {
+            m_locked = true;
+            m_lock.unlock();
+            return;
+        }
+
+        // unlock() hands the ownership over to us, so there's nothing to do after we're resumed.
+        m_waiters.Wait(m_lock);
+    }
+
+
+    bool FiberMutex::try_lock()
+    {
+        std::lock_guard lock{ m_lock };
+        if (m_locked)
+            return false;
+
+        m_locked = true;
+        return true;
+    }
+
+
+    void FiberMutex::unlock()
+    {
+        m_lock.lock();
+        FE_Assert(m_locked, "Mutex is not locked");
+
+        FiberWaitEntry* waiter = m_waiters.Pop();
+        if (waiter == nullptr)
+            m_locked = false;
+
+        m_lock.unlock();
+        FiberWaitQueue::Resume(waiter);
+    }
+
+
+    void FiberSharedMutex::lock()
+    {
+        m_lock.lock();
+        if (!m_exclusiveLocked && m_sharedLockCount == 0)
+        {
+            m_exclusiveLocked = true;
+            m_lock.unlock();
+            return;
+        }
+
+        m_exclusiveWaiters.Wait(m_lock);
+    }
+
+
+    bool FiberSharedMutex::try_lock()
+    {
+        std::lock_guard lock{ m_lock };
+        if (m_exclusiveLocked || m_sharedLockCount > 0)
+            return false;
+
+        m_exclusiveLocked = true;
+        return true;
+    }
+
+
+    void FiberSharedMutex::unlock()
+    {
+        m_lock.lock();
+        FE_Assert(m_exclusiveLocked, "Mutex is not locked");
+
+        FiberWaitEntry* waiters = m_sharedWaiters.PopAll();
+        if (waiters)
+        {
+            // Let all the waiting readers in.
+            m_exclusiveLocked = false;
+            for (const FiberWaitEntry* waiter = waiters; waiter; waiter = static_cast<FiberWaitEntry*>(waiter->m_next))
+                ++m_sharedLockCount;
+        }
+        else
+        {
+            // Pass the ownership to the next writer if there's one.
+            waiters = m_exclusiveWaiters.Pop();
+            m_exclusiveLocked = waiters != nullptr;
+        }
+
+        m_lock.unlock();
+        FiberWaitQueue::Resume(waiters);
+    }
+
+
+    void FiberSharedMutex::lock_shared()
+    {
+        m_lock.lock();
+        if (!m_exclusiveLocked && m_exclusiveWaiters.Empty())
+        {
+            ++m_sharedLockCount;
+            m_lock.unlock();
+            return;
+        }
+
+        m_sharedWaiters.Wait(m_lock);
+    }
+
+
+    bool FiberSharedMutex::try_lock_shared()
+    {
+        std::lock_guard lock{ m_lock };
+        if (m_exclusiveLocked || !m_exclusiveWaiters.Empty())
+            return false;
+
+        ++m_sharedLockCount;
+        return true;
+    }
+
+
+    void FiberSharedMutex::unlock_shared()
+    {
+        m_lock.lock();
+        FE_Assert(m_sharedLockCount > 0, "Mutex is not locked");
+
+        FiberWaitEntry* waiter = nullptr;
+        if (--m_sharedLockCount == 0)
+        {
+            waiter = m_exclusiveWaiters.Pop();
+            m_exclusiveLocked = waiter != nullptr;
+        }
+
+        m_lock.unlock();
+        FiberWaitQueue::Resume(waiter);
+    }
+} // namespace FE
@@ -0,0 +1,56 @@
+﻿#include <FeCore/Jobs/FiberSemaphore.h>
+
+namespace FE
+{
+    void FiberSemaphore::Acquire()
+    {
+        m_lock.lock();
+        if (m_value > 0)
+        {
+            --m_value;
+            m_lock.unlock();
+            return;
+        }
+
+        m_waiters.Wait(m_lock);
+    }
+
+
+    bool FiberSemaphore::TryAcquire()
+    {
+        std::lock_guard lock{ m_lock };
+        if (m_value == 0)
+            return false;
+
+        --m_value;
+        return true;
+    }
+
+
+    void FiberSemaphore::Release(uint32_t count)
+    {
+        FiberWaitEntry* waitersHead = nullptr;
+        FiberWaitEntry* waitersTail = nullptr;
+
+        m_lock.lock();
+        while (count > 0)
+        {
+            FiberWaitEntry* waiter = m_waiters.Pop();
+            if (waiter == nullptr)
+                break;
+
+            if (waitersTail)
+                waitersTail->m_next = waiter;
+            else
+                waitersHead = waiter;
+
+            waitersTail = waiter;
+            --count;
+        }
+
+        m_value += count;
+        m_lock.unlock();
+
+        FiberWaitQueue::Resume(waitersHead);
+    }
+} // namespace FE
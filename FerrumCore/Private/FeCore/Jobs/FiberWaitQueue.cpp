@@ -0,0 +1,44 @@
+﻿#include <FeCore/Jobs/FiberWaitQueue.h>
+#include <FeCore/Jobs/JobSystem.h>
+
+namespace FE
+{
+    void FiberWaitQueue::Wait(Threading::SpinLock& lock)
+    {
+        FE_PROFILER_ZONE();
+
+        JobSystem* jobSystem = JobSystem::GetCurrent();
+        FE_Assert(jobSystem, "Fiber synchronization primitives can only wait on a fiber");
+
+        const uint32_t workerIndex = jobSystem->GetWorkerIndex();
+        const JobSystem::Worker& worker = jobSystem->m_workers[workerIndex];
+
+        FiberWaitEntry waitEntry;
+        waitEntry.m_next = nullptr;
+        waitEntry.m_jobSystem = jobSystem;
+        waitEntry.m_priority = worker.m_priority;
+        waitEntry.m_affinityMask = worker.m_affinityMask;
+        waitEntry.m_fiber = worker.m_currentFiber;
+
+        if (m_tail)
+            m_tail->m_next = &waitEntry;
+        else
+            m_head = &waitEntry;
+        m_tail = &waitEntry;
+
+        // The entry can be resumed as soon as we unlock, the job system will wait for the switch to complete.
+        lock.unlock();
+        jobSystem->SwitchFromWaitingFiber(workerIndex, waitEntry);
+    }
+
+
+    void FiberWaitQueue::Resume(FiberWaitEntry* entries)
+    {
+        while (entries)
+        {
+            auto* next = static_cast<FiberWaitEntry*>(entries->m_next);
+            entries->m_jobSystem->AddReadyFiber(entries);
+            entries = next;
+        }
+    }
+} // namespace FE
@@ -0,0 +1,272 @@
+﻿#include <FeCore/Jobs/JobProfiler.h>
+#include <FeCore/Strings/Format.h>
+
+namespace FE
+{
+    namespace
+    {
+        constexpr size_t kExportFlushSize = 64 * 1024;
+
+
+        void AppendMicroseconds(festd::string& buffer, const uint64_t ticks)
+        {
+            const auto nanoseconds = static_cast<uint64_t>(static_cast<double>(ticks) * Platform::GetSecondsPerTick() * 1e9);
+            const uint64_t fraction = nanoseconds % 1000;
+            Fmt::FormatTo(buffer, "{}.", nanoseconds / 1000);
+            buffer.push_back(static_cast<char>('0' + fraction / 100));
+            buffer.push_back(static_cast<char>('0' + fraction / 10 % 10));
+            buffer.push_back(static_cast<char>('0' + fraction % 10));
+        }
+
+
+        void AppendEscaped(festd::string& buffer, const festd::string_view value)
+        {
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    buffer.push_back('\\');
+                buffer.push_back(c);
+            }
+        }
+
+
+        const char* GetEventName(const JobTraceEventType type)
+        {
+            switch (type)
+            {
+            case JobTraceEventType::kJob:
+                return "Job";
+            case JobTraceEventType::kWait:
+                return "Wait";
+            case JobTraceEventType::kIdle:
+                return "Idle";
+            default:
+                FE_DebugBreak();
+                return "Unknown";
+            }
+        }
+    } // namespace
+
+
+    JobProfiler::~JobProfiler()
+    {
+        for (WorkerData& worker : m_workers)
+            Memory::DefaultFree(worker.m_events);
+    }
+
+
+    void JobProfiler::RegisterWorker(const uint32_t workerIndex, const festd::string_view name)
+    {
+        FE_Assert(workerIndex < kMaxWorkerCount);
+        m_workers[workerIndex].m_name = name;
+        m_workers[workerIndex].m_registered = true;
+    }
+
+
+    void JobProfiler::StartCapture(const uint32_t eventCapacity)
+    {
+        FE_Assert(!IsCapturing(), "Capture already started");
+        FE_Assert(eventCapacity > 0 && eventCapacity <= kMaxEventCapacity);
+
+        for (WorkerData& worker : m_workers)
+        {
+            if (!worker.m_registered)
+                continue;
+
+            // No worker has recorded anything before the first capture, so it's safe to allocate here.
+            if (worker.m_events == nullptr)
+                worker.m_events = Memory::DefaultAllocateArray<JobTraceEvent>(kMaxEventCapacity);
+
+            worker.m_eventCapacity.store(eventCapacity, std::memory_order_relaxed);
+            worker.m_eventCount.store(0, std::memory_order_relaxed);
+            worker.m_jobCount.store(0, std::memory_order_relaxed);
+            worker.m_stolenJobCount.store(0, std::memory_order_relaxed);
+            worker.m_fiberSwitchCount.store(0, std::memory_order_relaxed);
+            worker.m_parkCount.store(0, std::memory_order_relaxed);
+            worker.m_executionTicks.store(0, std::memory_order_relaxed);
+            worker.m_queueLatencyTicks.store(0, std::memory_order_relaxed);
+            worker.m_waitTicks.store(0, std::memory_order_relaxed);
+            worker.m_idleTicks.store(0, std::memory_order_relaxed);
+        }
+
+        m_captureStartTicks.store(Platform::GetTicks(), std::memory_order_relaxed);
+        m_capturing.store(true, std::memory_order_release);
+    }
+
+
+    void JobProfiler::StopCapture()
+    {
+        m_capturing.store(false, std::memory_order_release);
+    }
+
+
+    JobWorkerStats JobProfiler::GetWorkerStats(const uint32_t workerIndex) const
+    {
+        FE_Assert(workerIndex < kMaxWorkerCount);
+        const WorkerData& worker = m_workers[workerIndex];
+
+        JobWorkerStats stats;
+        stats.m_jobCount = worker.m_jobCount.load(std::memory_order_relaxed);
+        stats.m_stolenJobCount = worker.m_stolenJobCount.load(std::memory_order_relaxed);
+        stats.m_fiberSwitchCount = worker.m_fiberSwitchCount.load(std::memory_order_relaxed);
+        stats.m_parkCount = worker.m_parkCount.load(std::memory_order_relaxed);
+        stats.m_executionTicks = worker.m_executionTicks.load(std::memory_order_relaxed);
+        stats.m_queueLatencyTicks = worker.m_queueLatencyTicks.load(std::memory_order_relaxed);
+        stats.m_waitTicks = worker.m_waitTicks.load(std::memory_order_relaxed);
+        stats.m_idleTicks = worker.m_idleTicks.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+
+    JobWorkerStats JobProfiler::GetTotalStats() const
+    {
+        JobWorkerStats total;
+        for (uint32_t workerIndex = 0; workerIndex < kMaxWorkerCount; ++workerIndex)
+        {
+            if (!m_workers[workerIndex].m_registered)
+                continue;
+
+            const JobWorkerStats stats = GetWorkerStats(workerIndex);
+            total.m_jobCount += stats.m_jobCount;
+            total.m_stolenJobCount += stats.m_stolenJobCount;
+            total.m_fiberSwitchCount += stats.m_fiberSwitchCount;
+            total.m_parkCount += stats.m_parkCount;
+            total.m_executionTicks += stats.m_executionTicks;
+            total.m_queueLatencyTicks += stats.m_queueLatencyTicks;
+            total.m_waitTicks += stats.m_waitTicks;
+            total.m_idleTicks += stats.m_idleTicks;
+        }
+
+        return total;
+    }
+
+
+    void JobProfiler::AddEvent(WorkerData& worker, const JobTraceEvent& event)
+    {
+        const uint64_t eventCount = worker.m_eventCount.load(std::memory_order_relaxed);
+        const uint32_t eventCapacity = worker.m_eventCapacity.load(std::memory_order_relaxed);
+        worker.m_events[eventCount % eventCapacity] = event;
+        worker.m_eventCount.store(eventCount + 1, std::memory_order_release);
+    }
+
+
+    void JobProfiler::RecordJob(const uint32_t workerIndex, const uint64_t scheduleTicks, const uint64_t startTicks,
+                                const uint64_t endTicks)
+    {
+        WorkerData& worker = m_workers[workerIndex];
+
+        JobTraceEvent event;
+        event.m_type = JobTraceEventType::kJob;
+        event.m_startTicks = startTicks;
+        event.m_endTicks = endTicks;
+
+        // The job might have been scheduled before the capture started.
+        if (scheduleTicks >= m_captureStartTicks.load(std::memory_order_relaxed) && scheduleTicks <= startTicks)
+            event.m_queueLatencyTicks = startTicks - scheduleTicks;
+
+        Increment(worker.m_jobCount, 1);
+        Increment(worker.m_executionTicks, endTicks - startTicks);
+        Increment(worker.m_queueLatencyTicks, event.m_queueLatencyTicks);
+        AddEvent(worker, event);
+    }
+
+
+    void JobProfiler::RecordWait(const uint32_t workerIndex, const uint64_t startTicks, const uint64_t endTicks)
+    {
+        WorkerData& worker = m_workers[workerIndex];
+
+        JobTraceEvent event;
+        event.m_type = JobTraceEventType::kWait;
+        event.m_startTicks = startTicks;
+        event.m_endTicks = endTicks;
+
+        Increment(worker.m_waitTicks, endTicks - startTicks);
+        AddEvent(worker, event);
+    }
+
+
+    void JobProfiler::RecordIdle(const uint32_t workerIndex, const uint64_t startTicks, const uint64_t endTicks)
+    {
+        WorkerData& worker = m_workers[workerIndex];
+
+        JobTraceEvent event;
+        event.m_type = JobTraceEventType::kIdle;
+        event.m_startTicks = startTicks;
+        event.m_endTicks = endTicks;
+
+        Increment(worker.m_parkCount, 1);
+        Increment(worker.m_idleTicks, endTicks - startTicks);
+        AddEvent(worker, event);
+    }
+
+
+    bool JobProfiler::ExportChromeTrace(IO::IStream* stream) const
+    {
+        FE_PROFILER_ZONE();
+        FE_Assert(!IsCapturing(), "Stop the capture before exporting");
+
+        festd::string buffer;
+        bool success = true;
+        const auto flush = [&] {
+            success &= stream->WriteFromBuffer(buffer.data(), buffer.size()) == buffer.size();
+            buffer.clear();
+        };
+
+        bool firstEvent = true;
+        const auto beginEvent = [&] {
+            buffer += firstEvent ? "\n" : ",\n";
+            firstEvent = false;
+        };
+
+        const uint64_t captureStartTicks = m_captureStartTicks.load(std::memory_order_relaxed);
+        buffer += R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+        for (uint32_t workerIndex = 0; workerIndex < kMaxWorkerCount; ++workerIndex)
+        {
+            const WorkerData& worker = m_workers[workerIndex];
+            if (!worker.m_registered)
+                continue;
+
+            beginEvent();
+            Fmt::FormatTo(buffer, R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")", workerIndex);
+            AppendEscaped(buffer, worker.m_name);
+            buffer += R"("}})";
+
+            beginEvent();
+            Fmt::FormatTo(buffer, R"({{"name":"thread_sort_index","ph":"M","pid":1,"tid":{},"args":{{"sort_index":{}}}}})",
+                          workerIndex,
+                          workerIndex);
+
+            const uint64_t eventCount = worker.m_eventCount.load(std::memory_order_acquire);
+            const uint32_t eventCapacity = worker.m_eventCapacity.load(std::memory_order_relaxed);
+            const uint64_t firstEventIndex = eventCount > eventCapacity ? eventCount - eventCapacity : 0;
+            for (uint64_t eventIndex = firstEventIndex; eventIndex < eventCount; ++eventIndex)
+            {
+                const JobTraceEvent& event = worker.m_events[eventIndex % eventCapacity];
+                const uint64_t startTicks = Math::Max(event.m_startTicks, captureStartTicks);
+                const uint64_t endTicks = Math::Max(event.m_endTicks, startTicks);
+
+                beginEvent();
+                Fmt::FormatTo(buffer, R"({{"name":"{}","cat":"jobs","ph":"X","pid":1,"tid":{},"ts":)", GetEventName(event.m_type), workerIndex);
+                AppendMicroseconds(buffer, startTicks - captureStartTicks);
+                buffer += R"(,"dur":)";
+                AppendMicroseconds(buffer, endTicks - startTicks);
+
+                if (event.m_type == JobTraceEventType::kJob)
+                {
+                    buffer += R"(,"args":{"queue_latency_us":)";
+                    AppendMicroseconds(buffer, event.m_queueLatencyTicks);
+                    buffer += "}";
+                }
+
+                buffer += "}";
+                if (buffer.size() >= kExportFlushSize)
+                    flush();
+            }
+        }
+
+        buffer += "\n]}\n";
+        flush();
+        return success;
+    }
+} // namespace FE
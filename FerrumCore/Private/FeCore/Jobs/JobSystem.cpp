@@ -5,39 +5,51 @@
 
 namespace FE
 {
-    void JobSystem::AddReadyFiber(FiberWaitEntry* entry)
+    namespace
     {
-        entry->m_orderHint = m_jobCounter.fetch_add(1, std::memory_order_relaxed);
-
-        const FiberAffinityMask affinityMask = entry->m_affinityMask;
-        const JobPriority priority = entry->m_priority;
-        GlobalQueueSet& globalQueueSet = m_globalQueues[festd::to_underlying(priority)];
-        switch (affinityMask)
+        JobThreadPoolType GetThreadPoolType(const FiberAffinityMask affinityMask)
         {
-        case FiberAffinityMask::kAll:
-            globalQueueSet.m_readyFiberQueues[festd::to_underlying(JobThreadPoolType::kGeneric)].Enqueue(entry);
-            break;
+            switch (affinityMask)
+            {
+            case FiberAffinityMask::kAll:
+                return JobThreadPoolType::kGeneric;
+            case FiberAffinityMask::kAllForeground:
+                return JobThreadPoolType::kForeground;
+            case FiberAffinityMask::kAllBackground:
+                return JobThreadPoolType::kBackground;
+            default:
+                return JobThreadPoolType::kCount;
+            }
+        }
 
-        case FiberAffinityMask::kAllForeground:
-            globalQueueSet.m_readyFiberQueues[festd::to_underlying(JobThreadPoolType::kForeground)].Enqueue(entry);
-            break;
 
-        case FiberAffinityMask::kAllBackground:
-            globalQueueSet.m_readyFiberQueues[festd::to_underlying(JobThreadPoolType::kBackground)].Enqueue(entry);
-            break;
+        FiberAffinityMask GetThreadPoolAffinityMask(const JobThreadPoolType threadPoolType)
+        {
+            return threadPoolType == JobThreadPoolType::kForeground ? FiberAffinityMask::kAllForeground
+                                                                    : FiberAffinityMask::kAllBackground;
+        }
+    } // namespace
 
-        case FiberAffinityMask::kNone:
-        case FiberAffinityMask::kMainThread:
-        default:
-            {
-                FE_AssertDebug(Bit::PopCount(festd::to_underlying(affinityMask)) == 1, "Invalid affinity mask");
-                const uint32_t threadIndex = Bit::CountTrailingZeros(festd::to_underlying(affinityMask));
 
-                Worker& worker = m_workers[threadIndex];
-                worker.m_readyFiberQueues[festd::to_underlying(priority)].Enqueue(entry);
-                break;
-            }
+    void JobSystem::AddReadyFiber(FiberWaitEntry* entry)
+    {
+        const FiberAffinityMask affinityMask = entry->m_affinityMask;
+        const JobPriority priority = entry->m_priority;
+        const JobThreadPoolType threadPoolType = GetThreadPoolType(affinityMask);
+        if (threadPoolType != JobThreadPoolType::kCount)
+        {
+            GlobalQueueSet& globalQueueSet = m_globalQueues[festd::to_underlying(priority)];
+            globalQueueSet.m_readyFiberQueues[festd::to_underlying(threadPoolType)].Enqueue(entry);
+            WakeWorker(affinityMask);
+            return;
         }
+
+        FE_AssertDebug(Bit::PopCount(festd::to_underlying(affinityMask)) == 1, "Invalid affinity mask");
+        const uint32_t threadIndex = Bit::CountTrailingZeros(festd::to_underlying(affinityMask));
+
+        Worker& worker = m_workers[threadIndex];
+        worker.m_readyFiberQueues[festd::to_underlying(priority)].Enqueue(entry);
+        WakeWorker(affinityMask);
     }
 
 
@@ -45,6 +57,7 @@ namespace FE
     {
         m_semaphore.Acquire();
         m_workers[workerIndex].m_threadId = Threading::GetCurrentThreadID();
+        EnterThread(m_workers[workerIndex]);
 
         const Threading::FiberHandle initialFiber = m_fiberPool.Rent(false);
         m_workers[workerIndex].m_currentFiber = initialFiber;
@@ -53,157 +66,257 @@ namespace FE
     }
 
 
-    FE_FORCE_INLINE void JobSystem::FiberProc(Context::TransferParams transferParams)
+    FE_FORCE_INLINE FiberWaitEntry* JobSystem::TryGetReadyFiber(Worker& worker, const uint32_t priorityIndex)
     {
-        const uint32_t initialWorkerIndex = GetWorkerIndex();
-        if (!m_workers[initialWorkerIndex].m_exitContext)
-            m_workers[initialWorkerIndex].m_exitContext = transferParams.m_contextHandle;
+        GlobalQueueSet& globalQueueSet = m_globalQueues[priorityIndex];
 
-        CleanUpAfterSwitch(transferParams);
-        while (!m_shouldExit.load(std::memory_order_acquire))
+        if (auto* entry = static_cast<FiberWaitEntry*>(worker.m_readyFiberQueues[priorityIndex].TryDequeue()))
+            return entry;
+
+        const uint32_t threadPoolIndex = festd::to_underlying(worker.m_threadPoolType);
+        if (auto* entry = static_cast<FiberWaitEntry*>(globalQueueSet.m_readyFiberQueues[threadPoolIndex].TryDequeue()))
+            return entry;
+
+        const uint32_t genericIndex = festd::to_underlying(JobThreadPoolType::kGeneric);
+        return static_cast<FiberWaitEntry*>(globalQueueSet.m_readyFiberQueues[genericIndex].TryDequeue());
+    }
+
+
+    FE_FORCE_INLINE Job* JobSystem::TryGetLocalJob(Worker& worker, const uint32_t priorityIndex, FiberAffinityMask& affinityMask)
+    {
+        // Jobs that can only run on this worker come first, since nobody else can take them.
+        if (Job* job = static_cast<Job*>(worker.m_jobQueues[priorityIndex].TryDequeue()))
         {
-            Worker& worker = m_workers[GetWorkerIndex()];
+            affinityMask = static_cast<FiberAffinityMask>(UINT64_C(1) << worker.m_index);
+            return job;
+        }
 
-            const FiberWaitEntry* waitEntry = nullptr;
-            Job* job = nullptr;
-            auto affinityMask = FiberAffinityMask::kNone;
+        if (Job* job = worker.m_threadPoolJobDeques[priorityIndex].Pop())
+        {
+            affinityMask = GetThreadPoolAffinityMask(worker.m_threadPoolType);
+            return job;
+        }
 
-            for (uint32_t attempt = 0; attempt < 8; ++attempt)
-            {
-                for (int32_t queueIndex = festd::to_underlying(JobPriority::kHigh); queueIndex >= 0; --queueIndex)
-                {
-                    GlobalQueueSet& globalQueueSet = m_globalQueues[queueIndex];
+        if (Job* job = worker.m_genericJobDeques[priorityIndex].Pop())
+        {
+            affinityMask = FiberAffinityMask::kAll;
+            return job;
+        }
 
-                    // Firstly, try to continue pending fiber.
+        GlobalQueueSet& globalQueueSet = m_globalQueues[priorityIndex];
 
-                    FiberWaitEntry* fibers[3] = {};
-                    ConcurrentQueue* queues[3] = {};
+        const uint32_t threadPoolIndex = festd::to_underlying(worker.m_threadPoolType);
+        if (Job* job = static_cast<Job*>(globalQueueSet.m_jobQueues[threadPoolIndex].TryDequeue()))
+        {
+            affinityMask = GetThreadPoolAffinityMask(worker.m_threadPoolType);
+            return job;
+        }
 
-                    queues[0] = &worker.m_readyFiberQueues[queueIndex];
-                    queues[1] = &globalQueueSet.m_readyFiberQueues[festd::to_underlying(JobThreadPoolType::kGeneric)];
-                    queues[2] = &globalQueueSet.m_readyFiberQueues[festd::to_underlying(worker.m_threadPoolType)];
+        const uint32_t genericIndex = festd::to_underlying(JobThreadPoolType::kGeneric);
+        if (Job* job = static_cast<Job*>(globalQueueSet.m_jobQueues[genericIndex].TryDequeue()))
+        {
+            affinityMask = FiberAffinityMask::kAll;
+            return job;
+        }
 
-                    // Since we use single-consumer queues, and we might push a job back to the front of the queue,
-                    // we need this lock here.
+        return nullptr;
+    }
 
-                    std::unique_lock lock{ globalQueueSet.m_consumerLocks[queueIndex] };
 
-                    for (uint32_t i = 0; i < 3; ++i)
-                        fibers[i] = static_cast<FiberWaitEntry*>(queues[i]->TryDequeue());
+    FE_FORCE_INLINE Job* JobSystem::TryStealJob(Worker& worker, const uint32_t priorityIndex, FiberAffinityMask& affinityMask)
+    {
+        const uint64_t victimMask = m_activeWorkerMask & ~(UINT64_C(1) << worker.m_index);
+        if (victimMask == 0)
+            return nullptr;
 
-                    // We can potentially have three fibers: one from the local queue, and two from the global queues.
-                    // Check which one has been scheduled earlier.
+        const uint64_t threadPoolMask = festd::to_underlying(GetThreadPoolAffinityMask(worker.m_threadPoolType));
 
-                    uint32_t fiberIndex = kInvalidIndex;
-                    uint64_t fiberOrderHint = Constants::kMaxU64;
-                    for (uint32_t i = 0; i < 3; ++i)
-                    {
-                        if (fibers[i] && fibers[i]->m_orderHint < fiberOrderHint)
-                        {
-                            fiberIndex = i;
-                            fiberOrderHint = fibers[i]->m_orderHint;
-                        }
-                    }
+        // Start from a random victim to spread the thieves across the workers.
+        // We split the mask into two parts to visit the victims in the order [start, 63], [0, start).
+        const uint32_t startIndex = static_cast<uint32_t>(worker.m_random.RandUInt64() % kMaxWorkerCount);
+        const uint64_t startMask = Constants::kMaxU64 << startIndex;
+        const uint64_t victimMaskParts[] = { victimMask & startMask, victimMask & ~startMask };
 
-                    for (uint32_t i = 0; i < 3; ++i)
-                    {
-                        // Push the rest of the fibers back to the front of the queue.
-                        if (i != fiberIndex && fibers[i])
-                            queues[i]->PushFront(fibers[i]);
-                    }
+        for (uint64_t victims : victimMaskParts)
+        {
+            while (victims)
+            {
+                const uint32_t victimIndex = Bit::CountTrailingZeros(victims);
+                victims &= victims - 1;
 
-                    if (fiberIndex != kInvalidIndex)
+                Worker& victim = m_workers[victimIndex];
+                if (threadPoolMask & (UINT64_C(1) << victimIndex))
+                {
+                    if (Job* job = victim.m_threadPoolJobDeques[priorityIndex].Steal())
                     {
-                        worker.m_priority = static_cast<JobPriority>(queueIndex);
-                        waitEntry = fibers[fiberIndex];
-
-                        switch (fiberIndex)
-                        {
-                        case 0:
-                            affinityMask = static_cast<FiberAffinityMask>(1 << GetWorkerIndex());
-                            break;
-                        case 1:
-                            affinityMask = FiberAffinityMask::kAll;
-                            break;
-                        case 2:
-                            affinityMask = worker.m_threadPoolType == JobThreadPoolType::kForeground
-                                ? FiberAffinityMask::kAllForeground
-                                : FiberAffinityMask::kAllBackground;
-                            break;
-                        default:
-                            FE_DebugBreak();
-                            break;
-                        }
-
-                        break;
+                        affinityMask = GetThreadPoolAffinityMask(worker.m_threadPoolType);
+                        return job;
                     }
+                }
 
-                    // If we don't have any ready fibers, try to get a new job.
-                    // The same logic applies here.
+                if (Job* job = victim.m_genericJobDeques[priorityIndex].Steal())
+                {
+                    affinityMask = FiberAffinityMask::kAll;
+                    return job;
+                }
+            }
+        }
 
-                    Job* jobs[3] = {};
+        return nullptr;
+    }
 
-                    queues[0] = &worker.m_jobQueues[queueIndex];
-                    queues[1] = &globalQueueSet.m_jobQueues[festd::to_underlying(JobThreadPoolType::kGeneric)];
-                    queues[2] = &globalQueueSet.m_jobQueues[festd::to_underlying(worker.m_threadPoolType)];
 
-                    for (uint32_t i = 0; i < 3; ++i)
-                        jobs[i] = static_cast<Job*>(queues[i]->TryDequeue());
+    FE_FORCE_INLINE bool JobSystem::TryFindWork(Worker& worker, FiberWaitEntry*& waitEntry, Job*& job,
+                                                FiberAffinityMask& affinityMask)
+    {
+        // Firstly, try to continue a pending fiber or take a job that doesn't require stealing.
+        for (int32_t queueIndex = festd::to_underlying(JobPriority::kHigh); queueIndex >= 0; --queueIndex)
+        {
+            waitEntry = TryGetReadyFiber(worker, queueIndex);
+            if (waitEntry)
+            {
+                worker.m_priority = static_cast<JobPriority>(queueIndex);
+                return true;
+            }
 
-                    uint32_t jobIndex = kInvalidIndex;
-                    uint64_t jobOrderHint = Constants::kMaxU64;
-                    for (uint32_t i = 0; i < 3; ++i)
-                    {
-                        if (jobs[i] && jobs[i]->m_orderHint < jobOrderHint)
-                        {
-                            jobIndex = i;
-                            jobOrderHint = jobs[i]->m_orderHint;
-                        }
-                    }
+            job = TryGetLocalJob(worker, queueIndex, affinityMask);
+            if (job)
+            {
+                worker.m_priority = static_cast<JobPriority>(queueIndex);
+                return true;
+            }
+        }
 
-                    for (uint32_t i = 0; i < 3; ++i)
-                    {
-                        if (i != jobIndex && jobs[i])
-                            queues[i]->PushFront(jobs[i]);
-                    }
+        // We have nothing to do, try to steal a job from another worker.
+        for (int32_t queueIndex = festd::to_underlying(JobPriority::kHigh); queueIndex >= 0; --queueIndex)
+        {
+            job = TryStealJob(worker, queueIndex, affinityMask);
+            if (job)
+            {
+                if (m_profiler.IsCapturing())
+                    m_profiler.RecordSteal(worker.m_index);
 
-                    if (jobIndex != kInvalidIndex)
-                    {
-                        worker.m_priority = static_cast<JobPriority>(queueIndex);
-                        job = jobs[jobIndex];
-
-                        switch (jobIndex)
-                        {
-                        case 0:
-                            affinityMask = static_cast<FiberAffinityMask>(1 << GetWorkerIndex());
-                            break;
-                        case 1:
-                            affinityMask = FiberAffinityMask::kAll;
-                            break;
-                        case 2:
-                            affinityMask = worker.m_threadPoolType == JobThreadPoolType::kForeground
-                                ? FiberAffinityMask::kAllForeground
-                                : FiberAffinityMask::kAllBackground;
-                            break;
-                        default:
-                            FE_DebugBreak();
-                            break;
-                        }
-
-                        break;
-                    }
-                }
+                worker.m_priority = static_cast<JobPriority>(queueIndex);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    bool JobSystem::Park(Worker& worker, FiberWaitEntry*& waitEntry, Job*& job, FiberAffinityMask& affinityMask)
+    {
+        const uint64_t workerBit = UINT64_C(1) << worker.m_index;
+        const uint32_t key = worker.m_parkingEvent.PrepareWait();
+        m_parkedWorkerMask.fetch_or(workerBit, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Check the queues once again: the work could have been added after the last attempt, but before
+        // this worker was marked as parked, in which case no one is going to wake us up.
+        if (TryFindWork(worker, waitEntry, job, affinityMask) || m_shouldExit.load(std::memory_order_acquire))
+        {
+            m_parkedWorkerMask.fetch_and(~workerBit, std::memory_order_relaxed);
+            worker.m_parkingEvent.CancelWait();
+            return waitEntry || job;
+        }
+
+        if (m_profiler.IsCapturing())
+        {
+            const uint64_t idleStartTicks = Platform::GetTicks();
+            worker.m_parkingEvent.Wait(key);
+            m_profiler.RecordIdle(worker.m_index, idleStartTicks, Platform::GetTicks());
+        }
+        else
+        {
+            worker.m_parkingEvent.Wait(key);
+        }
+
+        // The waking thread has already cleared the bit, but we might also have been woken up spuriously.
+        m_parkedWorkerMask.fetch_and(~workerBit, std::memory_order_relaxed);
+        return false;
+    }
+
+
+    void JobSystem::WakeWorker(const FiberAffinityMask affinityMask)
+    {
+        // Pairs with the fence in Park(): either the parking worker sees the work we've just added,
+        // or we see the worker's bit in the parked mask.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const uint64_t candidateMask = festd::to_underlying(affinityMask);
+        uint64_t parkedMask = m_parkedWorkerMask.load(std::memory_order_relaxed);
+        while (parkedMask & candidateMask)
+        {
+            const uint32_t workerIndex = Bit::CountTrailingZeros(parkedMask & candidateMask);
+            const uint64_t workerBit = UINT64_C(1) << workerIndex;
+
+            // Only one thread can clear the bit, so every parked worker is woken up at most once.
+            parkedMask = m_parkedWorkerMask.fetch_and(~workerBit, std::memory_order_acq_rel);
+            if (parkedMask & workerBit)
+            {
+                m_workers[workerIndex].m_parkingEvent.Notify();
+                return;
+            }
+        }
+    }
+
+
+    void JobSystem::WakeAllWorkers()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        uint64_t parkedMask = m_parkedWorkerMask.exchange(0, std::memory_order_acq_rel);
+        while (parkedMask)
+        {
+            const uint32_t workerIndex = Bit::CountTrailingZeros(parkedMask);
+            parkedMask &= parkedMask - 1;
+            m_workers[workerIndex].m_parkingEvent.Notify();
+        }
+    }
+
+
+    FE_FORCE_INLINE void JobSystem::FiberProc(Context::TransferParams transferParams)
+    {
+        CleanUpAfterSwitch(transferParams);
+        while (!m_shouldExit.load(std::memory_order_acquire))
+        {
+            Worker& worker = m_workers[GetWorkerIndex()];
 
-                if (job || waitEntry)
-                    break;
+            FiberWaitEntry* waitEntry = nullptr;
+            Job* job = std::exchange(worker.m_pendingJob, nullptr);
+            auto affinityMask = worker.m_pendingJobAffinityMask;
 
+            bool found = job || TryFindWork(worker, waitEntry, job, affinityMask);
+            for (uint32_t attempt = 0; !found && attempt < worker.m_spinAttemptCount; ++attempt)
+            {
                 const uint32_t spinCount = Math::Min(1u << attempt, 32u);
                 for (uint32_t spin = 0; spin < spinCount; ++spin)
                     _mm_pause();
+
+                found = TryFindWork(worker, waitEntry, job, affinityMask);
+                if (found)
+                {
+                    // Spinning has paid off, allow the worker to spin longer next time.
+                    worker.m_spinAttemptCount = Math::Min(worker.m_spinAttemptCount + 1, kMaxSpinAttemptCount);
+                }
+            }
+
+            if (!found)
+            {
+                // Spinning was a waste of time, so spin less next time.
+                worker.m_spinAttemptCount = Math::Max(worker.m_spinAttemptCount / 2, kMinSpinAttemptCount);
+                if (!Park(worker, waitEntry, job, affinityMask))
+                    continue;
             }
 
             if (waitEntry)
             {
+                // The fiber is added to the ready queue right after it releases the lock of the primitive it waits on,
+                // so it might still be switching away on another worker.
+                while (!waitEntry->m_switchCompleted.load(std::memory_order_acquire))
+                    _mm_pause();
+
                 worker.m_prevFiber = worker.m_currentFiber;
                 worker.m_currentFiber = waitEntry->m_fiber;
                 worker.m_affinityMask = waitEntry->m_affinityMask;
@@ -213,20 +326,40 @@ namespace FE
                 continue;
             }
 
-            if (job)
+            if (job->GetStackSize() == JobStackSize::kLarge && !m_fiberPool.IsExtended(worker.m_currentFiber))
             {
-                worker.m_affinityMask = affinityMask;
+                // Hand the job over to a large fiber, the current one will be returned to the pool after the switch.
+                worker.m_pendingJob = job;
+                worker.m_pendingJobAffinityMask = affinityMask;
+                worker.m_prevFiber = worker.m_currentFiber;
+                worker.m_currentFiber = m_fiberPool.Rent(true);
+                const char* switchMessage = worker.m_name.c_str();
+                transferParams = m_fiberPool.Switch(worker.m_currentFiber, reinterpret_cast<uintptr_t>(this), switchMessage);
+                CleanUpAfterSwitch(transferParams);
+                continue;
+            }
+
+            worker.m_affinityMask = affinityMask;
+
+            Rc completionWaitGroup = job->m_completionWaitGroup;
 
-                Rc completionWaitGroup = job->m_completionWaitGroup;
+            if (m_profiler.IsCapturing())
+            {
+                // The job can delete itself in Execute(), so we read everything we need beforehand.
+                const uint64_t scheduleTicks = job->m_scheduleTicks;
+                const uint64_t startTicks = Platform::GetTicks();
                 job->Execute();
-                if (completionWaitGroup)
-                    completionWaitGroup->Signal();
 
-                continue;
+                // The job could have waited and continued on another worker.
+                m_profiler.RecordJob(GetWorkerIndex(), scheduleTicks, startTicks, Platform::GetTicks());
+            }
+            else
+            {
+                job->Execute();
             }
 
-            // TODO: sleep
-            std::this_thread::yield();
+            if (completionWaitGroup)
+                completionWaitGroup->Signal();
         }
 
         TracyFiberLeave;
@@ -242,38 +375,75 @@ namespace FE
 
 
     JobSystem::JobSystem()
+        : JobSystem([] {
+            const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
+            const uint32_t threadCount = cpuInfo.m_physicalCores < 8 ? cpuInfo.m_logicalCores : cpuInfo.m_physicalCores;
+            return Math::Clamp(threadCount, 4u, kMaxWorkerCount);
+        }())
+    {
+    }
+
+
+    JobSystem::JobSystem(const uint32_t workerCount)
         : m_fiberPool(&FiberProcImpl)
     {
-        const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
-        const uint32_t threadCount = cpuInfo.m_physicalCores < 8 ? cpuInfo.m_logicalCores : cpuInfo.m_physicalCores;
-        const uint32_t workerCount = Math::Clamp(threadCount, 4u, kMaxWorkerCount);
-        // const uint32_t workerCount = 2;
+        FE_Assert(workerCount >= 2 && workerCount <= kMaxWorkerCount, "Invalid worker count");
+
+        for (GlobalQueueSet& globalQueueSet : m_globalQueues)
+        {
+            for (ConcurrentQueue& queue : globalQueueSet.m_jobQueues)
+                queue.Initialize(kGlobalQueueCapacity);
+            for (ConcurrentQueue& queue : globalQueueSet.m_readyFiberQueues)
+                queue.Initialize(kGlobalQueueCapacity);
+        }
+
         const uint32_t foregroundWorkerCount = Math::CeilDivide(workerCount, 2);
         const uint32_t backgroundWorkerCount = workerCount - foregroundWorkerCount;
 
+        for (uint32_t workerIndex = 0; workerIndex < kMaxWorkerCount; ++workerIndex)
+        {
+            const bool isForeground = workerIndex < foregroundWorkerCount;
+            const bool isBackground = workerIndex >= 32 && workerIndex < 32 + backgroundWorkerCount;
+            if (!isForeground && !isBackground)
+                continue;
+
+            Worker& worker = m_workers[workerIndex];
+            worker.m_jobSystem = this;
+            worker.m_index = workerIndex;
+            worker.m_threadPoolType = isForeground ? JobThreadPoolType::kForeground : JobThreadPoolType::kBackground;
+            worker.m_random.Reset(worker.m_random.m_state[0] ^ workerIndex, worker.m_random.m_state[1] + workerIndex);
+
+            for (uint32_t priorityIndex = 0; priorityIndex < kPriorityCount; ++priorityIndex)
+            {
+                worker.m_genericJobDeques[priorityIndex].Initialize(kLocalJobQueueCapacity);
+                worker.m_threadPoolJobDeques[priorityIndex].Initialize(kLocalJobQueueCapacity);
+            }
+
+            m_activeWorkerMask |= UINT64_C(1) << workerIndex;
+        }
+
         Worker& mainThread = m_workers[0];
         mainThread.m_threadId = Threading::GetCurrentThreadID();
         mainThread.m_name = "Main Thread";
-        mainThread.m_threadPoolType = JobThreadPoolType::kForeground;
+        m_profiler.RegisterWorker(0, mainThread.m_name);
 
         for (uint32_t workerIndex = 1; workerIndex < kMaxWorkerCount; ++workerIndex)
         {
-            const bool isForeground = workerIndex < foregroundWorkerCount;
-            const bool isBackground = workerIndex >= 32 && workerIndex < 32 + backgroundWorkerCount;
-            if (!isForeground && !isBackground)
+            Worker& worker = m_workers[workerIndex];
+            if (worker.m_jobSystem == nullptr)
                 continue;
 
+            const bool isForeground = worker.m_threadPoolType == JobThreadPoolType::kForeground;
             const auto threadName = isForeground ? Fmt::FixedFormat("Foreground Worker {}", workerIndex)
                                                  : Fmt::FixedFormat("Background Worker {}", workerIndex - 32);
-            const auto threadFunc = [](const uintptr_t workerIndex) {
-                fe_assert_cast<JobSystem*>(Env::GetServiceProvider()->ResolveRequired<IJobSystem>())
-                    ->ThreadProc(static_cast<uint32_t>(workerIndex));
+            const auto threadFunc = [](const uintptr_t workerAddress) {
+                const auto* worker = reinterpret_cast<const Worker*>(workerAddress);
+                worker->m_jobSystem->ThreadProc(worker->m_index);
             };
 
-            Worker& worker = m_workers[workerIndex];
-            worker.m_thread = Threading::CreateThread(threadName, threadFunc, workerIndex);
             worker.m_name = threadName;
-            worker.m_threadPoolType = isForeground ? JobThreadPoolType::kForeground : JobThreadPoolType::kBackground;
+            m_profiler.RegisterWorker(workerIndex, worker.m_name);
+            worker.m_thread = Threading::CreateThread(threadName, threadFunc, reinterpret_cast<uintptr_t>(&worker));
         }
 
         m_foregroundWorkerCount = foregroundWorkerCount;
@@ -284,6 +454,8 @@ namespace FE
     JobSystem::~JobSystem()
     {
         m_shouldExit.store(true, std::memory_order_release);
+        WakeAllWorkers();
+
         for (Worker& worker : m_workers)
         {
             Threading::CloseThread(worker.m_thread);
@@ -297,50 +469,69 @@ namespace FE
         Worker& mainThread = m_workers[0];
         mainThread.m_currentFiber = initialFiber;
         FE_Assert(mainThread.m_threadId == Threading::GetCurrentThreadID());
+        EnterThread(mainThread);
         m_semaphore.Release(m_backgroundWorkerCount + m_foregroundWorkerCount - 1);
         m_fiberPool.Switch(initialFiber, reinterpret_cast<uintptr_t>(this), mainThread.m_name.c_str());
+
+        // The job system has been stopped, the main thread doesn't belong to it anymore.
+        Context::GetThreadState() = {};
     }
 
 
     void JobSystem::Stop()
     {
         m_shouldExit.store(true, std::memory_order_release);
+        WakeAllWorkers();
     }
 
 
     void JobSystem::Schedule(const JobScheduleInfo& info)
     {
-        info.m_job->m_orderHint = m_jobCounter.fetch_add(1, std::memory_order_relaxed);
-
         const FiberAffinityMask affinityMask = info.m_affinityMask;
         const JobPriority priority = info.m_priority;
-        GlobalQueueSet& globalQueueSet = m_globalQueues[festd::to_underlying(priority)];
-        switch (affinityMask)
-        {
-        case FiberAffinityMask::kAll:
-            globalQueueSet.m_jobQueues[festd::to_underlying(JobThreadPoolType::kGeneric)].Enqueue(info.m_job);
-            break;
+        const uint32_t priorityIndex = festd::to_underlying(priority);
 
-        case FiberAffinityMask::kAllForeground:
-            globalQueueSet.m_jobQueues[festd::to_underlying(JobThreadPoolType::kForeground)].Enqueue(info.m_job);
-            break;
+        info.m_job->m_scheduleTicks = m_profiler.IsCapturing() ? Platform::GetTicks() : 0;
 
-        case FiberAffinityMask::kAllBackground:
-            globalQueueSet.m_jobQueues[festd::to_underlying(JobThreadPoolType::kBackground)].Enqueue(info.m_job);
-            break;
+        const JobThreadPoolType threadPoolType = GetThreadPoolType(affinityMask);
+        if (threadPoolType == JobThreadPoolType::kCount)
+        {
+            FE_AssertDebug(Bit::PopCount(festd::to_underlying(affinityMask)) == 1, "Invalid affinity mask");
+            const uint32_t threadIndex = Bit::CountTrailingZeros(festd::to_underlying(affinityMask));
 
-        case FiberAffinityMask::kNone:
-        case FiberAffinityMask::kMainThread:
-        default:
-            {
-                FE_AssertDebug(Bit::PopCount(festd::to_underlying(affinityMask)) == 1, "Invalid affinity mask");
-                const uint32_t threadIndex = Bit::CountTrailingZeros(festd::to_underlying(affinityMask));
+            Worker& worker = m_workers[threadIndex];
+            worker.m_jobQueues[priorityIndex].Enqueue(info.m_job);
+            WakeWorker(affinityMask);
+            return;
+        }
 
-                Worker& worker = m_workers[threadIndex];
-                worker.m_jobQueues[festd::to_underlying(priority)].Enqueue(info.m_job);
-                break;
+        // If we are on a worker thread, push the job to the worker's own deque, so that it stays hot in cache
+        // and other workers can steal it. Otherwise, or if the deque is full, fall back to the global queues.
+        const uint32_t workerIndex = FindWorkerIndex();
+        if (workerIndex != kInvalidIndex)
+        {
+            Worker& worker = m_workers[workerIndex];
+            if (threadPoolType == JobThreadPoolType::kGeneric)
+            {
+                if (worker.m_genericJobDeques[priorityIndex].Push(info.m_job))
+                {
+                    WakeWorker(affinityMask);
+                    return;
+                }
+            }
+            else if (threadPoolType == worker.m_threadPoolType)
+            {
+                if (worker.m_threadPoolJobDeques[priorityIndex].Push(info.m_job))
+                {
+                    WakeWorker(affinityMask);
+                    return;
+                }
             }
         }
+
+        GlobalQueueSet& globalQueueSet = m_globalQueues[priorityIndex];
+        globalQueueSet.m_jobQueues[festd::to_underlying(threadPoolType)].Enqueue(info.m_job);
+        WakeWorker(affinityMask);
     }
 
 
@@ -348,4 +539,10 @@ namespace FE
     {
         return static_cast<FiberAffinityMask>(UINT64_C(1) << GetWorkerIndex());
     }
+
+
+    uint32_t JobSystem::GetWorkerCount() const
+    {
+        return m_foregroundWorkerCount + m_backgroundWorkerCount;
+    }
 } // namespace FE
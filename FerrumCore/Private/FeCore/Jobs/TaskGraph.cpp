@@ -0,0 +1,154 @@
+﻿#include <FeCore/Jobs/TaskGraph.h>
+
+namespace FE
+{
+    void TaskGraph::Node::Execute()
+    {
+        m_job->Execute();
+        m_graph->OnNodeCompleted(*this);
+    }
+
+
+    TaskGraph::TaskGraph(std::pmr::memory_resource* allocator)
+        : m_allocator(allocator ? allocator : std::pmr::get_default_resource())
+        , m_nodes(m_allocator)
+    {
+    }
+
+
+    TaskGraph::~TaskGraph()
+    {
+        FE_Assert(!IsRunning(), "Destroying a task graph that is still running");
+
+        for (Job* job : m_ownedJobs)
+            Memory::DefaultDelete(job);
+    }
+
+
+    TaskGraphNodeHandle TaskGraph::AddNode(Job* job, const FiberAffinityMask affinityMask, const JobPriority priority)
+    {
+        FE_Assert(!IsRunning(), "Cannot modify a running task graph");
+        FE_Assert(job);
+
+        const uint32_t nodeIndex = m_nodes.size();
+        // The node is the job that actually gets scheduled, so it must request the same stack as the wrapped job.
+        Node& node = *new (m_nodes.push_back_uninitialized()) Node(job->GetStackSize());
+        node.m_graph = this;
+        node.m_job = job;
+        node.m_affinityMask = affinityMask;
+        node.m_priority = priority;
+        m_validated = false;
+        return TaskGraphNodeHandle{ nodeIndex };
+    }
+
+
+    void TaskGraph::AddDependency(const TaskGraphNodeHandle node, const TaskGraphNodeHandle dependency)
+    {
+        FE_Assert(!IsRunning(), "Cannot modify a running task graph");
+        FE_Assert(node.m_value < m_nodes.size() && dependency.m_value < m_nodes.size(), "Invalid node");
+        FE_Assert(node != dependency, "A node cannot depend on itself");
+
+        m_nodes[dependency.m_value].m_dependentNodes.push_back(node.m_value);
+        ++m_nodes[node.m_value].m_dependencyCount;
+        m_validated = false;
+    }
+
+
+    bool TaskGraph::HasCycles() const
+    {
+        // Kahn's algorithm: if we can't visit every node in topological order, the rest of them form a cycle.
+        festd::vector<uint32_t> dependencyCounts;
+        festd::vector<uint32_t> readyNodes;
+        dependencyCounts.reserve(m_nodes.size());
+        for (uint32_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex)
+        {
+            dependencyCounts.push_back(m_nodes[nodeIndex].m_dependencyCount);
+            if (m_nodes[nodeIndex].m_dependencyCount == 0)
+                readyNodes.push_back(nodeIndex);
+        }
+
+        uint32_t visitedNodeCount = 0;
+        while (!readyNodes.empty())
+        {
+            const uint32_t nodeIndex = readyNodes.back();
+            readyNodes.pop_back();
+            ++visitedNodeCount;
+
+            for (const uint32_t dependentIndex : m_nodes[nodeIndex].m_dependentNodes)
+            {
+                if (--dependencyCounts[dependentIndex] == 0)
+                    readyNodes.push_back(dependentIndex);
+            }
+        }
+
+        return visitedNodeCount != m_nodes.size();
+    }
+
+
+    void TaskGraph::Schedule(IJobSystem* jobSystem, WaitGroup* completionWaitGroup)
+    {
+        FE_PROFILER_ZONE();
+        FE_Assert(!IsRunning(), "The task graph is already running");
+
+        if (!m_validated)
+        {
+            FE_AssertDebug(!HasCycles(), "The task graph has cycles");
+
+            m_rootNodes.clear();
+            for (uint32_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex)
+            {
+                if (m_nodes[nodeIndex].m_dependencyCount == 0)
+                    m_rootNodes.push_back(nodeIndex);
+            }
+
+            m_validated = true;
+        }
+
+        if (m_nodes.size() == 0)
+        {
+            if (completionWaitGroup)
+                completionWaitGroup->Signal();
+            return;
+        }
+
+        m_jobSystem = jobSystem;
+        m_completionWaitGroup = completionWaitGroup;
+        for (Node& node : m_nodes)
+            node.m_pendingDependencyCount.store(node.m_dependencyCount, std::memory_order_relaxed);
+
+        m_pendingNodeCount.store(m_nodes.size(), std::memory_order_release);
+
+        for (const uint32_t nodeIndex : m_rootNodes)
+            ScheduleNode(m_nodes[nodeIndex]);
+    }
+
+
+    void TaskGraph::Run(IJobSystem* jobSystem)
+    {
+        const Rc completionWaitGroup = WaitGroup::Create();
+        Schedule(jobSystem, completionWaitGroup.Get());
+        completionWaitGroup->Wait();
+    }
+
+
+    void TaskGraph::ScheduleNode(Node& node)
+    {
+        node.Schedule(m_jobSystem, node.m_affinityMask, nullptr, node.m_priority);
+    }
+
+
+    void TaskGraph::OnNodeCompleted(const Node& node)
+    {
+        for (const uint32_t dependentIndex : node.m_dependentNodes)
+        {
+            Node& dependentNode = m_nodes[dependentIndex];
+            if (dependentNode.m_pendingDependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ScheduleNode(dependentNode);
+        }
+
+        // The graph can be destroyed or rescheduled as soon as the counter reaches zero, so copy everything we need first.
+        const Rc completionWaitGroup = m_completionWaitGroup;
+        if (m_pendingNodeCount.fetch_sub(1, std::memory_order_acq_rel) == 1 && completionWaitGroup)
+            completionWaitGroup->Signal();
+    }
+} // namespace FE
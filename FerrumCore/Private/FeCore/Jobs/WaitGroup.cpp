@@ -31,14 +31,13 @@ namespace FE
             return;
         }
 
-        IJobSystem* jobSystemInterface = Env::GetServiceProvider()->ResolveRequired<IJobSystem>();
-        auto* jobSystem = fe_assert_cast<JobSystem*>(jobSystemInterface);
-
+        // The group can be signaled from any thread, e.g. the I/O thread, so each fiber is resumed
+        // in the job system it was waiting in.
         auto entry = reinterpret_cast<FiberWaitEntry*>(lockAndQueue & ~1);
         while (entry)
         {
             auto* next = static_cast<FiberWaitEntry*>(entry->m_next);
-            jobSystem->AddReadyFiber(entry);
+            entry->m_jobSystem->AddReadyFiber(entry);
             entry = next;
         }
 
@@ -118,16 +117,16 @@ namespace FE
         }
 
         auto* queueHead = reinterpret_cast<FiberWaitEntry*>(lockAndQueue & ~1);
-        IJobSystem* jobSystemInterface = Env::GetServiceProvider()->ResolveRequired<IJobSystem>();
-        auto* jobSystem = fe_assert_cast<JobSystem*>(jobSystemInterface);
+        JobSystem* jobSystem = JobSystem::GetCurrent();
+        FE_Assert(jobSystem, "WaitGroup::Wait() can only be called from a fiber");
 
         const uint32_t workerIndex = jobSystem->GetWorkerIndex();
-        FE_Assert(workerIndex != kInvalidIndex, "WaitGroup::Wait() can only be called from a fiber");
 
         const JobSystem::Worker& worker = jobSystem->m_workers[workerIndex];
 
         FiberWaitEntry waitEntry;
         waitEntry.m_next = nullptr;
+        waitEntry.m_jobSystem = jobSystem;
         waitEntry.m_priority = worker.m_priority;
         waitEntry.m_affinityMask = worker.m_affinityMask;
         waitEntry.m_fiber = worker.m_currentFiber;
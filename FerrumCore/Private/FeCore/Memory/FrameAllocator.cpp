@@ -0,0 +1,123 @@
+﻿#include <FeCore/Memory/FrameAllocator.h>
+
+namespace FE::Memory
+{
+    FrameAllocator::FrameAllocator(const uint32_t frameCount, const size_t pageByteSize, const Tag tag)
+        : m_pageAllocator(tag)
+        , m_pageByteSize(pageByteSize)
+        , m_frameCount(frameCount)
+    {
+        // With a single buffer BeginFrame would release the allocations of the frame that is still in use.
+        FE_CoreAssert(frameCount >= 2 && frameCount <= kMaxFrameCount);
+        FE_CoreAssert(pageByteSize > 0);
+
+        m_memoryResource.m_owner = this;
+        for (uint32_t frameIndex = 0; frameIndex < m_frameCount; ++frameIndex)
+            m_frames[frameIndex].m_sharedAllocator = DefaultNew<LinearAllocator>(m_pageByteSize, &m_pageAllocator);
+    }
+
+
+    FrameAllocator::~FrameAllocator()
+    {
+        for (uint32_t frameIndex = 0; frameIndex < m_frameCount; ++frameIndex)
+        {
+            FrameData& frame = m_frames[frameIndex];
+            ResetFrame(frame);
+
+            for (std::atomic<LinearAllocator*>& threadAllocator : frame.m_threadAllocators)
+                DefaultDelete(threadAllocator.load(std::memory_order_acquire));
+
+            DefaultDelete(frame.m_sharedAllocator);
+        }
+    }
+
+
+    void FrameAllocator::ResetFrame(FrameData& frame)
+    {
+        for (std::atomic<LinearAllocator*>& threadAllocator : frame.m_threadAllocators)
+        {
+            if (LinearAllocator* allocator = threadAllocator.load(std::memory_order_acquire))
+                allocator->Clear();
+        }
+
+        frame.m_sharedAllocator->Clear();
+
+        ConcurrentOnceConsumedQueue::Node* node = frame.m_largeAllocations.DequeueAll();
+        while (node)
+        {
+            ConcurrentOnceConsumedQueue::Node* next = node->m_next;
+            DefaultFree(node);
+            node = next;
+        }
+    }
+
+
+    void FrameAllocator::BeginFrame()
+    {
+        FE_PROFILER_ZONE();
+
+        const uint64_t frameIndex = m_frameIndex.load(std::memory_order_relaxed) + 1;
+        ResetFrame(m_frames[frameIndex % m_frameCount]);
+        m_frameIndex.store(frameIndex, std::memory_order_release);
+    }
+
+
+    void FrameAllocator::FreeUnusedMemory()
+    {
+        FE_PROFILER_ZONE();
+
+        for (uint32_t frameIndex = 0; frameIndex < m_frameCount; ++frameIndex)
+        {
+            FrameData& frame = m_frames[frameIndex];
+            for (std::atomic<LinearAllocator*>& threadAllocator : frame.m_threadAllocators)
+            {
+                if (LinearAllocator* allocator = threadAllocator.load(std::memory_order_acquire))
+                    allocator->FreeUnusedMemory();
+            }
+
+            frame.m_sharedAllocator->FreeUnusedMemory();
+        }
+    }
+
+
+    LinearAllocator* FrameAllocator::CreateThreadAllocator(FrameData& frame, const uint32_t slot)
+    {
+        auto* allocator = DefaultNew<LinearAllocator>(m_pageByteSize, &m_pageAllocator);
+        frame.m_threadAllocators[slot].store(allocator, std::memory_order_release);
+        return allocator;
+    }
+
+
+    void* FrameAllocator::AllocateLarge(FrameData& frame, const size_t byteSize, const size_t byteAlignment)
+    {
+        // The allocation is linked into the frame's list through a header in front of it.
+        const size_t headerSize = Math::Max(byteAlignment, kDefaultAlignment);
+        auto* node = static_cast<ConcurrentOnceConsumedQueue::Node*>(DefaultAllocate(byteSize + headerSize, headerSize));
+        frame.m_largeAllocations.Enqueue(node);
+        return reinterpret_cast<std::byte*>(node) + headerSize;
+    }
+
+
+    void* FrameAllocator::Allocate(const size_t byteSize, const size_t byteAlignment)
+    {
+        FrameData& frame = m_frames[m_frameIndex.load(std::memory_order_acquire) % m_frameCount];
+
+        // Don't waste the rest of a page on an allocation that would take a large part of a new one.
+        if (AlignUp(kDefaultAlignment, byteAlignment) + byteSize > m_pageByteSize / 4) [[unlikely]]
+            return AllocateLarge(frame, byteSize, byteAlignment);
+
+        const uint32_t slot = Internal::GetThreadSlot();
+        if (slot == kInvalidIndex) [[unlikely]]
+        {
+            std::lock_guard lock{ frame.m_sharedAllocatorLock };
+            return frame.m_sharedAllocator->allocate(byteSize, byteAlignment);
+        }
+
+        // Only this thread can create the allocator for its slot.
+        LinearAllocator* allocator = frame.m_threadAllocators[slot].load(std::memory_order_relaxed);
+        if (allocator == nullptr) [[unlikely]]
+            allocator = CreateThreadAllocator(frame, slot);
+
+        return allocator->allocate(byteSize, byteAlignment);
+    }
+} // namespace FE::Memory
@@ -14,54 +14,170 @@ namespace FE::Memory
 {
     namespace
     {
-        struct MemoryState final
+        constexpr uint32_t kDebugHeapArenaCount = 8;
+        constexpr uint32_t kDebugHeapCallStackDepth = 32;
+        constexpr uint32_t kDefaultCallStackSampleRate = 16;
+        constexpr size_t kDefaultCallStackMinByteSize = 64 * 1024;
+
+
+        void PrintCallStack(const Trace::CallStack callstack)
+        {
+            void** frames = callstack.GetFrames();
+            if (frames[0] == nullptr)
+            {
+                Console::Write("Call stack was not captured, use SetDebugHeapCallStackSampling() to capture more\n");
+                return;
+            }
+
+            for (uint32_t frameIndex = 0; frames[frameIndex] != nullptr; ++frameIndex)
+            {
+                const Trace::SymbolInfo symbolInfo = Trace::SymbolInfo::Resolve(frames[frameIndex]);
+                Console::Write(Fmt::FixedFormatSized<512>("{}\t[{}]\t{}:{}: {}\n",
+                                                          symbolInfo.m_moduleName,
+                                                          symbolInfo.m_address,
+                                                          symbolInfo.m_fileName,
+                                                          symbolInfo.m_lineNumber,
+                                                          symbolInfo.m_symbolName));
+            }
+        }
+
+
+        //
+        // The debug heap is not thread-safe, so instead of putting a single heap behind a global lock we split
+        // the address space into several heaps. Threads are assigned to the arenas round-robin, so they only contend
+        // when they happen to share an arena or when memory is freed on a different thread than it was allocated on.
+        // Freed blocks are never cached or queued, not even the remote frees, since that would hide use-after-free.
+        //
+        struct alignas(kCacheLineSize) DebugHeapArena final
         {
             Threading::SpinLock m_lock;
-            DebugHeap* m_debugHeap = nullptr;
+            DebugHeap* m_heap = nullptr;
+        };
+
+
+        struct DebugHeapThreadState final
+        {
+            uint32_t m_arenaIndex = kInvalidIndex;
+            uint32_t m_allocationCounter = 0;
+        };
+
+
+        thread_local DebugHeapThreadState GTLSDebugHeapThreadState;
+
+
+        struct MemoryState final
+        {
+            DebugHeapArena m_debugHeapArenas[kDebugHeapArenaCount];
+            bool m_debugHeapEnabled = false;
+            std::atomic<uint32_t> m_nextArenaIndex = 0;
+            std::atomic<uint32_t> m_callStackSampleRate = kDefaultCallStackSampleRate;
+            std::atomic<size_t> m_callStackMinByteSize = kDefaultCallStackMinByteSize;
 
             MemoryState()
             {
                 constexpr size_t kGigabyte = 0x40000000;
                 if (Build::IsDevelopment())
-                    m_debugHeap = DebugHeapInit(8 * kGigabyte);
+                {
+                    for (DebugHeapArena& arena : m_debugHeapArenas)
+                        arena.m_heap = DebugHeapInit(8 * kGigabyte / kDebugHeapArenaCount);
+
+                    m_debugHeapEnabled = true;
+                }
             }
 
             ~MemoryState()
             {
-                if (m_debugHeap)
+                if (!m_debugHeapEnabled)
+                    return;
+
+                for (const DebugHeapArena& arena : m_debugHeapArenas)
                 {
                     DebugHeapWalk(
-                        m_debugHeap,
+                        arena.m_heap,
                         [](void* ptr, const size_t size, const uint32_t callstackHandle, void*) {
-                            const Trace::CallStack callstack{ callstackHandle };
-
                             Console::SetTextColor(Console::Color::kRed);
                             Console::Write(
                                 Fmt::FixedFormat("Memory leak detected: {}; {} bytes\n", reinterpret_cast<uintptr_t>(ptr), size));
-
-                            void** frames = callstack.GetFrames();
-                            for (uint32_t frameIndex = 0; frames[frameIndex] != nullptr; ++frameIndex)
-                            {
-                                const Trace::SymbolInfo symbolInfo = Trace::SymbolInfo::Resolve(frames[frameIndex]);
-                                Console::Write(Fmt::FixedFormatSized<512>("{}\t[{}]\t{}:{}: {}\n",
-                                                                          symbolInfo.m_moduleName,
-                                                                          symbolInfo.m_address,
-                                                                          symbolInfo.m_fileName,
-                                                                          symbolInfo.m_lineNumber,
-                                                                          symbolInfo.m_symbolName));
-                            }
-
+                            PrintCallStack(Trace::CallStack{ callstackHandle });
                             Console::SetTextColor(Console::Color::kDefault);
                         },
                         nullptr);
-                    DebugHeapDestroy(m_debugHeap);
                 }
+
+                // The console is buffered, make sure the report is written before the heaps are destroyed.
+                Console::Flush();
+
+                for (const DebugHeapArena& arena : m_debugHeapArenas)
+                    DebugHeapDestroy(arena.m_heap);
+            }
+
+            DebugHeapArena& GetOwnerArena(const void* ptr)
+            {
+                for (DebugHeapArena& arena : m_debugHeapArenas)
+                {
+                    if (DebugHeapOwns(arena.m_heap, const_cast<void*>(ptr)))
+                        return arena;
+                }
+
+                FE_CoreAssert(false, "The pointer was not allocated from the debug heap");
+                return m_debugHeapArenas[0];
+            }
+
+            void* Allocate(const size_t byteSize, const size_t byteAlignment, const Trace::CallStack callstack)
+            {
+                DebugHeapThreadState& threadState = GTLSDebugHeapThreadState;
+                if (threadState.m_arenaIndex == kInvalidIndex)
+                    threadState.m_arenaIndex = m_nextArenaIndex.fetch_add(1, std::memory_order_relaxed) % kDebugHeapArenaCount;
+
+                // If our arena is full, try the others before giving up.
+                for (uint32_t arenaOffset = 0; arenaOffset < kDebugHeapArenaCount; ++arenaOffset)
+                {
+                    DebugHeapArena& arena = m_debugHeapArenas[(threadState.m_arenaIndex + arenaOffset) % kDebugHeapArenaCount];
+                    std::lock_guard lock{ arena.m_lock };
+                    if (void* ptr = DebugHeapAllocate(arena.m_heap, byteSize, byteAlignment, callstack.m_value))
+                        return ptr;
+                }
+
+                return nullptr;
+            }
+
+            void Free(void* ptr)
+            {
+                DebugHeapArena& arena = GetOwnerArena(ptr);
+                std::lock_guard lock{ arena.m_lock };
+                DebugHeapFree(arena.m_heap, ptr);
+            }
+
+            size_t GetAllocatedSize(const void* ptr)
+            {
+                DebugHeapArena& arena = GetOwnerArena(ptr);
+                std::lock_guard lock{ arena.m_lock };
+                return DebugHeapGetAllocSize(arena.m_heap, const_cast<void*>(ptr));
             }
         };
 
         MemoryState* GMemoryState;
 
 
+        //! @brief Capture the call stack of the allocation if it is sampled.
+        //!
+        //! Capturing call stacks is the most expensive part of the debug heap, so we only do it for every Nth allocation
+        //! made on a thread and for all the large allocations.
+        FE_FORCE_INLINE Trace::CallStack CaptureAllocationCallStack(const size_t byteSize)
+        {
+            DebugHeapThreadState& threadState = GTLSDebugHeapThreadState;
+            const uint32_t sampleRate = GMemoryState->m_callStackSampleRate.load(std::memory_order_relaxed);
+            const size_t minByteSize = GMemoryState->m_callStackMinByteSize.load(std::memory_order_relaxed);
+
+            if (++threadState.m_allocationCounter >= sampleRate)
+                threadState.m_allocationCounter = 0;
+            else if (byteSize < minByteSize)
+                return Trace::CallStack::GetEmpty();
+
+            return Trace::CallStack::Capture(kDebugHeapCallStackDepth, Trace::CallStack::kDefaultSkipFrames + 2);
+        }
+
+
         constexpr uint32_t kMemoryProfilerCallstackDepth = 32;
 
 #if FE_PLATFORM_WINDOWS
@@ -71,17 +187,37 @@ namespace FE::Memory
                 reinterpret_cast<decltype(&VirtualAlloc2)>(GetProcAddress(GetModuleHandleW(L"kernelbase.dll"), "VirtualAlloc2"));
             return virtualAlloc2;
         }
+#elif FE_PLATFORM_LINUX
+        void* MapAlignedVirtual(const size_t byteSize, const size_t byteAlignment, const int32_t protection)
+        {
+            // mmap() has no alignment parameter, so we over-reserve and unmap the unaligned head and tail.
+            const size_t reservationSize = byteSize + byteAlignment;
+            void* reservation = mmap(nullptr, reservationSize, protection, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (reservation == MAP_FAILED)
+                return nullptr;
+
+            const uintptr_t reservationStart = reinterpret_cast<uintptr_t>(reservation);
+            const uintptr_t alignedStart = AlignUp(reservationStart, byteAlignment);
+            const uintptr_t alignedEnd = alignedStart + byteSize;
+            const uintptr_t reservationEnd = reservationStart + reservationSize;
+
+            if (alignedStart > reservationStart)
+                munmap(reservation, alignedStart - reservationStart);
+            if (reservationEnd > alignedEnd)
+                munmap(reinterpret_cast<void*>(alignedEnd), reservationEnd - alignedEnd);
+
+            return reinterpret_cast<void*>(alignedStart);
+        }
 #endif
 
         void* MallocImpl(const size_t byteSize)
         {
             if (Build::IsDevelopment())
             {
-                if (GMemoryState->m_debugHeap)
+                if (GMemoryState->m_debugHeapEnabled)
                 {
-                    std::lock_guard lock{ GMemoryState->m_lock };
-                    const Trace::CallStack callstack = Trace::CallStack::Capture(32, Trace::CallStack::kDefaultSkipFrames + 2);
-                    return DebugHeapAllocate(GMemoryState->m_debugHeap, byteSize, kDefaultAlignment, callstack.m_value);
+                    const Trace::CallStack callstack = CaptureAllocationCallStack(byteSize);
+                    return GMemoryState->Allocate(byteSize, kDefaultAlignment, callstack);
                 }
             }
 
@@ -92,11 +228,10 @@ namespace FE::Memory
         {
             if (Build::IsDevelopment())
             {
-                if (GMemoryState->m_debugHeap)
+                if (GMemoryState->m_debugHeapEnabled)
                 {
-                    std::lock_guard lock{ GMemoryState->m_lock };
-                    const Trace::CallStack callstack = Trace::CallStack::Capture(32, Trace::CallStack::kDefaultSkipFrames + 2);
-                    return DebugHeapAllocate(GMemoryState->m_debugHeap, byteSize, byteAlignment, callstack.m_value);
+                    const Trace::CallStack callstack = CaptureAllocationCallStack(byteSize);
+                    return GMemoryState->Allocate(byteSize, byteAlignment, callstack);
                 }
             }
 
@@ -107,26 +242,25 @@ namespace FE::Memory
         {
             if (Build::IsDevelopment())
             {
-                if (GMemoryState->m_debugHeap)
+                if (GMemoryState->m_debugHeapEnabled)
                 {
-                    std::lock_guard lock{ GMemoryState->m_lock };
                     if (byteSize == 0)
                     {
                         if (ptr != nullptr)
-                            DebugHeapFree(GMemoryState->m_debugHeap, ptr);
+                            GMemoryState->Free(ptr);
 
                         return nullptr;
                     }
 
-                    const Trace::CallStack callstack = Trace::CallStack::Capture(32, Trace::CallStack::kDefaultSkipFrames + 2);
+                    const Trace::CallStack callstack = CaptureAllocationCallStack(byteSize);
 
                     if (ptr == nullptr)
-                        return DebugHeapAllocate(GMemoryState->m_debugHeap, byteSize, kDefaultAlignment, callstack.m_value);
+                        return GMemoryState->Allocate(byteSize, kDefaultAlignment, callstack);
 
-                    const size_t oldSize = DebugHeapGetAllocSize(GMemoryState->m_debugHeap, ptr);
-                    void* newPtr = DebugHeapAllocate(GMemoryState->m_debugHeap, byteSize, kDefaultAlignment, callstack.m_value);
+                    const size_t oldSize = GMemoryState->GetAllocatedSize(ptr);
+                    void* newPtr = GMemoryState->Allocate(byteSize, kDefaultAlignment, callstack);
                     memcpy(newPtr, ptr, Math::Min(oldSize, byteSize));
-                    DebugHeapFree(GMemoryState->m_debugHeap, ptr);
+                    GMemoryState->Free(ptr);
                     return newPtr;
                 }
             }
@@ -138,13 +272,12 @@ namespace FE::Memory
         {
             if (Build::IsDevelopment())
             {
-                if (GMemoryState->m_debugHeap)
+                if (GMemoryState->m_debugHeapEnabled)
                 {
                     if (ptr == nullptr)
                         return;
 
-                    std::lock_guard lock{ GMemoryState->m_lock };
-                    DebugHeapFree(GMemoryState->m_debugHeap, ptr);
+                    GMemoryState->Free(ptr);
                     return;
                 }
             }
@@ -156,11 +289,8 @@ namespace FE::Memory
         {
             if (Build::IsDevelopment())
             {
-                if (GMemoryState->m_debugHeap)
-                {
-                    std::unique_lock lock{ GMemoryState->m_lock };
-                    return DebugHeapGetAllocSize(GMemoryState->m_debugHeap, const_cast<void*>(ptr));
-                }
+                if (GMemoryState->m_debugHeapEnabled)
+                    return GMemoryState->GetAllocatedSize(ptr);
             }
 
             return mi_usable_size(ptr);
@@ -171,26 +301,17 @@ namespace FE::Memory
             if (!Build::IsDevelopment())
                 return;
 
-            if (!GMemoryState->m_debugHeap)
+            if (!GMemoryState->m_debugHeapEnabled)
                 return;
 
-            std::unique_lock lock{ GMemoryState->m_lock };
+            DebugHeapArena& arena = GMemoryState->GetOwnerArena(ptr);
+            std::unique_lock lock{ arena.m_lock };
 
-            const Trace::CallStack callstack{ DebugHeapGetCallstackIfInvalid(GMemoryState->m_debugHeap, const_cast<void*>(ptr)) };
+            const Trace::CallStack callstack{ DebugHeapGetCallstackIfInvalid(arena.m_heap, const_cast<void*>(ptr)) };
 
             if (callstack.IsValid())
             {
-                void** frames = callstack.GetFrames();
-                for (uint32_t frameIndex = 0; frames[frameIndex] != nullptr; ++frameIndex)
-                {
-                    const Trace::SymbolInfo symbolInfo = Trace::SymbolInfo::Resolve(frames[frameIndex]);
-                    Console::Write(Fmt::FixedFormatSized<512>("{}\t[{}]\t{}:{}: {}\n",
-                                                              symbolInfo.m_moduleName,
-                                                              symbolInfo.m_address,
-                                                              symbolInfo.m_fileName,
-                                                              symbolInfo.m_lineNumber,
-                                                              symbolInfo.m_symbolName));
-                }
+                PrintCallStack(callstack);
 
                 // Flush might allocate memory, so we need to unlock the heap lock.
                 lock.unlock();
@@ -227,6 +348,9 @@ namespace FE::Memory
 
             spec.m_pageSize = info.dwPageSize;
             spec.m_granularity = info.dwAllocationGranularity;
+#elif FE_PLATFORM_LINUX
+            spec.m_pageSize = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+            spec.m_granularity = spec.m_pageSize;
 #else
 #    error Not implemented :(
 #endif
@@ -244,6 +368,9 @@ namespace FE::Memory
 
 #if FE_PLATFORM_WINDOWS
         return VirtualAlloc(nullptr, byteSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif FE_PLATFORM_LINUX
+        void* ptr = mmap(nullptr, byteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
 #else
 #    error Not implemented :(
 #endif
@@ -266,6 +393,8 @@ namespace FE::Memory
 
         return GetVirtualAlloc2()(
             GetCurrentProcess(), nullptr, byteSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, &extendedParameter, 1);
+#elif FE_PLATFORM_LINUX
+        return MapAlignedVirtual(byteSize, byteAlignment, PROT_READ | PROT_WRITE);
 #else
 #    error Not implemented :(
 #endif
@@ -276,6 +405,9 @@ namespace FE::Memory
     {
 #if FE_PLATFORM_WINDOWS
         return VirtualAlloc(nullptr, byteSize, MEM_RESERVE, PAGE_READWRITE);
+#elif FE_PLATFORM_LINUX
+        void* ptr = mmap(nullptr, byteSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
 #else
 #    error Not implemented :(
 #endif
@@ -297,6 +429,8 @@ namespace FE::Memory
         extendedParameter.Pointer = &requirements;
 
         return GetVirtualAlloc2()(GetCurrentProcess(), nullptr, byteSize, MEM_RESERVE, PAGE_READWRITE, &extendedParameter, 1);
+#elif FE_PLATFORM_LINUX
+        return MapAlignedVirtual(byteSize, byteAlignment, PROT_NONE);
 #else
 #    error Not implemented :(
 #endif
@@ -307,6 +441,9 @@ namespace FE::Memory
     {
 #if FE_PLATFORM_WINDOWS
         VirtualAlloc(ptr, byteSize, MEM_COMMIT, PAGE_READWRITE);
+#elif FE_PLATFORM_LINUX
+        const int32_t result = mprotect(ptr, byteSize, PROT_READ | PROT_WRITE);
+        FE_CoreAssert(result == 0);
 #else
 #    error Not implemented :(
 #endif
@@ -317,6 +454,8 @@ namespace FE::Memory
     {
 #if FE_PLATFORM_WINDOWS
         VirtualFree(ptr, 0, MEM_RELEASE);
+#elif FE_PLATFORM_LINUX
+        munmap(ptr, byteSize);
 #else
 #    error Not implemented :(
 #endif
@@ -346,6 +485,26 @@ namespace FE::Memory
         DWORD oldProtect = 0;
         const BOOL result = VirtualProtect(ptr, byteSize, osProtect, &oldProtect);
         FE_CoreAssert(result);
+#elif FE_PLATFORM_LINUX
+        int32_t osProtect = PROT_NONE;
+        switch (protection)
+        {
+        case ProtectFlags::kNone:
+            osProtect = PROT_NONE;
+            break;
+        case ProtectFlags::kReadOnly:
+            osProtect = PROT_READ;
+            break;
+        case ProtectFlags::kReadWrite:
+            osProtect = PROT_READ | PROT_WRITE;
+            break;
+        default:
+            FE_DebugBreak();
+            break;
+        }
+
+        const int32_t result = mprotect(ptr, byteSize, osProtect);
+        FE_CoreAssert(result == 0);
 #else
 #    error Not implemented :(
 #endif
@@ -396,6 +555,14 @@ namespace FE::Memory
     }
 
 
+    void SetDebugHeapCallStackSampling(const uint32_t sampleRate, const size_t minByteSize)
+    {
+        FE_CoreAssert(sampleRate > 0);
+        GMemoryState->m_callStackSampleRate.store(sampleRate, std::memory_order_relaxed);
+        GMemoryState->m_callStackMinByteSize.store(minByteSize, std::memory_order_relaxed);
+    }
+
+
     TLSFAllocator::TLSFAllocator(void* memory, const size_t size)
     {
         if (memory == nullptr)
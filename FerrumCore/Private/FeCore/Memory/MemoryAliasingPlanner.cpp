@@ -0,0 +1,108 @@
+﻿#include <FeCore/Memory/MemoryAliasingPlanner.h>
+
+namespace FE::Memory
+{
+    MemoryAliasingPlanner::MemoryAliasingPlanner(std::pmr::memory_resource* allocator)
+        : m_resources(allocator)
+        , m_placementOrder(allocator)
+        , m_occupiedRanges(allocator)
+    {
+    }
+
+
+    uint32_t MemoryAliasingPlanner::AddResource(const uint64_t byteSize, const uint64_t byteAlignment, const uint32_t firstUse,
+                                                const uint32_t lastUse)
+    {
+        FE_Assert(byteAlignment > 0 && (byteAlignment & (byteAlignment - 1)) == 0, "Alignment must be a power of two");
+        FE_Assert(firstUse <= lastUse);
+
+        Resource& resource = m_resources.push_back();
+        resource.m_byteSize = byteSize;
+        resource.m_byteAlignment = byteAlignment;
+        resource.m_firstUse = firstUse;
+        resource.m_lastUse = lastUse;
+
+        m_unaliasedByteSize = AlignUp(m_unaliasedByteSize, byteAlignment) + byteSize;
+        m_planned = false;
+        return m_resources.size() - 1;
+    }
+
+
+    void MemoryAliasingPlanner::Plan()
+    {
+        FE_PROFILER_ZONE();
+
+        m_placementOrder.clear();
+        for (uint32_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+            m_placementOrder.push_back(resourceIndex);
+
+        // Place large resources first, small ones are more likely to fit into the gaps between them.
+        festd::sort(m_placementOrder, [this](const uint32_t lhsIndex, const uint32_t rhsIndex) {
+            const Resource& lhs = m_resources[lhsIndex];
+            const Resource& rhs = m_resources[rhsIndex];
+            if (lhs.m_byteSize != rhs.m_byteSize)
+                return lhs.m_byteSize > rhs.m_byteSize;
+            if (lhs.m_firstUse != rhs.m_firstUse)
+                return lhs.m_firstUse < rhs.m_firstUse;
+            return lhsIndex < rhsIndex;
+        });
+
+        m_byteSize = 0;
+        for (uint32_t placedCount = 0; placedCount < m_placementOrder.size(); ++placedCount)
+        {
+            Resource& resource = m_resources[m_placementOrder[placedCount]];
+
+            m_occupiedRanges.clear();
+            for (uint32_t placedIndex = 0; placedIndex < placedCount; ++placedIndex)
+            {
+                const Resource& placedResource = m_resources[m_placementOrder[placedIndex]];
+                if (placedResource.m_firstUse > resource.m_lastUse || resource.m_firstUse > placedResource.m_lastUse)
+                    continue;
+
+                m_occupiedRanges.push_back({ placedResource.m_offset, placedResource.m_offset + placedResource.m_byteSize });
+            }
+
+            festd::sort(m_occupiedRanges, [](const Range& lhs, const Range& rhs) {
+                return lhs.m_begin < rhs.m_begin;
+            });
+
+            // Find the smallest gap between the memory ranges occupied by the resources alive at the same time.
+            // The occupied ranges can overlap each other, since they are not necessarily alive at the same time.
+            uint64_t bestOffset = Constants::kMaxU64;
+            uint64_t bestGapSize = Constants::kMaxU64;
+            uint64_t gapBegin = 0;
+            for (const Range& range : m_occupiedRanges)
+            {
+                const uint64_t candidateOffset = AlignUp(gapBegin, resource.m_byteAlignment);
+                if (range.m_begin >= candidateOffset + resource.m_byteSize)
+                {
+                    const uint64_t gapSize = range.m_begin - gapBegin;
+                    if (gapSize < bestGapSize)
+                    {
+                        bestOffset = candidateOffset;
+                        bestGapSize = gapSize;
+                    }
+                }
+
+                gapBegin = Math::Max(gapBegin, range.m_end);
+            }
+
+            if (bestOffset == Constants::kMaxU64)
+                bestOffset = AlignUp(gapBegin, resource.m_byteAlignment);
+
+            resource.m_offset = bestOffset;
+            m_byteSize = Math::Max(m_byteSize, bestOffset + resource.m_byteSize);
+        }
+
+        m_planned = true;
+    }
+
+
+    void MemoryAliasingPlanner::Clear()
+    {
+        m_resources.clear();
+        m_byteSize = 0;
+        m_unaliasedByteSize = 0;
+        m_planned = false;
+    }
+} // namespace FE::Memory
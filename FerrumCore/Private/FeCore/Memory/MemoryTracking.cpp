@@ -0,0 +1,290 @@
+﻿#include <FeCore/Memory/Memory.h>
+
+namespace FE::Memory
+{
+    namespace
+    {
+        constexpr uint32_t kTagCount = festd::to_underlying(Tag::kCount);
+        constexpr uint32_t kThreadSlotMaskCount = Internal::kMaxThreadSlotCount / 64;
+
+        // The per-thread byte counters are added to the shared ones when they get this far from zero.
+        constexpr int64_t kFlushByteSize = 64 * 1024;
+
+        std::atomic<uint64_t> GThreadSlotMasks[kThreadSlotMaskCount] = {};
+
+
+        struct ThreadSlot final
+        {
+            uint32_t m_index = kInvalidIndex;
+            bool m_initialized = false;
+
+            ~ThreadSlot()
+            {
+                if (m_index == kInvalidIndex)
+                    return;
+
+                const uint64_t bit = UINT64_C(1) << (m_index % 64);
+                GThreadSlotMasks[m_index / 64].fetch_and(~bit, std::memory_order_release);
+
+                // Keep m_initialized, so that if something allocates after this point it doesn't take the slot again.
+                m_index = kInvalidIndex;
+            }
+
+            void Acquire()
+            {
+                m_initialized = true;
+                for (uint32_t maskIndex = 0; maskIndex < kThreadSlotMaskCount; ++maskIndex)
+                {
+                    std::atomic<uint64_t>& mask = GThreadSlotMasks[maskIndex];
+                    uint64_t value = mask.load(std::memory_order_relaxed);
+                    while (value != Constants::kMaxU64)
+                    {
+                        const uint32_t bitIndex = Bit::CountTrailingZeros(~value);
+                        if (mask.compare_exchange_weak(value, value | (UINT64_C(1) << bitIndex), std::memory_order_acquire))
+                        {
+                            m_index = maskIndex * 64 + bitIndex;
+                            return;
+                        }
+                    }
+                }
+            }
+        };
+
+        thread_local ThreadSlot GTLSThreadSlot;
+
+
+        // Only written by the thread that owns the slot, so the counters are updated without read-modify-write operations.
+        // When a thread exits, the next thread that takes the slot continues with the same counters.
+        struct alignas(kCacheLineSize) ThreadTagCounters final
+        {
+            std::atomic<int64_t> m_pendingByteSize[kTagCount];
+            std::atomic<uint64_t> m_allocationCount[kTagCount];
+            std::atomic<uint64_t> m_allocatedByteSize[kTagCount];
+        };
+
+
+        struct alignas(kCacheLineSize) TagState final
+        {
+            std::atomic<int64_t> m_liveByteSize;
+            std::atomic<int64_t> m_peakByteSize;
+
+            // Updated directly by the threads that didn't get a slot.
+            std::atomic<uint64_t> m_allocationCount;
+            std::atomic<uint64_t> m_allocatedByteSize;
+
+            std::atomic<size_t> m_budgetByteSizes[2];
+            std::atomic<bool> m_budgetExceeded[2];
+            std::atomic<BudgetCallback> m_budgetCallback;
+            std::atomic<void*> m_budgetUserData;
+        };
+
+
+        ThreadTagCounters GThreadTagCounters[Internal::kMaxThreadSlotCount];
+        TagState GTagStates[kTagCount];
+
+
+        FE_FORCE_INLINE void Increment(std::atomic<uint64_t>& counter, const uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+
+        void CheckBudget(const Tag tag, TagState& state, const BudgetLevel level, const int64_t liveByteSize)
+        {
+            const uint32_t levelIndex = festd::to_underlying(level);
+            const size_t limit = state.m_budgetByteSizes[levelIndex].load(std::memory_order_relaxed);
+            if (limit == 0)
+                return;
+
+            std::atomic<bool>& exceeded = state.m_budgetExceeded[levelIndex];
+            if (liveByteSize <= static_cast<int64_t>(limit))
+            {
+                if (exceeded.load(std::memory_order_relaxed))
+                    exceeded.store(false, std::memory_order_relaxed);
+
+                return;
+            }
+
+            // Only the thread that sets the flag invokes the callback.
+            if (exceeded.load(std::memory_order_relaxed) || exceeded.exchange(true, std::memory_order_acq_rel))
+                return;
+
+            const BudgetCallback callback = state.m_budgetCallback.load(std::memory_order_acquire);
+            if (callback)
+                callback(tag, level, liveByteSize, state.m_budgetUserData.load(std::memory_order_relaxed));
+        }
+
+
+        void Flush(const Tag tag, const int64_t byteSize)
+        {
+            TagState& state = GTagStates[festd::to_underlying(tag)];
+            const int64_t liveByteSize = state.m_liveByteSize.fetch_add(byteSize, std::memory_order_relaxed) + byteSize;
+
+            int64_t peakByteSize = state.m_peakByteSize.load(std::memory_order_relaxed);
+            while (liveByteSize > peakByteSize)
+            {
+                if (state.m_peakByteSize.compare_exchange_weak(peakByteSize, liveByteSize, std::memory_order_relaxed))
+                    break;
+            }
+
+            CheckBudget(tag, state, BudgetLevel::kSoft, liveByteSize);
+            CheckBudget(tag, state, BudgetLevel::kHard, liveByteSize);
+        }
+
+
+        FE_FORCE_INLINE void AddPendingByteSize(ThreadTagCounters& counters, const Tag tag, const int64_t byteSize)
+        {
+            std::atomic<int64_t>& pending = counters.m_pendingByteSize[festd::to_underlying(tag)];
+            const int64_t pendingByteSize = pending.load(std::memory_order_relaxed) + byteSize;
+            if (pendingByteSize < kFlushByteSize && pendingByteSize > -kFlushByteSize) [[likely]]
+            {
+                pending.store(pendingByteSize, std::memory_order_relaxed);
+                return;
+            }
+
+            Flush(tag, pendingByteSize);
+            pending.store(0, std::memory_order_relaxed);
+        }
+    } // namespace
+
+
+    uint32_t Internal::GetThreadSlot()
+    {
+        ThreadSlot& slot = GTLSThreadSlot;
+        if (!slot.m_initialized) [[unlikely]]
+            slot.Acquire();
+
+        return slot.m_index;
+    }
+
+
+    const char* GetTagName(const Tag tag)
+    {
+        switch (tag)
+        {
+        case Tag::kUntagged:
+            return "Untagged";
+        case Tag::kJobs:
+            return "Jobs";
+        case Tag::kIO:
+            return "IO";
+        case Tag::kAssets:
+            return "Assets";
+        case Tag::kECS:
+            return "ECS";
+        case Tag::kFrameGraph:
+            return "FrameGraph";
+        case Tag::kGraphics:
+            return "Graphics";
+        default:
+            FE_DebugBreak();
+            return "Unknown";
+        }
+    }
+
+
+    void TrackAllocation(const Tag tag, const size_t byteSize)
+    {
+        const uint32_t tagIndex = festd::to_underlying(tag);
+        FE_CoreAssertDebug(tagIndex < kTagCount);
+
+        const uint32_t slot = Internal::GetThreadSlot();
+        if (slot == kInvalidIndex) [[unlikely]]
+        {
+            TagState& state = GTagStates[tagIndex];
+            state.m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+            state.m_allocatedByteSize.fetch_add(byteSize, std::memory_order_relaxed);
+            Flush(tag, static_cast<int64_t>(byteSize));
+            return;
+        }
+
+        ThreadTagCounters& counters = GThreadTagCounters[slot];
+        Increment(counters.m_allocationCount[tagIndex], 1);
+        Increment(counters.m_allocatedByteSize[tagIndex], byteSize);
+        AddPendingByteSize(counters, tag, static_cast<int64_t>(byteSize));
+    }
+
+
+    void TrackFree(const Tag tag, const size_t byteSize)
+    {
+        FE_CoreAssertDebug(festd::to_underlying(tag) < kTagCount);
+
+        const uint32_t slot = Internal::GetThreadSlot();
+        if (slot == kInvalidIndex) [[unlikely]]
+        {
+            Flush(tag, -static_cast<int64_t>(byteSize));
+            return;
+        }
+
+        AddPendingByteSize(GThreadTagCounters[slot], tag, -static_cast<int64_t>(byteSize));
+    }
+
+
+    TagStats GetTagStats(const Tag tag)
+    {
+        const uint32_t tagIndex = festd::to_underlying(tag);
+        FE_CoreAssert(tagIndex < kTagCount);
+
+        const TagState& state = GTagStates[tagIndex];
+
+        TagStats stats;
+        stats.m_liveByteSize = state.m_liveByteSize.load(std::memory_order_relaxed);
+        stats.m_allocationCount = state.m_allocationCount.load(std::memory_order_relaxed);
+        stats.m_allocatedByteSize = state.m_allocatedByteSize.load(std::memory_order_relaxed);
+
+        for (const ThreadTagCounters& counters : GThreadTagCounters)
+        {
+            stats.m_liveByteSize += counters.m_pendingByteSize[tagIndex].load(std::memory_order_relaxed);
+            stats.m_allocationCount += counters.m_allocationCount[tagIndex].load(std::memory_order_relaxed);
+            stats.m_allocatedByteSize += counters.m_allocatedByteSize[tagIndex].load(std::memory_order_relaxed);
+        }
+
+        stats.m_peakByteSize = Math::Max(state.m_peakByteSize.load(std::memory_order_relaxed), stats.m_liveByteSize);
+        return stats;
+    }
+
+
+    void SetBudget(const Tag tag, const Budget& budget)
+    {
+        const uint32_t tagIndex = festd::to_underlying(tag);
+        FE_CoreAssert(tagIndex < kTagCount);
+        FE_CoreAssert(budget.m_hardByteSize == 0 || budget.m_softByteSize <= budget.m_hardByteSize);
+
+        TagState& state = GTagStates[tagIndex];
+        state.m_budgetUserData.store(budget.m_userData, std::memory_order_relaxed);
+        state.m_budgetCallback.store(budget.m_callback, std::memory_order_release);
+        state.m_budgetByteSizes[festd::to_underlying(BudgetLevel::kSoft)].store(budget.m_softByteSize, std::memory_order_relaxed);
+        state.m_budgetByteSizes[festd::to_underlying(BudgetLevel::kHard)].store(budget.m_hardByteSize, std::memory_order_relaxed);
+        state.m_budgetExceeded[festd::to_underlying(BudgetLevel::kSoft)].store(false, std::memory_order_relaxed);
+        state.m_budgetExceeded[festd::to_underlying(BudgetLevel::kHard)].store(false, std::memory_order_relaxed);
+    }
+
+
+    void* TaggedMemoryResource::do_allocate(const size_t byteSize, const size_t byteAlignment)
+    {
+        // The header is placed right before the returned pointer and holds the header size and the allocation size.
+        const size_t headerSize = Math::Max(byteAlignment, kDefaultAlignment);
+        auto* base = static_cast<std::byte*>(m_upstream->allocate(byteSize + headerSize, headerSize));
+        if (base == nullptr)
+            return nullptr;
+
+        std::byte* result = base + headerSize;
+        size_t* header = reinterpret_cast<size_t*>(result) - 2;
+        header[0] = headerSize;
+        header[1] = byteSize;
+
+        TrackAllocation(m_tag, byteSize);
+        return result;
+    }
+
+
+    void TaggedMemoryResource::do_deallocate(void* ptr, size_t, size_t)
+    {
+        const size_t* header = static_cast<const size_t*>(ptr) - 2;
+        const size_t headerSize = header[0];
+        const size_t byteSize = header[1];
+
+        TrackFree(m_tag, byteSize);
+        m_upstream->deallocate(static_cast<std::byte*>(ptr) - headerSize, byteSize + headerSize, headerSize);
+    }
+} // namespace FE::Memory
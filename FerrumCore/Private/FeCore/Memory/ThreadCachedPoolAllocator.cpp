@@ -0,0 +1,260 @@
+﻿#include <FeCore/Memory/ThreadCachedPoolAllocator.h>
+
+namespace FE::Memory
+{
+    namespace
+    {
+        constexpr uint64_t kBatchPointerMask = (UINT64_C(1) << 48) - 1;
+        constexpr uint64_t kBatchTagIncrement = UINT64_C(1) << 48;
+
+
+        FE_FORCE_INLINE void*& GetNextBlock(void* block)
+        {
+            return *static_cast<void**>(block);
+        }
+
+
+        // The second word of the first block in a batch links the batches in the central list.
+        // It can be read by a thread that lost the race for the batch, so it's accessed atomically.
+        FE_FORCE_INLINE std::atomic<void*>& GetNextBatch(void* batch)
+        {
+            static_assert(sizeof(std::atomic<void*>) == sizeof(void*));
+            return *reinterpret_cast<std::atomic<void*>*>(static_cast<void**>(batch) + 1);
+        }
+
+
+        FE_FORCE_INLINE uint32_t GetBatchSize(const uint32_t sizeClass)
+        {
+            return Math::Clamp(8192 / ThreadCachedPoolAllocator::GetSizeClassByteSize(sizeClass), 4u, 64u);
+        }
+    } // namespace
+
+
+    ThreadCachedPoolAllocator::ThreadCachedPoolAllocator(const char* name, const Tag tag, const size_t reserveByteSize,
+                                                         const uint32_t pageByteSize)
+        : m_name(name)
+        , m_tag(tag)
+    {
+        FE_CoreAssert(Math::IsPowerOfTwo(pageByteSize));
+        FE_CoreAssert(pageByteSize >= GetPlatformSpec().m_granularity && pageByteSize >= kMaxByteSize);
+        FE_CoreAssert(reserveByteSize >= pageByteSize);
+
+        m_pageByteSize = pageByteSize;
+        m_pageSizeLog = Math::FloorLog2(pageByteSize);
+        m_maxPageCount = static_cast<uint32_t>(reserveByteSize / pageByteSize);
+        m_reserveByteSize = static_cast<size_t>(m_maxPageCount) * pageByteSize;
+        m_memory = static_cast<std::byte*>(ReserveVirtual(m_reserveByteSize, pageByteSize));
+        m_pageSizeClasses = DefaultAllocateArray<uint8_t>(m_maxPageCount);
+
+        // The central lists pack the batch pointers into 48 bits.
+        FE_CoreAssert((reinterpret_cast<uintptr_t>(m_memory + m_reserveByteSize) & ~kBatchPointerMask) == 0);
+    }
+
+
+    ThreadCachedPoolAllocator::~ThreadCachedPoolAllocator()
+    {
+        FE_CoreAssertDebug(m_allocationCount.load(std::memory_order_relaxed) == 0, "Leak detected");
+
+        for (std::atomic<ThreadCache*>& threadCache : m_threadCaches)
+            DefaultFree(threadCache.load(std::memory_order_relaxed));
+
+        TrackFree(m_tag, static_cast<size_t>(GetPageCount()) * m_pageByteSize);
+        DefaultFree(m_pageSizeClasses);
+        FreeVirtual(m_memory, m_reserveByteSize);
+    }
+
+
+    ThreadCachedPoolAllocator::ThreadCache& ThreadCachedPoolAllocator::GetThreadCache(const uint32_t slot)
+    {
+        // Only the thread that owns the slot can get here, so the cache doesn't need to be created atomically.
+        ThreadCache* threadCache = m_threadCaches[slot].load(std::memory_order_relaxed);
+        if (threadCache == nullptr) [[unlikely]]
+        {
+            threadCache = new (DefaultAllocate(sizeof(ThreadCache), alignof(ThreadCache))) ThreadCache;
+            m_threadCaches[slot].store(threadCache, std::memory_order_relaxed);
+        }
+
+        return *threadCache;
+    }
+
+
+    bool ThreadCachedPoolAllocator::Refill(SizeClassCache& cache, const uint32_t sizeClass)
+    {
+        FE_CoreAssertDebug(cache.m_head == nullptr && cache.m_count == 0);
+        CentralList& centralList = m_centralLists[sizeClass];
+        const uint32_t batchSize = GetBatchSize(sizeClass);
+
+        uint64_t head = centralList.m_batches.load(std::memory_order_acquire);
+        while (head & kBatchPointerMask)
+        {
+            void* batch = reinterpret_cast<void*>(head & kBatchPointerMask);
+            void* nextBatch = GetNextBatch(batch).load(std::memory_order_relaxed);
+            const uint64_t newHead = reinterpret_cast<uint64_t>(nextBatch) | ((head & ~kBatchPointerMask) + kBatchTagIncrement);
+            if (centralList.m_batches.compare_exchange_weak(head, newHead, std::memory_order_acquire))
+            {
+                cache.m_head = batch;
+                cache.m_count = batchSize;
+                return true;
+            }
+        }
+
+        // There are no free batches, carve a new one out of the current page.
+        const uint32_t blockByteSize = GetSizeClassByteSize(sizeClass);
+
+        std::byte* blocks;
+        uint32_t blockCount;
+        {
+            std::lock_guard lock{ centralList.m_pageLock };
+            if (centralList.m_pageCurrent == centralList.m_pageEnd)
+            {
+                const uint32_t pageIndex = m_pageCount.fetch_add(1, std::memory_order_relaxed);
+                if (pageIndex >= m_maxPageCount)
+                    return false;
+
+                std::byte* page = m_memory + (static_cast<size_t>(pageIndex) << m_pageSizeLog);
+                CommitVirtual(page, m_pageByteSize);
+                TrackAllocation(m_tag, m_pageByteSize);
+                m_pageSizeClasses[pageIndex] = static_cast<uint8_t>(sizeClass);
+
+                centralList.m_pageCurrent = page;
+                centralList.m_pageEnd = page + m_pageByteSize / blockByteSize * blockByteSize;
+            }
+
+            blocks = centralList.m_pageCurrent;
+            blockCount = Math::Min(batchSize, static_cast<uint32_t>(centralList.m_pageEnd - blocks) / blockByteSize);
+            centralList.m_pageCurrent += blockCount * blockByteSize;
+        }
+
+        for (uint32_t blockIndex = 0; blockIndex < blockCount - 1; ++blockIndex)
+            GetNextBlock(blocks + blockIndex * blockByteSize) = blocks + (blockIndex + 1) * blockByteSize;
+        GetNextBlock(blocks + (blockCount - 1) * blockByteSize) = nullptr;
+
+        cache.m_head = blocks;
+        cache.m_count = blockCount;
+        return true;
+    }
+
+
+    void ThreadCachedPoolAllocator::ReleaseBatch(SizeClassCache& cache, const uint32_t sizeClass)
+    {
+        const uint32_t batchSize = GetBatchSize(sizeClass);
+        FE_CoreAssertDebug(cache.m_count > batchSize);
+
+        void* batch = cache.m_head;
+        void* lastBlock = batch;
+        for (uint32_t blockIndex = 1; blockIndex < batchSize; ++blockIndex)
+            lastBlock = GetNextBlock(lastBlock);
+
+        cache.m_head = GetNextBlock(lastBlock);
+        cache.m_count -= batchSize;
+        GetNextBlock(lastBlock) = nullptr;
+
+        CentralList& centralList = m_centralLists[sizeClass];
+        uint64_t head = centralList.m_batches.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            GetNextBatch(batch).store(reinterpret_cast<void*>(head & kBatchPointerMask), std::memory_order_relaxed);
+            const uint64_t newHead = reinterpret_cast<uint64_t>(batch) | ((head & ~kBatchPointerMask) + kBatchTagIncrement);
+            if (centralList.m_batches.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+
+    FE_FORCE_INLINE void* ThreadCachedPoolAllocator::AllocateFromCache(ThreadCache& cache, const uint32_t sizeClass)
+    {
+        SizeClassCache& sizeClassCache = cache.m_sizeClasses[sizeClass];
+        if (sizeClassCache.m_head == nullptr && !Refill(sizeClassCache, sizeClass)) [[unlikely]]
+            return nullptr;
+
+        void* result = sizeClassCache.m_head;
+        sizeClassCache.m_head = GetNextBlock(result);
+        --sizeClassCache.m_count;
+        return result;
+    }
+
+
+    FE_FORCE_INLINE void ThreadCachedPoolAllocator::FreeToCache(ThreadCache& cache, const uint32_t sizeClass, void* ptr)
+    {
+        SizeClassCache& sizeClassCache = cache.m_sizeClasses[sizeClass];
+        GetNextBlock(ptr) = sizeClassCache.m_head;
+        sizeClassCache.m_head = ptr;
+
+        // Keep up to two batches, so that alternating allocations and frees don't move the same batch back and forth.
+        if (++sizeClassCache.m_count > 2 * GetBatchSize(sizeClass)) [[unlikely]]
+            ReleaseBatch(sizeClassCache, sizeClass);
+    }
+
+
+    void* ThreadCachedPoolAllocator::AllocateFallback(const size_t byteSize, const size_t byteAlignment) const
+    {
+        void* result = DefaultAllocate(byteSize, byteAlignment);
+        TrackAllocation(m_tag, GetAllocatedSize(result));
+        return result;
+    }
+
+
+    void* ThreadCachedPoolAllocator::do_allocate(const size_t byteSize, const size_t byteAlignment)
+    {
+        if (byteSize > kMaxByteSize || byteAlignment > kDefaultAlignment)
+            return AllocateFallback(byteSize, byteAlignment);
+
+        const uint32_t sizeClass = GetSizeClass(byteSize);
+        const uint32_t slot = Internal::GetThreadSlot();
+
+        void* result;
+        if (slot != kInvalidIndex) [[likely]]
+        {
+            result = AllocateFromCache(GetThreadCache(slot), sizeClass);
+        }
+        else
+        {
+            std::lock_guard lock{ m_sharedCacheLock };
+            result = AllocateFromCache(m_sharedCache, sizeClass);
+        }
+
+        if (result == nullptr) [[unlikely]]
+        {
+            // The reserved range is exhausted.
+            return AllocateFallback(byteSize, byteAlignment);
+        }
+
+#if FE_DEBUG
+        m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        TracySecureAllocNS(result, GetSizeClassByteSize(sizeClass), 32, m_name);
+        return result;
+    }
+
+
+    void ThreadCachedPoolAllocator::do_deallocate(void* ptr, size_t, size_t)
+    {
+        if (!Contains(ptr))
+        {
+            TrackFree(m_tag, GetAllocatedSize(ptr));
+            DefaultFree(ptr);
+            return;
+        }
+
+#if FE_DEBUG
+        FE_CoreAssert(m_allocationCount.fetch_sub(1, std::memory_order_relaxed) > 0);
+#endif
+
+        TracySecureFreeNS(ptr, 32, m_name);
+
+        const size_t pageIndex = static_cast<size_t>(static_cast<std::byte*>(ptr) - m_memory) >> m_pageSizeLog;
+        const uint32_t sizeClass = m_pageSizeClasses[pageIndex];
+
+        const uint32_t slot = Internal::GetThreadSlot();
+        if (slot != kInvalidIndex) [[likely]]
+        {
+            FreeToCache(GetThreadCache(slot), sizeClass, ptr);
+        }
+        else
+        {
+            std::lock_guard lock{ m_sharedCacheLock };
+            FreeToCache(m_sharedCache, sizeClass, ptr);
+        }
+    }
+} // namespace FE::Memory
@@ -9,11 +9,11 @@
 #include <FeCore/Memory/Memory.h>
 #include <FeCore/Memory/MemoryPrivate.h>
 #include <FeCore/Modules/Environment.h>
-#include <FeCore/Platform/Windows/Common.h>
+#include <FeCore/Strings/Format.h>
 #include <FeCore/Threading/SharedSpinLock.h>
 #include <FeCore/Threading/Thread.h>
 #include <FeCore/Threading/ThreadingPrivate.h>
-#include <festd/unordered_map.h>
+#include <festd/vector.h>
 
 namespace FE::Env
 {
@@ -25,6 +25,20 @@ namespace FE::Env
         static_assert(1 << kNameBlockShift == alignof(Name::Record));
 
 
+        struct NamePage final
+        {
+            uint32_t m_pageIndex = kInvalidIndex;
+            uint32_t m_offset = kNamePageByteSize;
+        };
+
+
+        thread_local NamePage GTLSNamePage;
+
+
+        //! @brief Allocates name records from pages of virtual memory that are never freed until shutdown.
+        //!
+        //! Every thread fills its own page, so threads that create names concurrently don't need to synchronize
+        //! except for an atomic increment when they run out of space in the current page.
         class NameDataAllocator final
         {
             struct NameHandle final
@@ -36,11 +50,8 @@ namespace FE::Env
             static constexpr uint32_t kPageListByteSize = 64 * 1024;
             static constexpr uint32_t kMaxPageCount = kPageListByteSize / sizeof(void*);
 
-            Threading::SharedSpinLock m_lock;
             void** m_pages;
-            uint32_t m_currentPageIndex = kInvalidIndex;
-            uint32_t m_offset = kNamePageByteSize;
-            festd::unordered_dense_map<uint64_t, uint32_t> m_map;
+            std::atomic<uint32_t> m_pageCount = 0;
 
         public:
             NameDataAllocator()
@@ -50,45 +61,38 @@ namespace FE::Env
 
             ~NameDataAllocator()
             {
-                while (m_currentPageIndex != kInvalidIndex)
+                const uint32_t pageCount = Math::Min(m_pageCount.load(std::memory_order_acquire), kMaxPageCount);
+                for (uint32_t pageIndex = 0; pageIndex < pageCount; ++pageIndex)
                 {
-                    Memory::FreeVirtual(m_pages[m_currentPageIndex], kNamePageByteSize);
-                    --m_currentPageIndex;
+                    if (m_pages[pageIndex])
+                        Memory::FreeVirtual(m_pages[pageIndex], kNamePageByteSize);
                 }
 
                 Memory::FreeVirtual(static_cast<void*>(m_pages), kPageListByteSize);
             }
 
-            uint32_t TryFind(const uint64_t hash)
+            Name::Record* Allocate(const size_t stringByteSize, uint32_t& handle)
             {
-                std::shared_lock lk{ m_lock };
-                const auto it = m_map.find(hash);
-                if (it != m_map.end())
-                    return it->second;
-                return kInvalidIndex;
-            }
-
-            Name::Record* Allocate(uint64_t hash, const size_t stringByteSize, uint32_t& handle)
-            {
-                std::lock_guard lk{ m_lock };
                 const size_t recordHeaderSize = offsetof(Name::Record, m_data);
                 const size_t recordSize = AlignUp<1 << kNameBlockShift>(recordHeaderSize + stringByteSize);
-                if (recordSize + m_offset > kNamePageByteSize)
+
+                NamePage& page = GTLSNamePage;
+                if (recordSize + page.m_offset > kNamePageByteSize)
                 {
-                    m_pages[++m_currentPageIndex] = Memory::AllocateVirtual(kNamePageByteSize);
-                    FE_CoreAssert(m_currentPageIndex < kMaxPageCount);
-                    m_offset = 0;
+                    page.m_pageIndex = m_pageCount.fetch_add(1, std::memory_order_relaxed);
+                    FE_CoreAssert(page.m_pageIndex < kMaxPageCount);
+                    m_pages[page.m_pageIndex] = Memory::AllocateVirtual(kNamePageByteSize);
+                    page.m_offset = 0;
                 }
 
                 NameHandle result;
-                result.m_pageIndex = m_currentPageIndex;
-                result.m_blockIndex = m_offset >> kNameBlockShift;
+                result.m_pageIndex = page.m_pageIndex;
+                result.m_blockIndex = page.m_offset >> kNameBlockShift;
                 handle = festd::bit_cast<uint32_t>(result);
-                m_map.insert(std::make_pair(hash, handle));
 
-                void* ptr = static_cast<uint8_t*>(m_pages[m_currentPageIndex]) + m_offset;
-                m_offset += static_cast<uint32_t>(recordSize);
-                FE_CoreAssert((m_offset >> kNameBlockShift) << kNameBlockShift == m_offset);
+                void* ptr = static_cast<uint8_t*>(m_pages[page.m_pageIndex]) + page.m_offset;
+                page.m_offset += static_cast<uint32_t>(recordSize);
+                FE_CoreAssert((page.m_offset >> kNameBlockShift) << kNameBlockShift == page.m_offset);
                 return static_cast<Name::Record*>(ptr);
             }
 
@@ -102,6 +106,129 @@ namespace FE::Env
         };
 
 
+        //! @brief Interns strings, mapping each unique string to a name handle.
+        //!
+        //! The table is split into shards by the high bits of the hash. Each shard is an open addressing hash table
+        //! with linear probing behind its own lock, so threads working with different names rarely contend.
+        //! The hash is only used to find the candidates, the strings are always compared to handle collisions.
+        class NameTable final
+        {
+            struct Slot final
+            {
+                uint64_t m_hash = 0;
+                uint32_t m_handle = kInvalidIndex;
+            };
+
+            struct alignas(Memory::kCacheLineSize) Shard final
+            {
+                Threading::SharedSpinLock m_lock;
+                uint32_t m_size = 0;
+                festd::vector<Slot> m_slots;
+            };
+
+            static constexpr uint32_t kShardCountShift = 6;
+            static constexpr uint32_t kShardCount = 1 << kShardCountShift;
+            static constexpr uint32_t kInitialShardCapacity = 64;
+
+            NameDataAllocator m_dataAllocator;
+            Shard m_shards[kShardCount];
+
+            Shard& GetShard(const uint64_t hash)
+            {
+                return m_shards[hash >> (64 - kShardCountShift)];
+            }
+
+            uint32_t FindImpl(const Shard& shard, const std::string_view str, const uint64_t hash) const
+            {
+                if (shard.m_slots.empty())
+                    return kInvalidIndex;
+
+                const uint32_t mask = static_cast<uint32_t>(shard.m_slots.size()) - 1;
+                for (uint32_t slotIndex = static_cast<uint32_t>(hash) & mask;; slotIndex = (slotIndex + 1) & mask)
+                {
+                    const Slot& slot = shard.m_slots[slotIndex];
+                    if (slot.m_handle == kInvalidIndex)
+                        return kInvalidIndex;
+                    if (slot.m_hash != hash)
+                        continue;
+
+                    const Name::Record* record = m_dataAllocator.ResolvePointer(slot.m_handle);
+                    if (record->m_size == str.size() && memcmp(record->m_data, str.data(), str.size()) == 0)
+                        return slot.m_handle;
+                }
+            }
+
+            static void InsertImpl(Shard& shard, const Slot& newSlot)
+            {
+                const uint32_t mask = static_cast<uint32_t>(shard.m_slots.size()) - 1;
+                uint32_t slotIndex = static_cast<uint32_t>(newSlot.m_hash) & mask;
+                while (shard.m_slots[slotIndex].m_handle != kInvalidIndex)
+                    slotIndex = (slotIndex + 1) & mask;
+
+                shard.m_slots[slotIndex] = newSlot;
+            }
+
+            static void Grow(Shard& shard)
+            {
+                const festd::vector<Slot> oldSlots = std::move(shard.m_slots);
+                const uint32_t oldCapacity = static_cast<uint32_t>(oldSlots.size());
+
+                shard.m_slots.clear();
+                shard.m_slots.resize(oldCapacity ? oldCapacity * 2 : kInitialShardCapacity);
+                for (const Slot& slot : oldSlots)
+                {
+                    if (slot.m_handle != kInvalidIndex)
+                        InsertImpl(shard, slot);
+                }
+            }
+
+        public:
+            uint32_t TryFind(const std::string_view str, const uint64_t hash)
+            {
+                Shard& shard = GetShard(hash);
+                std::shared_lock lk{ shard.m_lock };
+                return FindImpl(shard, str, hash);
+            }
+
+            uint32_t FindOrCreate(const std::string_view str, const uint64_t hash)
+            {
+                Shard& shard = GetShard(hash);
+
+                {
+                    std::shared_lock lk{ shard.m_lock };
+                    const uint32_t handle = FindImpl(shard, str, hash);
+                    if (handle != kInvalidIndex)
+                        return handle;
+                }
+
+                std::lock_guard lk{ shard.m_lock };
+
+                // Another thread could have created the same name while we weren't holding the lock.
+                uint32_t handle = FindImpl(shard, str, hash);
+                if (handle != kInvalidIndex)
+                    return handle;
+
+                // Keep the load factor under 75%, so that the probe sequences stay short.
+                if ((shard.m_size + 1) * 4 > shard.m_slots.size() * 3)
+                    Grow(shard);
+
+                Name::Record* record = m_dataAllocator.Allocate(str.size() + 1, handle);
+                record->m_size = static_cast<uint16_t>(str.size());
+                record->m_hash = hash;
+                memcpy(record->m_data, str.data(), str.size());
+
+                InsertImpl(shard, Slot{ hash, handle });
+                ++shard.m_size;
+                return handle;
+            }
+
+            Name::Record* ResolvePointer(const uint32_t handle) const
+            {
+                return m_dataAllocator.ResolvePointer(handle);
+            }
+        };
+
+
         struct DefaultMemoryResource final : public std::pmr::memory_resource
         {
             DefaultMemoryResource()
@@ -191,7 +318,7 @@ namespace FE::Env
 
             HighPriorityInitializer m_highPriorityInitializer;
 
-            NameDataAllocator m_nameDataAllocator;
+            NameTable m_nameTable;
             DI::Container m_diContainer;
 
             ApplicationInfo m_appInfo;
@@ -233,10 +360,14 @@ namespace FE::Env
         Module* GModuleList = nullptr;
 
 
-#pragma warning(disable : 4075)
-#pragma warning(disable : 4073)
-#pragma init_seg(lib)
+#if FE_COMPILER_MSVC || FE_COMPILER_MS_CLANG
+#    pragma warning(disable : 4075)
+#    pragma warning(disable : 4073)
+#    pragma init_seg(lib)
         Environment GEnvironment;
+#else
+        __attribute__((init_priority(101))) Environment GEnvironment;
+#endif
     } // namespace
 
 
@@ -266,37 +397,17 @@ namespace FE::Env
 
     Name::Name(const std::string_view str)
     {
-        auto& nameAllocator = GEnvironment.m_nameDataAllocator;
-        const uint64_t hash = DefaultHash(str);
-        m_handle = nameAllocator.TryFind(hash);
-        if (IsValid())
-        {
-            FE_CoreAssert(str == GetRecord()->m_data, "Env::Name collision");
-            return;
-        }
-
         const size_t recordHeaderSize = offsetof(Name::Record, m_data);
         FE_CoreAssert(str.size() < kNamePageByteSize - recordHeaderSize, "Env::Name is too long");
 
-        Record* record = nameAllocator.Allocate(hash, str.size() + 1, m_handle);
-        record->m_size = static_cast<uint16_t>(str.size());
-        record->m_hash = hash;
-        memcpy(record->m_data, str.data(), str.size());
+        m_handle = GEnvironment.m_nameTable.FindOrCreate(str, DefaultHash(str));
     }
 
 
     bool Name::TryGetExisting(const std::string_view str, Name& result)
     {
-        auto& nameAllocator = GEnvironment.m_nameDataAllocator;
-        const uint64_t hash = DefaultHash(str);
-        result.m_handle = nameAllocator.TryFind(hash);
-        if (result.IsValid())
-        {
-            FE_CoreAssert(str == result.GetRecord()->m_data, "Env::Name collision");
-            return true;
-        }
-
-        return false;
+        result.m_handle = GEnvironment.m_nameTable.TryFind(str, DefaultHash(str));
+        return result.IsValid();
     }
 
 
@@ -305,7 +416,7 @@ namespace FE::Env
         if (!IsValid())
             return nullptr;
 
-        return GEnvironment.m_nameDataAllocator.ResolvePointer(m_handle);
+        return GEnvironment.m_nameTable.ResolvePointer(m_handle);
     }
 
 
@@ -22,6 +22,10 @@ namespace FE
 
             const HMODULE hLibrary = LoadLibraryW(wideName.data());
             return { reinterpret_cast<uintptr_t>(hLibrary) };
+#elif FE_PLATFORM_LINUX
+            const festd::fixed_string nullTerminatedName{ name };
+            void* library = dlopen(nullTerminatedName.c_str(), RTLD_NOW | RTLD_LOCAL);
+            return { reinterpret_cast<uintptr_t>(library) };
 #else
 #    error Not implemented :(
 #endif
@@ -32,6 +36,8 @@ namespace FE
         {
 #if FE_PLATFORM_WINDOWS
             return FreeLibrary(reinterpret_cast<HMODULE>(moduleHandle.m_value));
+#elif FE_PLATFORM_LINUX
+            return dlclose(reinterpret_cast<void*>(moduleHandle.m_value)) == 0;
 #else
 #    error Not implemented :(
 #endif
@@ -42,6 +48,8 @@ namespace FE
         {
 #if FE_PLATFORM_WINDOWS
             return (void*)GetProcAddress(reinterpret_cast<HMODULE>(moduleHandle.m_value), symbolName);
+#elif FE_PLATFORM_LINUX
+            return dlsym(reinterpret_cast<void*>(moduleHandle.m_value), symbolName);
 #else
 #    error Not implemented :(
 #endif
@@ -0,0 +1,113 @@
+﻿#pragma once
+#include <FeCore/Base/PlatformInclude.h>
+#include <FeCore/IO/BaseIO.h>
+#include <FeCore/Time/BaseTime.h>
+
+namespace FE::Platform
+{
+    inline int32_t DescriptorCast(const FileHandle handle)
+    {
+        return static_cast<int32_t>(handle.m_value);
+    }
+
+
+    inline long FutexWait(uint32_t* address, const uint32_t expectedValue)
+    {
+        return syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+    }
+
+
+    inline long FutexWake(uint32_t* address, const uint32_t count)
+    {
+        return syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+
+
+    inline TimeValue ConvertTimespecToUnixSeconds(const timespec time)
+    {
+        return static_cast<TimeValue>(time.tv_sec);
+    }
+
+
+    inline void ConvertDateTimeToTm(const SystemTimeInfo dateTime, tm& result)
+    {
+        result = {};
+        result.tm_year = dateTime.m_year;
+        result.tm_mon = dateTime.m_month;
+        result.tm_mday = dateTime.m_day;
+        result.tm_wday = dateTime.m_dayOfWeek;
+        result.tm_hour = dateTime.m_hour;
+        result.tm_min = dateTime.m_minute;
+        result.tm_sec = dateTime.m_second;
+        result.tm_isdst = -1;
+    }
+
+
+    inline void ConvertTmToDateTime(const tm& time, SystemTimeInfo& result)
+    {
+        result.m_year = time.tm_year;
+        result.m_month = time.tm_mon;
+        result.m_day = time.tm_mday;
+        result.m_dayOfWeek = time.tm_wday;
+        result.m_hour = time.tm_hour;
+        result.m_minute = time.tm_min;
+        result.m_second = time.tm_sec;
+    }
+
+
+    inline IO::FileAttributeFlags ConvertFileAttributeFlags(const festd::string_view fileName, const struct stat& fileStat)
+    {
+        IO::FileAttributeFlags result = IO::FileAttributeFlags::kNone;
+        if (!fileName.empty() && fileName.byte_at(0) == '.')
+            result |= IO::FileAttributeFlags::kHidden;
+        if (S_ISDIR(fileStat.st_mode))
+            result |= IO::FileAttributeFlags::kDirectory;
+        if ((fileStat.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)) == 0)
+            result |= IO::FileAttributeFlags::kReadOnly;
+
+        return result;
+    }
+
+
+    inline IO::ResultCode ConvertErrnoIOError(const int32_t error)
+    {
+        switch (error)
+        {
+        case EEXIST:
+            return IO::ResultCode::kFileExists;
+        case ENOENT:
+            return IO::ResultCode::kNoFileOrDirectory;
+        case EACCES:
+        case EPERM:
+        case EROFS:
+            return IO::ResultCode::kPermissionDenied;
+        case EINVAL:
+        case EBADF:
+            return IO::ResultCode::kInvalidArgument;
+        case EFBIG:
+        case EOVERFLOW:
+            return IO::ResultCode::kFileTooLarge;
+        case ENAMETOOLONG:
+            return IO::ResultCode::kFilenameTooLong;
+        case ENOTDIR:
+            return IO::ResultCode::kNotDirectory;
+        case EISDIR:
+            return IO::ResultCode::kIsDirectory;
+        case ENOTEMPTY:
+            return IO::ResultCode::kDirectoryNotEmpty;
+        case EMFILE:
+        case ENFILE:
+            return IO::ResultCode::kTooManyOpenFiles;
+        case ESPIPE:
+            return IO::ResultCode::kInvalidSeek;
+        case EIO:
+            return IO::ResultCode::kIOError;
+        case EDEADLK:
+            return IO::ResultCode::kDeadLock;
+        case ENOTSUP:
+            return IO::ResultCode::kNotSupported;
+        default:
+            return IO::ResultCode::kUnknownError;
+        }
+    }
+} // namespace FE::Platform
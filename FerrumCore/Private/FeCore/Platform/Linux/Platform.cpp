@@ -0,0 +1,192 @@
+﻿#include <FeCore/Base/Base.h>
+#include <FeCore/Base/Platform.h>
+#include <FeCore/Base/PlatformInclude.h>
+#include <FeCore/Memory/Memory.h>
+#include <cpuid.h>
+
+namespace FE::Platform
+{
+    namespace
+    {
+        union CpuId final
+        {
+            struct
+            {
+                [[maybe_unused]] uint32_t eax;
+                [[maybe_unused]] uint32_t ebx;
+                [[maybe_unused]] uint32_t ecx;
+                [[maybe_unused]] uint32_t edx;
+            };
+
+            uint32_t m_regs[4];
+
+            CpuId(const uint32_t funcId, const uint32_t subFuncId)
+            {
+                Memory::Zero(m_regs, sizeof(m_regs));
+                __cpuid_count(funcId, subFuncId, m_regs[0], m_regs[1], m_regs[2], m_regs[3]);
+            }
+        };
+
+
+        bool GetCpuIdInfo(CpuInfo& cpuInfo)
+        {
+            FE_PROFILER_ZONE();
+
+            {
+                const CpuId cpuId0(0, 0);
+
+                memcpy(cpuInfo.m_vendorId, &cpuId0.ebx, 4);
+                memcpy(cpuInfo.m_vendorId + 4, &cpuId0.edx, 4);
+                memcpy(cpuInfo.m_vendorId + 8, &cpuId0.ecx, 4);
+                cpuInfo.m_vendorId[12] = 0;
+            }
+            {
+                const CpuId cpuId1(1, 0);
+
+                cpuInfo.m_flags.m_sse41 = (cpuId1.ecx & 0x00080000) != 0;
+                cpuInfo.m_flags.m_sse42 = (cpuId1.ecx & 0x00100000) != 0;
+                cpuInfo.m_flags.m_avx = (cpuId1.ecx & 0x10000000) != 0;
+            }
+            {
+                const CpuId cpuId7(7, 0);
+
+                cpuInfo.m_flags.m_avx2 = (cpuId7.ebx & 0x00000020) != 0;
+            }
+
+            uint32_t cpuNameLength = 0;
+            for (uint32_t funcId = 0x80000002; funcId < 0x80000005; ++funcId)
+            {
+                const CpuId cpuId(funcId, 0);
+
+                memcpy(&cpuInfo.m_cpuName[cpuNameLength], &cpuId, sizeof(CpuId));
+                cpuNameLength += 16;
+            }
+
+            // CPUs without AVX support don't meet our minimal requirements, no further checks needed.
+            // However, we have to get the CPU name for the error message.
+            return cpuInfo.MeetsMinimalRequirements();
+        }
+
+
+        bool ReadSysfsInteger(const char* path, int32_t& result)
+        {
+            const int32_t descriptor = open(path, O_RDONLY | O_CLOEXEC);
+            if (descriptor < 0)
+                return false;
+
+            char buffer[32];
+            const ssize_t bytesRead = read(descriptor, buffer, sizeof(buffer) - 1);
+            close(descriptor);
+            if (bytesRead <= 0)
+                return false;
+
+            buffer[bytesRead] = 0;
+            result = atoi(buffer);
+            return true;
+        }
+
+
+        void GetCoreInfo(CpuInfo& cpuInfo)
+        {
+            FE_PROFILER_ZONE();
+
+            const long logicalCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
+            cpuInfo.m_logicalCores = logicalCoreCount > 0 ? static_cast<uint32_t>(logicalCoreCount) : 1;
+
+            // Linux has no processor groups, all the logical cores are accessible through a single affinity mask.
+            cpuInfo.m_processorGroups = 1;
+
+            // Physical cores are identified by a unique (package, core) pair. SMT siblings share the pair.
+            constexpr uint32_t kMaxTrackedCores = 1024;
+            uint64_t* coreKeys = FE_StackAlloc(uint64_t, kMaxTrackedCores);
+            uint32_t coreKeyCount = 0;
+
+            for (uint32_t cpuIndex = 0; cpuIndex < cpuInfo.m_logicalCores; ++cpuIndex)
+            {
+                char path[128];
+                int32_t packageId = 0;
+                int32_t coreId = 0;
+
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpuIndex);
+                const bool hasPackage = ReadSysfsInteger(path, packageId);
+                snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpuIndex);
+                const bool hasCore = ReadSysfsInteger(path, coreId);
+                if (!hasPackage || !hasCore)
+                    continue;
+
+                const uint64_t coreKey = (static_cast<uint64_t>(packageId) << 32) | static_cast<uint32_t>(coreId);
+
+                bool found = false;
+                for (uint32_t keyIndex = 0; keyIndex < coreKeyCount && !found; ++keyIndex)
+                    found = coreKeys[keyIndex] == coreKey;
+
+                if (!found && coreKeyCount < kMaxTrackedCores)
+                    coreKeys[coreKeyCount++] = coreKey;
+            }
+
+            cpuInfo.m_physicalCores = coreKeyCount > 0 ? coreKeyCount : cpuInfo.m_logicalCores;
+
+            cpuInfo.m_numaNodes = 0;
+            if (DIR* directory = opendir("/sys/devices/system/node"))
+            {
+                while (const dirent* entry = readdir(directory))
+                {
+                    if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+                        ++cpuInfo.m_numaNodes;
+                }
+
+                closedir(directory);
+            }
+
+            if (cpuInfo.m_numaNodes == 0)
+                cpuInfo.m_numaNodes = 1;
+        }
+    } // namespace
+
+
+    CpuInfo GetCpuInfo()
+    {
+        // Static initialization guarantees thread-safety
+        const static CpuInfo kCpuInfo = [] {
+            CpuInfo info;
+            if (GetCpuIdInfo(info))
+                GetCoreInfo(info);
+            return info;
+        }();
+
+        return kCpuInfo;
+    }
+
+
+    bool IsDebuggerPresent()
+    {
+        const int32_t descriptor = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0)
+            return false;
+
+        char buffer[4096];
+        const ssize_t bytesRead = read(descriptor, buffer, sizeof(buffer) - 1);
+        close(descriptor);
+        if (bytesRead <= 0)
+            return false;
+
+        buffer[bytesRead] = 0;
+
+        constexpr const char kTracerPidField[] = "TracerPid:";
+        const char* tracerPid = strstr(buffer, kTracerPidField);
+        if (tracerPid == nullptr)
+            return false;
+
+        return atoi(tracerPid + sizeof(kTracerPidField) - 1) != 0;
+    }
+
+
+    void FatalInitError(const char* message)
+    {
+        constexpr const char kHeader[] = "App initialization error: ";
+        [[maybe_unused]] ssize_t result = write(STDERR_FILENO, kHeader, sizeof(kHeader) - 1);
+        result = write(STDERR_FILENO, message, strlen(message));
+        result = write(STDERR_FILENO, "\n", 1);
+        FE_DebugBreak();
+    }
+} // namespace FE::Platform
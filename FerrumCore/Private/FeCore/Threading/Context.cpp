@@ -3,6 +3,18 @@
 
 namespace FE::Context
 {
+    namespace
+    {
+        thread_local ThreadState GTLSThreadState;
+    } // namespace
+
+
+    ThreadState& GetThreadState()
+    {
+        return GTLSThreadState;
+    }
+
+
     Handle Create(void* pStack, const size_t stackByteSize, const Callback callback)
     {
         const fcontext_t result = make_fcontext(pStack, stackByteSize, reinterpret_cast<pfn_fcontext>(callback));
@@ -6,14 +6,36 @@ namespace FE::Threading
 {
     namespace
     {
-        inline constexpr size_t kNormalStackSize = 512 * 1024;
-        inline constexpr size_t kExtendedStackSize = 512 * 1024;
-        inline constexpr uint32_t kNormalFiberCount = 128;
-        inline constexpr uint32_t kExtendedFiberCount = 32;
-        inline constexpr uint32_t kTotalFiberCount = kNormalFiberCount + kExtendedFiberCount;
-        inline constexpr size_t kTotalStackSize = (kExtendedFiberCount + kNormalFiberCount) * kExtendedStackSize;
+        //
+        // Each fiber owns a slot of kFiberSlotSize bytes aligned to its size:
+        //
+        //   | runtime info | reserved ... | guard page | stack (grows down) |
+        //   ^ slot start                                                   ^ slot end
+        //
+        // The runtime info is always at the start of the slot, so it can be found from any address on the stack.
+        // The page below the stack is never committed, so a stack overflow hits it instead of the runtime info.
+        //
+
+        inline constexpr size_t kFiberSlotSize = 1024 * 1024;
+        inline constexpr size_t kNormalStackSize = 128 * 1024;
+        inline constexpr uint32_t kMaxFiberCount = 2048;
 
         inline constexpr uint32_t kFiberTempAllocatorPageSize = 64 * 1024;
+
+
+        size_t GetRuntimeInfoSize(const size_t pageSize)
+        {
+            return AlignUp(sizeof(FiberRuntimeInfo), pageSize);
+        }
+
+
+        size_t GetStackSize(const bool extended, const size_t pageSize)
+        {
+            if (extended)
+                return kFiberSlotSize - GetRuntimeInfoSize(pageSize) - pageSize;
+
+            return kNormalStackSize;
+        }
     } // namespace
 
 
@@ -22,12 +44,12 @@ namespace FE::Threading
         //
         // To get the current fiber runtime info we need to get a pointer to the block of memory
         // allocated for the fiber's stack.
-        // Since these blocks of memory are aligned to kExtendedStackSize, we can use a pointer
+        // Since these blocks of memory are aligned to kFiberSlotSize, we can use a pointer
         // located somewhere on the stack and align it down to the start of the block.
         //
 
         auto* addressOnStack = FE_StackAlloc(std::byte, 0);
-        auto* fiberStackStart = AlignDownPtr(addressOnStack, kExtendedStackSize);
+        auto* fiberStackStart = AlignDownPtr(addressOnStack, kFiberSlotSize);
         auto* result = reinterpret_cast<FiberRuntimeInfo*>(fiberStackStart);
 
         if (result->m_magic != kFiberMagic)
@@ -38,110 +60,104 @@ namespace FE::Threading
 
 
     FiberPool::FiberPool(const Context::Callback fiberCallback)
+        : m_fiberCallback(fiberCallback)
     {
         FE_PROFILER_ZONE();
 
         m_tempPagePool.Initialize("FiberTempMemoryPool", kFiberTempAllocatorPageSize, kFiberTempAllocatorPageSize * 4);
 
-        const Memory::PlatformSpec memorySpec = Memory::GetPlatformSpec();
-
-        m_stackMemorySize = kTotalStackSize + kExtendedStackSize * 2;
-        m_stackMemory = Memory::ReserveVirtual(m_stackMemorySize, kExtendedStackSize);
-
-        m_fibers = Memory::DefaultAllocateArray<FiberInfo>(kTotalFiberCount);
-        eastl::uninitialized_value_construct(m_fibers, m_fibers + kTotalFiberCount);
+        // Only the address space is reserved here, the memory is committed when the fibers are created.
+        m_stackMemorySize = kMaxFiberCount * kFiberSlotSize;
+        m_stackMemory = Memory::ReserveVirtual(m_stackMemorySize, kFiberSlotSize);
+        FE_Assert(m_stackMemory, "Failed to reserve fiber stack memory");
 
-        auto* ptr = static_cast<std::byte*>(m_stackMemory);
+        m_fibers = Memory::DefaultAllocateArray<FiberInfo>(kMaxFiberCount);
+        eastl::uninitialized_value_construct(m_fibers, m_fibers + kMaxFiberCount);
+    }
 
-        // First guard page.
-        ptr += kExtendedStackSize;
 
-        for (uint32_t i = 0; i < kNormalFiberCount; ++i)
+    FiberPool::~FiberPool()
+    {
+        const size_t pageSize = Memory::GetPlatformSpec().m_pageSize;
+        const uint32_t fiberCount = m_fiberCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < fiberCount; ++i)
         {
-            Memory::CommitVirtual(ptr, kNormalStackSize - memorySpec.m_pageSize);
-
-            auto* runtimeInfo = new (ptr) FiberRuntimeInfo(kFiberTempAllocatorPageSize, &m_tempPagePool);
-            runtimeInfo->m_handle = FiberHandle{ i };
-            FE_Assert(IsAlignedPtr(runtimeInfo, kExtendedStackSize));
+            m_fibers[i].m_runtimeInfo->~FiberRuntimeInfo();
+            Memory::TrackFree(Memory::Tag::kJobs, GetRuntimeInfoSize(pageSize) + GetStackSize(m_fibers[i].m_extended, pageSize));
+        }
 
-            ptr += kNormalStackSize - memorySpec.m_pageSize; // top of the stack, last page is reserved
+        for (uint32_t i = 0; i < kMaxFiberCount; ++i)
+            m_fibers[i].~FiberInfo();
 
-            const size_t stackByteSize = kNormalStackSize - memorySpec.m_pageSize - sizeof(FiberRuntimeInfo);
-            m_fibers[i].m_runtimeInfo = runtimeInfo;
-            m_fibers[i].m_context = Context::Create(ptr, stackByteSize, fiberCallback);
-            m_fibers[i].m_isFree = true;
-            Fmt::FormatTo(m_fibers[i].m_name, "Fiber {}", i);
-            runtimeInfo->m_name = m_fibers[i].m_name.c_str();
+        Memory::DefaultFree(m_fibers);
+        Memory::FreeVirtual(m_stackMemory, m_stackMemorySize);
+    }
 
-            ptr = AlignUpPtr(ptr, kExtendedStackSize);
-        }
-        for (uint32_t i = 0; i < kExtendedFiberCount; ++i)
-        {
-            Memory::CommitVirtual(ptr, kExtendedStackSize - memorySpec.m_pageSize);
 
-            auto* runtimeInfo = new (ptr) FiberRuntimeInfo(kFiberTempAllocatorPageSize, &m_tempPagePool);
-            runtimeInfo->m_handle = FiberHandle{ i };
-            FE_Assert(IsAlignedPtr(runtimeInfo, kExtendedStackSize));
+    FiberHandle FiberPool::CreateFiber(const bool extended)
+    {
+        FE_PROFILER_ZONE();
 
-            ptr += kExtendedStackSize - memorySpec.m_pageSize; // top of the stack, last page is reserved
+        const uint32_t fiberIndex = m_fiberCount.fetch_add(1, std::memory_order_relaxed);
+        FE_Assert(fiberIndex < kMaxFiberCount, "Too many fibers");
 
-            const size_t stackByteSize = kExtendedStackSize - memorySpec.m_pageSize - sizeof(FiberRuntimeInfo);
-            m_fibers[i + kNormalFiberCount].m_runtimeInfo = runtimeInfo;
-            m_fibers[i + kNormalFiberCount].m_context = Context::Create(ptr, stackByteSize, fiberCallback);
-            m_fibers[i + kNormalFiberCount].m_isFree = true;
-            Fmt::FormatTo(m_fibers[i + kNormalFiberCount].m_name, "Fiber Big {}", i);
-            runtimeInfo->m_name = m_fibers[i + kNormalFiberCount].m_name.c_str();
+        const size_t pageSize = Memory::GetPlatformSpec().m_pageSize;
+        const size_t runtimeInfoSize = GetRuntimeInfoSize(pageSize);
+        const size_t stackSize = GetStackSize(extended, pageSize);
 
-            ptr = AlignUpPtr(ptr, kExtendedStackSize);
-        }
+        std::byte* slotStart = static_cast<std::byte*>(m_stackMemory) + fiberIndex * kFiberSlotSize;
+        std::byte* stackTop = slotStart + kFiberSlotSize;
 
-        FE_Assert(ptr + kExtendedStackSize == static_cast<std::byte*>(m_stackMemory) + m_stackMemorySize);
-    }
+        Memory::CommitVirtual(slotStart, runtimeInfoSize);
+        Memory::CommitVirtual(stackTop - stackSize, stackSize);
+        Memory::TrackAllocation(Memory::Tag::kJobs, runtimeInfoSize + stackSize);
 
+        FiberInfo& info = m_fibers[fiberIndex];
+        info.m_extended = extended;
+        if (extended)
+            Fmt::FormatTo(info.m_name, "Fiber Big {}", fiberIndex);
+        else
+            Fmt::FormatTo(info.m_name, "Fiber {}", fiberIndex);
 
-    FiberPool::~FiberPool()
-    {
-        for (uint32_t i = 0; i < kTotalFiberCount; ++i)
-        {
-            m_fibers[i].m_runtimeInfo->~FiberRuntimeInfo();
-            m_fibers[i].~FiberInfo();
-        }
+        auto* runtimeInfo = new (slotStart) FiberRuntimeInfo(kFiberTempAllocatorPageSize, &m_tempPagePool);
+        runtimeInfo->m_handle = FiberHandle{ fiberIndex };
+        runtimeInfo->m_name = info.m_name.c_str();
 
-        Memory::DefaultFree(m_fibers);
+        info.m_runtimeInfo = runtimeInfo;
+        info.m_context = Context::Create(stackTop, stackSize, m_fiberCallback);
+        return FiberHandle{ fiberIndex };
     }
 
 
     FiberHandle FiberPool::Rent(const bool extended)
     {
-        const uint32_t fiberCount = extended ? kExtendedFiberCount : kNormalFiberCount;
-        const uint32_t baseFiberIndex = extended ? kNormalFiberCount : 0;
-        const uint32_t indexSeed = m_indexSeed.fetch_add(1, std::memory_order_release);
-        const uint64_t indexOffset = DefaultHash(&indexSeed, sizeof(indexSeed));
+        FreeList& freeList = m_freeLists[extended];
 
-        while (true)
         {
-            for (uint32_t fiberIndex = 0; fiberIndex < fiberCount; ++fiberIndex)
+            std::lock_guard lock{ freeList.m_lock };
+            const uint32_t fiberIndex = freeList.m_headIndex;
+            if (fiberIndex != kInvalidIndex)
             {
-                const uint32_t realIndex = static_cast<uint32_t>((fiberIndex + indexOffset) % fiberCount);
-                FiberInfo& info = m_fibers[realIndex + baseFiberIndex];
-                if (!info.m_isFree.load(std::memory_order_relaxed))
-                    continue;
-
-                bool expected = true;
-                if (info.m_isFree.compare_exchange_weak(expected, false, std::memory_order_release))
-                    return FiberHandle{ realIndex + baseFiberIndex };
+                freeList.m_headIndex = m_fibers[fiberIndex].m_nextFreeIndex;
+                m_fibers[fiberIndex].m_nextFreeIndex = kInvalidIndex;
+                return FiberHandle{ fiberIndex };
             }
-
-            for (uint32_t spin = 0; spin < 32; ++spin)
-                _mm_pause();
         }
+
+        // All fibers of this size class are busy (most likely waiting), grow the pool.
+        return CreateFiber(extended);
     }
 
 
     void FiberPool::Return(const FiberHandle fiberHandle)
     {
-        FE_Assert(m_fibers[fiberHandle.m_value].m_runtimeInfo->m_tempAllocator.IsEmpty());
-        m_fibers[fiberHandle.m_value].m_isFree.store(true, std::memory_order_release);
+        FiberInfo& info = m_fibers[fiberHandle.m_value];
+        FE_Assert(info.m_runtimeInfo->m_tempAllocator.IsEmpty());
+
+        FreeList& freeList = m_freeLists[info.m_extended];
+        std::lock_guard lock{ freeList.m_lock };
+        info.m_nextFreeIndex = freeList.m_headIndex;
+        freeList.m_headIndex = fiberHandle.m_value;
     }
 
 
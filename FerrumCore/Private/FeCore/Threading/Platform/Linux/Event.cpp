@@ -0,0 +1,101 @@
+﻿#include <FeCore/Logging/Trace.h>
+#include <FeCore/Memory/Memory.h>
+#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Threading/Event.h>
+
+namespace FE::Threading
+{
+    namespace
+    {
+        struct NativeEvent final
+        {
+            std::atomic<uint32_t> m_signaled = 0;
+            bool m_manualReset = false;
+
+            uint32_t* GetFutexAddress()
+            {
+                static_assert(sizeof(m_signaled) == sizeof(uint32_t));
+                return reinterpret_cast<uint32_t*>(&m_signaled);
+            }
+        };
+
+
+        NativeEvent* EventCast(const uintptr_t nativeEvent)
+        {
+            return reinterpret_cast<NativeEvent*>(nativeEvent);
+        }
+
+
+        uintptr_t CreateEventImpl(const bool manualReset, const bool initialState)
+        {
+            NativeEvent* event = Memory::DefaultNew<NativeEvent>();
+            event->m_manualReset = manualReset;
+            event->m_signaled.store(initialState ? 1 : 0, std::memory_order_relaxed);
+            return reinterpret_cast<uintptr_t>(event);
+        }
+    } // namespace
+
+
+    void Event::Send()
+    {
+        NativeEvent* event = EventCast(m_nativeEvent);
+        if (event->m_signaled.exchange(1, std::memory_order_release) == 1)
+            return;
+
+        // A manual-reset event releases all the waiting threads, an auto-reset event releases only one of them.
+        Platform::FutexWake(event->GetFutexAddress(), event->m_manualReset ? INT32_MAX : 1);
+    }
+
+
+    void Event::Reset()
+    {
+        EventCast(m_nativeEvent)->m_signaled.store(0, std::memory_order_relaxed);
+    }
+
+
+    void Event::Wait()
+    {
+        NativeEvent* event = EventCast(m_nativeEvent);
+        for (;;)
+        {
+            if (event->m_manualReset)
+            {
+                if (event->m_signaled.load(std::memory_order_acquire) == 1)
+                    return;
+            }
+            else
+            {
+                uint32_t expected = 1;
+                if (event->m_signaled.compare_exchange_strong(expected, 0, std::memory_order_acquire))
+                    return;
+            }
+
+            const long result = Platform::FutexWait(event->GetFutexAddress(), 0);
+            FE_Verify(result == 0 || errno == EAGAIN || errno == EINTR);
+        }
+    }
+
+
+    void Event::Close()
+    {
+        if (m_nativeEvent == 0)
+            return;
+
+        NativeEvent* event = EventCast(m_nativeEvent);
+        event->~NativeEvent();
+        Memory::DefaultFree(event);
+        m_nativeEvent = 0;
+    }
+
+
+    Event Event::CreateAutoReset(const bool initialState)
+    {
+        return Event{ CreateEventImpl(false, initialState) };
+    }
+
+
+    Event Event::CreateManualReset(const bool initialState)
+    {
+        return Event{ CreateEventImpl(true, initialState) };
+    }
+} // namespace FE::Threading
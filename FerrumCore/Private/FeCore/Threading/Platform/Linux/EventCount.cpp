@@ -0,0 +1,29 @@
+﻿#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Threading/EventCount.h>
+
+namespace FE::Threading
+{
+    namespace
+    {
+        uint32_t* GetFutexAddress(std::atomic<uint32_t>* value)
+        {
+            static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+            return reinterpret_cast<uint32_t*>(value);
+        }
+    } // namespace
+
+
+    void EventCount::Wait(const uint32_t key)
+    {
+        while (m_epoch.load(std::memory_order_acquire) == key)
+            Platform::FutexWait(GetFutexAddress(&m_epoch), key);
+
+        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+
+    void EventCount::WakeImpl(const bool all)
+    {
+        Platform::FutexWake(GetFutexAddress(&m_epoch), all ? INT32_MAX : 1);
+    }
+} // namespace FE::Threading
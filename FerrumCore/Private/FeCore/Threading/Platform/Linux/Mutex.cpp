@@ -0,0 +1,44 @@
+﻿#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Threading/Mutex.h>
+
+namespace FE::Threading
+{
+    Mutex::Mutex([[maybe_unused]] const uint32_t spinCount) noexcept
+    {
+        FE_PROFILER_ZONE();
+
+        // There is no way to specify the spin count for a pthread mutex, but adaptive mutexes
+        // spin for a while before going to sleep, which is the closest thing to a critical section.
+        static_assert(sizeof(m_nativeMutex) >= sizeof(pthread_mutex_t));
+
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_ADAPTIVE_NP);
+        pthread_mutex_init(reinterpret_cast<pthread_mutex_t*>(m_nativeMutex), &attributes);
+        pthread_mutexattr_destroy(&attributes);
+    }
+
+
+    Mutex::~Mutex()
+    {
+        pthread_mutex_destroy(reinterpret_cast<pthread_mutex_t*>(m_nativeMutex));
+    }
+
+
+    void Mutex::lock() noexcept
+    {
+        pthread_mutex_lock(reinterpret_cast<pthread_mutex_t*>(m_nativeMutex));
+    }
+
+
+    bool Mutex::try_lock()
+    {
+        return pthread_mutex_trylock(reinterpret_cast<pthread_mutex_t*>(m_nativeMutex)) == 0;
+    }
+
+
+    void Mutex::unlock()
+    {
+        pthread_mutex_unlock(reinterpret_cast<pthread_mutex_t*>(m_nativeMutex));
+    }
+} // namespace FE::Threading
@@ -0,0 +1,58 @@
+﻿#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Threading/Semaphore.h>
+
+namespace FE::Threading
+{
+    namespace
+    {
+        // Futexes operate on 32-bit words, so we only use the lower half of the semaphore value.
+        uint32_t* GetFutexAddress(intptr_t* semaphore)
+        {
+            static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Only little-endian platforms are supported");
+            return reinterpret_cast<uint32_t*>(semaphore);
+        }
+    } // namespace
+
+
+    Semaphore::Semaphore(const uint32_t initialValue)
+    {
+        m_semaphore = initialValue;
+    }
+
+
+    Semaphore::~Semaphore() = default;
+
+
+    void Semaphore::Acquire()
+    {
+        uint32_t* value = GetFutexAddress(&m_semaphore);
+        for (;;)
+        {
+            uint32_t originalValue = __atomic_load_n(value, __ATOMIC_RELAXED);
+            while (originalValue == 0)
+            {
+                Platform::FutexWait(value, 0);
+                originalValue = __atomic_load_n(value, __ATOMIC_RELAXED);
+            }
+
+            if (__atomic_compare_exchange_n(value, &originalValue, originalValue - 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                return;
+        }
+    }
+
+
+    void Semaphore::Release()
+    {
+        uint32_t* value = GetFutexAddress(&m_semaphore);
+        __atomic_add_fetch(value, 1, __ATOMIC_RELEASE);
+        Platform::FutexWake(value, 1);
+    }
+
+
+    void Semaphore::Release(const uint32_t count)
+    {
+        uint32_t* value = GetFutexAddress(&m_semaphore);
+        __atomic_add_fetch(value, count, __ATOMIC_RELEASE);
+        Platform::FutexWake(value, count);
+    }
+} // namespace FE::Threading
@@ -0,0 +1,179 @@
+﻿#include <FeCore/Memory/PoolAllocator.h>
+#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Threading/Thread.h>
+#include <FeCore/Threading/ThreadingPrivate.h>
+
+namespace FE::Threading
+{
+    namespace
+    {
+        struct ThreadingState final
+        {
+            SpinLock m_lock;
+            uint64_t m_mainThreadID = 0;
+            Memory::Pool<NativeThreadData> m_threadDataAllocator{ "NativeThreadData", 64 * 1024 };
+        };
+
+        ThreadingState* GThreadingState;
+
+
+        NativeThreadData* AllocateThreadData()
+        {
+            const std::lock_guard lock{ GThreadingState->m_lock };
+            return GThreadingState->m_threadDataAllocator.New();
+        }
+
+
+        void FreeThreadData(NativeThreadData* data)
+        {
+            const std::lock_guard lock{ GThreadingState->m_lock };
+            GThreadingState->m_threadDataAllocator.Delete(data);
+        }
+
+
+        int32_t ConvertPriorityToNiceValue(const Priority priority)
+        {
+            switch (priority)
+            {
+            case Priority::kLowest:
+                return 10;
+            case Priority::kBelowNormal:
+                return 5;
+            case Priority::kAboveNormal:
+                return -5;
+            case Priority::kHighest:
+                return -10;
+            case Priority::kNormal:
+            default:
+                return 0;
+            }
+        }
+
+
+        void* ThreadRoutineImpl(void* param)
+        {
+            // The thread data is owned by the thread handle and freed in CloseThread() after pthread_join(),
+            // since the handle must stay valid after the thread has exited.
+            auto* pData = static_cast<NativeThreadData*>(param);
+
+            if (pData->m_priority != Priority::kNormal)
+            {
+                // With the default scheduling policy Linux threads are scheduled by their nice value,
+                // which can be set per thread using its kernel thread ID.
+                // Raising the priority requires CAP_SYS_NICE, so we silently ignore the failure here.
+                const auto kernelThreadID = static_cast<id_t>(syscall(SYS_gettid));
+                setpriority(PRIO_PROCESS, kernelThreadID, ConvertPriorityToNiceValue(pData->m_priority));
+            }
+
+            pData->m_startRoutine(pData->m_userData);
+            return nullptr;
+        }
+    } // namespace
+
+
+    void Internal::Init(std::pmr::memory_resource* allocator)
+    {
+        FE_CoreAssert(GThreadingState == nullptr, "Threading already initialized");
+        GThreadingState = Memory::New<ThreadingState>(allocator);
+        GThreadingState->m_mainThreadID = GetCurrentThreadID();
+    }
+
+
+    void Internal::Shutdown()
+    {
+        FE_CoreAssert(GThreadingState != nullptr, "Threading not initialized");
+        GThreadingState->~ThreadingState();
+        GThreadingState = nullptr;
+    }
+
+
+    ThreadHandle CreateThread(const festd::string_view name, const ThreadFunction startRoutine, const uintptr_t pUserData,
+                              Priority priority, const size_t stackSize)
+    {
+        FE_PROFILER_ZONE();
+
+        NativeThreadData* data = AllocateThreadData();
+        data->m_priority = priority;
+        data->m_userData = pUserData;
+        data->m_startRoutine = startRoutine;
+
+        pthread_attr_t attributes;
+        FE_CoreVerify(pthread_attr_init(&attributes) == 0);
+        if (stackSize != 0)
+            FE_CoreVerify(pthread_attr_setstacksize(&attributes, Math::Max<size_t>(stackSize, PTHREAD_STACK_MIN)) == 0);
+
+        pthread_t thread;
+        const int32_t result = pthread_create(&thread, &attributes, &ThreadRoutineImpl, data);
+        FE_CoreAssert(result == 0, "pthread_create failed");
+        pthread_attr_destroy(&attributes);
+
+        data->m_id = static_cast<uint64_t>(thread);
+        data->m_threadHandle = static_cast<uint64_t>(thread);
+
+        if (Build::IsDevelopment())
+        {
+            // Thread names on Linux are limited to 16 bytes including the null terminator.
+            char shortName[16] = {};
+            memcpy(shortName, name.data(), Math::Min<size_t>(name.size(), sizeof(shortName) - 1));
+            pthread_setname_np(thread, shortName);
+        }
+
+        return ThreadHandle{ reinterpret_cast<uint64_t>(data) };
+    }
+
+
+    void CloseThread(ThreadHandle& thread)
+    {
+        FE_PROFILER_ZONE();
+
+        if (thread.m_value == 0)
+            return;
+
+        auto* data = reinterpret_cast<NativeThreadData*>(thread.m_value);
+        FE_CoreVerify(pthread_join(static_cast<pthread_t>(data->m_threadHandle), nullptr) == 0);
+        FreeThreadData(data);
+        thread.Reset();
+    }
+
+
+    void SetThreadAffinity(const ThreadHandle thread, const uint64_t affinityMask)
+    {
+        FE_PROFILER_ZONE();
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (uint32_t cpuIndex = 0; cpuIndex < 64; ++cpuIndex)
+        {
+            if (affinityMask & (UINT64_C(1) << cpuIndex))
+                CPU_SET(cpuIndex, &cpuSet);
+        }
+
+        const NativeThreadData& data = GetNativeThreadData(thread);
+        FE_CoreVerify(pthread_setaffinity_np(static_cast<pthread_t>(data.m_threadHandle), sizeof(cpuSet), &cpuSet) == 0);
+    }
+
+
+    void Sleep(const uint32_t milliseconds)
+    {
+        FE_PROFILER_ZONE();
+
+        timespec duration;
+        duration.tv_sec = milliseconds / 1000;
+        duration.tv_nsec = static_cast<long>(milliseconds % 1000) * 1000000;
+        while (nanosleep(&duration, &duration) != 0 && errno == EINTR)
+        {
+        }
+    }
+
+
+    uint64_t GetCurrentThreadID()
+    {
+        return static_cast<uint64_t>(pthread_self());
+    }
+
+
+    uint64_t GetMainThreadID()
+    {
+        return GThreadingState->m_mainThreadID;
+    }
+} // namespace FE::Threading
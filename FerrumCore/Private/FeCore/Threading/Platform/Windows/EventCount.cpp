@@ -0,0 +1,24 @@
+#include <FeCore/Base/PlatformInclude.h>
+#include <FeCore/Threading/EventCount.h>
+
+#pragma comment(lib, "synchronization.lib")
+
+namespace FE::Threading
+{
+    void EventCount::Wait(uint32_t key)
+    {
+        while (m_epoch.load(std::memory_order_acquire) == key)
+            WaitOnAddress(&m_epoch, &key, sizeof(key), INFINITE);
+
+        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+
+    void EventCount::WakeImpl(const bool all)
+    {
+        if (all)
+            WakeByAddressAll(&m_epoch);
+        else
+            WakeByAddressSingle(&m_epoch);
+    }
+} // namespace FE::Threading
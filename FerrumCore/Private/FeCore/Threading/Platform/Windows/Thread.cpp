@@ -125,6 +125,15 @@ namespace FE::Threading
     }
 
 
+    void SetThreadAffinity(const ThreadHandle thread, const uint64_t affinityMask)
+    {
+        FE_PROFILER_ZONE();
+
+        const NativeThreadData& data = GetNativeThreadData(thread);
+        FE_CoreVerify(SetThreadAffinityMask(data.m_threadHandle, static_cast<DWORD_PTR>(affinityMask)) != 0);
+    }
+
+
     void Sleep(const uint32_t milliseconds)
     {
         FE_PROFILER_ZONE();
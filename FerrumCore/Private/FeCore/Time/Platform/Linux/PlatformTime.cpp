@@ -0,0 +1,99 @@
+﻿#include <FeCore/Platform/Linux/Common.h>
+#include <FeCore/Time/DateTime.h>
+#include <ctime>
+
+namespace FE::Platform
+{
+    namespace
+    {
+        constexpr double kTicksPerSecond = 1e9;
+        constexpr double kSecondsPerTick = 1e-9;
+    } // namespace
+
+
+    uint64_t GetTicks()
+    {
+        timespec time;
+        FE_Verify(clock_gettime(CLOCK_MONOTONIC, &time) == 0);
+        return static_cast<uint64_t>(time.tv_sec) * 1000000000 + static_cast<uint64_t>(time.tv_nsec);
+    }
+
+
+    double GetTicksPerSecond()
+    {
+        return kTicksPerSecond;
+    }
+
+
+    double GetSecondsPerTick()
+    {
+        return kSecondsPerTick;
+    }
+
+
+    double GetProcessCpuTime()
+    {
+        timespec time;
+        FE_Verify(clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) == 0);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * kSecondsPerTick;
+    }
+
+
+    TimeZoneInfo GetTimeZoneInfo()
+    {
+        tzset();
+
+        TimeZoneInfo result;
+        result.m_minuteBias = static_cast<int32_t>(timezone / 60);
+
+        if (tzname[0] == nullptr || tzname[0][0] == 0)
+            return result;
+
+        result.m_standardName = Env::Name{ tzname[0] };
+        return result;
+    }
+
+
+    TimeValue GetCurrentTimeUTC()
+    {
+        timespec time;
+        FE_Verify(clock_gettime(CLOCK_REALTIME, &time) == 0);
+        return ConvertTimespecToUnixSeconds(time);
+    }
+
+
+    bool ConvertUTCToLocalTime(const SystemTimeInfo source, SystemTimeInfo& result)
+    {
+        tm utcTime;
+        ConvertDateTimeToTm(source, utcTime);
+
+        const time_t time = timegm(&utcTime);
+        if (time == -1)
+            return false;
+
+        tm localTime;
+        if (localtime_r(&time, &localTime) == nullptr)
+            return false;
+
+        ConvertTmToDateTime(localTime, result);
+        return true;
+    }
+
+
+    bool ConvertLocalTimeToUTC(const SystemTimeInfo source, SystemTimeInfo& result)
+    {
+        tm localTime;
+        ConvertDateTimeToTm(source, localTime);
+
+        const time_t time = mktime(&localTime);
+        if (time == -1)
+            return false;
+
+        tm utcTime;
+        if (gmtime_r(&time, &utcTime) == nullptr)
+            return false;
+
+        ConvertTmToDateTime(utcTime, result);
+        return true;
+    }
+} // namespace FE::Platform
@@ -37,6 +37,20 @@ namespace FE::Platform
     }
 
 
+    double GetProcessCpuTime()
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        FE_Verify(GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime));
+
+        // FILETIME values are in 100-nanosecond intervals.
+        const auto toUInt64 = [](const FILETIME time) {
+            return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+
+        return static_cast<double>(toUInt64(kernelTime) + toUInt64(userTime)) * 1e-7;
+    }
+
+
     TimeZoneInfo GetTimeZoneInfo()
     {
         TIME_ZONE_INFORMATION info;
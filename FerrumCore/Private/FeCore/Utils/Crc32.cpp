@@ -135,4 +135,62 @@ namespace FE
         //return ~(uint32_t)crcA; // if you want to invert the result
         return static_cast<uint32_t>(crcA);
     }
+
+
+    namespace
+    {
+        // The reflected CRC32C polynomial.
+        constexpr uint32_t kPolynomial = 0x82f63b78;
+
+
+        //! @brief Multiply two polynomials modulo the CRC polynomial, both in the reflected bit order.
+        constexpr uint32_t MultiplyModP(uint32_t lhs, uint32_t rhs)
+        {
+            uint32_t product = 0;
+            for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1)
+            {
+                if (lhs & mask)
+                    product ^= rhs;
+
+                rhs = (rhs & 1) ? (rhs >> 1) ^ kPolynomial : rhs >> 1;
+            }
+
+            return product;
+        }
+
+
+        struct PowerTable final
+        {
+            uint32_t m_values[64];
+        };
+
+
+        //! @brief Table of x^(2^n) modulo the CRC polynomial.
+        constexpr PowerTable kPowersOfTwoModP = [] {
+            PowerTable table{};
+            uint32_t power = 1u << 30; // x^1
+            for (uint32_t& value : table.m_values)
+            {
+                value = power;
+                power = MultiplyModP(power, power);
+            }
+
+            return table;
+        }();
+    } // namespace
+
+
+    uint32_t Crc32::Combine(const uint32_t crc, const uint32_t nextCrc, const size_t nextByteSize)
+    {
+        // Appending n bytes to the data multiplies its CRC by x^(8n), since neither the seed nor the result are inverted.
+        uint32_t shift = 1u << 31; // x^0
+        uint64_t bitCount = static_cast<uint64_t>(nextByteSize) * 8;
+        for (uint32_t powerIndex = 0; bitCount != 0; bitCount >>= 1, ++powerIndex)
+        {
+            if (bitCount & 1)
+                shift = MultiplyModP(kPowersOfTwoModP.m_values[powerIndex], shift);
+        }
+
+        return MultiplyModP(shift, crc) ^ nextCrc;
+    }
 } // namespace FE
@@ -7,7 +7,6 @@
 #include <cstdint>
 #include <festd/base.h>
 #include <festd/span.h>
-#include <intrin.h>
 #include <mutex>
 #include <tracy/Tracy.hpp>
 
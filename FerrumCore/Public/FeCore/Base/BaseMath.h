@@ -4,6 +4,12 @@
 #include <FeCore/Base/CompilerTraits.h>
 #include <festd/base.h>
 
+#if FE_PLATFORM_WINDOWS
+#    include <intrin.h>
+#else
+#    include <immintrin.h>
+#endif
+
 namespace FE
 {
     //! @brief Align up an integer.
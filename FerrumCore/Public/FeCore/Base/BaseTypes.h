@@ -1,6 +1,11 @@
 #pragma once
 #include <FeCore/Base/CompilerTraits.h>
 #include <FeCore/Base/PlatformTraits.h>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
 
 namespace FE
 {
@@ -96,6 +96,26 @@
 #    endif
 
 #    define FE_FORCE_NOINLINE __declspec(noinline)
+#elif defined __GNUC__
+#    define FE_COMPILER_GCC 1
+
+#    define FE_PUSH_MSVC_WARNING(...)
+#    define FE_POP_MSVC_WARNING()
+
+#    define FE_PUSH_CLANG_WARNING(...)
+#    define FE_POP_CLANG_WARNING()
+
+#    define FE_FUNCSIG __PRETTY_FUNCTION__
+
+#    if FE_DEBUG
+#        define FE_FORCE_INLINE inline
+#        define FE_ALWAYS_INLINE __attribute__((always_inline)) inline
+#    else
+#        define FE_FORCE_INLINE __attribute__((always_inline)) inline
+#        define FE_ALWAYS_INLINE __attribute__((always_inline)) inline
+#    endif
+
+#    define FE_FORCE_NOINLINE __attribute__((noinline))
 #endif
 
 
@@ -103,6 +123,10 @@
 #    define FE_DebugBreak() __debugbreak()
 #    define FE_VECTORCALL __vectorcall
 #    define FE_NO_SECURITY_COOKIE __declspec(safebuffers)
+#elif FE_COMPILER_GCC
+#    define FE_DebugBreak() raise(SIGTRAP)
+#    define FE_VECTORCALL
+#    define FE_NO_SECURITY_COOKIE
 #else
 #    define FE_DebugBreak() __builtin_debugtrap()
 #    define FE_VECTORCALL
@@ -16,6 +16,20 @@
 #    undef MemoryBarrier
 #    undef GetCurrentDirectory
 #    undef SetCurrentDirectory
+#elif FE_PLATFORM_LINUX
+#    include <cerrno>
+#    include <dirent.h>
+#    include <dlfcn.h>
+#    include <fcntl.h>
+#    include <linux/futex.h>
+#    include <pthread.h>
+#    include <sched.h>
+#    include <sys/mman.h>
+#    include <sys/resource.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <sys/types.h>
+#    include <unistd.h>
 #else
 #    error Unsupported platform
 #endif
@@ -23,6 +23,9 @@ namespace FE::Trace
         [[nodiscard]] static FE_FORCE_NOINLINE CallStack Capture(uint32_t maxFrames = kDefaultMaxFrames,
                                                                  uint32_t skipFrames = kDefaultSkipFrames);
 
+        //! @brief Get a valid call stack without frames, e.g. to mark allocations whose call stacks weren't captured.
+        [[nodiscard]] static CallStack GetEmpty();
+
         [[nodiscard]] void** GetFrames() const;
     };
 } // namespace FE::Trace
@@ -8,6 +8,7 @@ namespace FE::Compression
 {
     constexpr uint32_t kBlockSize = 256 * 1024;
     constexpr uint32_t kGDeflatePageSize = 65536;
+    constexpr uint32_t kLZ4PageSize = 65536;
 
 
     enum class ResultCode : int32_t
@@ -30,6 +31,7 @@ namespace FE::Compression
         kNone,
         kDeflate,
         kGDeflate,
+        kLZ4, //!< LZ4 block format, trades compression ratio for very fast decompression.
         kInvalid,
     };
 
@@ -96,6 +98,16 @@ namespace FE::Compression
 
         [[nodiscard]] size_t GetBounds(size_t uncompressedSize) const;
 
+        [[nodiscard]] Method GetMethod() const
+        {
+            return m_method;
+        }
+
+        [[nodiscard]] int32_t GetLevel() const
+        {
+            return m_level;
+        }
+
         //! @brief Compress an entire block of data.
         //!
         //! This function will write a block header, followed by one or more pages, followed by a block footer.
@@ -7,7 +7,7 @@ namespace FE::Console
     enum class Color : uint8_t
     {
         kDefault = 0x7f,
-#ifdef FE_PLATFORM_WINDOWS
+#if FE_PLATFORM_WINDOWS || FE_PLATFORM_LINUX
         kBlack = 0x0,
         kNavy = 0x1,
         kGreen = 0x2,
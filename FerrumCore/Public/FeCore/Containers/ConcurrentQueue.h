@@ -1,20 +1,89 @@
 #pragma once
+#include <FeCore/Memory/Memory.h>
 #include <FeCore/Threading/SpinLock.h>
 #include <mutex>
 
 namespace FE
 {
-    struct ConcurrentQueue final
+    //! @brief Intrusive node shared by ConcurrentQueue and MPSCQueue, so that an object can be moved between them.
+    struct ConcurrentQueueNode
     {
-        struct Node
+        ConcurrentQueueNode* m_next;
+    };
+
+
+    namespace Internal
+    {
+        inline std::atomic<ConcurrentQueueNode*>& GetAtomicNext(ConcurrentQueueNode* node)
         {
-            Node* m_next;
-        };
+            // The node is a plain struct so that the objects deriving from it stay copyable.
+            static_assert(sizeof(std::atomic<ConcurrentQueueNode*>) == sizeof(ConcurrentQueueNode*));
+            return *reinterpret_cast<std::atomic<ConcurrentQueueNode*>*>(&node->m_next);
+        }
+    } // namespace Internal
+
+
+    //! @brief Intrusive multi-producer multi-consumer FIFO queue.
+    //!
+    //! By default, the queue is a linked list protected by a spin lock. After a call to Initialize() the queue switches
+    //! to the bounded ring mode: the nodes are stored in a lock-free ring buffer with per-slot sequence numbers
+    //! (see Dmitry Vyukov's bounded MPMC queue), and the spin-locked list is only used for the nodes that don't fit
+    //! into the ring. While the overflow list is not empty, new nodes are appended to it instead of the ring, so the
+    //! overflowed nodes are dequeued after at most a ring's worth of older nodes and can't be starved by a steady stream
+    //! of new ones. The order is only approximately FIFO when the ring fills up concurrently.
+    struct ConcurrentQueue final
+    {
+        using Node = ConcurrentQueueNode;
 
         ConcurrentQueue() = default;
 
+        ~ConcurrentQueue()
+        {
+            Deinitialize();
+        }
+
+        ConcurrentQueue(const ConcurrentQueue&) = delete;
+        ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+        ConcurrentQueue(ConcurrentQueue&&) = delete;
+        ConcurrentQueue& operator=(ConcurrentQueue&&) = delete;
+
+        //! @brief Switch the queue to the bounded ring mode. Must be called before the queue is used.
+        //!
+        //! @param capacity  The number of nodes that can be stored without taking the lock, must be a power of two.
+        //! @param allocator The allocator to allocate the ring with.
+        void Initialize(const uint32_t capacity, std::pmr::memory_resource* allocator = nullptr)
+        {
+            FE_CoreAssert(m_cells == nullptr, "Queue already initialized");
+            FE_CoreAssert(Math::IsPowerOfTwo(capacity), "Capacity must be a power of two");
+
+            if (allocator == nullptr)
+                allocator = std::pmr::get_default_resource();
+
+            m_allocator = allocator;
+            m_mask = capacity - 1;
+            m_cells = Memory::AllocateArray<Cell>(allocator, capacity);
+            for (uint32_t cellIndex = 0; cellIndex < capacity; ++cellIndex)
+                new (&m_cells[cellIndex]) Cell{ cellIndex, nullptr };
+        }
+
+        void Deinitialize()
+        {
+            if (m_cells == nullptr)
+                return;
+
+            m_allocator->deallocate(m_cells, (m_mask + 1) * sizeof(Cell));
+            m_cells = nullptr;
+            m_mask = 0;
+            m_enqueuePosition.store(0, std::memory_order_relaxed);
+            m_dequeuePosition.store(0, std::memory_order_relaxed);
+        }
+
         void Enqueue(Node* node)
         {
+            // Don't bypass the overflowed nodes, they would only be dequeued once the ring is empty.
+            if (m_cells && m_overflowCount.load(std::memory_order_relaxed) == 0 && TryEnqueueRing(node))
+                return;
+
             std::lock_guard lock{ m_lock };
             node->m_next = nullptr;
             if (m_tail)
@@ -22,18 +91,22 @@ namespace FE
             else
                 m_head = node;
             m_tail = node;
-        }
-
-        void PushFront(Node* node)
-        {
-            std::lock_guard lock{ m_lock };
-            node->m_next = m_head;
-            m_head = node;
+            m_overflowCount.store(m_overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         }
 
         Node* TryDequeue()
         {
-            std::unique_lock lock{ m_lock };
+            if (m_cells)
+            {
+                if (Node* node = TryDequeueRing())
+                    return node;
+            }
+
+            // Don't take the lock if there's nothing in the list.
+            if (m_overflowCount.load(std::memory_order_relaxed) == 0)
+                return nullptr;
+
+            std::lock_guard lock{ m_lock };
             if (m_head)
             {
                 Node* node = m_head;
@@ -41,6 +114,7 @@ namespace FE
                 if (!m_head)
                     m_tail = nullptr;
 
+                m_overflowCount.store(m_overflowCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
                 return node;
             }
 
@@ -48,9 +122,159 @@ namespace FE
         }
 
     private:
+        struct Cell final
+        {
+            std::atomic<uint64_t> m_sequence;
+            Node* m_node;
+        };
+
+        bool TryEnqueueRing(Node* node)
+        {
+            uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = m_cells[position & m_mask];
+                const uint64_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+                const int64_t difference = static_cast<int64_t>(sequence - position);
+                if (difference == 0)
+                {
+                    // The cell is free, try to claim it.
+                    if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.m_node = node;
+                        cell.m_sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The cell still holds a node from the previous lap, the ring is full.
+                    return false;
+                }
+                else
+                {
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        Node* TryDequeueRing()
+        {
+            uint64_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = m_cells[position & m_mask];
+                const uint64_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+                const int64_t difference = static_cast<int64_t>(sequence - (position + 1));
+                if (difference == 0)
+                {
+                    if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        Node* node = cell.m_node;
+                        cell.m_sequence.store(position + m_mask + 1, std::memory_order_release);
+                        return node;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The cell hasn't been written yet, the ring is empty.
+                    return nullptr;
+                }
+                else
+                {
+                    position = m_dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        alignas(Memory::kCacheLineSize) std::atomic<uint64_t> m_enqueuePosition = 0;
+        alignas(Memory::kCacheLineSize) std::atomic<uint64_t> m_dequeuePosition = 0;
+        alignas(Memory::kCacheLineSize) Cell* m_cells = nullptr;
+        uint64_t m_mask = 0;
+        std::pmr::memory_resource* m_allocator = nullptr;
+
+        Threading::SpinLock m_lock;
+        std::atomic<uint32_t> m_overflowCount = 0;
         Node* m_head = nullptr;
         Node* m_tail = nullptr;
-        Threading::SpinLock m_lock;
+    };
+
+
+    //! @brief Intrusive lock-free multi-producer single-consumer FIFO queue.
+    //!
+    //! Enqueue() is wait-free and can be called from any thread. TryDequeue() and Empty() can only be called from
+    //! the consumer thread. The implementation follows Dmitry Vyukov's intrusive MPSC node-based queue.
+    //!
+    //! The consumer might temporarily not see the nodes if a producer has been preempted in the middle of Enqueue().
+    //! The producers are expected to notify the consumer after Enqueue() returns.
+    struct MPSCQueue final
+    {
+        using Node = ConcurrentQueueNode;
+
+        MPSCQueue()
+            : m_stub{ nullptr }
+            , m_head(&m_stub)
+            , m_tail(&m_stub)
+        {
+        }
+
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+        MPSCQueue(MPSCQueue&&) = delete;
+        MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+        void Enqueue(Node* node)
+        {
+            Internal::GetAtomicNext(node).store(nullptr, std::memory_order_relaxed);
+            Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+            Internal::GetAtomicNext(previous).store(node, std::memory_order_release);
+        }
+
+        Node* TryDequeue()
+        {
+            Node* tail = m_tail;
+            Node* next = Internal::GetAtomicNext(tail).load(std::memory_order_acquire);
+            if (tail == &m_stub)
+            {
+                if (next == nullptr)
+                    return nullptr;
+
+                m_tail = next;
+                tail = next;
+                next = Internal::GetAtomicNext(next).load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            // The tail is the last node, unless a producer is in the middle of Enqueue().
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            // We can't take the last node before another one is linked after it, so push the stub.
+            Enqueue(&m_stub);
+            next = Internal::GetAtomicNext(tail).load(std::memory_order_acquire);
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            return nullptr;
+        }
+
+        [[nodiscard]] bool Empty() const
+        {
+            return m_tail == &m_stub && m_head.load(std::memory_order_acquire) == &m_stub;
+        }
+
+    private:
+        Node m_stub;
+        alignas(Memory::kCacheLineSize) std::atomic<Node*> m_head;
+        alignas(Memory::kCacheLineSize) Node* m_tail;
     };
 
 
@@ -0,0 +1,266 @@
+﻿#pragma once
+#include <FeCore/Memory/PoolAllocator.h>
+#include <FeCore/Memory/RefCount.h>
+#include <FeCore/Modules/Environment.h>
+#include <FeCore/Threading/SpinLock.h>
+#include <festd/intrusive_list.h>
+#include <festd/unordered_map.h>
+#include <mutex>
+
+namespace FE
+{
+    //! @brief A thread-safe cache of reference-counted objects keyed by name.
+    //!
+    //! The cache holds a reference to every object it contains, so the objects stay alive even if no one else uses them.
+    //! When the total byte size of the objects exceeds the budget, the least recently used objects that are not
+    //! referenced outside the cache are evicted. Objects that are still in use are never evicted.
+    template<class T>
+    struct RefCountedCache final
+    {
+        explicit RefCountedCache(const uint64_t byteBudget = Constants::kMaxU64)
+            : m_byteBudget(byteBudget)
+        {
+        }
+
+        ~RefCountedCache()
+        {
+            Clear();
+        }
+
+        RefCountedCache(const RefCountedCache&) = delete;
+        RefCountedCache& operator=(const RefCountedCache&) = delete;
+        RefCountedCache(RefCountedCache&&) = delete;
+        RefCountedCache& operator=(RefCountedCache&&) = delete;
+
+        //! @brief Find an object and mark it as the most recently used one.
+        //!
+        //! @return The object or nullptr if it's not in the cache.
+        T* Find(Env::Name name);
+
+        //! @brief Find an object or create a new one if it's not in the cache.
+        //!
+        //! The factory is called under the lock, so concurrent calls with the same name always return the same object.
+        //!
+        //! @param name    The name of the object.
+        //! @param factory A function that returns a new T*, called only if the object is not in the cache.
+        //! @param created Set to true if the object has been created by this call.
+        template<class TFactory>
+        T* FindOrCreate(Env::Name name, TFactory&& factory, bool& created);
+
+        //! @brief Set the number of bytes that the object occupies, e.g. when it has finished loading.
+        //!
+        //! Evicts unused objects if the cache doesn't fit into the budget anymore.
+        void SetByteSize(Env::Name name, uint64_t byteSize);
+
+        //! @brief Set the byte budget and evict unused objects until the cache fits into it.
+        void SetByteBudget(uint64_t byteBudget);
+
+        //! @brief Remove an object from the cache even if it is still in use.
+        //!
+        //! @return True if the object was in the cache.
+        bool Remove(Env::Name name);
+
+        //! @brief Remove an object from the cache if it satisfies the predicate.
+        //!
+        //! The predicate is called under the lock, so the object cannot be replaced between the check and the removal.
+        //!
+        //! @return True if the object was removed.
+        template<class TPredicate>
+        bool RemoveIf(Env::Name name, TPredicate&& predicate);
+
+        //! @brief Remove all the objects from the cache.
+        void Clear();
+
+        //! @brief Evict unused objects until the cache fits into the budget.
+        void Trim();
+
+        [[nodiscard]] uint64_t GetByteSize() const
+        {
+            std::lock_guard lock{ m_lock };
+            return m_byteSize;
+        }
+
+        [[nodiscard]] uint64_t GetByteBudget() const
+        {
+            std::lock_guard lock{ m_lock };
+            return m_byteBudget;
+        }
+
+        [[nodiscard]] uint32_t size() const
+        {
+            std::lock_guard lock{ m_lock };
+            return static_cast<uint32_t>(m_entries.size());
+        }
+
+    private:
+        struct Entry final : public festd::intrusive_list_node
+        {
+            Rc<T> m_object;
+            Env::Name m_name;
+            uint64_t m_byteSize = 0;
+        };
+
+        void TrimImpl();
+        void RemoveImpl(Entry* entry);
+
+        mutable Threading::SpinLock m_lock;
+        festd::unordered_dense_map<Env::Name, Entry*> m_entries;
+        festd::intrusive_list<Entry> m_lruList; //!< The most recently used entries are at the front.
+        Memory::Pool<Entry> m_entryPool{ "RefCountedCacheEntryPool" };
+        uint64_t m_byteSize = 0;
+        uint64_t m_byteBudget = 0;
+    };
+
+
+    template<class T>
+    T* RefCountedCache<T>::Find(const Env::Name name)
+    {
+        std::lock_guard lock{ m_lock };
+
+        const auto iter = m_entries.find(name);
+        if (iter == m_entries.end())
+            return nullptr;
+
+        Entry* entry = iter->second;
+        festd::intrusive_list<Entry>::remove(*entry);
+        m_lruList.push_front(*entry);
+        return entry->m_object.Get();
+    }
+
+
+    template<class T>
+    template<class TFactory>
+    T* RefCountedCache<T>::FindOrCreate(const Env::Name name, TFactory&& factory, bool& created)
+    {
+        std::lock_guard lock{ m_lock };
+
+        const auto [iter, inserted] = m_entries.insert({ name, nullptr });
+        created = inserted;
+
+        if (!inserted)
+        {
+            Entry* entry = iter->second;
+            festd::intrusive_list<Entry>::remove(*entry);
+            m_lruList.push_front(*entry);
+            return entry->m_object.Get();
+        }
+
+        Entry* entry = m_entryPool.New();
+        entry->m_object = factory();
+        entry->m_name = name;
+        FE_Assert(entry->m_object);
+
+        iter->second = entry;
+        m_lruList.push_front(*entry);
+        return entry->m_object.Get();
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::SetByteSize(const Env::Name name, const uint64_t byteSize)
+    {
+        std::lock_guard lock{ m_lock };
+
+        const auto iter = m_entries.find(name);
+        if (iter == m_entries.end())
+            return;
+
+        Entry* entry = iter->second;
+        m_byteSize = m_byteSize - entry->m_byteSize + byteSize;
+        entry->m_byteSize = byteSize;
+        TrimImpl();
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::SetByteBudget(const uint64_t byteBudget)
+    {
+        std::lock_guard lock{ m_lock };
+        m_byteBudget = byteBudget;
+        TrimImpl();
+    }
+
+
+    template<class T>
+    bool RefCountedCache<T>::Remove(const Env::Name name)
+    {
+        std::lock_guard lock{ m_lock };
+
+        const auto iter = m_entries.find(name);
+        if (iter == m_entries.end())
+            return false;
+
+        RemoveImpl(iter->second);
+        return true;
+    }
+
+
+    template<class T>
+    template<class TPredicate>
+    bool RefCountedCache<T>::RemoveIf(const Env::Name name, TPredicate&& predicate)
+    {
+        std::lock_guard lock{ m_lock };
+
+        const auto iter = m_entries.find(name);
+        if (iter == m_entries.end())
+            return false;
+
+        Entry* entry = iter->second;
+        if (!predicate(static_cast<const T*>(entry->m_object.Get())))
+            return false;
+
+        RemoveImpl(entry);
+        return true;
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::Clear()
+    {
+        std::lock_guard lock{ m_lock };
+
+        while (!m_lruList.empty())
+            RemoveImpl(&m_lruList.back());
+
+        FE_Assert(m_entries.empty());
+        FE_Assert(m_byteSize == 0);
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::Trim()
+    {
+        std::lock_guard lock{ m_lock };
+        TrimImpl();
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::TrimImpl()
+    {
+        auto iter = m_lruList.end();
+        while (m_byteSize > m_byteBudget && iter != m_lruList.begin())
+        {
+            --iter;
+            Entry* entry = &*iter;
+
+            // The cache holds the only reference, so no one can be using the object.
+            // New references can only be obtained through the cache, which is locked.
+            if (entry->m_object->GetRefCount() == 1)
+            {
+                ++iter;
+                RemoveImpl(entry);
+            }
+        }
+    }
+
+
+    template<class T>
+    void RefCountedCache<T>::RemoveImpl(Entry* entry)
+    {
+        m_entries.erase(entry->m_name);
+        festd::intrusive_list<Entry>::remove(*entry);
+        m_byteSize -= entry->m_byteSize;
+        m_entryPool.Delete(entry);
+    }
+} // namespace FE
@@ -170,7 +170,7 @@ namespace FE
             }
         }
 
-        template<size_t TSizeOther>
+        template<uint32_t TSizeOther>
         SegmentedVector(const SegmentedVector<T, TSizeOther>& other)
             : m_allocator(other.m_allocator)
         {
@@ -197,7 +197,7 @@ namespace FE
             return *this;
         }
 
-        template<size_t TSizeOther>
+        template<uint32_t TSizeOther>
         SegmentedVector& operator=(const SegmentedVector<T, TSizeOther>& other)
         {
             if (this == &other)
@@ -0,0 +1,136 @@
+﻿#pragma once
+#include <FeCore/Memory/Memory.h>
+#include <atomic>
+
+namespace FE
+{
+    //! @brief Bounded Chase-Lev work-stealing deque of pointers.
+    //!
+    //! The owner thread pushes and pops elements at the bottom of the deque (LIFO), other threads
+    //! steal elements from the top (FIFO). Push and pop never take a lock, steal is a single CAS.
+    //!
+    //! The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., 2013).
+    //! Unlike the original algorithm, the buffer never grows: Push() returns false when the deque is full,
+    //! and the caller is expected to fall back to a shared queue.
+    template<class T>
+    struct WorkStealingDeque final
+    {
+        WorkStealingDeque() = default;
+
+        ~WorkStealingDeque()
+        {
+            Deinitialize();
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+        WorkStealingDeque(WorkStealingDeque&&) = delete;
+        WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+        void Initialize(const uint32_t capacity, std::pmr::memory_resource* allocator = nullptr)
+        {
+            FE_CoreAssert(m_buffer == nullptr, "Deque already initialized");
+            FE_CoreAssert(Math::IsPowerOfTwo(capacity), "Capacity must be a power of two");
+
+            if (allocator == nullptr)
+                allocator = std::pmr::get_default_resource();
+
+            m_allocator = allocator;
+            m_mask = capacity - 1;
+            m_buffer = Memory::AllocateArray<std::atomic<T*>>(allocator, capacity);
+            for (uint32_t elementIndex = 0; elementIndex < capacity; ++elementIndex)
+                new (&m_buffer[elementIndex]) std::atomic<T*>(nullptr);
+        }
+
+        void Deinitialize()
+        {
+            if (m_buffer == nullptr)
+                return;
+
+            m_allocator->deallocate(m_buffer, (m_mask + 1) * sizeof(std::atomic<T*>));
+            m_buffer = nullptr;
+            m_mask = 0;
+            m_top.store(0, std::memory_order_relaxed);
+            m_bottom.store(0, std::memory_order_relaxed);
+        }
+
+        //! @brief Push an element to the bottom of the deque. Can only be called by the owner thread.
+        //!
+        //! @return False if the deque is full.
+        [[nodiscard]] bool Push(T* element)
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_top.load(std::memory_order_acquire);
+            if (bottom - top > static_cast<int64_t>(m_mask))
+                return false;
+
+            m_buffer[bottom & m_mask].store(element, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        //! @brief Pop an element from the bottom of the deque. Can only be called by the owner thread.
+        //!
+        //! @return The most recently pushed element or null if the deque is empty.
+        [[nodiscard]] T* Pop()
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // The deque is empty.
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* element = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // This is the last element, we must race against the thieves for it.
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    element = nullptr;
+
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return element;
+        }
+
+        //! @brief Steal an element from the top of the deque. Can be called from any thread.
+        //!
+        //! @return The least recently pushed element or null if the deque is empty or another thread won the race.
+        [[nodiscard]] T* Steal()
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return nullptr;
+
+            T* element = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return element;
+        }
+
+        //! @brief Check if the deque is empty. The result is only a hint when called concurrently with other operations.
+        [[nodiscard]] bool Empty() const
+        {
+            const int64_t top = m_top.load(std::memory_order_relaxed);
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            return top >= bottom;
+        }
+
+    private:
+        alignas(Memory::kCacheLineSize) std::atomic<int64_t> m_top = 0;
+        alignas(Memory::kCacheLineSize) std::atomic<int64_t> m_bottom = 0;
+        std::atomic<T*>* m_buffer = nullptr;
+        uint32_t m_mask = 0;
+        std::pmr::memory_resource* m_allocator = nullptr;
+    };
+} // namespace FE
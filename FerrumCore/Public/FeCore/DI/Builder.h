@@ -96,7 +96,7 @@ namespace FE::DI
         private:
             static_assert(std::is_base_of_v<Memory::RefCountedObjectBase, TInterface>);
 
-            friend struct ServiceRegistryBuilder;
+            friend struct DI::ServiceRegistryBuilder;
             ServiceRegistrationSpec m_target;
 
             RegistryBindBuilder(const ServiceRegistrationSpec registrationSpec)
@@ -11,6 +11,11 @@ namespace FE::Platform
         {
             return FileHandle{ reinterpret_cast<uint64_t>(ptr) };
         }
+
+        static FileHandle FromDescriptor(const int32_t descriptor)
+        {
+            return FileHandle{ static_cast<uint64_t>(descriptor) };
+        }
     };
 } // namespace FE::Platform
 
@@ -47,6 +52,7 @@ namespace FE::IO
         kInvalidArgument = -14,    //!< Argument value has not been accepted.
         kInvalidFormat = -15,      //!< Invalid file format.
         kDecompressionError = -16, //!< Block file decompression failed.
+        kIntegrityViolation = -17, //!< The checksum of the data doesn't match the stored one.
         kUnknownError = kDefaultErrorCode<ResultCode>,
     };
 
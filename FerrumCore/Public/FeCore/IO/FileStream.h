@@ -27,6 +27,7 @@ namespace FE::IO
         festd::string_view GetName() override;
         [[nodiscard]] OpenMode GetOpenMode() const override;
         [[nodiscard]] FileStats GetStats() const override;
+        [[nodiscard]] Platform::FileHandle GetNativeHandle() const override;
         void Close() override;
 
     private:
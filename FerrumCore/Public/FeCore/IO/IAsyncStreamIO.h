@@ -50,6 +50,8 @@ namespace FE::IO
         Rc<IStream> m_stream;  //!< The stream that the operation will be performed on, optional.
         Path m_path;           //!< The path to the file to open the stream for, must be provided if pStream is null.
         intptr_t m_offset = 0; //!< The starting offset in the source file. Will be moved by the I/O thread after each operation.
+        bool m_memoryMapped = false; //!< Optional: if the I/O thread opens the stream from m_path, map the file into memory
+                                     //!< instead of reading it with system calls, see MappedFileStream.
 
         uintptr_t m_userData0 = 0; //!< Optional user data, ignored by the I/O thread.
         uintptr_t m_userData1 = 0; //!< Optional user data, ignored by the I/O thread.
@@ -71,6 +73,10 @@ namespace FE::IO
                                           //!< For instance, this can be useful for text files to reserve
                                           //!< one byte for the terminating zero.
                                           //!< Note: this overallocated memory is not guaranteed to be zeroed.
+        bool m_zeroCopy = false; //!< Optional: if m_readBuffer is null and the stream is memory-mapped, m_readBuffer will point
+                                 //!< straight into the mapped region instead of being allocated and filled with a copy.
+                                 //!< The data must not be modified. The file stays mapped until the buffer is freed
+                                 //!< with FreeData() or m_allocator. m_overallocateBytes is ignored.
     };
 
 
@@ -93,7 +99,11 @@ namespace FE::IO
         uint32_t m_blockCount = 1;         //!< The number of blocks to read.
         Crc32 m_crc32;                     //!< The initial CRC32 value to be used for integrity checks when decompressing.
                                            //!< The I/O thread will update this value as it reads blocks.
+                                           //!< When reading from the middle of a block stream, this must be the CRC stored
+                                           //!< in the footer of the preceding block.
         bool m_decompress = true;          //!< If true, the data read from blocks will be decompressed.
+        bool m_verifyIntegrity = false;    //!< If true, the CRC of the decompressed data will be checked against the one
+                                           //!< stored in the block footers. Has no effect if m_decompress is false.
 
         JobPriority m_decompressionPriority = JobPriority::kNormal; //!< If m_decompress is true, the priority of the job that
                                                                     //!< the I/O thread will schedule for decompression.
@@ -120,6 +130,7 @@ namespace FE::IO
         IAsyncController* m_controller = nullptr;
         size_t m_bytesRead = 0;
         uint32_t m_blockIndex = 0;
+        ResultCode m_result = ResultCode::kSuccess; //!< The result for this particular block.
 
         void FreeData() const
         {
@@ -117,6 +117,24 @@ namespace FE::IO
         //! @brief Only works for file streams.
         [[nodiscard]] virtual FileStats GetStats() const = 0;
 
+        //! @brief Get the platform file handle that backs this stream.
+        //!
+        //! If the returned handle is valid, the stream can be read with positional platform reads, bypassing ReadToBuffer().
+        //! Streams that are not backed by a single file (e.g. memory streams) return an invalid handle.
+        [[nodiscard]] virtual Platform::FileHandle GetNativeHandle() const = 0;
+
+        //! @brief Get the offset of the stream data within the file returned by GetNativeHandle().
+        //!
+        //! Streams that serve a part of a larger file (e.g. an entry of a pak archive) return the offset of that part,
+        //! all other streams return zero.
+        [[nodiscard]] virtual uint64_t GetNativeOffset() const = 0;
+
+        //! @brief Get the memory the whole stream is mapped to.
+        //!
+        //! If the returned span is not empty, the stream contents can be accessed directly without copying.
+        //! Streams that are not memory-mapped return an empty span.
+        [[nodiscard]] virtual festd::span<const std::byte> GetMappedData() const = 0;
+
         //! @brief Close this stream.
         virtual void Close() = 0;
 
@@ -10,6 +10,9 @@ namespace FE::IO
         virtual festd::expected<Rc<IStream>, ResultCode> OpenFileStream(festd::string_view filename, OpenMode openMode) = 0;
         virtual festd::expected<Rc<IStream>, ResultCode> OpenUnbufferedFileStream(festd::string_view filename,
                                                                                   OpenMode openMode) = 0;
+
+        //! @brief Open a read-only stream backed by a memory mapping of the file, see MappedFileStream.
+        virtual festd::expected<Rc<IStream>, ResultCode> OpenMappedFileStream(festd::string_view filename) = 0;
         virtual bool FileExists(festd::string_view filename) = 0;
         virtual FileAttributeFlags GetFileAttributeFlags(festd::string_view filename) = 0;
     };
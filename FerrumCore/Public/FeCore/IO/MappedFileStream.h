@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <FeCore/IO/StreamBase.h>
+
+namespace FE::IO
+{
+    //! @brief Read-only file stream backed by a memory mapping of the whole file.
+    //!
+    //! ReadToBuffer() is a plain memory copy, and GetView() returns spans pointing straight into the mapped region,
+    //! so the data can be consumed without any copies or system calls. The pages are loaded on first access,
+    //! use Prefetch() to start reading them ahead of time. Files larger than 4 GiB cannot be mapped.
+    struct MappedFileStream final : public StreamBase
+    {
+        MappedFileStream() = default;
+
+        ~MappedFileStream() override
+        {
+            Close();
+        }
+
+        ResultCode Open(festd::string_view fileName);
+
+        //! @brief Get a view of the mapped file contents. The view is clamped to the length of the file.
+        //!
+        //! The returned span is valid until the stream is closed.
+        [[nodiscard]] festd::span<const std::byte> GetView(size_t offset, size_t byteSize) const;
+
+        //! @brief Get a view of the mapped file contents starting at the current position and advance the position.
+        [[nodiscard]] festd::span<const std::byte> ReadView(size_t byteSize);
+
+        //! @brief Hint the OS to start reading the specified range of the file into memory.
+        void Prefetch(size_t offset, size_t byteSize) const;
+
+        [[nodiscard]] bool SeekAllowed() const override;
+        [[nodiscard]] bool IsOpen() const override;
+        ResultCode Seek(intptr_t offset, SeekMode seekMode) override;
+        [[nodiscard]] uintptr_t Tell() const override;
+        [[nodiscard]] size_t Length() const override;
+        size_t ReadToBuffer(void* buffer, size_t byteSize) override;
+        size_t WriteFromBuffer(const void* buffer, size_t byteSize) override;
+        festd::string_view GetName() override;
+        [[nodiscard]] OpenMode GetOpenMode() const override;
+        [[nodiscard]] FileStats GetStats() const override;
+        [[nodiscard]] festd::span<const std::byte> GetMappedData() const override;
+        void Close() override;
+
+    private:
+        Path m_name;
+        const std::byte* m_data = nullptr;
+        uintptr_t m_position = 0;
+        FileStats m_stats{};
+        bool m_isOpen = false;
+    };
+} // namespace FE::IO
@@ -0,0 +1,124 @@
+﻿#pragma once
+#include <FeCore/IO/IStream.h>
+#include <FeCore/IO/Path.h>
+#include <festd/vector.h>
+
+namespace FE::IO
+{
+    namespace Pak
+    {
+        inline constexpr uint32_t kMagic = Math::MakeFourCC('F', 'P', 'K', 0);
+        inline constexpr uint32_t kVersion = 1;
+
+        //! @brief Alignment of the entry data within an archive.
+        //!
+        //! The entries start on page boundaries, so they can be read with unbuffered I/O and mapped into memory
+        //! without sharing pages with their neighbours.
+        inline constexpr uint32_t kDataAlignment = 4096;
+
+
+        //! @brief Archive header. It is followed by the table of contents, the name table and the entry data.
+        struct Header final
+        {
+            uint32_t m_magic;
+            uint32_t m_version;
+            uint32_t m_entryCount;
+            uint32_t m_nameTableSize;
+        };
+
+
+        //! @brief Table of contents entry. The entries are sorted by the name hash, so they can be binary searched.
+        struct Entry final
+        {
+            uint64_t m_nameHash;   //!< DefaultHash() of the normalized entry path, matches Env::Name::GetHash().
+            uint64_t m_offset;     //!< Offset of the entry data from the beginning of the archive.
+            uint64_t m_byteSize;   //!< Size of the entry data in bytes.
+            uint32_t m_nameOffset; //!< Offset of the entry path in the name table, used to resolve hash collisions.
+            uint32_t m_nameSize;   //!< Size of the entry path in bytes.
+        };
+
+        static_assert(sizeof(Entry) == 32);
+
+
+        //! @brief Normalize an entry path the same way the packer does.
+        inline Path NormalizeEntryName(const festd::string_view name)
+        {
+            return NormalizePath(name);
+        }
+    } // namespace Pak
+
+
+    //! @brief Packs a set of files into a single pak archive.
+    struct PakWriter final
+    {
+        //! @brief Add a file to the archive.
+        //!
+        //! @param entryName  The path the file will be looked up by, usually relative to the asset directory.
+        //! @param sourcePath The path of the file to copy the data from.
+        void AddFile(festd::string_view entryName, festd::string_view sourcePath);
+
+        //! @brief Write the archive. The entry data is written in the order the files were added.
+        //!
+        //! @param outputPath The path of the archive to create.
+        //!
+        //! @return Success or error code. kFileExists is returned if two files have the same entry name.
+        ResultCode Write(festd::string_view outputPath) const;
+
+    private:
+        struct SourceFile final
+        {
+            Path m_entryName;
+            Path m_sourcePath;
+        };
+
+        festd::vector<SourceFile> m_files;
+    };
+
+
+    //! @brief Read-only pak archive.
+    //!
+    //! All the entry streams share the archive's file handle and read from it at their offsets, so opening an entry
+    //! doesn't require any system calls. The streams keep a reference to the archive.
+    struct PakArchive final : public Memory::RefCountedObjectBase
+    {
+        FE_RTTI_Class(PakArchive, "1E4B8C8A-5F5C-4B0E-9E0A-6F0B3D2A7C41");
+
+        ~PakArchive() override;
+
+        ResultCode Open(festd::string_view path);
+
+        //! @brief Find an entry by its path. Returns null if the archive doesn't contain the entry.
+        [[nodiscard]] const Pak::Entry* FindEntry(festd::string_view name) const;
+
+        [[nodiscard]] festd::string_view GetEntryName(const Pak::Entry& entry) const;
+
+        [[nodiscard]] festd::span<const Pak::Entry> GetEntries() const
+        {
+            return m_entries;
+        }
+
+        //! @brief Open a read-only stream for the specified entry.
+        //!
+        //! @param entry        The entry to open the stream for, must belong to this archive.
+        //! @param memoryMapped If true and the archive has been mapped into memory, the stream will expose the mapped data
+        //!                     (see IStream::GetMappedData()) instead of the native file handle.
+        [[nodiscard]] Rc<IStream> OpenEntryStream(const Pak::Entry* entry, bool memoryMapped = false);
+
+        [[nodiscard]] festd::string_view GetPath() const
+        {
+            return m_path;
+        }
+
+    private:
+        friend struct PakEntryStream;
+
+        Path m_path;
+        Platform::FileHandle m_handle;
+        FileStats m_stats{};
+        const std::byte* m_mappedData = nullptr;
+        festd::vector<Pak::Entry> m_entries;
+        festd::vector<char> m_nameTable;
+
+        void Close();
+    };
+} // namespace FE::IO
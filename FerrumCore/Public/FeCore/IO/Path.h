@@ -73,7 +73,7 @@ namespace FE::IO
 
         [[nodiscard]] bool has_stem() const
         {
-            return m_filenameSize - m_extensionSize > 0;
+            return m_filenameSize > 0;
         }
 
         [[nodiscard]] bool has_extension() const
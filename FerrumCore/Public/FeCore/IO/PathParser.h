@@ -64,7 +64,7 @@ namespace FE::PathParser
 
     [[nodiscard]] constexpr bool IsAbsolutePath(const char* str, const uint32_t length)
     {
-        return length > 0 && str[0] == '/' || SkipPathRoot(str, length) != str;
+        return (length > 0 && str[0] == '/') || SkipPathRoot(str, length) != str;
     }
 
 
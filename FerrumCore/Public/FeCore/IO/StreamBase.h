@@ -48,6 +48,21 @@ namespace FE::IO
             FE_Assert(false, "Not supported");
             return {};
         }
+
+        Platform::FileHandle GetNativeHandle() const override
+        {
+            return {};
+        }
+
+        uint64_t GetNativeOffset() const override
+        {
+            return 0;
+        }
+
+        festd::span<const std::byte> GetMappedData() const override
+        {
+            return {};
+        }
     };
 
 
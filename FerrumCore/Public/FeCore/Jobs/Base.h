@@ -7,8 +7,11 @@ namespace FE
     //!
     //! Jobs with different priorities are assigned to different queues.
     //! Each worker thread has a set of queues (one for each priority)
-    //! for the jobs that can only run on that thread (due to affinity).
-    //! There is also two global sets of queues: one for foreground jobs
+    //! for the jobs that can only run on that thread (due to affinity),
+    //! and a set of work-stealing deques for the jobs it has scheduled itself.
+    //! Idle workers steal jobs from the deques of other workers.
+    //! There are also global sets of queues for the jobs scheduled from
+    //! non-worker threads: one for generic jobs, one for foreground jobs
     //! and one for background jobs.
     enum class JobPriority : uint16_t
     {
@@ -54,6 +57,18 @@ namespace FE
     };
 
 
+    //! \brief Size class of the fiber stack a job runs on.
+    //!
+    //! Most jobs run on small stacks, so that the fibers blocked in WaitGroup::Wait() don't hold much memory.
+    //! Jobs that need a lot of stack space, e.g. the ones that call into shader compilers or drivers,
+    //! must request a large stack.
+    enum class JobStackSize : uint32_t
+    {
+        kSmall,
+        kLarge,
+    };
+
+
     enum class JobThreadPoolType : uint32_t
     {
         kGeneric,
@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <FeCore/Jobs/FiberWaitQueue.h>
+
+namespace FE
+{
+    //! @brief An event that suspends the waiting fiber instead of blocking the worker thread.
+    //!
+    //! A manual reset event stays signaled and releases all the waiters until Reset() is called.
+    //! An auto reset event releases a single waiter per Send() call.
+    struct FiberEvent final
+    {
+        FiberEvent(const FiberEvent&) = delete;
+        FiberEvent& operator=(const FiberEvent&) = delete;
+        FiberEvent(FiberEvent&&) = delete;
+        FiberEvent& operator=(FiberEvent&&) = delete;
+
+        void Send();
+        void Reset();
+        void Wait();
+
+        [[nodiscard]] bool IsSignaled() const
+        {
+            return m_signaled.load(std::memory_order_acquire);
+        }
+
+        static FiberEvent CreateAutoReset(const bool initialState = false)
+        {
+            return FiberEvent{ false, initialState };
+        }
+
+        static FiberEvent CreateManualReset(const bool initialState = false)
+        {
+            return FiberEvent{ true, initialState };
+        }
+
+    private:
+        FiberEvent(const bool manualReset, const bool initialState)
+            : m_signaled(initialState)
+            , m_manualReset(manualReset)
+        {
+        }
+
+        Threading::SpinLock m_lock;
+        std::atomic<bool> m_signaled = false;
+        bool m_manualReset = false;
+        FiberWaitQueue m_waiters;
+    };
+} // namespace FE
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <FeCore/Jobs/FiberWaitQueue.h>
+
+namespace FE
+{
+    //! @brief A mutex that suspends the waiting fiber instead of blocking the worker thread.
+    //!
+    //! When the mutex is unlocked, the ownership is passed directly to the first waiting fiber,
+    //! so the waiters acquire the mutex in FIFO order. Can only be locked from the job system fibers.
+    struct FiberMutex final
+    {
+        FiberMutex() = default;
+
+        FiberMutex(const FiberMutex&) = delete;
+        FiberMutex& operator=(const FiberMutex&) = delete;
+        FiberMutex(FiberMutex&&) = delete;
+        FiberMutex& operator=(FiberMutex&&) = delete;
+
+        void lock();
+        bool try_lock();
+        void unlock();
+
+    private:
+        Threading::SpinLock m_lock;
+        bool m_locked = false;
+        FiberWaitQueue m_waiters;
+    };
+
+
+    //! @brief A reader-writer mutex that suspends the waiting fibers instead of blocking the worker threads.
+    //!
+    //! New readers don't acquire the mutex while a writer is waiting. When a writer unlocks the mutex,
+    //! all the waiting readers are let in before the next writer, so neither side can starve the other.
+    struct FiberSharedMutex final
+    {
+        FiberSharedMutex() = default;
+
+        FiberSharedMutex(const FiberSharedMutex&) = delete;
+        FiberSharedMutex& operator=(const FiberSharedMutex&) = delete;
+        FiberSharedMutex(FiberSharedMutex&&) = delete;
+        FiberSharedMutex& operator=(FiberSharedMutex&&) = delete;
+
+        void lock();
+        bool try_lock();
+        void unlock();
+
+        void lock_shared();
+        bool try_lock_shared();
+        void unlock_shared();
+
+    private:
+        Threading::SpinLock m_lock;
+        bool m_exclusiveLocked = false;
+        uint32_t m_sharedLockCount = 0;
+        FiberWaitQueue m_exclusiveWaiters;
+        FiberWaitQueue m_sharedWaiters;
+    };
+} // namespace FE
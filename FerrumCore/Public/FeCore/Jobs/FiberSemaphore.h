@@ -0,0 +1,37 @@
+﻿#pragma once
+#include <FeCore/Jobs/FiberWaitQueue.h>
+
+namespace FE
+{
+    //! @brief A counting semaphore that suspends the waiting fiber instead of blocking the worker thread.
+    //!
+    //! Useful to limit the number of jobs that use a resource at the same time, e.g. concurrent file reads.
+    //! Released units are passed directly to the waiting fibers in FIFO order.
+    struct FiberSemaphore final
+    {
+        explicit FiberSemaphore(const uint32_t initialValue = 0)
+            : m_value(initialValue)
+        {
+        }
+
+        FiberSemaphore(const FiberSemaphore&) = delete;
+        FiberSemaphore& operator=(const FiberSemaphore&) = delete;
+        FiberSemaphore(FiberSemaphore&&) = delete;
+        FiberSemaphore& operator=(FiberSemaphore&&) = delete;
+
+        void Acquire();
+        bool TryAcquire();
+
+        void Release()
+        {
+            Release(1);
+        }
+
+        void Release(uint32_t count);
+
+    private:
+        Threading::SpinLock m_lock;
+        uint32_t m_value = 0;
+        FiberWaitQueue m_waiters;
+    };
+} // namespace FE
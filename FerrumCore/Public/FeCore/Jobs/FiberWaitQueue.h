@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <FeCore/Containers/ConcurrentQueue.h>
+#include <FeCore/Jobs/Base.h>
+#include <FeCore/Threading/Fiber.h>
+#include <FeCore/Threading/SpinLock.h>
+
+namespace FE
+{
+    struct FiberWaitEntry final : public ConcurrentQueue::Node
+    {
+        FiberWaitEntry* m_queueTail = nullptr;
+        JobSystem* m_jobSystem = nullptr; //!< The job system that owns the fiber, it must be resumed there.
+        FiberAffinityMask m_affinityMask = FiberAffinityMask::kNone;
+        Threading::FiberHandle m_fiber;
+        JobPriority m_priority = JobPriority::kNormal;
+        std::atomic<bool> m_switchCompleted = false;
+    };
+
+
+    //! @brief Intrusive FIFO queue of fibers waiting on a synchronization primitive.
+    //!
+    //! The queue is not thread-safe by itself: every call except Resume() must be made while holding the lock
+    //! that protects the state of the primitive. The wait entries live on the stacks of the waiting fibers.
+    struct FiberWaitQueue final
+    {
+        FiberWaitQueue() = default;
+
+        FiberWaitQueue(const FiberWaitQueue&) = delete;
+        FiberWaitQueue& operator=(const FiberWaitQueue&) = delete;
+        FiberWaitQueue(FiberWaitQueue&&) = delete;
+        FiberWaitQueue& operator=(FiberWaitQueue&&) = delete;
+
+        ~FiberWaitQueue()
+        {
+            FE_Assert(Empty(), "Destroying a primitive that has waiting fibers");
+        }
+
+        [[nodiscard]] bool Empty() const
+        {
+            return m_head == nullptr;
+        }
+
+        //! @brief Suspend the current fiber until it is passed to Resume().
+        //!
+        //! Must be called from a job system fiber with the lock held. The lock is released before the fiber
+        //! is suspended and is not re-acquired after it is resumed.
+        void Wait(Threading::SpinLock& lock);
+
+        //! @brief Remove the first waiting fiber from the queue.
+        //!
+        //! @return The wait entry to pass to Resume() or null if the queue is empty.
+        [[nodiscard]] FiberWaitEntry* Pop()
+        {
+            FiberWaitEntry* entry = m_head;
+            if (entry)
+            {
+                m_head = static_cast<FiberWaitEntry*>(entry->m_next);
+                if (m_head == nullptr)
+                    m_tail = nullptr;
+
+                entry->m_next = nullptr;
+            }
+
+            return entry;
+        }
+
+        //! @brief Remove all the waiting fibers from the queue.
+        //!
+        //! @return A list of wait entries linked through ConcurrentQueueNode::m_next to pass to Resume().
+        [[nodiscard]] FiberWaitEntry* PopAll()
+        {
+            FiberWaitEntry* entries = m_head;
+            m_head = nullptr;
+            m_tail = nullptr;
+            return entries;
+        }
+
+        //! @brief Schedule a list of fibers previously removed from a queue for execution.
+        //!
+        //! Should be called after the lock is released, so that the resumed fibers don't have to spin on it.
+        static void Resume(FiberWaitEntry* entries);
+
+    private:
+        FiberWaitEntry* m_head = nullptr;
+        FiberWaitEntry* m_tail = nullptr;
+    };
+} // namespace FE
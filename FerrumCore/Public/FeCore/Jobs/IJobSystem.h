@@ -21,5 +21,8 @@ namespace FE
         virtual void Stop() = 0;
 
         virtual FiberAffinityMask GetAffinityMaskForCurrentThread() const = 0;
+
+        //! @brief Get the total number of worker threads, including the main thread.
+        [[nodiscard]] virtual uint32_t GetWorkerCount() const = 0;
     };
 } // namespace FE
@@ -8,9 +8,17 @@ namespace FE
 {
     struct Job : public ConcurrentQueue::Node
     {
+        //! @brief The affinity mask used by ScheduleForeground().
+        static constexpr FiberAffinityMask kForegroundAffinityMask = FiberAffinityMask::kAll;
+
         Job() = default;
         virtual ~Job() = default;
 
+        explicit Job(const JobStackSize stackSize)
+            : m_stackSize(stackSize)
+        {
+        }
+
         Job(const Job&) = delete;
         Job& operator=(const Job&) = delete;
         Job(Job&&) = delete;
@@ -34,7 +42,7 @@ namespace FE
         void ScheduleForeground(IJobSystem* jobSystem, WaitGroup* completionWaitGroup = nullptr,
                                 const JobPriority priority = JobPriority::kNormal)
         {
-            Schedule(jobSystem, FiberAffinityMask::kAll, completionWaitGroup, priority);
+            Schedule(jobSystem, kForegroundAffinityMask, completionWaitGroup, priority);
         }
 
         void ScheduleBackground(IJobSystem* jobSystem, WaitGroup* completionWaitGroup = nullptr,
@@ -43,18 +51,25 @@ namespace FE
             Schedule(jobSystem, FiberAffinityMask::kAllBackground, completionWaitGroup, priority);
         }
 
+        [[nodiscard]] JobStackSize GetStackSize() const
+        {
+            return m_stackSize;
+        }
+
     private:
         friend struct JobSystem;
         Rc<WaitGroup> m_completionWaitGroup;
-        uint64_t m_orderHint = 0;
+        JobStackSize m_stackSize = JobStackSize::kSmall;
+        uint64_t m_scheduleTicks = 0;
     };
 
 
     template<class TFunc>
     struct FunctorJob final : public Job
     {
-        explicit FunctorJob(TFunc&& func)
-            : m_func(std::move(func))
+        explicit FunctorJob(TFunc&& func, const JobStackSize stackSize = JobStackSize::kSmall)
+            : Job(stackSize)
+            , m_func(std::move(func))
         {
         }
 
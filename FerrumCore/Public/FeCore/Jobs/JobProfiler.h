@@ -0,0 +1,135 @@
+﻿#pragma once
+#include <FeCore/Base/Base.h>
+#include <FeCore/IO/IStream.h>
+#include <FeCore/Time/BaseTime.h>
+#include <festd/string.h>
+
+namespace FE
+{
+    enum class JobTraceEventType : uint32_t
+    {
+        kJob,  //!< A job has been executed, the duration includes the time the job spent waiting.
+        kWait, //!< A fiber has been suspended until a wait group or a fiber synchronization primitive let it continue.
+        kIdle, //!< A worker has been parked because there was no work.
+    };
+
+
+    struct JobTraceEvent final
+    {
+        uint64_t m_startTicks = 0;
+        uint64_t m_endTicks = 0;
+        uint64_t m_queueLatencyTicks = 0;
+        JobTraceEventType m_type = JobTraceEventType::kJob;
+    };
+
+
+    //! @brief Scheduler statistics of a single worker collected during a capture.
+    struct JobWorkerStats final
+    {
+        uint64_t m_jobCount = 0;
+        uint64_t m_stolenJobCount = 0;
+        uint64_t m_fiberSwitchCount = 0;
+        uint64_t m_parkCount = 0;
+        uint64_t m_executionTicks = 0;
+        uint64_t m_queueLatencyTicks = 0;
+        uint64_t m_waitTicks = 0;
+        uint64_t m_idleTicks = 0;
+    };
+
+
+    //! @brief Lightweight recorder of the job system activity.
+    //!
+    //! Each worker writes the events to its own ring buffer, so recording doesn't need any synchronization.
+    //! When the ring buffer is full, the oldest events are overwritten. Nothing is recorded unless a capture is in progress.
+    //! The captured events can be exported in the Chrome trace format, which can be opened in Perfetto or chrome://tracing
+    //! without a live connection to the application.
+    struct JobProfiler final
+    {
+        static constexpr uint32_t kMaxWorkerCount = 64;
+        static constexpr uint32_t kMaxEventCapacity = 64 * 1024;
+        static constexpr uint32_t kDefaultEventCapacity = kMaxEventCapacity;
+
+        JobProfiler() = default;
+        ~JobProfiler();
+
+        JobProfiler(const JobProfiler&) = delete;
+        JobProfiler& operator=(const JobProfiler&) = delete;
+        JobProfiler(JobProfiler&&) = delete;
+        JobProfiler& operator=(JobProfiler&&) = delete;
+
+        void RegisterWorker(uint32_t workerIndex, festd::string_view name);
+
+        //! @brief Reset the statistics and start recording.
+        //!
+        //! The ring buffers are allocated at the maximum capacity on the first capture and are never reallocated, since
+        //! a worker that has seen the previous capture can still be recording an event when the next one starts.
+        //!
+        //! @param eventCapacity The number of events each worker can store before the oldest ones are overwritten.
+        //!                      Must not exceed kMaxEventCapacity.
+        void StartCapture(uint32_t eventCapacity = kDefaultEventCapacity);
+
+        //! @brief Stop recording. The events recorded by the jobs that are still running might be missing.
+        void StopCapture();
+
+        [[nodiscard]] bool IsCapturing() const
+        {
+            return m_capturing.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] JobWorkerStats GetWorkerStats(uint32_t workerIndex) const;
+
+        //! @brief Get the statistics summed over all the workers.
+        [[nodiscard]] JobWorkerStats GetTotalStats() const;
+
+        //! @brief Write the captured events as Chrome trace JSON. The capture must be stopped.
+        //!
+        //! @return True if the whole trace has been written to the stream.
+        bool ExportChromeTrace(IO::IStream* stream) const;
+
+        void RecordJob(uint32_t workerIndex, uint64_t scheduleTicks, uint64_t startTicks, uint64_t endTicks);
+        void RecordWait(uint32_t workerIndex, uint64_t startTicks, uint64_t endTicks);
+        void RecordIdle(uint32_t workerIndex, uint64_t startTicks, uint64_t endTicks);
+
+        void RecordSteal(const uint32_t workerIndex)
+        {
+            Increment(m_workers[workerIndex].m_stolenJobCount, 1);
+        }
+
+        void RecordFiberSwitch(const uint32_t workerIndex)
+        {
+            Increment(m_workers[workerIndex].m_fiberSwitchCount, 1);
+        }
+
+    private:
+        // Only the owning worker writes the counters, so they are updated without read-modify-write operations.
+        static void Increment(std::atomic<uint64_t>& counter, const uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        struct alignas(Memory::kCacheLineSize) WorkerData final
+        {
+            festd::fixed_string m_name;
+            bool m_registered = false;
+
+            JobTraceEvent* m_events = nullptr;
+            std::atomic<uint32_t> m_eventCapacity = 0;
+            std::atomic<uint64_t> m_eventCount = 0;
+
+            std::atomic<uint64_t> m_jobCount = 0;
+            std::atomic<uint64_t> m_stolenJobCount = 0;
+            std::atomic<uint64_t> m_fiberSwitchCount = 0;
+            std::atomic<uint64_t> m_parkCount = 0;
+            std::atomic<uint64_t> m_executionTicks = 0;
+            std::atomic<uint64_t> m_queueLatencyTicks = 0;
+            std::atomic<uint64_t> m_waitTicks = 0;
+            std::atomic<uint64_t> m_idleTicks = 0;
+        };
+
+        void AddEvent(WorkerData& worker, const JobTraceEvent& event);
+
+        std::atomic<bool> m_capturing = false;
+        std::atomic<uint64_t> m_captureStartTicks = 0;
+        WorkerData m_workers[kMaxWorkerCount];
+    };
+} // namespace FE
@@ -1,38 +1,49 @@
 ﻿#pragma once
+#include <FeCore/Containers/WorkStealingDeque.h>
+#include <FeCore/Jobs/FiberWaitQueue.h>
 #include <FeCore/Jobs/IJobSystem.h>
 #include <FeCore/Jobs/Job.h>
+#include <FeCore/Jobs/JobProfiler.h>
+#include <FeCore/Math/Random.h>
 #include <FeCore/Memory/PoolAllocator.h>
+#include <FeCore/Threading/EventCount.h>
 #include <FeCore/Threading/Fiber.h>
 #include <FeCore/Threading/Semaphore.h>
 #include <FeCore/Threading/Thread.h>
 
 namespace FE
 {
-    struct FiberWaitEntry final : public ConcurrentQueue::Node
-    {
-        FiberWaitEntry* m_queueTail = nullptr;
-        std::atomic<uint64_t> m_orderHint = 0;
-        FiberAffinityMask m_affinityMask = FiberAffinityMask::kNone;
-        Threading::FiberHandle m_fiber;
-        JobPriority m_priority = JobPriority::kNormal;
-        std::atomic<bool> m_switchCompleted = false;
-    };
-
-
     struct JobSystem final : public IJobSystem
     {
         FE_RTTI_Class(JobSystem, "6754DA31-46FA-4661-A46E-2787E6D9FD29");
 
         explicit JobSystem();
+        explicit JobSystem(uint32_t workerCount);
         ~JobSystem() override;
 
         void Start() override;
         void Stop() override;
         void Schedule(const JobScheduleInfo& info) override;
         FiberAffinityMask GetAffinityMaskForCurrentThread() const override;
+        uint32_t GetWorkerCount() const override;
+
+        //! @brief Get the job system that runs the current thread.
+        //!
+        //! @return The job system or null if the current thread is not one of the job system's workers.
+        [[nodiscard]] static JobSystem* GetCurrent()
+        {
+            return static_cast<JobSystem*>(Context::GetThreadState().m_scheduler);
+        }
+
+        //! @brief Get the profiler that records the activity of the workers when a capture is in progress.
+        [[nodiscard]] JobProfiler& GetProfiler()
+        {
+            return m_profiler;
+        }
 
     private:
         friend struct WaitGroup;
+        friend struct FiberWaitQueue;
 
         void SwitchFromWaitingFiber(const uint32_t workerIndex, FiberWaitEntry& entry)
         {
@@ -41,10 +52,16 @@ namespace FE
             worker.m_prevFiber = worker.m_currentFiber;
             worker.m_currentFiber = m_fiberPool.Rent(false);
 
+            const uint64_t waitStartTicks = m_profiler.IsCapturing() ? Platform::GetTicks() : 0;
+
             const char* switchMessage = worker.m_name.c_str();
             const Context::TransferParams tp =
                 m_fiberPool.Switch(worker.m_currentFiber, reinterpret_cast<uintptr_t>(this), switchMessage);
             CleanUpAfterSwitch(tp);
+
+            // The fiber might have been resumed by a different worker.
+            if (waitStartTicks != 0 && m_profiler.IsCapturing())
+                m_profiler.RecordWait(GetWorkerIndex(), waitStartTicks, Platform::GetTicks());
         }
 
         void AddReadyFiber(FiberWaitEntry* entry);
@@ -53,6 +70,16 @@ namespace FE
         {
             const uint32_t workerIndex = GetWorkerIndex();
             Worker& worker = m_workers[workerIndex];
+
+            if (m_profiler.IsCapturing())
+                m_profiler.RecordFiberSwitch(workerIndex);
+
+            // The only switches without a previous fiber are the ones from the thread's own context in ThreadProc()
+            // and Start(). The fiber we've switched to can be a recycled one that doesn't start from FiberProc(),
+            // so the context to return to on exit must be saved here.
+            if (!worker.m_prevFiber)
+                worker.m_exitContext = transferParams.m_contextHandle;
+
             m_fiberPool.Update(worker.m_prevFiber, transferParams.m_contextHandle);
 
             if (worker.m_lastWaitEntry)
@@ -69,48 +96,94 @@ namespace FE
             worker.m_prevFiber.Reset();
         }
 
+        static constexpr uint32_t kMaxWorkerCount = 64;
+        static constexpr uint32_t kLocalJobQueueCapacity = 1024;
+        static constexpr uint32_t kGlobalQueueCapacity = 1024;
+        static constexpr uint32_t kPriorityCount = festd::to_underlying(JobPriority::kCount);
+
+        // The number of times an idle worker polls the queues before parking, adjusted based on
+        // whether spinning has recently been useful.
+        static constexpr uint32_t kMinSpinAttemptCount = 2;
+        static constexpr uint32_t kMaxSpinAttemptCount = 16;
+
         struct alignas(Memory::kCacheLineSize) Worker final
         {
             uint64_t m_threadId = 0;
             Threading::ThreadHandle m_thread;
             festd::fixed_string m_name;
             Context::Handle m_exitContext;
+            JobSystem* m_jobSystem = nullptr;
+            uint32_t m_index = kInvalidIndex;
 
             Threading::FiberHandle m_prevFiber;
             Threading::FiberHandle m_currentFiber;
             FiberWaitEntry* m_lastWaitEntry = nullptr;
 
+            // A job that needs a large stack, handed over to a large fiber by the fiber that found it.
+            Job* m_pendingJob = nullptr;
+            FiberAffinityMask m_pendingJobAffinityMask = FiberAffinityMask::kNone;
+
             JobThreadPoolType m_threadPoolType = JobThreadPoolType::kGeneric;
             JobPriority m_priority = JobPriority::kNormal;
             FiberAffinityMask m_affinityMask = FiberAffinityMask::kNone;
 
+            // Only touched by the worker itself, used to pick a random victim to steal from.
+            DefaultRandom m_random;
+            uint32_t m_spinAttemptCount = kMaxSpinAttemptCount;
+
+            // Idle workers sleep on this event until someone adds work that they can process.
+            Threading::EventCount m_parkingEvent;
+
             // Jobs in these queues can only be processed by this worker (due to affinity).
-            ConcurrentQueue m_jobQueues[festd::to_underlying(JobPriority::kCount)] = {};
-            ConcurrentQueue m_readyFiberQueues[festd::to_underlying(JobPriority::kCount)] = {};
+            MPSCQueue m_jobQueues[kPriorityCount] = {};
+            MPSCQueue m_readyFiberQueues[kPriorityCount] = {};
+
+            // Jobs scheduled by this worker. The worker pushes and pops them in LIFO order,
+            // idle workers steal them in FIFO order.
+            // The generic deques can be stolen from by any worker, the thread pool deques can only
+            // be stolen from by the workers of the same thread pool.
+            WorkStealingDeque<Job> m_genericJobDeques[kPriorityCount];
+            WorkStealingDeque<Job> m_threadPoolJobDeques[kPriorityCount];
         };
 
+        // Shared queues for the jobs scheduled from non-worker threads or when a worker's deque is full.
+        // Ready fibers always go here since they can be resumed by any worker of the thread pool.
+        // The queues work in the bounded ring mode, so that they don't take a lock unless they overflow.
         struct alignas(Memory::kCacheLineSize) GlobalQueueSet final
         {
-            Threading::SpinLock m_consumerLocks[festd::to_underlying(JobThreadPoolType::kCount)] = {};
             ConcurrentQueue m_jobQueues[festd::to_underlying(JobThreadPoolType::kCount)] = {};
             ConcurrentQueue m_readyFiberQueues[festd::to_underlying(JobThreadPoolType::kCount)] = {};
         };
 
-        std::atomic<uint64_t> m_jobCounter = 0;
-        GlobalQueueSet m_globalQueues[festd::to_underlying(JobPriority::kCount)];
+        GlobalQueueSet m_globalQueues[kPriorityCount];
 
-        static constexpr uint32_t kMaxWorkerCount = 64;
         festd::array<Worker, kMaxWorkerCount> m_workers;
         Threading::FiberPool m_fiberPool;
+        JobProfiler m_profiler;
 
         uint32_t m_backgroundWorkerCount = 0;
         uint32_t m_foregroundWorkerCount = 0;
+        uint64_t m_activeWorkerMask = 0;
+        std::atomic<uint64_t> m_parkedWorkerMask = 0;
 
         Threading::Semaphore m_semaphore;
-        std::atomic<bool> m_shouldExit;
+        std::atomic<bool> m_shouldExit = false;
 
-        uint32_t GetWorkerIndex() const
+        void EnterThread(Worker& worker)
+        {
+            Context::ThreadState& threadState = Context::GetThreadState();
+            threadState.m_scheduler = this;
+            threadState.m_workerData = &worker;
+            threadState.m_workerIndex = worker.m_index;
+        }
+
+        uint32_t FindWorkerIndex() const
         {
+            const Context::ThreadState& threadState = Context::GetThreadState();
+            if (threadState.m_scheduler == this)
+                return threadState.m_workerIndex;
+
+            // Only the threads that haven't entered the job system yet get here, e.g. the main thread before Start().
             const uint64_t threadID = Threading::GetCurrentThreadID();
             for (uint32_t threadIndex = 0; threadIndex < m_workers.size(); ++threadIndex)
             {
@@ -118,10 +191,30 @@ namespace FE
                     return threadIndex;
             }
 
-            FE_Assert(0, "Thread not found");
             return kInvalidIndex;
         }
 
+        uint32_t GetWorkerIndex() const
+        {
+            const uint32_t workerIndex = FindWorkerIndex();
+            FE_Assert(workerIndex != kInvalidIndex, "Thread not found");
+            return workerIndex;
+        }
+
+        Job* TryGetLocalJob(Worker& worker, uint32_t priorityIndex, FiberAffinityMask& affinityMask);
+        Job* TryStealJob(Worker& worker, uint32_t priorityIndex, FiberAffinityMask& affinityMask);
+        FiberWaitEntry* TryGetReadyFiber(Worker& worker, uint32_t priorityIndex);
+        bool TryFindWork(Worker& worker, FiberWaitEntry*& waitEntry, Job*& job, FiberAffinityMask& affinityMask);
+
+        //! @brief Put the worker to sleep until someone calls WakeWorker() with a matching affinity mask.
+        //!
+        //! @return True if the worker has found work right before going to sleep.
+        bool Park(Worker& worker, FiberWaitEntry*& waitEntry, Job*& job, FiberAffinityMask& affinityMask);
+
+        //! @brief Wake up one of the parked workers that can process work with the specified affinity.
+        void WakeWorker(FiberAffinityMask affinityMask);
+        void WakeAllWorkers();
+
         void ThreadProc(uint32_t workerIndex);
         void FiberProc(Context::TransferParams transferParams);
 
@@ -0,0 +1,152 @@
+﻿#pragma once
+#include <FeCore/Jobs/Job.h>
+#include <FeCore/Memory/FiberTempAllocator.h>
+#include <festd/span.h>
+
+namespace FE
+{
+    namespace Internal
+    {
+        template<class TFunc>
+        struct ParallelForContext;
+
+
+        template<class TFunc>
+        struct ParallelForJob final : public Job
+        {
+            void Execute() override
+            {
+                m_context->ExecuteRange(m_begin, m_end);
+            }
+
+            ParallelForContext<TFunc>* m_context = nullptr;
+            uint32_t m_begin = 0;
+            uint32_t m_end = 0;
+        };
+
+
+        template<class TFunc>
+        struct ParallelForContext final
+        {
+            IJobSystem* m_jobSystem = nullptr;
+            TFunc* m_func = nullptr;
+            WaitGroup* m_waitGroup = nullptr;
+            ParallelForJob<TFunc>* m_jobs = nullptr;
+            uint32_t m_maxJobCount = 0;
+            uint32_t m_grainSize = 1;
+            FiberAffinityMask m_affinityMask = FiberAffinityMask::kAll;
+            std::atomic<uint32_t> m_jobCount = 0;
+
+            void ExecuteRange(const uint32_t begin, uint32_t end)
+            {
+                // Split off the upper half of the range as a new job until the rest is no larger than the grain.
+                // The jobs are split only when they start running, so a range that has been stolen by an idle worker
+                // is split further, while a busy worker mostly processes its own range without splitting it.
+                while (end - begin > m_grainSize)
+                {
+                    const uint32_t middle = begin + (end - begin) / 2;
+                    const uint32_t jobIndex = m_jobCount.fetch_add(1, std::memory_order_relaxed);
+                    FE_AssertDebug(jobIndex < m_maxJobCount);
+
+                    auto* job = new (&m_jobs[jobIndex]) ParallelForJob<TFunc>;
+                    job->m_context = this;
+                    job->m_begin = middle;
+                    job->m_end = end;
+
+                    // We are still holding our own counter, so the wait group cannot be signaled before the job is added.
+                    m_waitGroup->Add(1);
+                    job->Schedule(m_jobSystem, m_affinityMask, m_waitGroup);
+                    end = middle;
+                }
+
+                for (uint32_t index = begin; index < end; ++index)
+                    (*m_func)(index);
+            }
+        };
+    } // namespace Internal
+
+
+    //! @brief The number of ranges per worker ParallelFor() aims for when the grain size is not specified.
+    inline constexpr uint32_t kParallelForRangesPerWorker = 4;
+
+
+    //! @brief Call a function for every index in [0, count) using the job system and wait for all calls to complete.
+    //!
+    //! The range is recursively split in halves until the parts are no larger than the grain size. The calling fiber
+    //! processes the first part itself and then waits on a WaitGroup, so the worker can execute other jobs in the meantime.
+    //! Must be called from a fiber.
+    //!
+    //! @param jobSystem    The job system to schedule the jobs to.
+    //! @param count        The number of indices.
+    //! @param func         The function to call, must accept a uint32_t index. Called concurrently from multiple threads.
+    //! @param grainSize    The maximum number of indices to process in a single job, or 0 to pick it automatically.
+    //! @param affinityMask The threads the jobs are allowed to run on.
+    template<class TFunc>
+    void ParallelFor(IJobSystem* jobSystem, const uint32_t count, TFunc&& func, uint32_t grainSize = 0,
+                     const FiberAffinityMask affinityMask = FiberAffinityMask::kAll)
+    {
+        FE_PROFILER_ZONE();
+
+        if (grainSize == 0)
+            grainSize = Math::Max(1u, count / (jobSystem->GetWorkerCount() * kParallelForRangesPerWorker));
+
+        if (count <= grainSize)
+        {
+            for (uint32_t index = 0; index < count; ++index)
+                func(index);
+
+            return;
+        }
+
+        using Context = Internal::ParallelForContext<std::remove_reference_t<TFunc>>;
+        using RangeJob = Internal::ParallelForJob<std::remove_reference_t<TFunc>>;
+
+        // Every part is at least half the grain size, so there are at most 2 * count / grainSize parts.
+        const uint64_t maxJobCount = Math::CeilDivide(UINT64_C(2) * count, grainSize);
+
+        Memory::FiberTempAllocator temp;
+        const Rc waitGroup = WaitGroup::Create(1);
+
+        // The fiber temporary allocator can't allocate more than a page, large job arrays go to the heap.
+        RangeJob* jobs = Memory::AllocateArray<RangeJob>(&temp, maxJobCount);
+        const bool heapAllocatedJobs = jobs == nullptr;
+        if (heapAllocatedJobs)
+            jobs = Memory::DefaultAllocateArray<RangeJob>(maxJobCount);
+
+        Context context;
+        context.m_jobSystem = jobSystem;
+        context.m_func = &func;
+        context.m_waitGroup = waitGroup.Get();
+        context.m_jobs = jobs;
+        context.m_maxJobCount = static_cast<uint32_t>(maxJobCount);
+        context.m_grainSize = grainSize;
+        context.m_affinityMask = affinityMask;
+
+        context.ExecuteRange(0, count);
+        waitGroup->Signal();
+        waitGroup->Wait();
+
+        const uint32_t jobCount = context.m_jobCount.load(std::memory_order_acquire);
+        for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+            jobs[jobIndex].~RangeJob();
+
+        if (heapAllocatedJobs)
+            Memory::DefaultFree(jobs);
+    }
+
+
+    //! @brief Call a function for every element of a span using the job system and wait for all calls to complete.
+    //!
+    //! @see ParallelFor()
+    template<class T, class TFunc>
+    void ParallelForEach(IJobSystem* jobSystem, const festd::span<T> elements, TFunc&& func, const uint32_t grainSize = 0,
+                         const FiberAffinityMask affinityMask = FiberAffinityMask::kAll)
+    {
+        T* data = elements.data();
+        const auto elementFunc = [data, &func](const uint32_t index) {
+            func(data[index]);
+        };
+
+        ParallelFor(jobSystem, static_cast<uint32_t>(elements.size()), elementFunc, grainSize, affinityMask);
+    }
+} // namespace FE
@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <FeCore/Containers/SegmentedVector.h>
+#include <FeCore/Jobs/Job.h>
+#include <festd/vector.h>
+
+namespace FE
+{
+    struct TaskGraphNodeHandle final : TypedHandle<TaskGraphNodeHandle, uint32_t>
+    {
+    };
+
+
+    //! @brief A reusable graph of jobs with dependencies between them.
+    //!
+    //! Each node is scheduled to the job system as soon as all of its dependencies complete, so no fiber has to wait
+    //! for them. The graph is built once and can be scheduled any number of times, e.g. once every frame,
+    //! but only one run of the graph can be in progress at a time.
+    struct TaskGraph final
+    {
+        explicit TaskGraph(std::pmr::memory_resource* allocator = nullptr);
+        ~TaskGraph();
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+        TaskGraph(TaskGraph&&) = delete;
+        TaskGraph& operator=(TaskGraph&&) = delete;
+
+        //! @brief Add a node that executes the specified job. The job must outlive the graph.
+        //!
+        //! The node runs on a fiber with the stack size requested by the job.
+        TaskGraphNodeHandle AddNode(Job* job, FiberAffinityMask affinityMask = FiberAffinityMask::kAll,
+                                    JobPriority priority = JobPriority::kNormal);
+
+        //! @brief Add a node that calls the specified function. The function is owned by the graph.
+        template<class TFunc, class = std::enable_if_t<!std::is_convertible_v<TFunc, Job*>>>
+        TaskGraphNodeHandle AddNode(TFunc&& func, const FiberAffinityMask affinityMask = FiberAffinityMask::kAll,
+                                    const JobPriority priority = JobPriority::kNormal,
+                                    const JobStackSize stackSize = JobStackSize::kSmall)
+        {
+            using FunctorJobType = FunctorJob<std::decay_t<TFunc>>;
+            auto* job = Memory::DefaultNew<FunctorJobType>(std::decay_t<TFunc>(std::forward<TFunc>(func)), stackSize);
+            m_ownedJobs.push_back(job);
+            return AddNode(static_cast<Job*>(job), affinityMask, priority);
+        }
+
+        //! @brief Make a node wait until another node completes.
+        //!
+        //! @param node       The node that depends on the other node.
+        //! @param dependency The node that must complete before the first one is scheduled.
+        void AddDependency(TaskGraphNodeHandle node, TaskGraphNodeHandle dependency);
+
+        //! @brief Schedule all the nodes that don't have dependencies, the rest is scheduled as the dependencies complete.
+        //!
+        //! @param jobSystem           The job system to schedule the jobs to.
+        //! @param completionWaitGroup The wait group to signal when all the nodes have completed.
+        void Schedule(IJobSystem* jobSystem, WaitGroup* completionWaitGroup = nullptr);
+
+        //! @brief Schedule the graph and wait for it to complete. Must be called from a fiber.
+        void Run(IJobSystem* jobSystem);
+
+        [[nodiscard]] bool IsRunning() const
+        {
+            return m_pendingNodeCount.load(std::memory_order_acquire) != 0;
+        }
+
+        [[nodiscard]] uint32_t GetNodeCount() const
+        {
+            return m_nodes.size();
+        }
+
+    private:
+        struct Node final : public Job
+        {
+            explicit Node(const JobStackSize stackSize)
+                : Job(stackSize)
+            {
+            }
+
+            void Execute() override;
+
+            TaskGraph* m_graph = nullptr;
+            Job* m_job = nullptr;
+            FiberAffinityMask m_affinityMask = FiberAffinityMask::kAll;
+            JobPriority m_priority = JobPriority::kNormal;
+            uint32_t m_dependencyCount = 0;
+            std::atomic<uint32_t> m_pendingDependencyCount = 0;
+            festd::inline_vector<uint32_t, 4> m_dependentNodes;
+        };
+
+        void ScheduleNode(Node& node);
+        void OnNodeCompleted(const Node& node);
+        [[nodiscard]] bool HasCycles() const;
+
+        std::pmr::memory_resource* m_allocator = nullptr;
+        SegmentedVector<Node> m_nodes;
+        festd::vector<uint32_t> m_rootNodes;
+        festd::vector<Job*> m_ownedJobs;
+        IJobSystem* m_jobSystem = nullptr;
+        Rc<WaitGroup> m_completionWaitGroup;
+        std::atomic<uint32_t> m_pendingNodeCount = 0;
+        bool m_validated = false;
+    };
+} // namespace FE
@@ -0,0 +1,115 @@
+﻿#pragma once
+#include <FeCore/Containers/ConcurrentQueue.h>
+#include <FeCore/Memory/LinearAllocator.h>
+
+namespace FE::Memory
+{
+    //! @brief N-buffered arena for the data that has to live for a fixed number of frames.
+    //!
+    //! Every thread bumps a pointer in its own LinearAllocator, so allocating doesn't take any locks. The memory allocated
+    //! during a frame stays valid until the same buffer is reused frameCount frames later, at which point it is all
+    //! released at once. The pages are kept between the frames, so in a steady state the allocator doesn't touch the heap.
+    //! Individual allocations are never freed and the destructors of the allocated objects are never called.
+    struct FrameAllocator final : public RefCountedObjectBase
+    {
+        FE_RTTI_Class(FrameAllocator, "36E7D828-7976-4B72-A814-5595368842FC");
+
+        static constexpr uint32_t kMaxFrameCount = 4;
+        static constexpr uint32_t kDefaultFrameCount = 2;
+        static constexpr size_t kDefaultPageByteSize = 256 * 1024;
+
+        //! @param frameCount   The number of frames the allocations live for, at least two.
+        //! @param pageByteSize The size of the pages of the per-thread allocators.
+        //! @param tag          The memory tag to account the pages to.
+        explicit FrameAllocator(uint32_t frameCount = kDefaultFrameCount, size_t pageByteSize = kDefaultPageByteSize,
+                                Tag tag = Tag::kUntagged);
+        ~FrameAllocator() override;
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+        FrameAllocator(FrameAllocator&&) = delete;
+        FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+        //! @brief Start a new frame and release everything allocated during the frame that used the same buffer.
+        //!
+        //! The allocations made frameCount - 1 frames ago are released, so all the jobs that use them must have finished
+        //! by the time this function is called. Must not be called concurrently with itself.
+        void BeginFrame();
+
+        //! @brief Free the pages that were not used during the last frameCount frames.
+        //!
+        //! Must be called at the same point of a frame as BeginFrame(), e.g. after a spike in the memory usage.
+        void FreeUnusedMemory();
+
+        [[nodiscard]] uint64_t GetFrameIndex() const
+        {
+            return m_frameIndex.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] void* Allocate(size_t byteSize, size_t byteAlignment = kDefaultAlignment);
+
+        template<class T>
+        [[nodiscard]] festd::span<T> AllocateArray(const uint32_t elementCount)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "Destructors of the frame allocations are never called");
+            T* data = static_cast<T*>(Allocate(elementCount * sizeof(T), alignof(T)));
+            return { data, elementCount };
+        }
+
+        template<class T, class... TArgs>
+        [[nodiscard]] T* New(TArgs&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "Destructors of the frame allocations are never called");
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+        }
+
+        //! @brief Get a memory resource that allocates from the current frame, e.g. to use with containers.
+        [[nodiscard]] std::pmr::memory_resource* GetMemoryResource()
+        {
+            return &m_memoryResource;
+        }
+
+    private:
+        struct FrameMemoryResource final : public std::pmr::memory_resource
+        {
+            FrameAllocator* m_owner = nullptr;
+
+        private:
+            void* do_allocate(const size_t byteSize, const size_t byteAlignment) override
+            {
+                return m_owner->Allocate(byteSize, byteAlignment);
+            }
+
+            void do_deallocate(void*, size_t, size_t) override {}
+
+            [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        struct FrameData final
+        {
+            // Only the thread that owns the slot allocates from its allocator.
+            std::atomic<LinearAllocator*> m_threadAllocators[Internal::kMaxThreadSlotCount] = {};
+
+            // Used by the threads that didn't get a slot.
+            Threading::SpinLock m_sharedAllocatorLock;
+            LinearAllocator* m_sharedAllocator = nullptr;
+
+            // The allocations too large for the pages, freed when the frame is reset.
+            ConcurrentOnceConsumedQueue m_largeAllocations;
+        };
+
+        TaggedMemoryResource m_pageAllocator;
+        FrameMemoryResource m_memoryResource;
+        size_t m_pageByteSize = 0;
+        uint32_t m_frameCount = 0;
+        std::atomic<uint64_t> m_frameIndex = 0;
+        FrameData m_frames[kMaxFrameCount];
+
+        void* AllocateLarge(FrameData& frame, size_t byteSize, size_t byteAlignment);
+        LinearAllocator* CreateThreadAllocator(FrameData& frame, uint32_t slot);
+        void ResetFrame(FrameData& frame);
+    };
+} // namespace FE::Memory
@@ -70,7 +70,7 @@ namespace FE::Memory
         [[nodiscard]] bool IsEmpty() const
         {
             return m_currentMarker.m_page == nullptr
-                || m_currentMarker.m_offset == sizeof(Page) && m_currentMarker.m_page == m_firstPage;
+                || (m_currentMarker.m_offset == sizeof(Page) && m_currentMarker.m_page == m_firstPage);
         }
 
         [[nodiscard]] Marker GetMarker() const
@@ -104,9 +104,12 @@ namespace FE::Memory
         if (!m_currentMarker.m_page)
             NewPage();
 
-        const size_t newOffset = AlignUp(m_currentMarker.m_offset, byteAlignment) + byteSize;
+        size_t newOffset = AlignUp(m_currentMarker.m_offset, byteAlignment) + byteSize;
         if (newOffset > m_pageByteSize)
+        {
             NewPage();
+            newOffset = AlignUp(m_currentMarker.m_offset, byteAlignment) + byteSize;
+        }
 
         m_currentMarker.m_offset = newOffset;
         return reinterpret_cast<uint8_t*>(m_currentMarker.m_page) + newOffset - byteSize;
@@ -43,6 +43,92 @@ namespace FE
 
         void AssertPointerIsValid(const void* ptr);
 
+        //! @brief Set which debug heap allocations record their call stacks for leak and use-after-free reports.
+        //!
+        //! @param sampleRate  Capture the call stack of every Nth allocation made on a thread, 1 captures all of them.
+        //! @param minByteSize Always capture the call stacks of allocations of at least this many bytes.
+        void SetDebugHeapCallStackSampling(uint32_t sampleRate, size_t minByteSize);
+
+
+        namespace Internal
+        {
+            inline constexpr uint32_t kMaxThreadSlotCount = 128;
+
+            //! @brief Get a small index unique among the running threads, used to index per-thread data.
+            //!
+            //! The slot is released when the thread exits and can then be taken by another thread.
+            //!
+            //! @return The slot index or kInvalidIndex if all the slots are taken.
+            uint32_t GetThreadSlot();
+        } // namespace Internal
+
+
+        //! @brief Subsystem that the memory usage is accounted to.
+        enum class Tag : uint32_t
+        {
+            kUntagged,
+            kJobs,
+            kIO,
+            kAssets,
+            kECS,
+            kFrameGraph,
+            kGraphics,
+            kCount,
+        };
+
+
+        [[nodiscard]] const char* GetTagName(Tag tag);
+
+
+        struct TagStats final
+        {
+            int64_t m_liveByteSize = 0;
+            int64_t m_peakByteSize = 0;
+
+            //! @brief The number of allocations since startup, sample it periodically to get the allocation rate.
+            uint64_t m_allocationCount = 0;
+
+            //! @brief The number of bytes allocated since startup.
+            uint64_t m_allocatedByteSize = 0;
+        };
+
+
+        enum class BudgetLevel : uint32_t
+        {
+            kSoft,
+            kHard,
+        };
+
+
+        using BudgetCallback = void (*)(Tag tag, BudgetLevel level, int64_t liveByteSize, void* userData);
+
+
+        //! @brief Memory budget of a tag.
+        //!
+        //! The callback is invoked on the allocating thread once each time the live size of the tag goes over one of
+        //! the limits. The limits are checked when the per-thread counters are flushed, so they can be exceeded by up
+        //! to a few hundred kilobytes before the callback is invoked.
+        struct Budget final
+        {
+            size_t m_softByteSize = 0; //!< Zero means no limit.
+            size_t m_hardByteSize = 0; //!< Zero means no limit.
+            BudgetCallback m_callback = nullptr;
+            void* m_userData = nullptr;
+        };
+
+
+        //! @brief Account an allocation to a tag.
+        //!
+        //! Only updates a counter of the current thread most of the time, cheap enough to call for every allocation.
+        void TrackAllocation(Tag tag, size_t byteSize);
+
+        //! @brief Account a deallocation to a tag. Can be called on a different thread than TrackAllocation().
+        void TrackFree(Tag tag, size_t byteSize);
+
+        [[nodiscard]] TagStats GetTagStats(Tag tag);
+
+        void SetBudget(Tag tag, const Budget& budget);
+
 
         //! @brief Allocate an uninitialized array using the provided allocator.
         template<class T, class TAllocator>
@@ -136,6 +222,36 @@ namespace FE
         using SpinLockedMemoryResource = LockedMemoryResource<TBase, Threading::SpinLock>;
 
 
+        //! @brief A memory resource that accounts the allocations of another memory resource to a tag.
+        //!
+        //! The size of every allocation is stored in front of it, so the memory can be freed without specifying the size.
+        struct TaggedMemoryResource final : public std::pmr::memory_resource
+        {
+            explicit TaggedMemoryResource(const Tag tag, std::pmr::memory_resource* upstream = nullptr)
+                : m_upstream(upstream ? upstream : std::pmr::get_default_resource())
+                , m_tag(tag)
+            {
+            }
+
+            [[nodiscard]] Tag GetTag() const
+            {
+                return m_tag;
+            }
+
+        private:
+            std::pmr::memory_resource* m_upstream;
+            Tag m_tag;
+
+            void* do_allocate(size_t byteSize, size_t byteAlignment) override;
+            void do_deallocate(void* ptr, size_t byteSize, size_t byteAlignment) override;
+
+            [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+
         struct FixedBlockAllocator final : public std::pmr::memory_resource
         {
             FixedBlockAllocator(void* memory, const size_t size)
@@ -240,8 +356,9 @@ namespace FE
         };
 
 
+        // Not final: libstdc++ containers derive from their allocator to apply the empty base optimization.
         template<class T, class TSizeType = size_t>
-        class StdDefaultAllocator final
+        class StdDefaultAllocator
         {
         public:
             using value_type = T;
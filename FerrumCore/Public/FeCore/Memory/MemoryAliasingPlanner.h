@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <FeCore/Memory/Memory.h>
+#include <festd/vector.h>
+
+namespace FE::Memory
+{
+    //! @brief Places resources with known lifetimes into a single memory range.
+    //!
+    //! Resources that are never alive at the same time are allowed to share memory. Lifetimes are inclusive
+    //! intervals of abstract time points, e.g. frame graph pass indices. The planner doesn't allocate any
+    //! memory itself, it only calculates the offsets and the size of the memory range.
+    struct MemoryAliasingPlanner final
+    {
+        MemoryAliasingPlanner() = default;
+        explicit MemoryAliasingPlanner(std::pmr::memory_resource* allocator);
+
+        //! @brief Add a resource to the plan.
+        //!
+        //! @param byteSize      The size of the resource in bytes.
+        //! @param byteAlignment The required alignment of the resource offset, must be a power of two.
+        //! @param firstUse      The first time point the resource is used at.
+        //! @param lastUse       The last time point the resource is used at.
+        //!
+        //! @return The index of the added resource.
+        uint32_t AddResource(uint64_t byteSize, uint64_t byteAlignment, uint32_t firstUse, uint32_t lastUse);
+
+        //! @brief Calculate the offsets of all the added resources.
+        void Plan();
+
+        //! @brief Remove all the resources, but keep the allocated memory for the next plan.
+        void Clear();
+
+        //! @brief Get the offset of a resource in the memory range. Only valid after Plan() was called.
+        [[nodiscard]] uint64_t GetOffset(const uint32_t resourceIndex) const
+        {
+            FE_AssertDebug(m_planned);
+            return m_resources[resourceIndex].m_offset;
+        }
+
+        //! @brief Get the size of the memory range required to hold all the resources. Only valid after Plan() was called.
+        [[nodiscard]] uint64_t GetByteSize() const
+        {
+            FE_AssertDebug(m_planned);
+            return m_byteSize;
+        }
+
+        //! @brief Get the size of the memory that would be required if the resources didn't share memory.
+        [[nodiscard]] uint64_t GetUnaliasedByteSize() const
+        {
+            return m_unaliasedByteSize;
+        }
+
+        [[nodiscard]] uint32_t GetResourceCount() const
+        {
+            return m_resources.size();
+        }
+
+    private:
+        struct Resource final
+        {
+            uint64_t m_byteSize = 0;
+            uint64_t m_byteAlignment = 0;
+            uint64_t m_offset = Constants::kMaxU64;
+            uint32_t m_firstUse = 0;
+            uint32_t m_lastUse = 0;
+        };
+
+        struct Range final
+        {
+            uint64_t m_begin = 0;
+            uint64_t m_end = 0;
+        };
+
+        festd::pmr::vector<Resource> m_resources;
+        festd::pmr::vector<uint32_t> m_placementOrder;
+        festd::pmr::vector<Range> m_occupiedRanges;
+        uint64_t m_byteSize = 0;
+        uint64_t m_unaliasedByteSize = 0;
+        bool m_planned = false;
+    };
+} // namespace FE::Memory
@@ -0,0 +1,134 @@
+﻿#pragma once
+#include <FeCore/Memory/Memory.h>
+#include <FeCore/Threading/SpinLock.h>
+
+namespace FE::Memory
+{
+    //! @brief Pool allocator with multiple size classes and per-thread caches.
+    //!
+    //! Allocations of up to kMaxByteSize bytes are rounded up to one of the size classes and served from the free list
+    //! of the current thread without any synchronization. A block can be freed on any thread, it then goes to the cache
+    //! of the freeing thread. When a thread cache holds too many blocks of a size class, a batch of them is returned
+    //! to a lock-free central list, from where another thread can take the whole batch at once.
+    //!
+    //! The pages are committed from a single reserved range of virtual memory, so the size class of a block is known
+    //! from its address and the blocks can be freed without specifying their size. Larger or over-aligned allocations,
+    //! as well as the allocations made after the reserved range is exhausted, are forwarded to the default allocator.
+    //!
+    //! The committed pages and the forwarded allocations are accounted to the memory tag of the allocator.
+    struct ThreadCachedPoolAllocator final : public std::pmr::memory_resource
+    {
+        static constexpr size_t kMaxByteSize = 2048;
+        static constexpr uint32_t kSizeClassCount = 24;
+        static constexpr uint32_t kMaxThreadCacheCount = Internal::kMaxThreadSlotCount;
+
+        //! @param name             The name of the allocator shown in the profiler.
+        //! @param tag              The memory tag to account the allocations to.
+        //! @param reserveByteSize  The size of the virtual memory range to reserve for the pages.
+        //! @param pageByteSize     The size of a page, must be a power of two. A page only holds blocks of one size class.
+        ThreadCachedPoolAllocator(const char* name, Tag tag, size_t reserveByteSize = 256 * 1024 * 1024,
+                                  uint32_t pageByteSize = 64 * 1024);
+        ~ThreadCachedPoolAllocator() override;
+
+        ThreadCachedPoolAllocator(const ThreadCachedPoolAllocator&) = delete;
+        ThreadCachedPoolAllocator& operator=(const ThreadCachedPoolAllocator&) = delete;
+        ThreadCachedPoolAllocator(ThreadCachedPoolAllocator&&) = delete;
+        ThreadCachedPoolAllocator& operator=(ThreadCachedPoolAllocator&&) = delete;
+
+        [[nodiscard]] static uint32_t GetSizeClass(const size_t byteSize)
+        {
+            FE_CoreAssertDebug(byteSize <= kMaxByteSize);
+            if (byteSize <= 128)
+                return static_cast<uint32_t>(Math::Max<size_t>(byteSize, 1) - 1) / 16;
+
+            // Above 128 bytes, every power of two range is split into four size classes.
+            const uint32_t value = static_cast<uint32_t>(byteSize - 1);
+            const uint32_t log = Math::FloorLog2(value);
+            return 8 + (log - 7) * 4 + ((value >> (log - 2)) & 3);
+        }
+
+        [[nodiscard]] static uint32_t GetSizeClassByteSize(const uint32_t sizeClass)
+        {
+            FE_CoreAssertDebug(sizeClass < kSizeClassCount);
+            if (sizeClass < 8)
+                return (sizeClass + 1) * 16;
+
+            const uint32_t group = (sizeClass - 8) / 4;
+            return (128 << group) + ((sizeClass - 8) % 4 + 1) * (32 << group);
+        }
+
+        //! @brief Get the number of pages committed so far.
+        [[nodiscard]] uint32_t GetPageCount() const
+        {
+            return Math::Min(m_pageCount.load(std::memory_order_relaxed), m_maxPageCount);
+        }
+
+    private:
+        struct SizeClassCache final
+        {
+            void* m_head = nullptr;
+            uint32_t m_count = 0;
+        };
+
+        struct alignas(kCacheLineSize) ThreadCache final
+        {
+            SizeClassCache m_sizeClasses[kSizeClassCount];
+        };
+
+        struct alignas(kCacheLineSize) CentralList final
+        {
+            // A stack of full batches. The upper 16 bits of the head hold a counter that protects against ABA.
+            std::atomic<uint64_t> m_batches = 0;
+
+            // The page that new blocks of this size class are carved from.
+            Threading::SpinLock m_pageLock;
+            std::byte* m_pageCurrent = nullptr;
+            std::byte* m_pageEnd = nullptr;
+        };
+
+        const char* m_name = nullptr;
+        Tag m_tag = Tag::kUntagged;
+        std::byte* m_memory = nullptr;
+        size_t m_reserveByteSize = 0;
+        uint32_t m_pageByteSize = 0;
+        uint32_t m_pageSizeLog = 0;
+        uint32_t m_maxPageCount = 0;
+        uint8_t* m_pageSizeClasses = nullptr;
+        std::atomic<uint32_t> m_pageCount = 0;
+
+        CentralList m_centralLists[kSizeClassCount];
+        std::atomic<ThreadCache*> m_threadCaches[kMaxThreadCacheCount] = {};
+
+        // Used by the threads that didn't get a slot.
+        Threading::SpinLock m_sharedCacheLock;
+        ThreadCache m_sharedCache;
+
+#if FE_DEBUG
+        // Used to ensure we don't destroy the allocator while it's still in use.
+        std::atomic<int64_t> m_allocationCount = 0;
+#endif
+
+        [[nodiscard]] bool Contains(const void* ptr) const
+        {
+            return ptr >= m_memory && ptr < m_memory + m_reserveByteSize;
+        }
+
+        ThreadCache& GetThreadCache(uint32_t slot);
+
+        void* AllocateFromCache(ThreadCache& cache, uint32_t sizeClass);
+        void FreeToCache(ThreadCache& cache, uint32_t sizeClass, void* ptr);
+
+        void* AllocateFallback(size_t byteSize, size_t byteAlignment) const;
+
+        bool Refill(SizeClassCache& cache, uint32_t sizeClass);
+        void ReleaseBatch(SizeClassCache& cache, uint32_t sizeClass);
+
+    protected:
+        void* do_allocate(size_t byteSize, size_t byteAlignment) override;
+        void do_deallocate(void* ptr, size_t byteSize, size_t byteAlignment) override;
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace FE::Memory
@@ -518,11 +518,13 @@ namespace FE::Str
             return m_data;
         }
 
+#if FE_PLATFORM_WINDOWS
         [[nodiscard]] const wchar_t* ToWideString() const
         {
             static_assert(sizeof(char16_t) == sizeof(wchar_t));
             return reinterpret_cast<const wchar_t*>(m_data);
         }
+#endif
 
     private:
         void Convert(const char* source, const uint32_t sourceSize)
@@ -551,6 +553,7 @@ namespace FE::Str
             Convert(source, UTF16::ByteLength(source) >> 1);
         }
 
+#if FE_PLATFORM_WINDOWS
         explicit Utf16ToUtf8(const wchar_t* source, const uint32_t sourceSize, std::pmr::memory_resource* allocator = nullptr)
         {
             static_assert(sizeof(char16_t) == sizeof(wchar_t));
@@ -564,6 +567,7 @@ namespace FE::Str
             m_allocator = allocator ? allocator : std::pmr::get_default_resource();
             Convert(reinterpret_cast<const char16_t*>(source), UTF16::ByteLength(reinterpret_cast<const char16_t*>(source)) >> 1);
         }
+#endif
 
         [[nodiscard]] uint32_t size() const
         {
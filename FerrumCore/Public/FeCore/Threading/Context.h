@@ -17,6 +17,26 @@ namespace FE::Context
     using Callback = void (*)(TransferParams);
 
 
+    //! @brief Thread-local state of the fiber scheduler that runs on the current thread.
+    //!
+    //! The scheduler fills it in when a thread starts running its fibers, so that the current worker can be found
+    //! with a single thread-local read. On threads that don't run fibers, the scheduler is null.
+    struct ThreadState final
+    {
+        void* m_scheduler = nullptr;             //!< The scheduler that owns the current thread, e.g. the job system.
+        void* m_workerData = nullptr;            //!< Per-worker scheduler state.
+        uint32_t m_workerIndex = kInvalidIndex; //!< Index of the current thread within the scheduler.
+    };
+
+
+    //! @brief Get the thread-local scheduler state of the current thread.
+    //!
+    //! Fibers can migrate between threads, so the returned reference must not be kept across context switches.
+    //! The function is never inlined for the same reason: otherwise, the compiler could cache the address
+    //! of the thread-local variable in a fiber that has been resumed on another thread.
+    FE_FORCE_NOINLINE ThreadState& GetThreadState();
+
+
     //! @brief Create a new context.
     //!
     //! @param pStack        A pointer to the context stack
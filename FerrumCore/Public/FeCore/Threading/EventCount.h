@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <FeCore/Base/Base.h>
+
+namespace FE::Threading
+{
+    //! @brief A primitive that lets threads sleep until a condition they polled for becomes true.
+    //!
+    //! A waiting thread calls PrepareWait(), checks its condition once more and then either calls CancelWait() if
+    //! the condition is now satisfied or Wait() with the key returned by PrepareWait(). A notifying thread makes
+    //! the condition true and then calls Notify(). A notification that happens after PrepareWait() is never lost,
+    //! and Notify() doesn't make a system call when no one is waiting.
+    struct EventCount final
+    {
+        EventCount() = default;
+
+        EventCount(const EventCount&) = delete;
+        EventCount(EventCount&&) = delete;
+        EventCount& operator=(const EventCount&) = delete;
+        EventCount& operator=(EventCount&&) = delete;
+
+        //! @brief Register the current thread as a waiter.
+        //!
+        //! @return The key to pass to Wait().
+        [[nodiscard]] uint32_t PrepareWait()
+        {
+            m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+            return m_epoch.load(std::memory_order_seq_cst);
+        }
+
+        //! @brief Unregister the current thread after a call to PrepareWait() without waiting.
+        void CancelWait()
+        {
+            m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        //! @brief Sleep until Notify() is called after the PrepareWait() that returned the key.
+        void Wait(uint32_t key);
+
+        //! @brief Wake up the threads that called PrepareWait().
+        //!
+        //! @param all If true, wake up all the waiting threads, otherwise wake up at least one.
+        void Notify(bool all = false)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiterCount.load(std::memory_order_relaxed) == 0)
+                return;
+
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            WakeImpl(all);
+        }
+
+    private:
+        void WakeImpl(bool all);
+
+        std::atomic<uint32_t> m_epoch = 0;
+        std::atomic<uint32_t> m_waiterCount = 0;
+    };
+} // namespace FE::Threading
@@ -30,6 +30,15 @@ namespace FE::Threading
     };
 
 
+    //! @brief A growable pool of fibers with guard-paged stacks.
+    //!
+    //! The address space for all the fibers is reserved once, but each fiber is only created (and its stack committed)
+    //! when there are no free fibers left, so the pool grows on demand up to a large limit. Every stack is placed
+    //! at the top of its slot with an uncommitted page below it, so a stack overflow faults instead of silently
+    //! corrupting the neighbouring memory.
+    //!
+    //! There are two stack size classes: the normal one for most jobs and the extended one for jobs that
+    //! use a lot of stack memory.
     struct FiberPool final
     {
         explicit FiberPool(Context::Callback fiberCallback);
@@ -43,22 +52,40 @@ namespace FE::Threading
         FiberHandle Rent(bool extended);
         void Return(FiberHandle fiberHandle);
 
+        [[nodiscard]] bool IsExtended(const FiberHandle fiberHandle) const
+        {
+            return m_fibers[fiberHandle.m_value].m_extended;
+        }
+
         void Update(FiberHandle fiberHandle, Context::Handle context);
         Context::TransferParams Switch(FiberHandle to, uintptr_t userData, const char* message);
 
     private:
         struct alignas(Memory::kCacheLineSize) FiberInfo final
         {
-            std::atomic<bool> m_isFree = false;
-            festd::basic_fixed_string<116> m_name;
+            uint32_t m_nextFreeIndex = kInvalidIndex;
+            bool m_extended = false;
+            festd::basic_fixed_string<108> m_name;
             Context::Handle m_context;
             FiberRuntimeInfo* m_runtimeInfo = nullptr;
         };
 
+        // Fibers are returned and rented in LIFO order, so that the stacks that were used recently
+        // (and are likely to be resident and in cache) are reused first.
+        struct FreeList final
+        {
+            SpinLock m_lock;
+            uint32_t m_headIndex = kInvalidIndex;
+        };
+
+        FiberHandle CreateFiber(bool extended);
+
+        Context::Callback m_fiberCallback = nullptr;
         void* m_stackMemory = nullptr;
         size_t m_stackMemorySize = 0;
         FiberInfo* m_fibers = nullptr;
-        std::atomic<uint32_t> m_indexSeed;
+        std::atomic<uint32_t> m_fiberCount = 0;
+        FreeList m_freeLists[2];
 
         Memory::LockedMemoryResource<Memory::PoolAllocator, SpinLock> m_tempPagePool;
     };
@@ -26,6 +26,15 @@ namespace FE::Threading
         uintptr_t m_userData;
         ThreadFunction m_startRoutine;
     };
+#elif FE_PLATFORM_LINUX
+    struct NativeThreadData final
+    {
+        uint64_t m_id;
+        Priority m_priority;
+        uint64_t m_threadHandle;
+        uintptr_t m_userData;
+        ThreadFunction m_startRoutine;
+    };
 #else
 #    error Not implemented :(
 #endif
@@ -40,6 +49,12 @@ namespace FE::Threading
                               Priority priority = Priority::kNormal, size_t stackSize = 0);
     void CloseThread(ThreadHandle& thread);
 
+    //! @brief Restrict the thread to run only on the specified logical processors.
+    //!
+    //! @param thread       The thread to set the affinity for.
+    //! @param affinityMask Bit mask of logical processor indices, e.g. 0b101 means processors 0 and 2.
+    void SetThreadAffinity(ThreadHandle thread, uint64_t affinityMask);
+
     void Sleep(uint32_t milliseconds);
 
     uint64_t GetCurrentThreadID();
@@ -55,6 +55,10 @@ namespace FE
         [[nodiscard]] double GetSecondsPerTick();
 
 
+        //! @brief Get the CPU time in seconds consumed by all the threads of the current process.
+        [[nodiscard]] double GetProcessCpuTime();
+
+
         //! @brief Get system's local time zone info.
         [[nodiscard]] TimeZoneInfo GetTimeZoneInfo();
 
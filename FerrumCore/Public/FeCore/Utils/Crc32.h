@@ -7,6 +7,16 @@ namespace FE
     {
         static uint32_t Compute(const void* data, size_t byteSize, uint32_t seed = 0);
 
+        //! @brief Calculate the CRC of two concatenated byte sequences from the CRCs of the sequences.
+        //!
+        //! This allows to compute the CRC of a large buffer in parallel: Combine(Compute(a, seed), Compute(b), size(b))
+        //! is equal to Compute(b, Compute(a, seed)).
+        //!
+        //! @param crc          The CRC of the first sequence.
+        //! @param nextCrc      The CRC of the second sequence computed with a zero seed.
+        //! @param nextByteSize The size of the second sequence in bytes.
+        static uint32_t Combine(uint32_t crc, uint32_t nextCrc, size_t nextByteSize);
+
         uint32_t Update(const void* data, const size_t byteSize)
         {
             m_current = Compute(data, byteSize, m_current);
@@ -216,7 +216,7 @@ namespace FE::Internal
             TStorage::InitializeImpl(0, TStorage::GetAllocator());
         }
 
-        template<class = std::enable_if_t<TStorage::kHasAllocator>>
+        template<class TAllocatorStorage = TStorage, class = std::enable_if_t<TAllocatorStorage::kHasAllocator>>
         explicit BasicBitSetImpl(std::pmr::memory_resource* allocator)
             : TStorage(allocator)
         {
@@ -377,7 +377,7 @@ namespace FE::Internal
             return TStorage::GetAllocator();
         }
 
-        template<class = std::enable_if_t<TStorage::kHasAllocator>>
+        template<class TAllocatorStorage = TStorage, class = std::enable_if_t<TAllocatorStorage::kHasAllocator>>
         void set_allocator(std::pmr::memory_resource* allocator)
         {
             FE_AssertDebug(TStorage::SizeImpl() == 0);
@@ -106,7 +106,7 @@ namespace FE::Internal
                 data[0] = '\0';
         }
 
-        template<class = std::enable_if_t<TStorage::kHasAllocator>>
+        template<class TAllocatorStorage = TStorage, class = std::enable_if_t<TAllocatorStorage::kHasAllocator>>
         BasicStringImpl(std::pmr::memory_resource* allocator)
             : TStorage(allocator)
         {
@@ -129,7 +129,7 @@ namespace FE::Internal
 
         BasicStringImpl(BasicStringImpl&& other) noexcept
         {
-            memcpy(this, &other, sizeof(*this));
+            memcpy(static_cast<void*>(this), &other, sizeof(*this));
             other.InitializeImpl(0, other.GetAllocator());
         }
 
@@ -162,7 +162,7 @@ namespace FE::Internal
                 return *this;
 
             TStorage::DestroyImpl(TStorage::GetAllocator());
-            memcpy(this, &other, sizeof(*this));
+            memcpy(static_cast<void*>(this), &other, sizeof(*this));
             other.InitializeImpl(0, other.GetAllocator());
             return *this;
         }
@@ -285,7 +285,7 @@ namespace FE::Internal
             return TStorage::GetAllocator();
         }
 
-        template<class = std::enable_if_t<TStorage::kHasAllocator>>
+        template<class TAllocatorStorage = TStorage, class = std::enable_if_t<TAllocatorStorage::kHasAllocator>>
         void set_allocator(std::pmr::memory_resource* allocator)
         {
             TStorage::SetAllocator(allocator);
@@ -1,5 +1,7 @@
 #pragma once
 #include <FeCore/Base/Base.h>
+#include <FeCore/IO/Path.h>
+#include <filesystem>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -70,3 +72,44 @@ private:
         return this == &other;
     }
 };
+
+
+//! @brief An empty temporary directory for the files written by the current test, deleted with its contents on destruction.
+struct TestDirectory final
+{
+    TestDirectory()
+    {
+        const testing::TestInfo* testInfo = testing::UnitTest::GetInstance()->current_test_info();
+
+        std::string directoryName = "FeCoreTests.";
+        directoryName += testInfo->test_suite_name();
+        directoryName += '.';
+        directoryName += testInfo->name();
+
+        m_path = std::filesystem::temp_directory_path() / directoryName;
+        std::filesystem::remove_all(m_path);
+        std::filesystem::create_directories(m_path);
+    }
+
+    ~TestDirectory()
+    {
+        std::error_code errorCode;
+        std::filesystem::remove_all(m_path, errorCode);
+    }
+
+    TestDirectory(const TestDirectory&) = delete;
+    TestDirectory& operator=(const TestDirectory&) = delete;
+
+    [[nodiscard]] FE::IO::Path GetPath() const
+    {
+        return FE::IO::NormalizePath(m_path.string().c_str());
+    }
+
+    [[nodiscard]] FE::IO::Path GetPath(const FE::festd::string_view filename) const
+    {
+        return GetPath() / filename;
+    }
+
+private:
+    std::filesystem::path m_path;
+};
@@ -0,0 +1,391 @@
+#include <FeCore/Base/Platform.h>
+#include <FeCore/Compression/Compression.h>
+#include <FeCore/Jobs/JobSystem.h>
+#include <FeCore/Time/BaseTime.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    constexpr Compression::Method kMethods[] = {
+        Compression::Method::kNone,
+        Compression::Method::kDeflate,
+        Compression::Method::kGDeflate,
+        Compression::Method::kLZ4,
+    };
+
+    constexpr const char* kMethodNames[] = { "None", "Deflate", "GDeflate", "LZ4" };
+
+
+    struct CompressedPage final
+    {
+        const std::byte* m_data = nullptr;
+        uint32_t m_compressedSize = 0;
+    };
+
+
+    struct PageDecompressJob final : public Job
+    {
+        struct Context final
+        {
+            JobSystem* m_jobSystem = nullptr;
+            const CompressedPage* m_pages = nullptr;
+            const std::byte* m_expectedData = nullptr;
+            uint32_t m_pageCount = 0;
+            uint32_t m_jobCount = 0;
+            std::atomic<uint32_t> m_completedJobCount = 0;
+            std::atomic<uint32_t> m_failedJobCount = 0;
+        };
+
+        Context* m_context = nullptr;
+        uint32_t m_index = 0;
+        festd::vector<std::byte> m_buffer;
+
+        void Execute() override
+        {
+            const uint32_t pageIndex = m_index % m_context->m_pageCount;
+            const CompressedPage& page = m_context->m_pages[pageIndex];
+
+            // Every job acquires and releases its own context, just like the streaming decompression jobs do.
+            const auto decompressor = Compression::Decompressor::Create(Compression::Method::kGDeflate);
+            const auto result = decompressor.Decompress(page.m_data, page.m_compressedSize, m_buffer.data(), m_buffer.size());
+
+            const std::byte* expectedData = m_context->m_expectedData + pageIndex * Compression::kGDeflatePageSize;
+            if (result.m_result != Compression::ResultCode::kSuccess
+                || memcmp(m_buffer.data(), expectedData, Compression::kGDeflatePageSize) != 0)
+                m_context->m_failedJobCount.fetch_add(1, std::memory_order_relaxed);
+
+            if (m_context->m_completedJobCount.fetch_add(1, std::memory_order_acq_rel) + 1 == m_context->m_jobCount)
+                m_context->m_jobSystem->Stop();
+        }
+    };
+
+
+    //! @brief Parse the pages of a compressed block.
+    //!
+    //! @return The size of the block in bytes after compaction, i.e. as it would be stored in a file.
+    size_t ParseBlock(const std::byte* block, festd::vector<CompressedPage>& pages, Compression::BlockHeader& header,
+                      Compression::BlockFooter& footer)
+    {
+        pages.clear();
+        memcpy(&header, block, sizeof(header));
+
+        size_t compactedSize = sizeof(Compression::BlockHeader) + sizeof(Compression::BlockFooter);
+        const std::byte* pagePtr = block + sizeof(Compression::BlockHeader);
+        for (;;)
+        {
+            Compression::PageHeader pageHeader;
+            memcpy(&pageHeader, pagePtr, sizeof(pageHeader));
+            pagePtr += sizeof(Compression::PageHeader);
+            pages.push_back({ pagePtr, pageHeader.m_compressedSize });
+            compactedSize += sizeof(Compression::PageHeader) + pageHeader.m_compressedSize;
+
+            if (pageHeader.m_nextPageOffset == kInvalidIndex)
+            {
+                pagePtr += pageHeader.m_compressedSize;
+                break;
+            }
+
+            pagePtr += pageHeader.m_nextPageOffset;
+        }
+
+        memcpy(&footer, pagePtr, sizeof(footer));
+        return compactedSize;
+    }
+
+
+    //! @brief Decompress a block serially, page by page.
+    //!
+    //! @return The size of the decompressed data or kInvalidIndex on failure.
+    uint32_t DecompressBlock(const std::byte* block, std::byte* dst, const uint32_t dstSize)
+    {
+        festd::vector<CompressedPage> pages;
+        Compression::BlockHeader header;
+        Compression::BlockFooter footer;
+        ParseBlock(block, pages, header, footer);
+
+        const auto decompressor = Compression::Decompressor::Create(Compression::DecodeMagic(header.m_magic));
+
+        uint32_t offset = 0;
+        for (uint32_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex)
+        {
+            const uint32_t pageSize =
+                pageIndex + 1 == pages.size() ? footer.m_tailPageUncompressedSize : header.m_uncompressedPageSize;
+            if (pageSize > dstSize - offset)
+                return kInvalidIndex;
+
+            const CompressedPage& page = pages[pageIndex];
+            const auto result = decompressor.Decompress(page.m_data, page.m_compressedSize, dst + offset, pageSize);
+            if (result.m_result != Compression::ResultCode::kSuccess || result.m_decompressedSize != pageSize)
+                return kInvalidIndex;
+
+            offset += pageSize;
+        }
+
+        return offset;
+    }
+
+
+    uint32_t NextRandom(uint32_t& state)
+    {
+        state = state * 1664525 + 1013904223;
+        return state;
+    }
+
+
+    //! @brief Interleaved vertices of a smooth, slightly noisy height field: position, normal and texture coordinates.
+    festd::vector<std::byte> GenerateMeshPayload(const uint32_t byteSize)
+    {
+        struct Vertex final
+        {
+            float m_position[3];
+            float m_normal[3];
+            float m_uv[2];
+        };
+
+        festd::vector<std::byte> payload(byteSize);
+        const uint32_t vertexCount = byteSize / sizeof(Vertex);
+        const uint32_t gridSize = static_cast<uint32_t>(Math::Sqrt(static_cast<float>(vertexCount)));
+
+        uint32_t state = 1;
+        for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            const float x = static_cast<float>(vertexIndex % gridSize);
+            const float z = static_cast<float>(vertexIndex / gridSize);
+            const float noise = static_cast<float>(NextRandom(state) >> 16) / 65536.0f * 0.01f;
+
+            Vertex vertex;
+            vertex.m_position[0] = x * 0.1f;
+            vertex.m_position[1] = std::sin(x * 0.05f) * std::cos(z * 0.05f) + noise;
+            vertex.m_position[2] = z * 0.1f;
+            vertex.m_normal[0] = -std::cos(x * 0.05f) * 0.05f;
+            vertex.m_normal[1] = 1.0f;
+            vertex.m_normal[2] = std::sin(z * 0.05f) * 0.05f;
+            vertex.m_uv[0] = x / static_cast<float>(gridSize);
+            vertex.m_uv[1] = z / static_cast<float>(gridSize);
+            memcpy(payload.data() + vertexIndex * sizeof(Vertex), &vertex, sizeof(Vertex));
+        }
+
+        return payload;
+    }
+
+
+    //! @brief BC1 blocks of a noisy gradient: two RGB565 endpoints and 2-bit indices per 4x4 pixel block.
+    festd::vector<std::byte> GenerateTexturePayload(const uint32_t byteSize)
+    {
+        festd::vector<std::byte> payload(byteSize);
+
+        uint32_t state = 2;
+        const uint32_t blockCount = byteSize / 8;
+        for (uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+        {
+            const uint32_t x = blockIndex % 256;
+            const uint32_t y = blockIndex / 256;
+            const auto color0 = static_cast<uint16_t>(((x / 8) << 11) | ((y % 64) << 5) | 16);
+            const auto color1 = static_cast<uint16_t>(((x / 8 + 1) << 11) | ((y % 64) << 5) | 20);
+            const uint32_t indices = (NextRandom(state) >> 4) & 0x55555555;
+
+            memcpy(payload.data() + blockIndex * 8 + 0, &color0, sizeof(color0));
+            memcpy(payload.data() + blockIndex * 8 + 2, &color1, sizeof(color1));
+            memcpy(payload.data() + blockIndex * 8 + 4, &indices, sizeof(indices));
+        }
+
+        return payload;
+    }
+
+
+    //! @brief Decompress the pages of a GDeflate block concurrently, one page per job.
+    //!
+    //! @return The time it took to run all the jobs in seconds.
+    double RunConcurrentDecompression(const uint32_t workerCount, const uint32_t jobCount)
+    {
+        festd::vector<std::byte> data(Compression::kBlockSize);
+        uint32_t state = 0x12345678;
+        for (uint32_t byteIndex = 0; byteIndex < data.size(); ++byteIndex)
+        {
+            state = state * 1664525 + 1013904223;
+            data[byteIndex] = static_cast<std::byte>((byteIndex % 251) ^ ((state >> 24) < 32 ? state >> 16 : 0));
+        }
+
+        const auto compressor = Compression::Compressor::Create(Compression::Method::kGDeflate);
+        festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(data.size())));
+        Crc32 crc;
+        EXPECT_TRUE(compressor.Compress(crc, data.data(), data.size(), compressed.data(), compressed.size()));
+
+        festd::vector<CompressedPage> pages;
+        Compression::BlockHeader header;
+        Compression::BlockFooter footer;
+        ParseBlock(compressed.data(), pages, header, footer);
+
+        EXPECT_EQ(pages.size(), Compression::kBlockSize / Compression::kGDeflatePageSize);
+
+        JobSystem jobSystem{ workerCount };
+
+        PageDecompressJob::Context context;
+        context.m_jobSystem = &jobSystem;
+        context.m_pages = pages.data();
+        context.m_expectedData = data.data();
+        context.m_pageCount = pages.size();
+        context.m_jobCount = jobCount;
+
+        const std::unique_ptr<PageDecompressJob[]> jobs{ new PageDecompressJob[jobCount] };
+        for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+        {
+            jobs[jobIndex].m_context = &context;
+            jobs[jobIndex].m_index = jobIndex;
+            jobs[jobIndex].m_buffer.resize(Compression::kGDeflatePageSize);
+            jobs[jobIndex].ScheduleBackground(&jobSystem);
+        }
+
+        const uint64_t startTicks = Platform::GetTicks();
+        jobSystem.Start();
+        const uint64_t endTicks = Platform::GetTicks();
+
+        EXPECT_EQ(context.m_completedJobCount.load(), jobCount);
+        EXPECT_EQ(context.m_failedJobCount.load(), 0u);
+        return static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+    }
+} // namespace
+
+
+TEST(Compression, LZ4RoundTrip)
+{
+    festd::vector<std::byte> source = GenerateMeshPayload(Compression::kBlockSize);
+
+    // Overwrite a part with incompressible data.
+    uint32_t state = 3;
+    for (uint32_t byteIndex = 0; byteIndex < 4096; ++byteIndex)
+        source[70000 + byteIndex] = static_cast<std::byte>(NextRandom(state) >> 24);
+
+    const auto compressor = Compression::Compressor::Create(Compression::Method::kLZ4);
+    festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(Compression::kBlockSize)));
+    festd::vector<std::byte> decompressed(Compression::kBlockSize);
+
+    for (const uint32_t byteSize : { 0u, 1u, 13u, 100u, Compression::kLZ4PageSize, Compression::kLZ4PageSize + 1, 200000u,
+                                     Compression::kBlockSize })
+    {
+        Crc32 crc;
+        ASSERT_TRUE(compressor.Compress(crc, source.data(), byteSize, compressed.data(), compressed.size()));
+        EXPECT_EQ(Compression::DecodeMagic(reinterpret_cast<const Compression::BlockHeader*>(compressed.data())->m_magic),
+                  Compression::Method::kLZ4);
+
+        ASSERT_EQ(DecompressBlock(compressed.data(), decompressed.data(), decompressed.size()), byteSize);
+        EXPECT_EQ(memcmp(decompressed.data(), source.data(), byteSize), 0);
+        EXPECT_EQ(crc.m_current, Crc32::Compute(source.data(), byteSize));
+    }
+
+    // A corrupted page must either fail or produce wrong data, but never access memory outside the buffers.
+    Crc32 crc;
+    ASSERT_TRUE(compressor.Compress(crc, source.data(), Compression::kBlockSize, compressed.data(), compressed.size()));
+
+    festd::vector<CompressedPage> pages;
+    Compression::BlockHeader header;
+    Compression::BlockFooter footer;
+    ParseBlock(compressed.data(), pages, header, footer);
+
+    const auto decompressor = Compression::Decompressor::Create(Compression::Method::kLZ4);
+    for (uint32_t iterationIndex = 0; iterationIndex < 64; ++iterationIndex)
+    {
+        festd::vector<std::byte> corrupted{ pages[0].m_data, pages[0].m_data + pages[0].m_compressedSize };
+        corrupted[NextRandom(state) % corrupted.size()] ^= static_cast<std::byte>(1 + NextRandom(state) % 255);
+        const auto result = decompressor.Decompress(
+            corrupted.data(), corrupted.size(), decompressed.data(), Compression::kLZ4PageSize);
+        EXPECT_LE(result.m_decompressedSize, Compression::kLZ4PageSize);
+    }
+}
+
+
+TEST(Compression, MethodRoundTrip)
+{
+    const festd::vector<std::byte> payloads[] = {
+        GenerateMeshPayload(Compression::kBlockSize),
+        GenerateTexturePayload(Compression::kBlockSize),
+    };
+
+    festd::vector<std::byte> decompressed(Compression::kBlockSize);
+    for (const festd::vector<std::byte>& payload : payloads)
+    {
+        for (const Compression::Method method : kMethods)
+        {
+            const auto compressor = Compression::Compressor::Create(method);
+            festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(payload.size())));
+
+            Crc32 crc;
+            ASSERT_TRUE(compressor.Compress(crc, payload.data(), payload.size(), compressed.data(), compressed.size()));
+            ASSERT_EQ(DecompressBlock(compressed.data(), decompressed.data(), decompressed.size()), payload.size());
+            EXPECT_EQ(memcmp(decompressed.data(), payload.data(), payload.size()), 0);
+        }
+    }
+}
+
+
+//! @brief Prints the compression ratio and decoding speed of every method, run with --gtest_also_run_disabled_tests.
+TEST(Compression, DISABLED_MethodBenchmark)
+{
+    constexpr uint32_t kIterationCount = 8;
+
+    struct Payload final
+    {
+        const char* m_name;
+        festd::vector<std::byte> m_data;
+    };
+
+    const Payload payloads[] = {
+        { "mesh", GenerateMeshPayload(Compression::kBlockSize) },
+        { "texture", GenerateTexturePayload(Compression::kBlockSize) },
+    };
+
+    festd::vector<std::byte> decompressed(Compression::kBlockSize);
+    for (const Payload& payload : payloads)
+    {
+        for (uint32_t methodIndex = 0; methodIndex < festd::size(kMethods); ++methodIndex)
+        {
+            const auto compressor = Compression::Compressor::Create(kMethods[methodIndex]);
+            festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(payload.m_data.size())));
+
+            Crc32 crc;
+            ASSERT_TRUE(compressor.Compress(crc, payload.m_data.data(), payload.m_data.size(), compressed.data(), compressed.size()));
+
+            festd::vector<CompressedPage> pages;
+            Compression::BlockHeader header;
+            Compression::BlockFooter footer;
+            const size_t blockSize = ParseBlock(compressed.data(), pages, header, footer);
+
+            const uint64_t startTicks = Platform::GetTicks();
+            for (uint32_t iterationIndex = 0; iterationIndex < kIterationCount; ++iterationIndex)
+                ASSERT_EQ(DecompressBlock(compressed.data(), decompressed.data(), decompressed.size()), payload.m_data.size());
+
+            const uint64_t endTicks = Platform::GetTicks();
+            EXPECT_EQ(memcmp(decompressed.data(), payload.m_data.data(), payload.m_data.size()), 0);
+
+            const double seconds = static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+            const double gigabytes = kIterationCount * static_cast<double>(payload.m_data.size()) / (1024.0 * 1024.0 * 1024.0);
+            printf("[ Compression ] %-8s %-8s ratio %.3f, decode %.2f GB/s\n",
+                   payload.m_name,
+                   kMethodNames[methodIndex],
+                   static_cast<double>(payload.m_data.size()) / static_cast<double>(blockSize),
+                   gigabytes / seconds);
+        }
+    }
+}
+
+
+TEST(Compression, ConcurrentDecompression)
+{
+    RunConcurrentDecompression(4, 64);
+}
+
+
+//! @brief Prints the GDeflate page decompression throughput for different worker counts, run with --gtest_also_run_disabled_tests.
+TEST(Compression, DISABLED_ConcurrentDecompressionBenchmark)
+{
+    constexpr uint32_t kJobCount = 256;
+
+    for (const uint32_t workerCount : { 2u, 4u, 8u })
+    {
+        const double seconds = RunConcurrentDecompression(workerCount, kJobCount);
+        printf("[ Compression ] %u workers: %.0f GDeflate pages/s\n", workerCount, kJobCount / seconds);
+    }
+}
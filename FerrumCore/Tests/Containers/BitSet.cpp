@@ -35,7 +35,9 @@ namespace
         void* memory = AlignDownPtr(words, pageSize);
         const BitSetWord* result = static_cast<BitSetWord*>(memory) + padWords;
         if (padWords > 0)
+        {
             EXPECT_EQ(result[-1], DefaultHash(&count, sizeof(count)));
+        }
         Memory::FreeVirtual(memory, byteSize);
     }
 } // namespace
@@ -0,0 +1,274 @@
+#include <FeCore/Containers/ConcurrentQueue.h>
+#include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <FeCore/Time/BaseTime.h>
+#include <festd/vector.h>
+#include <gtest/gtest.h>
+
+using namespace FE;
+
+namespace
+{
+    struct TestNode final : public ConcurrentQueueNode
+    {
+        uint32_t m_producerIndex = 0;
+        uint32_t m_value = 0;
+        std::atomic<uint32_t> m_consumeCount = 0;
+    };
+
+
+    template<class TQueue>
+    struct ConcurrentTestState final
+    {
+        TQueue* m_queue = nullptr;
+        TestNode* m_nodes = nullptr;
+        uint32_t m_nodesPerProducer = 0;
+        std::atomic<uint32_t> m_producerIndex = 0;
+        std::atomic<uint32_t> m_consumerIndex = 0;
+        std::atomic<uint32_t> m_consumedCount = 0;
+        uint32_t m_totalCount = 0;
+    };
+
+
+    template<class TQueue>
+    void ProducerThread(const uintptr_t userData)
+    {
+        auto& state = *reinterpret_cast<ConcurrentTestState<TQueue>*>(userData);
+        const uint32_t producerIndex = state.m_producerIndex.fetch_add(1, std::memory_order_relaxed);
+        TestNode* nodes = state.m_nodes + producerIndex * state.m_nodesPerProducer;
+        for (uint32_t nodeIndex = 0; nodeIndex < state.m_nodesPerProducer; ++nodeIndex)
+        {
+            nodes[nodeIndex].m_producerIndex = producerIndex;
+            nodes[nodeIndex].m_value = nodeIndex;
+            state.m_queue->Enqueue(&nodes[nodeIndex]);
+        }
+    }
+
+
+    template<class TQueue>
+    void ConsumerThread(const uintptr_t userData)
+    {
+        auto& state = *reinterpret_cast<ConcurrentTestState<TQueue>*>(userData);
+        while (state.m_consumedCount.load(std::memory_order_relaxed) < state.m_totalCount)
+        {
+            auto* node = static_cast<TestNode*>(state.m_queue->TryDequeue());
+            if (node == nullptr)
+            {
+                _mm_pause();
+                continue;
+            }
+
+            node->m_consumeCount.fetch_add(1, std::memory_order_relaxed);
+            state.m_consumedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+
+    double RunConcurrentQueue(ConcurrentQueue& queue, const uint32_t threadCount, const uint32_t nodesPerProducer)
+    {
+        ConcurrentTestState<ConcurrentQueue> state;
+        state.m_queue = &queue;
+        state.m_nodesPerProducer = nodesPerProducer;
+        state.m_totalCount = nodesPerProducer * threadCount;
+
+        const std::unique_ptr<TestNode[]> nodes{ new TestNode[state.m_totalCount] };
+        state.m_nodes = nodes.get();
+
+        const uint64_t startTicks = Platform::GetTicks();
+
+        festd::inline_vector<Threading::ThreadHandle, 16> threads;
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            const auto producerName = Fmt::FixedFormat("Producer {}", threadIndex);
+            const auto consumerName = Fmt::FixedFormat("Consumer {}", threadIndex);
+            const auto userData = reinterpret_cast<uintptr_t>(&state);
+            threads.push_back(Threading::CreateThread(producerName, &ProducerThread<ConcurrentQueue>, userData));
+            threads.push_back(Threading::CreateThread(consumerName, &ConsumerThread<ConcurrentQueue>, userData));
+        }
+
+        for (Threading::ThreadHandle& thread : threads)
+            Threading::CloseThread(thread);
+
+        const uint64_t endTicks = Platform::GetTicks();
+
+        EXPECT_EQ(queue.TryDequeue(), nullptr);
+        for (uint32_t nodeIndex = 0; nodeIndex < state.m_totalCount; ++nodeIndex)
+        {
+            if (nodes[nodeIndex].m_consumeCount.load() != 1)
+            {
+                ADD_FAILURE() << "Node " << nodeIndex << " consumed " << nodes[nodeIndex].m_consumeCount.load() << " times";
+                break;
+            }
+        }
+
+        return static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+    }
+} // namespace
+
+
+TEST(ConcurrentQueue, LockedFIFO)
+{
+    ConcurrentQueue queue;
+    EXPECT_EQ(queue.TryDequeue(), nullptr);
+
+    TestNode nodes[8];
+    for (TestNode& node : nodes)
+        queue.Enqueue(&node);
+
+    for (TestNode& node : nodes)
+        EXPECT_EQ(queue.TryDequeue(), &node);
+
+    EXPECT_EQ(queue.TryDequeue(), nullptr);
+}
+
+
+TEST(ConcurrentQueue, RingOverflow)
+{
+    ConcurrentQueue queue;
+    queue.Initialize(4);
+
+    TestNode nodes[10];
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        // The first four nodes go to the ring, the rest go to the overflow list, both in FIFO order.
+        for (TestNode& node : nodes)
+            queue.Enqueue(&node);
+
+        for (TestNode& node : nodes)
+            EXPECT_EQ(queue.TryDequeue(), &node);
+
+        EXPECT_EQ(queue.TryDequeue(), nullptr);
+    }
+}
+
+
+TEST(ConcurrentQueue, RingOverflowIsNotStarved)
+{
+    ConcurrentQueue queue;
+    queue.Initialize(4);
+
+    // Overflow the ring, then keep it busy: every dequeue frees a ring cell that is refilled right away.
+    TestNode nodes[64];
+    uint32_t enqueuedCount = 0;
+    for (; enqueuedCount < 6; ++enqueuedCount)
+        queue.Enqueue(&nodes[enqueuedCount]);
+
+    for (uint32_t dequeuedCount = 0; dequeuedCount < std::size(nodes); ++dequeuedCount)
+    {
+        EXPECT_EQ(queue.TryDequeue(), &nodes[dequeuedCount]);
+        if (enqueuedCount < std::size(nodes))
+            queue.Enqueue(&nodes[enqueuedCount++]);
+    }
+
+    EXPECT_EQ(queue.TryDequeue(), nullptr);
+}
+
+
+TEST(ConcurrentQueue, Concurrent)
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kNodesPerProducer = 16 * 1024;
+
+    ConcurrentQueue lockedQueue;
+    RunConcurrentQueue(lockedQueue, kThreadCount, kNodesPerProducer);
+
+    ConcurrentQueue ringQueue;
+    ringQueue.Initialize(1024);
+    RunConcurrentQueue(ringQueue, kThreadCount, kNodesPerProducer);
+}
+
+
+//! @brief Compares the locked and the ring queue throughput, run with --gtest_also_run_disabled_tests.
+TEST(ConcurrentQueue, DISABLED_Throughput)
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kNodesPerProducer = 64 * 1024;
+
+    ConcurrentQueue lockedQueue;
+    const double lockedSeconds = RunConcurrentQueue(lockedQueue, kThreadCount, kNodesPerProducer);
+
+    ConcurrentQueue ringQueue;
+    ringQueue.Initialize(1024);
+    const double ringSeconds = RunConcurrentQueue(ringQueue, kThreadCount, kNodesPerProducer);
+
+    const double nodeCount = kThreadCount * kNodesPerProducer;
+    printf("[ ConcurrentQueue ] %u producers, %u consumers: locked %.2f M nodes/s, ring %.2f M nodes/s\n",
+           kThreadCount,
+           kThreadCount,
+           nodeCount / lockedSeconds / 1e6,
+           nodeCount / ringSeconds / 1e6);
+}
+
+
+TEST(MPSCQueue, FIFO)
+{
+    MPSCQueue queue;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(queue.TryDequeue(), nullptr);
+
+    TestNode nodes[8];
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        for (TestNode& node : nodes)
+            queue.Enqueue(&node);
+
+        EXPECT_FALSE(queue.Empty());
+        for (TestNode& node : nodes)
+            EXPECT_EQ(queue.TryDequeue(), &node);
+
+        EXPECT_TRUE(queue.Empty());
+        EXPECT_EQ(queue.TryDequeue(), nullptr);
+    }
+}
+
+
+TEST(MPSCQueue, Concurrent)
+{
+    constexpr uint32_t kProducerCount = 4;
+    constexpr uint32_t kNodesPerProducer = 64 * 1024;
+
+    MPSCQueue queue;
+
+    ConcurrentTestState<MPSCQueue> state;
+    state.m_queue = &queue;
+    state.m_nodesPerProducer = kNodesPerProducer;
+    state.m_totalCount = kProducerCount * kNodesPerProducer;
+
+    const std::unique_ptr<TestNode[]> nodes{ new TestNode[state.m_totalCount] };
+    state.m_nodes = nodes.get();
+
+    Threading::ThreadHandle producers[kProducerCount];
+    for (uint32_t producerIndex = 0; producerIndex < kProducerCount; ++producerIndex)
+    {
+        const auto threadName = Fmt::FixedFormat("Producer {}", producerIndex);
+        producers[producerIndex] =
+            Threading::CreateThread(threadName, &ProducerThread<MPSCQueue>, reinterpret_cast<uintptr_t>(&state));
+    }
+
+    // The nodes of each producer must come out in the order they were enqueued.
+    uint32_t nextValues[kProducerCount] = {};
+    uint32_t orderViolationCount = 0;
+    uint32_t consumedCount = 0;
+    while (consumedCount < state.m_totalCount)
+    {
+        auto* node = static_cast<TestNode*>(queue.TryDequeue());
+        if (node == nullptr)
+        {
+            _mm_pause();
+            continue;
+        }
+
+        if (node->m_value != nextValues[node->m_producerIndex])
+            ++orderViolationCount;
+
+        nextValues[node->m_producerIndex] = node->m_value + 1;
+        ++consumedCount;
+    }
+
+    for (Threading::ThreadHandle& producer : producers)
+        Threading::CloseThread(producer);
+
+    EXPECT_EQ(orderViolationCount, 0);
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(queue.TryDequeue(), nullptr);
+}
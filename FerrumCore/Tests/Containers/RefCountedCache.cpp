@@ -0,0 +1,165 @@
+﻿#include <FeCore/Containers/RefCountedCache.h>
+#include <gtest/gtest.h>
+
+using namespace FE;
+
+namespace
+{
+    struct CachedObject final : public Memory::RefCountedObjectBase
+    {
+        explicit CachedObject(uint32_t* destroyedCount)
+            : m_destroyedCount(destroyedCount)
+        {
+        }
+
+        ~CachedObject() override
+        {
+            ++*m_destroyedCount;
+        }
+
+        uint32_t* m_destroyedCount;
+    };
+
+
+    CachedObject* CreateObject(uint32_t* destroyedCount)
+    {
+        return Rc<CachedObject>::DefaultNew(destroyedCount);
+    }
+} // namespace
+
+
+TEST(RefCountedCache, FindOrCreate)
+{
+    uint32_t destroyedCount = 0;
+    uint32_t createdCount = 0;
+
+    {
+        RefCountedCache<CachedObject> cache;
+        EXPECT_EQ(cache.Find("A"), nullptr);
+
+        const auto factory = [&] {
+            ++createdCount;
+            return CreateObject(&destroyedCount);
+        };
+
+        bool created = false;
+        CachedObject* a = cache.FindOrCreate("A", factory, created);
+        EXPECT_TRUE(created);
+        EXPECT_EQ(cache.FindOrCreate("A", factory, created), a);
+        EXPECT_FALSE(created);
+        EXPECT_EQ(cache.Find("A"), a);
+
+        CachedObject* b = cache.FindOrCreate("B", factory, created);
+        EXPECT_TRUE(created);
+        EXPECT_NE(a, b);
+
+        EXPECT_EQ(createdCount, 2);
+        EXPECT_EQ(cache.size(), 2);
+        EXPECT_EQ(destroyedCount, 0);
+    }
+
+    EXPECT_EQ(destroyedCount, 2);
+}
+
+
+TEST(RefCountedCache, Remove)
+{
+    uint32_t destroyedCount = 0;
+
+    RefCountedCache<CachedObject> cache;
+
+    bool created;
+    const Rc a = cache.FindOrCreate("A", [&] { return CreateObject(&destroyedCount); }, created);
+    cache.SetByteSize("A", 100);
+    EXPECT_EQ(cache.GetByteSize(), 100);
+
+    EXPECT_TRUE(cache.Remove("A"));
+    EXPECT_FALSE(cache.Remove("A"));
+    EXPECT_EQ(cache.Find("A"), nullptr);
+    EXPECT_EQ(cache.GetByteSize(), 0);
+    EXPECT_EQ(destroyedCount, 0);
+    EXPECT_EQ(a->GetRefCount(), 1);
+}
+
+
+TEST(RefCountedCache, RemoveIf)
+{
+    uint32_t destroyedCount = 0;
+
+    RefCountedCache<CachedObject> cache;
+
+    bool created;
+    const CachedObject* a = cache.FindOrCreate("A", [&] { return CreateObject(&destroyedCount); }, created);
+
+    EXPECT_FALSE(cache.RemoveIf("A", [](const CachedObject*) { return false; }));
+    EXPECT_EQ(cache.Find("A"), a);
+
+    EXPECT_TRUE(cache.RemoveIf("A", [a](const CachedObject* object) { return object == a; }));
+    EXPECT_FALSE(cache.RemoveIf("A", [](const CachedObject*) { return true; }));
+    EXPECT_EQ(cache.Find("A"), nullptr);
+    EXPECT_EQ(destroyedCount, 1);
+}
+
+
+TEST(RefCountedCache, EvictsLeastRecentlyUsed)
+{
+    uint32_t destroyedCount = 0;
+
+    RefCountedCache<CachedObject> cache{ 300 };
+    const auto factory = [&] {
+        return CreateObject(&destroyedCount);
+    };
+
+    bool created;
+    cache.FindOrCreate("A", factory, created);
+    cache.SetByteSize("A", 100);
+    cache.FindOrCreate("B", factory, created);
+    cache.SetByteSize("B", 100);
+    cache.FindOrCreate("C", factory, created);
+    cache.SetByteSize("C", 100);
+    EXPECT_EQ(destroyedCount, 0);
+
+    // Touch A, so that B becomes the least recently used object.
+    EXPECT_NE(cache.Find("A"), nullptr);
+
+    cache.FindOrCreate("D", factory, created);
+    cache.SetByteSize("D", 100);
+
+    EXPECT_EQ(destroyedCount, 1);
+    EXPECT_EQ(cache.Find("B"), nullptr);
+    EXPECT_NE(cache.Find("A"), nullptr);
+    EXPECT_NE(cache.Find("C"), nullptr);
+    EXPECT_NE(cache.Find("D"), nullptr);
+    EXPECT_EQ(cache.GetByteSize(), 300);
+}
+
+
+TEST(RefCountedCache, KeepsObjectsInUse)
+{
+    uint32_t destroyedCount = 0;
+
+    RefCountedCache<CachedObject> cache{ 100 };
+    const auto factory = [&] {
+        return CreateObject(&destroyedCount);
+    };
+
+    bool created;
+    Rc a = cache.FindOrCreate("A", factory, created);
+    cache.SetByteSize("A", 100);
+    const Rc b = cache.FindOrCreate("B", factory, created);
+    cache.SetByteSize("B", 100);
+
+    // Both objects are referenced outside the cache, so the cache is allowed to exceed the budget.
+    EXPECT_EQ(destroyedCount, 0);
+    EXPECT_EQ(cache.GetByteSize(), 200);
+
+    a.Reset();
+    cache.Trim();
+    EXPECT_EQ(destroyedCount, 1);
+    EXPECT_EQ(cache.Find("A"), nullptr);
+    EXPECT_EQ(cache.Find("B"), b.Get());
+
+    cache.SetByteBudget(0);
+    EXPECT_EQ(cache.Find("B"), b.Get());
+    EXPECT_EQ(destroyedCount, 1);
+}
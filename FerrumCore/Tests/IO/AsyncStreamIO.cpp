@@ -0,0 +1,133 @@
+#include <FeCore/Compression/Compression.h>
+#include <FeCore/IO/AsyncStreamIO.h>
+#include <FeCore/IO/FileStream.h>
+#include <FeCore/Jobs/JobSystem.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    //! @brief Calculate the size of a compressed block as the compressor has written it, including the gaps between the pages.
+    uint32_t MeasureBlock(const std::byte* block)
+    {
+        const std::byte* page = block + sizeof(Compression::BlockHeader);
+        for (;;)
+        {
+            Compression::PageHeader pageHeader;
+            memcpy(&pageHeader, page, sizeof(pageHeader));
+            page += sizeof(Compression::PageHeader);
+
+            if (pageHeader.m_nextPageOffset == kInvalidIndex)
+                return static_cast<uint32_t>(page + pageHeader.m_compressedSize + sizeof(Compression::BlockFooter) - block);
+
+            page += pageHeader.m_nextPageOffset;
+        }
+    }
+
+
+    struct BlockReadCallback final : public IO::IAsyncReadCallback
+    {
+        JobSystem* m_jobSystem = nullptr;
+        uint32_t m_blockCount = 0;
+        std::atomic<uint32_t> m_completedBlockCount = 0;
+        IO::ResultCode m_blockResults[4] = {};
+        IO::AsyncOperationStatus m_status = IO::AsyncOperationStatus::kQueued;
+        IO::ResultCode m_lastResult = IO::ResultCode::kSuccess;
+
+        void AsyncIOCallback(const IO::AsyncBlockReadResult& result) override
+        {
+            m_blockResults[result.m_blockIndex] = result.m_result;
+            if (m_completedBlockCount.fetch_add(1, std::memory_order_acq_rel) + 1 < m_blockCount)
+                return;
+
+            // All the blocks have been verified by now, so the status is final.
+            m_status = result.m_controller->GetStatus();
+            m_lastResult = result.m_controller->GetLastOperationResult();
+            m_jobSystem->Stop();
+        }
+    };
+} // namespace
+
+
+TEST(AsyncStreamIO, BlockReadIntegrityFailureIsSticky)
+{
+    constexpr uint32_t kBlockCount = 3;
+    constexpr uint32_t kCorruptedBlockIndex = kBlockCount - 1;
+    constexpr uint32_t kBlockDataSize = 64 * 1024;
+
+    const TestDirectory directory;
+    const IO::Path path = directory.GetPath("Blocks.bin");
+
+    {
+        const auto compressor = Compression::Compressor::Create(Compression::Method::kGDeflate);
+        festd::vector<std::byte> data(kBlockDataSize);
+        festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(kBlockDataSize)));
+
+        IO::FileStream stream;
+        ASSERT_EQ(stream.Open(path, IO::OpenMode::kCreate), IO::ResultCode::kSuccess);
+
+        Crc32 crc;
+        for (uint32_t blockIndex = 0; blockIndex < kBlockCount; ++blockIndex)
+        {
+            for (uint32_t byteIndex = 0; byteIndex < kBlockDataSize; ++byteIndex)
+                data[byteIndex] = static_cast<std::byte>((byteIndex / 7 + blockIndex * 31) & 0xff);
+
+            ASSERT_TRUE(compressor.Compress(crc, data.data(), data.size(), compressed.data(), compressed.size()));
+
+            // The last block fails the integrity check, the earlier ones must not report the request as succeeded.
+            const uint32_t blockByteSize = MeasureBlock(compressed.data());
+            if (blockIndex == kCorruptedBlockIndex)
+            {
+                Compression::BlockFooter footer;
+                std::byte* footerPtr = compressed.data() + blockByteSize - sizeof(Compression::BlockFooter);
+                memcpy(&footer, footerPtr, sizeof(footer));
+                footer.m_crc32 = ~footer.m_crc32;
+                memcpy(footerPtr, &footer, sizeof(footer));
+            }
+
+            ASSERT_EQ(stream.WriteFromBuffer(compressed.data(), blockByteSize), blockByteSize);
+        }
+    }
+
+    const Rc stream = Rc<IO::FileStream>::DefaultNew();
+    ASSERT_EQ(stream->Open(path, IO::OpenMode::kReadOnly), IO::ResultCode::kSuccess);
+
+    Logger logger;
+    auto jobSystem = std::make_unique<JobSystem>(4);
+    festd::vector<std::byte> readBuffer(kBlockCount * Compression::kBlockSize);
+
+    BlockReadCallback callback;
+    callback.m_jobSystem = jobSystem.get();
+    callback.m_blockCount = kBlockCount;
+
+    {
+        const Rc<IO::IAsyncStreamIO> asyncIO = Rc<IO::AsyncStreamIO>::DefaultNew(&logger, jobSystem.get(), nullptr);
+
+        IO::AsyncBlockReadRequest request;
+        request.m_stream = stream;
+        request.m_callback = &callback;
+        request.m_readBuffer = readBuffer.data();
+        request.m_readBufferSize = readBuffer.size();
+        request.m_blockCount = kBlockCount;
+        request.m_verifyIntegrity = true;
+        asyncIO->ReadAsync(request);
+
+        // Runs the decompression jobs on this thread too, until the callback of the last block stops the job system.
+        jobSystem->Start();
+
+        // The decompression jobs still release the request after the callbacks, wait for the workers to exit.
+        jobSystem.reset();
+
+        for (uint32_t blockIndex = 0; blockIndex < kBlockCount; ++blockIndex)
+        {
+            const IO::ResultCode expectedResult =
+                blockIndex == kCorruptedBlockIndex ? IO::ResultCode::kIntegrityViolation : IO::ResultCode::kSuccess;
+            EXPECT_EQ(callback.m_blockResults[blockIndex], expectedResult);
+        }
+
+        EXPECT_EQ(callback.m_status, IO::AsyncOperationStatus::kFailed);
+        EXPECT_EQ(callback.m_lastResult, IO::ResultCode::kIntegrityViolation);
+    }
+}
@@ -0,0 +1,172 @@
+#include <FeCore/IO/AsyncStreamIO.h>
+#include <FeCore/IO/FileStream.h>
+#include <FeCore/IO/MappedFileStream.h>
+#include <FeCore/IO/StreamFactory.h>
+#include <FeCore/Modules/Configuration.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    festd::vector<std::byte> WriteTestFile(const festd::string_view path, const uint32_t byteSize)
+    {
+        festd::vector<std::byte> data;
+        data.resize(byteSize);
+        for (uint32_t byteIndex = 0; byteIndex < byteSize; ++byteIndex)
+            data[byteIndex] = static_cast<std::byte>((byteIndex * 7 + byteIndex / 251) & 0xff);
+
+        IO::FileStream stream;
+        EXPECT_EQ(stream.Open(path, IO::OpenMode::kCreate), IO::ResultCode::kSuccess);
+        EXPECT_EQ(stream.WriteFromBuffer(data.data(), data.size()), data.size());
+        return data;
+    }
+
+
+    struct ZeroCopyReadCallback final : public IO::IAsyncReadCallback
+    {
+        std::atomic<bool> m_completed = false;
+        IO::AsyncOperationStatus m_status = IO::AsyncOperationStatus::kQueued;
+        std::pmr::memory_resource* m_allocator = nullptr;
+        std::byte* m_buffer = nullptr;
+        uint32_t m_bufferSize = 0;
+        size_t m_bytesRead = 0;
+
+        void AsyncIOCallback(const IO::AsyncReadResult& result) override
+        {
+            // Keep the buffer after the request is deleted, like the asset managers do.
+            m_status = result.m_controller->GetStatus();
+            m_allocator = result.m_request->m_allocator;
+            m_buffer = result.m_request->m_readBuffer;
+            m_bufferSize = result.m_request->m_readBufferSize;
+            m_bytesRead = result.m_bytesRead;
+            m_completed.store(true, std::memory_order_release);
+        }
+    };
+} // namespace
+
+
+TEST(MappedFileStream, Read)
+{
+    const TestDirectory directory;
+    const IO::Path path = directory.GetPath("Read.bin");
+    constexpr uint32_t kFileSize = 1024 * 1024 + 123;
+    const festd::vector<std::byte> expected = WriteTestFile(path, kFileSize);
+
+    IO::MappedFileStream stream;
+    ASSERT_EQ(stream.Open(path), IO::ResultCode::kSuccess);
+    EXPECT_TRUE(stream.IsOpen());
+    EXPECT_TRUE(stream.ReadAllowed());
+    EXPECT_FALSE(stream.WriteAllowed());
+    EXPECT_FALSE(stream.GetNativeHandle().IsValid());
+    ASSERT_EQ(stream.Length(), kFileSize);
+
+    const festd::span<const std::byte> mappedData = stream.GetMappedData();
+    ASSERT_EQ(mappedData.size(), kFileSize);
+    EXPECT_EQ(memcmp(mappedData.data(), expected.data(), kFileSize), 0);
+
+    // Views point straight into the mapping and are clamped to the end of the file.
+    stream.Prefetch(4096, 64 * 1024);
+    const festd::span<const std::byte> view = stream.GetView(4096, 64 * 1024);
+    EXPECT_EQ(view.data(), mappedData.data() + 4096);
+    EXPECT_EQ(view.size(), 64 * 1024);
+    EXPECT_EQ(stream.GetView(kFileSize - 10, 100).size(), 10);
+    EXPECT_TRUE(stream.GetView(kFileSize, 100).empty());
+
+    festd::vector<std::byte> buffer;
+    buffer.resize(1000);
+    ASSERT_EQ(stream.Seek(500, IO::SeekMode::kBegin), IO::ResultCode::kSuccess);
+    EXPECT_EQ(stream.ReadToBuffer(buffer.data(), buffer.size()), buffer.size());
+    EXPECT_EQ(memcmp(buffer.data(), expected.data() + 500, buffer.size()), 0);
+    EXPECT_EQ(stream.Tell(), 1500);
+
+    ASSERT_EQ(stream.Seek(-100, IO::SeekMode::kEnd), IO::ResultCode::kSuccess);
+    const festd::span<const std::byte> tail = stream.ReadView(1000);
+    EXPECT_EQ(tail.size(), 100);
+    EXPECT_EQ(tail.data(), mappedData.data() + kFileSize - 100);
+    EXPECT_EQ(stream.Tell(), kFileSize);
+    EXPECT_EQ(stream.ReadToBuffer(buffer.data(), buffer.size()), 0);
+
+    EXPECT_EQ(stream.Seek(1, IO::SeekMode::kCurrent), IO::ResultCode::kInvalidSeek);
+    EXPECT_EQ(stream.Seek(-1, IO::SeekMode::kBegin), IO::ResultCode::kInvalidSeek);
+
+    stream.Close();
+    EXPECT_FALSE(stream.IsOpen());
+    EXPECT_TRUE(stream.GetMappedData().empty());
+}
+
+
+TEST(MappedFileStream, EmptyAndMissingFiles)
+{
+    const TestDirectory directory;
+    const IO::Path path = directory.GetPath("Empty.bin");
+    WriteTestFile(path, 0);
+
+    IO::MappedFileStream stream;
+    ASSERT_EQ(stream.Open(path), IO::ResultCode::kSuccess);
+    EXPECT_TRUE(stream.IsOpen());
+    EXPECT_EQ(stream.Length(), 0);
+    EXPECT_TRUE(stream.GetMappedData().empty());
+
+    std::byte buffer[16];
+    EXPECT_EQ(stream.ReadToBuffer(buffer, sizeof(buffer)), 0);
+    stream.Close();
+
+    EXPECT_EQ(stream.Open(directory.GetPath("Missing.bin")), IO::ResultCode::kNoFileOrDirectory);
+    EXPECT_FALSE(stream.IsOpen());
+}
+
+
+TEST(MappedFileStream, AsyncZeroCopyRead)
+{
+    const TestDirectory directory;
+    constexpr uint32_t kFileSize = 256 * 1024 + 17;
+    const festd::vector<std::byte> expected = WriteTestFile(directory.GetPath("MappedFileStreamZeroCopy.bin"), kFileSize);
+
+    // The stream factory changes the current directory to the asset directory.
+    const IO::Path currentDirectory = IO::Directory::GetCurrentDirectory();
+
+    {
+        const IO::Path directoryPath = directory.GetPath();
+        const std::string assetDirectory = "AssetDirectory=" + std::string{ directoryPath.data(), directoryPath.size() };
+        const festd::string_view commandLine[] = {
+            "-c",
+            festd::string_view{ assetDirectory.data(), static_cast<uint32_t>(assetDirectory.size()) },
+        };
+
+        // Plain reads don't schedule any jobs, so the I/O thread doesn't need a job system.
+        Logger logger;
+        const Rc config = Rc<Env::Configuration>::DefaultNew(festd::span{ commandLine });
+        const Rc streamFactory = Rc<IO::FileStreamFactory>::DefaultNew(config.Get());
+
+        ZeroCopyReadCallback callback;
+
+        {
+            const Rc<IO::IAsyncStreamIO> asyncIO = Rc<IO::AsyncStreamIO>::DefaultNew(&logger, nullptr, streamFactory.Get());
+
+            IO::AsyncReadRequest request;
+            request.m_path = "MappedFileStreamZeroCopy.bin";
+            request.m_memoryMapped = true;
+            request.m_zeroCopy = true;
+            request.m_callback = &callback;
+            asyncIO->ReadAsync(request);
+
+            while (!callback.m_completed.load(std::memory_order_acquire))
+                _mm_pause();
+        }
+
+        // The I/O thread is gone and the request is deleted, but the buffer still keeps the file mapped.
+        EXPECT_EQ(callback.m_status, IO::AsyncOperationStatus::kSucceeded);
+        EXPECT_EQ(callback.m_bytesRead, kFileSize);
+        if (callback.m_bufferSize == kFileSize)
+        {
+            EXPECT_EQ(memcmp(callback.m_buffer, expected.data(), kFileSize), 0);
+        }
+
+        if (callback.m_buffer)
+            callback.m_allocator->deallocate(callback.m_buffer, callback.m_bufferSize);
+    }
+
+    IO::Directory::SetCurrentDirectory(currentDirectory);
+}
@@ -0,0 +1,196 @@
+#include <FeCore/IO/FileStream.h>
+#include <FeCore/IO/PakArchive.h>
+#include <FeCore/IO/PakStreamFactory.h>
+#include <FeCore/Modules/Configuration.h>
+#include <FeCore/Modules/Environment.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    festd::vector<std::byte> WriteTestFile(const festd::string_view path, const uint32_t byteSize, const uint32_t seed)
+    {
+        festd::vector<std::byte> data;
+        data.resize(byteSize);
+        for (uint32_t byteIndex = 0; byteIndex < byteSize; ++byteIndex)
+            data[byteIndex] = static_cast<std::byte>((byteIndex * 13 + seed) & 0xff);
+
+        IO::FileStream stream;
+        EXPECT_EQ(stream.Open(path, IO::OpenMode::kCreate), IO::ResultCode::kSuccess);
+        EXPECT_EQ(stream.WriteFromBuffer(data.data(), data.size()), data.size());
+        return data;
+    }
+} // namespace
+
+
+TEST(PakArchive, WriteAndRead)
+{
+    struct TestFile final
+    {
+        festd::string_view m_entryName;
+        festd::string_view m_sourceName;
+        uint32_t m_byteSize;
+        festd::vector<std::byte> m_data;
+    };
+
+    TestFile files[] = {
+        { "Models/Cube.fmd", "Cube.bin", 10000 },
+        { "Textures/Empty.ftx", "Empty.bin", 0 },
+        { "Textures/Bricks.ftx", "Bricks.bin", 3 * IO::Pak::kDataAlignment + 7 },
+    };
+
+    const TestDirectory directory;
+
+    IO::PakWriter writer;
+    for (uint32_t fileIndex = 0; fileIndex < std::size(files); ++fileIndex)
+    {
+        TestFile& file = files[fileIndex];
+        const IO::Path sourcePath = directory.GetPath(file.m_sourceName);
+        file.m_data = WriteTestFile(sourcePath, file.m_byteSize, fileIndex);
+        writer.AddFile(file.m_entryName, sourcePath);
+    }
+
+    const IO::Path archivePath = directory.GetPath("Test.pak");
+    ASSERT_EQ(writer.Write(archivePath), IO::ResultCode::kSuccess);
+
+    const Rc archive = Rc<IO::PakArchive>::DefaultNew();
+    ASSERT_EQ(archive->Open(archivePath), IO::ResultCode::kSuccess);
+
+    const festd::span<const IO::Pak::Entry> entries = archive->GetEntries();
+    ASSERT_EQ(entries.size(), std::size(files));
+    for (uint32_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex)
+    {
+        const IO::Pak::Entry& entry = entries[entryIndex];
+        EXPECT_EQ(entry.m_offset % IO::Pak::kDataAlignment, 0);
+        EXPECT_EQ(entry.m_nameHash, Env::Name{ archive->GetEntryName(entry) }.GetHash());
+        if (entryIndex > 0)
+        {
+            EXPECT_LE(entries[entryIndex - 1].m_nameHash, entry.m_nameHash);
+        }
+    }
+
+    for (const TestFile& file : files)
+    {
+        const IO::Pak::Entry* entry = archive->FindEntry(file.m_entryName);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(archive->GetEntryName(*entry), file.m_entryName);
+        EXPECT_EQ(entry->m_byteSize, file.m_byteSize);
+
+        const Rc<IO::IStream> stream = archive->OpenEntryStream(entry);
+        EXPECT_TRUE(stream->GetNativeHandle().IsValid());
+        EXPECT_EQ(stream->GetNativeOffset(), entry->m_offset);
+        ASSERT_EQ(stream->Length(), file.m_byteSize);
+
+        festd::vector<std::byte> buffer;
+        buffer.resize(file.m_byteSize + 16);
+        EXPECT_EQ(stream->ReadToBuffer(buffer.data(), buffer.size()), file.m_byteSize);
+        EXPECT_EQ(memcmp(buffer.data(), file.m_data.data(), file.m_byteSize), 0);
+
+        if (file.m_byteSize > 10)
+        {
+            ASSERT_EQ(stream->Seek(-10, IO::SeekMode::kEnd), IO::ResultCode::kSuccess);
+            EXPECT_EQ(stream->ReadToBuffer(buffer.data(), buffer.size()), 10);
+            EXPECT_EQ(memcmp(buffer.data(), file.m_data.data() + file.m_byteSize - 10, 10), 0);
+        }
+
+        const Rc<IO::IStream> mappedStream = archive->OpenEntryStream(entry, true);
+        EXPECT_FALSE(mappedStream->GetNativeHandle().IsValid());
+        const festd::span<const std::byte> mappedData = mappedStream->GetMappedData();
+        ASSERT_EQ(mappedData.size(), file.m_byteSize);
+        EXPECT_EQ(memcmp(mappedData.data(), file.m_data.data(), file.m_byteSize), 0);
+    }
+
+    // The entry names are normalized.
+    EXPECT_EQ(archive->FindEntry("Models\\Cube.fmd"), archive->FindEntry("Models/Cube.fmd"));
+    EXPECT_EQ(archive->FindEntry("Models/Missing.fmd"), nullptr);
+}
+
+
+TEST(PakArchive, InvalidInput)
+{
+    const TestDirectory directory;
+    const IO::Path duplicatePath = directory.GetPath("Duplicate.bin");
+    WriteTestFile(duplicatePath, 100, 0);
+
+    IO::PakWriter writer;
+    writer.AddFile("Duplicate.bin", duplicatePath);
+    writer.AddFile("./Duplicate.bin", duplicatePath);
+    writer.AddFile("Duplicate.bin", duplicatePath);
+    EXPECT_EQ(writer.Write(directory.GetPath("Duplicate.pak")), IO::ResultCode::kFileExists);
+
+    IO::PakWriter missingFileWriter;
+    missingFileWriter.AddFile("Missing.bin", directory.GetPath("Missing.bin"));
+    EXPECT_EQ(missingFileWriter.Write(directory.GetPath("Missing.pak")), IO::ResultCode::kNoFileOrDirectory);
+
+    // Not an archive.
+    const Rc archive = Rc<IO::PakArchive>::DefaultNew();
+    EXPECT_EQ(archive->Open(duplicatePath), IO::ResultCode::kInvalidFormat);
+}
+
+
+TEST(PakArchive, StreamFactory)
+{
+    const TestDirectory directory;
+    const IO::Path sourcePath = directory.GetPath("Cube.bin");
+    const festd::vector<std::byte> data = WriteTestFile(sourcePath, 1000, 0);
+    WriteTestFile(directory.GetPath("Loose.fmd"), 100, 1);
+
+    IO::PakWriter writer;
+    writer.AddFile("Models/Cube.fmd", sourcePath);
+    ASSERT_EQ(writer.Write(directory.GetPath("Assets.pak")), IO::ResultCode::kSuccess);
+
+    // The stream factory changes the current directory to the asset directory.
+    const IO::Path currentDirectory = IO::Directory::GetCurrentDirectory();
+
+    {
+        const IO::Path directoryPath = directory.GetPath();
+        const std::string assetDirectory = "AssetDirectory=" + std::string{ directoryPath.data(), directoryPath.size() };
+        const festd::string_view commandLine[] = {
+            "-c",
+            festd::string_view{ assetDirectory.data(), static_cast<uint32_t>(assetDirectory.size()) },
+            "-c",
+            "AssetArchives=Missing.pak;Assets.pak",
+        };
+
+        // The missing archive is logged and skipped.
+        Logger logger;
+        const Rc config = Rc<Env::Configuration>::DefaultNew(festd::span{ commandLine });
+        const Rc factory = Rc<IO::PakStreamFactory>::DefaultNew(&logger, config.Get());
+
+        // The asset managers open the files by their absolute paths.
+        const IO::Path entryPath = IO::GetAbsolutePath("Models/Cube.fmd");
+        EXPECT_TRUE(factory->FileExists(entryPath));
+        EXPECT_TRUE(factory->FileExists("Models/Cube.fmd"));
+        EXPECT_EQ(factory->GetFileAttributeFlags(entryPath), IO::FileAttributeFlags::kReadOnly);
+
+        const auto streamResult = factory->OpenFileStream(entryPath, IO::OpenMode::kReadOnly);
+        ASSERT_TRUE(streamResult);
+
+        const Rc<IO::IStream>& stream = streamResult.value();
+        EXPECT_TRUE(stream->GetNativeHandle().IsValid());
+        ASSERT_EQ(stream->Length(), data.size());
+
+        festd::vector<std::byte> buffer;
+        buffer.resize(data.size());
+        EXPECT_EQ(stream->ReadToBuffer(buffer.data(), buffer.size()), data.size());
+        EXPECT_EQ(memcmp(buffer.data(), data.data(), data.size()), 0);
+
+        const auto mappedStreamResult = factory->OpenMappedFileStream(entryPath);
+        ASSERT_TRUE(mappedStreamResult);
+        EXPECT_EQ(mappedStreamResult.value()->GetMappedData().size(), data.size());
+
+        // The files that aren't in the archive are loaded from the asset directory.
+        const auto looseStreamResult = factory->OpenFileStream(IO::GetAbsolutePath("Loose.fmd"), IO::OpenMode::kReadOnly);
+        ASSERT_TRUE(looseStreamResult);
+        EXPECT_EQ(looseStreamResult.value()->Length(), 100);
+
+        // The paths outside the asset directory don't hit the archive.
+        const std::string siblingPath = std::string{ directoryPath.data(), directoryPath.size() } + "Sibling/Models/Cube.fmd";
+        EXPECT_FALSE(factory->FileExists(IO::GetAbsolutePath("../Models/Cube.fmd")));
+        EXPECT_FALSE(factory->FileExists(festd::string_view{ siblingPath.data(), static_cast<uint32_t>(siblingPath.size()) }));
+    }
+
+    IO::Directory::SetCurrentDirectory(currentDirectory);
+}
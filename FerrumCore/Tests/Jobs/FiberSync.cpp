@@ -0,0 +1,185 @@
+﻿#include <FeCore/Jobs/FiberEvent.h>
+#include <FeCore/Jobs/FiberMutex.h>
+#include <FeCore/Jobs/FiberSemaphore.h>
+#include <FeCore/Jobs/JobSystem.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    constexpr uint32_t kWorkerCount = 4;
+    constexpr uint32_t kJobCount = 64;
+
+
+    //! @brief Run the function in kJobCount jobs on a local job system and wait for all of them to complete.
+    template<class TFunc>
+    void RunConcurrently(TFunc func)
+    {
+        JobSystem jobSystem{ kWorkerCount };
+
+        festd::vector<std::unique_ptr<Job>> jobs;
+        for (uint32_t jobIndex = 0; jobIndex < kJobCount; ++jobIndex)
+        {
+            jobs.push_back(std::make_unique<FunctorJob<std::function<void()>>>([&func, jobIndex] {
+                func(jobIndex);
+            }));
+        }
+
+        FunctorJob mainJob{ [&] {
+            const Rc completion = WaitGroup::Create(kJobCount);
+            for (const std::unique_ptr<Job>& job : jobs)
+                job->Schedule(&jobSystem, FiberAffinityMask::kAll, completion.Get());
+
+            completion->Wait();
+            jobSystem.Stop();
+        } };
+
+        mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+        jobSystem.Start();
+    }
+} // namespace
+
+
+TEST(FiberSync, Mutex)
+{
+    constexpr uint32_t kIterationCount = 200;
+
+    FiberMutex mutex;
+    uint32_t counter = 0;
+    std::atomic<uint32_t> ownerCount = 0;
+    std::atomic<bool> overlapped = false;
+
+    RunConcurrently([&](uint32_t) {
+        for (uint32_t iteration = 0; iteration < kIterationCount; ++iteration)
+        {
+            std::lock_guard lock{ mutex };
+            if (ownerCount.fetch_add(1) != 0)
+                overlapped = true;
+
+            // Hold the lock for a while so that the other fibers have to wait.
+            const uint32_t value = counter;
+            std::this_thread::yield();
+            counter = value + 1;
+
+            ownerCount.fetch_sub(1);
+        }
+    });
+
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(counter, kJobCount * kIterationCount);
+}
+
+
+TEST(FiberSync, SharedMutex)
+{
+    constexpr uint32_t kIterationCount = 100;
+
+    FiberSharedMutex mutex;
+    std::atomic<int32_t> readerCount = 0;
+    std::atomic<int32_t> writerCount = 0;
+    std::atomic<bool> violated = false;
+    uint32_t writeCount = 0;
+
+    RunConcurrently([&](const uint32_t jobIndex) {
+        for (uint32_t iteration = 0; iteration < kIterationCount; ++iteration)
+        {
+            if ((jobIndex + iteration) % 4 == 0)
+            {
+                std::lock_guard lock{ mutex };
+                if (writerCount.fetch_add(1) != 0 || readerCount.load() != 0)
+                    violated = true;
+
+                std::this_thread::yield();
+                ++writeCount;
+                writerCount.fetch_sub(1);
+            }
+            else
+            {
+                std::shared_lock lock{ mutex };
+                readerCount.fetch_add(1);
+                if (writerCount.load() != 0)
+                    violated = true;
+
+                std::this_thread::yield();
+                readerCount.fetch_sub(1);
+            }
+        }
+    });
+
+    EXPECT_FALSE(violated.load());
+    EXPECT_EQ(writeCount, kJobCount * kIterationCount / 4);
+}
+
+
+TEST(FiberSync, SemaphoreLimitsConcurrency)
+{
+    constexpr uint32_t kMaxConcurrency = 2;
+
+    FiberSemaphore semaphore{ kMaxConcurrency };
+    std::atomic<uint32_t> activeCount = 0;
+    std::atomic<uint32_t> maxActiveCount = 0;
+    std::atomic<uint32_t> completedCount = 0;
+
+    RunConcurrently([&](uint32_t) {
+        semaphore.Acquire();
+
+        const uint32_t active = activeCount.fetch_add(1) + 1;
+        uint32_t prevMax = maxActiveCount.load();
+        while (prevMax < active && !maxActiveCount.compare_exchange_weak(prevMax, active))
+        {
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        activeCount.fetch_sub(1);
+        completedCount.fetch_add(1);
+
+        semaphore.Release();
+    });
+
+    EXPECT_EQ(completedCount.load(), kJobCount);
+    EXPECT_LE(maxActiveCount.load(), kMaxConcurrency);
+    EXPECT_TRUE(semaphore.TryAcquire());
+    EXPECT_TRUE(semaphore.TryAcquire());
+    EXPECT_FALSE(semaphore.TryAcquire());
+}
+
+
+TEST(FiberSync, Event)
+{
+    FiberEvent startEvent = FiberEvent::CreateManualReset();
+    FiberEvent tokenEvent = FiberEvent::CreateAutoReset();
+    std::atomic<uint32_t> waitingCount = 0;
+    std::atomic<uint32_t> tokenHolderCount = 0;
+    std::atomic<bool> overlapped = false;
+
+    RunConcurrently([&](const uint32_t jobIndex) {
+        if (jobIndex == 0)
+        {
+            // Let the other jobs block on the event first.
+            while (waitingCount.load() < kJobCount - 1)
+                std::this_thread::yield();
+
+            tokenEvent.Send();
+            startEvent.Send();
+            return;
+        }
+
+        waitingCount.fetch_add(1);
+        startEvent.Wait();
+
+        // The auto reset event works like a token passed from one job to the next.
+        tokenEvent.Wait();
+        if (tokenHolderCount.fetch_add(1) != 0)
+            overlapped = true;
+
+        std::this_thread::yield();
+        tokenHolderCount.fetch_sub(1);
+        tokenEvent.Send();
+    });
+
+    EXPECT_TRUE(startEvent.IsSignaled());
+    EXPECT_TRUE(tokenEvent.IsSignaled());
+    EXPECT_FALSE(overlapped.load());
+}
@@ -0,0 +1,489 @@
+﻿#include <FeCore/Base/Platform.h>
+#include <FeCore/IO/FileStream.h>
+#include <FeCore/Containers/WorkStealingDeque.h>
+#include <FeCore/Jobs/JobSystem.h>
+#include <FeCore/Jobs/ParallelFor.h>
+#include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <FeCore/Time/BaseTime.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    struct TestItem final
+    {
+        uint32_t m_value = 0;
+        std::atomic<uint32_t> m_consumeCount = 0;
+    };
+
+
+    struct EmptyTreeJob final : public Job
+    {
+        struct Context final
+        {
+            JobSystem* m_jobSystem = nullptr;
+            EmptyTreeJob* m_jobs = nullptr;
+            uint32_t m_jobCount = 0;
+            std::atomic<uint32_t> m_completedJobCount = 0;
+        };
+
+        Context* m_context = nullptr;
+        uint32_t m_index = 0;
+
+        void Execute() override
+        {
+            // Jobs form an implicit binary tree: each job schedules its two children.
+            // This way the work starts on a single worker and has to be stolen by the others.
+            const uint32_t firstChildIndex = m_index * 2 + 1;
+            for (uint32_t childIndex = firstChildIndex; childIndex < firstChildIndex + 2; ++childIndex)
+            {
+                if (childIndex < m_context->m_jobCount)
+                    m_context->m_jobs[childIndex].ScheduleForeground(m_context->m_jobSystem);
+            }
+
+            if (m_context->m_completedJobCount.fetch_add(1, std::memory_order_acq_rel) + 1 == m_context->m_jobCount)
+                m_context->m_jobSystem->Stop();
+        }
+    };
+
+
+    double RunEmptyJobs(const uint32_t workerCount, const uint32_t jobCount)
+    {
+        JobSystem jobSystem{ workerCount };
+
+        EmptyTreeJob::Context context;
+        context.m_jobSystem = &jobSystem;
+        context.m_jobCount = jobCount;
+
+        const std::unique_ptr<EmptyTreeJob[]> jobs{ new EmptyTreeJob[jobCount] };
+        for (uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex)
+        {
+            jobs[jobIndex].m_context = &context;
+            jobs[jobIndex].m_index = jobIndex;
+        }
+
+        context.m_jobs = jobs.get();
+
+        const uint64_t startTicks = Platform::GetTicks();
+        jobs[0].ScheduleForeground(&jobSystem);
+        jobSystem.Start();
+        const uint64_t endTicks = Platform::GetTicks();
+
+        EXPECT_EQ(context.m_completedJobCount.load(), jobCount);
+        return static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+    }
+} // namespace
+
+
+TEST(WorkStealingDeque, PushPop)
+{
+    WorkStealingDeque<TestItem> deque;
+    deque.Initialize(16);
+
+    TestItem items[16];
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_EQ(deque.Pop(), nullptr);
+
+    for (TestItem& item : items)
+        EXPECT_TRUE(deque.Push(&item));
+
+    TestItem extraItem;
+    EXPECT_FALSE(deque.Push(&extraItem));
+
+    // The owner pops in LIFO order.
+    for (int32_t itemIndex = 15; itemIndex >= 0; --itemIndex)
+        EXPECT_EQ(deque.Pop(), &items[itemIndex]);
+
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_EQ(deque.Pop(), nullptr);
+}
+
+
+TEST(WorkStealingDeque, PushSteal)
+{
+    WorkStealingDeque<TestItem> deque;
+    deque.Initialize(4);
+
+    TestItem items[8];
+    for (uint32_t round = 0; round < 2; ++round)
+    {
+        for (uint32_t itemIndex = 0; itemIndex < 4; ++itemIndex)
+            EXPECT_TRUE(deque.Push(&items[round * 4 + itemIndex]));
+
+        // Thieves take the elements in FIFO order.
+        EXPECT_EQ(deque.Steal(), &items[round * 4 + 0]);
+        EXPECT_EQ(deque.Steal(), &items[round * 4 + 1]);
+        EXPECT_EQ(deque.Pop(), &items[round * 4 + 3]);
+        EXPECT_EQ(deque.Steal(), &items[round * 4 + 2]);
+        EXPECT_EQ(deque.Steal(), nullptr);
+        EXPECT_TRUE(deque.Empty());
+    }
+}
+
+
+TEST(WorkStealingDeque, ConcurrentSteal)
+{
+    constexpr uint32_t kItemCount = 256 * 1024;
+    constexpr uint32_t kThiefCount = 3;
+
+    struct State final
+    {
+        WorkStealingDeque<TestItem> m_deque;
+        std::atomic<bool> m_ownerDone = false;
+    };
+
+    State state;
+    state.m_deque.Initialize(256);
+
+    const std::unique_ptr<TestItem[]> items{ new TestItem[kItemCount] };
+
+    const auto thiefFunc = [](const uintptr_t userData) {
+        State& state = *reinterpret_cast<State*>(userData);
+        while (true)
+        {
+            const bool ownerDone = state.m_ownerDone.load(std::memory_order_acquire);
+            if (TestItem* item = state.m_deque.Steal())
+            {
+                item->m_consumeCount.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (ownerDone && state.m_deque.Empty())
+                break;
+
+            _mm_pause();
+        }
+    };
+
+    Threading::ThreadHandle thieves[kThiefCount];
+    for (uint32_t thiefIndex = 0; thiefIndex < kThiefCount; ++thiefIndex)
+    {
+        const auto threadName = Fmt::FixedFormat("Thief {}", thiefIndex);
+        thieves[thiefIndex] = Threading::CreateThread(threadName, thiefFunc, reinterpret_cast<uintptr_t>(&state));
+    }
+
+    for (uint32_t itemIndex = 0; itemIndex < kItemCount; ++itemIndex)
+    {
+        while (!state.m_deque.Push(&items[itemIndex]))
+        {
+            if (TestItem* item = state.m_deque.Pop())
+                item->m_consumeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Pop some elements ourselves to race with the thieves.
+        if (itemIndex % 3 == 0)
+        {
+            if (TestItem* item = state.m_deque.Pop())
+                item->m_consumeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    while (TestItem* item = state.m_deque.Pop())
+        item->m_consumeCount.fetch_add(1, std::memory_order_relaxed);
+
+    state.m_ownerDone.store(true, std::memory_order_release);
+    for (Threading::ThreadHandle& thief : thieves)
+        Threading::CloseThread(thief);
+
+    // Every element must be consumed exactly once.
+    for (uint32_t itemIndex = 0; itemIndex < kItemCount; ++itemIndex)
+        ASSERT_EQ(items[itemIndex].m_consumeCount.load(), 1u) << "Item " << itemIndex;
+}
+
+
+TEST(JobSystem, EmptyJobs)
+{
+    RunEmptyJobs(4, 64 * 1024);
+}
+
+
+//! @brief Prints the empty job throughput for different worker counts, run with --gtest_also_run_disabled_tests.
+TEST(JobSystem, DISABLED_EmptyJobThroughput)
+{
+    constexpr uint32_t kJobCount = 2 * 1024 * 1024;
+
+    const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
+    const uint32_t maxWorkerCount = Math::Clamp(cpuInfo.m_logicalCores, 2u, 64u);
+
+    festd::vector<uint32_t> workerCounts;
+    for (uint32_t workerCount = 2; workerCount < maxWorkerCount; workerCount *= 2)
+        workerCounts.push_back(workerCount);
+    workerCounts.push_back(maxWorkerCount);
+
+    for (const uint32_t workerCount : workerCounts)
+    {
+        const double seconds = RunEmptyJobs(workerCount, kJobCount);
+        const double jobsPerSecond = kJobCount / seconds;
+        printf("[ JobSystem ] %2u workers: %u jobs in %.3f ms, %.2f M jobs/s\n",
+               workerCount,
+               kJobCount,
+               seconds * 1000.0,
+               jobsPerSecond / 1e6);
+    }
+}
+
+
+TEST(JobSystem, IdleWorkersSleep)
+{
+    constexpr uint32_t kWorkerCount = 8;
+    constexpr auto kIdleDuration = std::chrono::milliseconds(100);
+
+    JobSystem jobSystem{ kWorkerCount };
+
+    double idleCpuTime = 0.0;
+    double idleWallTime = 0.0;
+
+    FunctorJob mainJob{ [&] {
+        // Let the workers run out of work and measure how much CPU time they burn while idle.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const double startCpuTime = Platform::GetProcessCpuTime();
+        const uint64_t startTicks = Platform::GetTicks();
+        std::this_thread::sleep_for(kIdleDuration);
+        idleCpuTime = Platform::GetProcessCpuTime() - startCpuTime;
+        idleWallTime = static_cast<double>(Platform::GetTicks() - startTicks) * Platform::GetSecondsPerTick();
+
+        jobSystem.Stop();
+    } };
+
+    mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+    jobSystem.Start();
+
+    // Spinning workers would consume several cores, parked workers should consume almost nothing.
+    EXPECT_LT(idleCpuTime, idleWallTime * 0.5);
+}
+
+
+//! @brief Prints the latency of waking up a parked worker, run with --gtest_also_run_disabled_tests.
+TEST(JobSystem, DISABLED_WakeLatency)
+{
+    constexpr uint32_t kWorkerCount = 8;
+    constexpr uint32_t kWakeCount = 200;
+
+    JobSystem jobSystem{ kWorkerCount };
+
+    double totalLatency = 0.0;
+    double maxLatency = 0.0;
+
+    std::atomic<uint64_t> executionTicks = 0;
+    FunctorJob wakeJob{ [&] {
+        executionTicks.store(Platform::GetTicks(), std::memory_order_release);
+    } };
+
+    FunctorJob mainJob{ [&] {
+        // The main thread is a foreground worker, so a background job always has to wake up another worker.
+        for (uint32_t wakeIndex = 0; wakeIndex < kWakeCount; ++wakeIndex)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            executionTicks.store(0, std::memory_order_relaxed);
+            const uint64_t scheduleTicks = Platform::GetTicks();
+            wakeJob.ScheduleBackground(&jobSystem);
+
+            while (executionTicks.load(std::memory_order_acquire) == 0)
+                std::this_thread::yield();
+
+            const double latency =
+                static_cast<double>(executionTicks.load(std::memory_order_relaxed) - scheduleTicks) * Platform::GetSecondsPerTick();
+            totalLatency += latency;
+            maxLatency = Math::Max(maxLatency, latency);
+        }
+
+        jobSystem.Stop();
+    } };
+
+    mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+    jobSystem.Start();
+
+    printf("[ JobSystem ] Wake-up latency: %.2f us average, %.2f us max\n",
+           totalLatency / kWakeCount * 1e6,
+           maxLatency * 1e6);
+}
+
+
+TEST(JobSystem, ParallelFor)
+{
+    constexpr uint32_t kCount = 100000;
+
+    JobSystem localJobSystem{ 4 };
+    IJobSystem* jobSystem = &localJobSystem;
+
+    const std::unique_ptr<std::atomic<uint32_t>[]> callCounts{ new std::atomic<uint32_t>[kCount]() };
+    festd::vector<uint32_t> values(kCount, 1);
+    uint32_t emptyCallCount = 0;
+
+    bool isCurrentJobSystem = false;
+
+    FunctorJob job{ [&] {
+        isCurrentJobSystem = JobSystem::GetCurrent() == &localJobSystem;
+
+        ParallelFor(jobSystem, 0, [&](uint32_t) {
+            ++emptyCallCount;
+        });
+
+        ParallelFor(
+            jobSystem,
+            kCount,
+            [&](const uint32_t index) {
+                callCounts[index].fetch_add(1, std::memory_order_relaxed);
+            },
+            64);
+
+        ParallelForEach(jobSystem, festd::span(values), [](uint32_t& value) {
+            value *= 2;
+        });
+
+        jobSystem->Stop();
+    } };
+
+    job.Schedule(jobSystem, FiberAffinityMask::kMainThread);
+    jobSystem->Start();
+
+    EXPECT_TRUE(isCurrentJobSystem);
+    EXPECT_EQ(JobSystem::GetCurrent(), nullptr);
+    EXPECT_EQ(emptyCallCount, 0);
+    for (uint32_t index = 0; index < kCount; ++index)
+    {
+        ASSERT_EQ(callCounts[index].load(), 1u) << "Index " << index;
+        ASSERT_EQ(values[index], 2u) << "Index " << index;
+    }
+}
+
+
+TEST(JobSystem, ManyWaitingFibersAndLargeStacks)
+{
+    // More jobs are blocked at the same time than the old fixed-size fiber pool could hold.
+    constexpr uint32_t kWaitingJobCount = 400;
+
+    JobSystem jobSystem{ 4 };
+
+    std::atomic<uint32_t> startedJobCount = 0;
+    std::atomic<uint32_t> finishedJobCount = 0;
+    bool largeStackJobExecuted = false;
+
+    const Rc gate = WaitGroup::Create();
+    const Rc completion = WaitGroup::Create(kWaitingJobCount + 1);
+
+    festd::vector<std::unique_ptr<Job>> jobs;
+    for (uint32_t jobIndex = 0; jobIndex < kWaitingJobCount; ++jobIndex)
+    {
+        jobs.push_back(std::make_unique<FunctorJob<std::function<void()>>>([&] {
+            startedJobCount.fetch_add(1, std::memory_order_relaxed);
+            gate->Wait();
+            finishedJobCount.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+
+    // This would overflow a small stack and hit its guard page.
+    auto useLargeStack = [&] {
+        volatile std::byte buffer[512 * 1024];
+        for (size_t offset = 0; offset < sizeof(buffer); offset += 4096)
+            buffer[offset] = std::byte{ 1 };
+        largeStackJobExecuted = buffer[0] == std::byte{ 1 };
+    };
+
+    FunctorJob largeStackJob{ std::move(useLargeStack), JobStackSize::kLarge };
+
+    FunctorJob mainJob{ [&] {
+        for (const std::unique_ptr<Job>& job : jobs)
+            job->ScheduleBackground(&jobSystem, completion.Get());
+
+        while (startedJobCount.load(std::memory_order_relaxed) < kWaitingJobCount)
+            std::this_thread::yield();
+
+        largeStackJob.ScheduleBackground(&jobSystem, completion.Get());
+        gate->Signal();
+        completion->Wait();
+        jobSystem.Stop();
+    } };
+
+    mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+    jobSystem.Start();
+
+    EXPECT_EQ(finishedJobCount.load(), kWaitingJobCount);
+    EXPECT_TRUE(largeStackJobExecuted);
+}
+
+
+TEST(JobSystem, ProfilerCapture)
+{
+    constexpr uint32_t kJobCount = 256;
+    constexpr uint32_t kWaitingJobCount = 16;
+
+    JobSystem jobSystem{ 4 };
+    JobProfiler& profiler = jobSystem.GetProfiler();
+
+    std::atomic<uint32_t> executedJobCount = 0;
+    const Rc gate = WaitGroup::Create();
+    const Rc completion = WaitGroup::Create(kJobCount + kWaitingJobCount);
+
+    festd::vector<std::unique_ptr<Job>> jobs;
+    for (uint32_t jobIndex = 0; jobIndex < kJobCount; ++jobIndex)
+    {
+        jobs.push_back(std::make_unique<FunctorJob<std::function<void()>>>([&] {
+            executedJobCount.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+
+    for (uint32_t jobIndex = 0; jobIndex < kWaitingJobCount; ++jobIndex)
+    {
+        jobs.push_back(std::make_unique<FunctorJob<std::function<void()>>>([&] {
+            gate->Wait();
+            executedJobCount.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+
+    FunctorJob mainJob{ [&] {
+        profiler.StartCapture(1024);
+
+        for (const std::unique_ptr<Job>& job : jobs)
+            job->ScheduleForeground(&jobSystem, completion.Get());
+
+        Threading::Sleep(5);
+        gate->Signal();
+        completion->Wait();
+
+        profiler.StopCapture();
+        jobSystem.Stop();
+    } };
+
+    mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+    jobSystem.Start();
+
+    ASSERT_EQ(executedJobCount.load(), kJobCount + kWaitingJobCount);
+
+    const JobWorkerStats stats = profiler.GetTotalStats();
+    EXPECT_GE(stats.m_jobCount, kJobCount + kWaitingJobCount);
+    EXPECT_GT(stats.m_fiberSwitchCount, 0u);
+    EXPECT_GT(stats.m_waitTicks, 0u);
+
+    uint64_t jobCount = 0;
+    for (uint32_t workerIndex = 0; workerIndex < JobProfiler::kMaxWorkerCount; ++workerIndex)
+        jobCount += profiler.GetWorkerStats(workerIndex).m_jobCount;
+    EXPECT_EQ(jobCount, stats.m_jobCount);
+
+    const TestDirectory directory;
+    const IO::Path tracePath = directory.GetPath("ProfilerCapture.json");
+
+    {
+        IO::FileStream stream;
+        ASSERT_EQ(stream.Open(tracePath, IO::OpenMode::kCreate), IO::ResultCode::kSuccess);
+        EXPECT_TRUE(profiler.ExportChromeTrace(&stream));
+    }
+
+    IO::FileStream stream;
+    ASSERT_EQ(stream.Open(tracePath, IO::OpenMode::kReadOnly), IO::ResultCode::kSuccess);
+
+    festd::string trace;
+    trace.resize_uninitialized(static_cast<uint32_t>(stream.Length()));
+    ASSERT_EQ(stream.ReadToBuffer(trace.data(), trace.size()), trace.size());
+    stream.Close();
+
+    EXPECT_TRUE(trace.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    EXPECT_TRUE(trace.ends_with("]}\n"));
+    EXPECT_NE(trace.find(R"("args":{"name":"Main Thread"})"), trace.end());
+    EXPECT_NE(trace.find(R"("name":"Job","cat":"jobs","ph":"X")"), trace.end());
+    EXPECT_NE(trace.find(R"("name":"Wait")"), trace.end());
+}
@@ -0,0 +1,155 @@
+﻿#include <FeCore/Jobs/JobSystem.h>
+#include <FeCore/Jobs/TaskGraph.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    template<class TFunc>
+    void RunOnJobSystem(TFunc func)
+    {
+        JobSystem jobSystem{ 4 };
+
+        FunctorJob mainJob{ [&] {
+            func(&jobSystem);
+            jobSystem.Stop();
+        } };
+
+        mainJob.Schedule(&jobSystem, FiberAffinityMask::kMainThread);
+        jobSystem.Start();
+    }
+} // namespace
+
+
+TEST(TaskGraph, DependencyOrder)
+{
+    // A diamond: B and C depend on A, D depends on B and C.
+    std::atomic<uint32_t> sequence = 0;
+    uint32_t order[4] = {};
+
+    TaskGraph graph;
+    const TaskGraphNodeHandle a = graph.AddNode([&] {
+        order[0] = sequence.fetch_add(1);
+    });
+    const TaskGraphNodeHandle b = graph.AddNode([&] {
+        order[1] = sequence.fetch_add(1);
+    });
+    const TaskGraphNodeHandle c = graph.AddNode([&] {
+        order[2] = sequence.fetch_add(1);
+    });
+    const TaskGraphNodeHandle d = graph.AddNode([&] {
+        order[3] = sequence.fetch_add(1);
+    });
+
+    graph.AddDependency(b, a);
+    graph.AddDependency(c, a);
+    graph.AddDependency(d, b);
+    graph.AddDependency(d, c);
+
+    RunOnJobSystem([&](IJobSystem* jobSystem) {
+        graph.Run(jobSystem);
+    });
+
+    EXPECT_EQ(sequence.load(), 4u);
+    EXPECT_EQ(order[0], 0u);
+    EXPECT_LT(order[0], order[1]);
+    EXPECT_LT(order[0], order[2]);
+    EXPECT_EQ(order[3], 3u);
+    EXPECT_FALSE(graph.IsRunning());
+}
+
+
+TEST(TaskGraph, ReuseAcrossRuns)
+{
+    constexpr uint32_t kStageCount = 8;
+    constexpr uint32_t kNodesPerStage = 16;
+    constexpr uint32_t kRunCount = 50;
+
+    // Every node of a stage depends on every node of the previous stage.
+    std::atomic<uint32_t> completedStageNodeCounts[kStageCount] = {};
+    std::atomic<bool> orderViolated = false;
+
+    TaskGraph graph;
+    festd::vector<TaskGraphNodeHandle> previousStage;
+    for (uint32_t stageIndex = 0; stageIndex < kStageCount; ++stageIndex)
+    {
+        festd::vector<TaskGraphNodeHandle> currentStage;
+        for (uint32_t nodeIndex = 0; nodeIndex < kNodesPerStage; ++nodeIndex)
+        {
+            const TaskGraphNodeHandle node = graph.AddNode([&, stageIndex] {
+                if (stageIndex > 0 && completedStageNodeCounts[stageIndex - 1].load() % kNodesPerStage != 0)
+                    orderViolated = true;
+
+                completedStageNodeCounts[stageIndex].fetch_add(1);
+            });
+
+            for (const TaskGraphNodeHandle dependency : previousStage)
+                graph.AddDependency(node, dependency);
+
+            currentStage.push_back(node);
+        }
+
+        previousStage = std::move(currentStage);
+    }
+
+    EXPECT_EQ(graph.GetNodeCount(), kStageCount * kNodesPerStage);
+
+    RunOnJobSystem([&](IJobSystem* jobSystem) {
+        for (uint32_t runIndex = 0; runIndex < kRunCount; ++runIndex)
+        {
+            const Rc completion = WaitGroup::Create();
+            graph.Schedule(jobSystem, completion.Get());
+            completion->Wait();
+        }
+    });
+
+    EXPECT_FALSE(orderViolated.load());
+    for (const std::atomic<uint32_t>& count : completedStageNodeCounts)
+        EXPECT_EQ(count.load(), kNodesPerStage * kRunCount);
+}
+
+
+TEST(TaskGraph, LargeStackJobs)
+{
+    // These would overflow a small stack and hit its guard page.
+    bool largeJobExecuted = false;
+    FunctorJob largeJob{ [&] {
+                            volatile std::byte buffer[512 * 1024];
+                            for (size_t offset = 0; offset < sizeof(buffer); offset += 4096)
+                                buffer[offset] = std::byte{ 1 };
+                            largeJobExecuted = buffer[0] == std::byte{ 1 };
+                        },
+                         JobStackSize::kLarge };
+
+    bool largeFunctorExecuted = false;
+    const auto largeFunctor = [&] {
+        volatile std::byte buffer[512 * 1024];
+        for (size_t offset = 0; offset < sizeof(buffer); offset += 4096)
+            buffer[offset] = std::byte{ 2 };
+        largeFunctorExecuted = buffer[0] == std::byte{ 2 };
+    };
+
+    TaskGraph graph;
+    const TaskGraphNodeHandle first = graph.AddNode(&largeJob);
+    const TaskGraphNodeHandle second =
+        graph.AddNode(largeFunctor, FiberAffinityMask::kAll, JobPriority::kNormal, JobStackSize::kLarge);
+    graph.AddDependency(second, first);
+
+    RunOnJobSystem([&](IJobSystem* jobSystem) {
+        graph.Run(jobSystem);
+    });
+
+    EXPECT_TRUE(largeJobExecuted);
+    EXPECT_TRUE(largeFunctorExecuted);
+}
+
+
+TEST(TaskGraph, EmptyGraph)
+{
+    TaskGraph graph;
+    const Rc completion = WaitGroup::Create();
+    graph.Schedule(nullptr, completion.Get());
+    EXPECT_TRUE(completion->IsSignaled());
+}
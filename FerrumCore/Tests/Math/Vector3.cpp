@@ -40,7 +40,7 @@ TEST(Vector3, CreateFunctions)
 
 TEST(Vector3, Load)
 {
-    const float alignas(__m128) values[] = { 1, 2, 3, 4, 5 };
+    alignas(__m128) const float values[] = { 1, 2, 3, 4, 5 };
     const Vector3 vector1 = Vector3::LoadAligned(values);
     EXPECT_EQ(vector1.x, 1);
     EXPECT_EQ(vector1.y, 2);
@@ -30,7 +30,7 @@ TEST(Vector4, CreateFunctions)
 
 TEST(Vector4, Load)
 {
-    const float alignas(__m128) values[] = { 1, 2, 3, 4, 5 };
+    alignas(__m128) const float values[] = { 1, 2, 3, 4, 5 };
     const Vector4 vector1 = Vector4::LoadAligned(values);
     EXPECT_EQ(vector1.x, 1);
     EXPECT_EQ(vector1.y, 2);
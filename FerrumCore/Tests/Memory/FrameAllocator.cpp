@@ -0,0 +1,123 @@
+﻿#include <FeCore/Memory/FrameAllocator.h>
+#include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <festd/vector.h>
+#include <gtest/gtest.h>
+
+using namespace FE;
+
+namespace
+{
+    constexpr uint32_t kAllocationsPerThread = 4 * 1024;
+
+
+    struct AllocationContext final
+    {
+        Memory::FrameAllocator* m_allocator = nullptr;
+        uint32_t* m_allocations[kAllocationsPerThread] = {};
+        uint32_t m_threadIndex = 0;
+    };
+
+
+    void AllocateFrameData(const uintptr_t userData)
+    {
+        AllocationContext& context = *reinterpret_cast<AllocationContext*>(userData);
+        for (uint32_t allocationIndex = 0; allocationIndex < kAllocationsPerThread; ++allocationIndex)
+        {
+            const uint32_t elementCount = 1 + allocationIndex % 32;
+            const festd::span array = context.m_allocator->AllocateArray<uint32_t>(elementCount);
+            for (uint32_t& element : array)
+                element = context.m_threadIndex;
+
+            context.m_allocations[allocationIndex] = array.data();
+        }
+    }
+} // namespace
+
+
+TEST(FrameAllocator, FrameLifetime)
+{
+    constexpr uint32_t kFrameCount = 3;
+    const Rc<Memory::FrameAllocator> allocator = Rc<Memory::FrameAllocator>::DefaultNew(kFrameCount, 4096);
+
+    auto* first = allocator->New<uint64_t>(0xdeadbeefull);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % alignof(uint64_t), 0u);
+
+    void* aligned = allocator->Allocate(64, 256);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 256, 0u);
+
+    // The allocation must stay valid for kFrameCount - 1 subsequent frames.
+    for (uint32_t frameIndex = 1; frameIndex < kFrameCount; ++frameIndex)
+    {
+        allocator->BeginFrame();
+        auto* other = allocator->New<uint64_t>(frameIndex);
+        EXPECT_NE(other, first);
+        EXPECT_EQ(*first, 0xdeadbeefull);
+    }
+
+    // The buffer of the first frame is reused now.
+    allocator->BeginFrame();
+    EXPECT_EQ(allocator->GetFrameIndex(), kFrameCount);
+    EXPECT_EQ(allocator->New<uint64_t>(0ull), first);
+}
+
+
+TEST(FrameAllocator, LargeAllocations)
+{
+    const Rc<Memory::FrameAllocator> allocator = Rc<Memory::FrameAllocator>::DefaultNew(2, 4096);
+
+    const festd::span large = allocator->AllocateArray<uint8_t>(64 * 1024);
+    memset(large.data(), 0xab, large.size());
+
+    void* largeAligned = allocator->Allocate(8192, 512);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(largeAligned) % 512, 0u);
+
+    festd::pmr::vector<uint32_t> vector{ allocator->GetMemoryResource() };
+    for (uint32_t elementIndex = 0; elementIndex < 4096; ++elementIndex)
+        vector.push_back(elementIndex);
+
+    allocator->BeginFrame();
+    EXPECT_EQ(large[large.size() - 1], 0xab);
+    EXPECT_EQ(vector[4095], 4095u);
+
+    allocator->BeginFrame();
+    allocator->FreeUnusedMemory();
+}
+
+
+TEST(FrameAllocator, ConcurrentAllocations)
+{
+    constexpr uint32_t kThreadCount = 8;
+    const Rc<Memory::FrameAllocator> allocator = Rc<Memory::FrameAllocator>::DefaultNew();
+
+    festd::vector<AllocationContext> contexts(kThreadCount);
+    Threading::ThreadHandle threads[kThreadCount];
+
+    for (uint32_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        for (uint32_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+        {
+            contexts[threadIndex].m_allocator = allocator.Get();
+            contexts[threadIndex].m_threadIndex = threadIndex;
+
+            const auto threadName = Fmt::FixedFormat("FrameAllocator {}", threadIndex);
+            const auto userData = reinterpret_cast<uintptr_t>(&contexts[threadIndex]);
+            threads[threadIndex] = Threading::CreateThread(threadName, AllocateFrameData, userData);
+        }
+
+        for (Threading::ThreadHandle& thread : threads)
+            Threading::CloseThread(thread);
+
+        for (const AllocationContext& context : contexts)
+        {
+            for (uint32_t allocationIndex = 0; allocationIndex < kAllocationsPerThread; ++allocationIndex)
+            {
+                const uint32_t elementCount = 1 + allocationIndex % 32;
+                for (uint32_t elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+                    ASSERT_EQ(context.m_allocations[allocationIndex][elementIndex], context.m_threadIndex);
+            }
+        }
+
+        allocator->BeginFrame();
+    }
+}
@@ -0,0 +1,153 @@
+﻿#include <FeCore/Base/Platform.h>
+#include <FeCore/Base/StackTrace.h>
+#include <FeCore/Memory/Memory.h>
+#include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <gtest/gtest.h>
+
+using namespace FE;
+
+namespace
+{
+    constexpr uint32_t kAllocationsPerThread = 4 * 1024;
+    constexpr uint32_t kLiveAllocationCount = 64;
+
+
+    struct AllocationContext final
+    {
+        void** m_handoff = nullptr;
+        uint32_t m_threadIndex = 0;
+        uint32_t m_failedCount = 0;
+    };
+
+
+    void AllocateAndFree(const uintptr_t userData)
+    {
+        AllocationContext& context = *reinterpret_cast<AllocationContext*>(userData);
+
+        void* liveAllocations[kLiveAllocationCount] = {};
+        for (uint32_t allocationIndex = 0; allocationIndex < kAllocationsPerThread; ++allocationIndex)
+        {
+            const uint32_t slotIndex = allocationIndex % kLiveAllocationCount;
+            Memory::DefaultFree(liveAllocations[slotIndex]);
+
+            const size_t byteSize = 16 + (allocationIndex * 37) % 512;
+            auto* ptr = static_cast<uint8_t*>(Memory::DefaultAllocate(byteSize));
+            memset(ptr, static_cast<int32_t>(context.m_threadIndex), byteSize);
+            if (Memory::GetAllocatedSize(ptr) < byteSize)
+                ++context.m_failedCount;
+
+            liveAllocations[slotIndex] = ptr;
+        }
+
+        // Leave the remaining allocations to the main thread, so that they are freed on a different thread.
+        for (uint32_t slotIndex = 0; slotIndex < kLiveAllocationCount; ++slotIndex)
+            context.m_handoff[slotIndex] = liveAllocations[slotIndex];
+    }
+} // namespace
+
+
+TEST(Memory, CallStackDeduplication)
+{
+    Trace::CallStack callstacks[2] = { Trace::CallStack::GetEmpty(), Trace::CallStack::GetEmpty() };
+    for (Trace::CallStack& callstack : callstacks)
+        callstack = Trace::CallStack::Capture();
+
+    EXPECT_TRUE(callstacks[0].IsValid());
+    EXPECT_EQ(callstacks[0], callstacks[1]);
+
+#if FE_DEVELOPMENT
+    EXPECT_NE(callstacks[0].GetFrames()[0], nullptr);
+    EXPECT_EQ(Trace::CallStack::GetEmpty().GetFrames()[0], nullptr);
+#endif
+}
+
+
+TEST(Memory, ConcurrentAllocations)
+{
+    const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
+    const uint32_t threadCount = Math::Clamp(cpuInfo.m_logicalCores, 2u, 16u);
+
+    void* handoff[16][kLiveAllocationCount];
+    AllocationContext contexts[16];
+    Threading::ThreadHandle threads[16];
+
+    for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        contexts[threadIndex].m_handoff = handoff[threadIndex];
+        contexts[threadIndex].m_threadIndex = threadIndex;
+
+        const auto threadName = Fmt::FixedFormat("Allocator {}", threadIndex);
+        const auto userData = reinterpret_cast<uintptr_t>(&contexts[threadIndex]);
+        threads[threadIndex] = Threading::CreateThread(threadName, AllocateAndFree, userData);
+    }
+
+    for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        Threading::CloseThread(threads[threadIndex]);
+
+    for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        EXPECT_EQ(contexts[threadIndex].m_failedCount, 0u);
+        for (void* ptr : handoff[threadIndex])
+        {
+            EXPECT_EQ(*static_cast<uint8_t*>(ptr), threadIndex);
+            Memory::DefaultFree(ptr);
+        }
+    }
+}
+
+
+TEST(Memory, TagTracking)
+{
+    constexpr uint32_t kAllocationCount = 256;
+    constexpr size_t kAllocationByteSize = 4096;
+
+    struct BudgetState final
+    {
+        uint32_t m_softCount = 0;
+        uint32_t m_hardCount = 0;
+    };
+
+    BudgetState budgetState;
+
+    Memory::Budget budget;
+    budget.m_softByteSize = kAllocationCount * kAllocationByteSize / 2;
+    budget.m_hardByteSize = kAllocationCount * kAllocationByteSize * 2;
+    budget.m_userData = &budgetState;
+    budget.m_callback = [](const Memory::Tag tag, const Memory::BudgetLevel level, int64_t, void* userData) {
+        EXPECT_EQ(tag, Memory::Tag::kAssets);
+        auto* state = static_cast<BudgetState*>(userData);
+        ++(level == Memory::BudgetLevel::kSoft ? state->m_softCount : state->m_hardCount);
+    };
+
+    const Memory::TagStats initialStats = Memory::GetTagStats(Memory::Tag::kAssets);
+    Memory::SetBudget(Memory::Tag::kAssets, budget);
+
+    Memory::TaggedMemoryResource allocator{ Memory::Tag::kAssets };
+
+    void* allocations[kAllocationCount];
+    for (void*& ptr : allocations)
+    {
+        ptr = allocator.allocate(kAllocationByteSize, 64);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+    }
+
+    const Memory::TagStats stats = Memory::GetTagStats(Memory::Tag::kAssets);
+    EXPECT_EQ(stats.m_liveByteSize - initialStats.m_liveByteSize, kAllocationCount * kAllocationByteSize);
+    EXPECT_EQ(stats.m_allocationCount - initialStats.m_allocationCount, kAllocationCount);
+    EXPECT_EQ(stats.m_allocatedByteSize - initialStats.m_allocatedByteSize, kAllocationCount * kAllocationByteSize);
+    EXPECT_GE(stats.m_peakByteSize, stats.m_liveByteSize);
+    EXPECT_EQ(budgetState.m_softCount, 1u);
+    EXPECT_EQ(budgetState.m_hardCount, 0u);
+
+    // The size is not needed to free the memory.
+    for (void* ptr : allocations)
+        allocator.deallocate(ptr, 0);
+
+    const Memory::TagStats finalStats = Memory::GetTagStats(Memory::Tag::kAssets);
+    EXPECT_EQ(finalStats.m_liveByteSize, initialStats.m_liveByteSize);
+    EXPECT_GE(finalStats.m_peakByteSize, stats.m_liveByteSize);
+    EXPECT_STREQ(Memory::GetTagName(Memory::Tag::kAssets), "Assets");
+
+    Memory::SetBudget(Memory::Tag::kAssets, {});
+}
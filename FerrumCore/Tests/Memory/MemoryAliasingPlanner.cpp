@@ -0,0 +1,171 @@
+﻿#include <FeCore/Memory/MemoryAliasingPlanner.h>
+#include <festd/vector.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace FE;
+
+namespace
+{
+    struct TestResource final
+    {
+        uint64_t m_byteSize = 0;
+        uint64_t m_byteAlignment = 0;
+        uint32_t m_firstUse = 0;
+        uint32_t m_lastUse = 0;
+    };
+
+
+    void ValidatePlan(const Memory::MemoryAliasingPlanner& planner, const festd::vector<TestResource>& resources)
+    {
+        for (uint32_t lhsIndex = 0; lhsIndex < resources.size(); ++lhsIndex)
+        {
+            const TestResource& lhs = resources[lhsIndex];
+            const uint64_t lhsOffset = planner.GetOffset(lhsIndex);
+            EXPECT_EQ(lhsOffset % lhs.m_byteAlignment, 0);
+            EXPECT_LE(lhsOffset + lhs.m_byteSize, planner.GetByteSize());
+
+            for (uint32_t rhsIndex = lhsIndex + 1; rhsIndex < resources.size(); ++rhsIndex)
+            {
+                const TestResource& rhs = resources[rhsIndex];
+                const bool aliveTogether = lhs.m_firstUse <= rhs.m_lastUse && rhs.m_firstUse <= lhs.m_lastUse;
+                if (!aliveTogether)
+                    continue;
+
+                const uint64_t rhsOffset = planner.GetOffset(rhsIndex);
+                const bool memoryOverlaps = lhsOffset < rhsOffset + rhs.m_byteSize && rhsOffset < lhsOffset + lhs.m_byteSize;
+                EXPECT_FALSE(memoryOverlaps) << "Resources " << lhsIndex << " and " << rhsIndex << " overlap";
+            }
+        }
+
+        EXPECT_LE(planner.GetByteSize(), planner.GetUnaliasedByteSize());
+    }
+} // namespace
+
+
+TEST(MemoryAliasingPlanner, Empty)
+{
+    Memory::MemoryAliasingPlanner planner;
+    planner.Plan();
+    EXPECT_EQ(planner.GetResourceCount(), 0);
+    EXPECT_EQ(planner.GetByteSize(), 0);
+    EXPECT_EQ(planner.GetUnaliasedByteSize(), 0);
+}
+
+
+TEST(MemoryAliasingPlanner, DisjointLifetimes)
+{
+    Memory::MemoryAliasingPlanner planner;
+    const uint32_t first = planner.AddResource(1024, 256, 0, 1);
+    const uint32_t second = planner.AddResource(512, 256, 2, 3);
+    const uint32_t third = planner.AddResource(1024, 256, 4, 4);
+    planner.Plan();
+
+    EXPECT_EQ(planner.GetOffset(first), 0);
+    EXPECT_EQ(planner.GetOffset(second), 0);
+    EXPECT_EQ(planner.GetOffset(third), 0);
+    EXPECT_EQ(planner.GetByteSize(), 1024);
+    EXPECT_EQ(planner.GetUnaliasedByteSize(), 2560);
+}
+
+
+TEST(MemoryAliasingPlanner, OverlappingLifetimes)
+{
+    Memory::MemoryAliasingPlanner planner;
+    const uint32_t first = planner.AddResource(1024, 256, 0, 2);
+    const uint32_t second = planner.AddResource(1024, 256, 2, 3);
+    planner.Plan();
+
+    EXPECT_NE(planner.GetOffset(first), planner.GetOffset(second));
+    EXPECT_EQ(planner.GetByteSize(), 2048);
+}
+
+
+TEST(MemoryAliasingPlanner, FillsGaps)
+{
+    // The last resource is alive together with the second and the third ones, which leave a gap between them
+    // in the memory previously used by the first resource.
+    festd::vector<TestResource> resources;
+    resources.push_back({ 2048, 256, 0, 0 });
+    resources.push_back({ 1024, 256, 1, 1 });
+    resources.push_back({ 1024, 256, 0, 1 });
+    resources.push_back({ 512, 256, 1, 1 });
+
+    Memory::MemoryAliasingPlanner planner;
+    for (const TestResource& resource : resources)
+        planner.AddResource(resource.m_byteSize, resource.m_byteAlignment, resource.m_firstUse, resource.m_lastUse);
+
+    planner.Plan();
+    ValidatePlan(planner, resources);
+    EXPECT_EQ(planner.GetOffset(3), 1024);
+    EXPECT_EQ(planner.GetByteSize(), 3072);
+}
+
+
+TEST(MemoryAliasingPlanner, Alignment)
+{
+    festd::vector<TestResource> resources;
+    resources.push_back({ 100, 4, 0, 3 });
+    resources.push_back({ 100, 64, 0, 3 });
+    resources.push_back({ 100, 65536, 0, 3 });
+
+    Memory::MemoryAliasingPlanner planner;
+    for (const TestResource& resource : resources)
+        planner.AddResource(resource.m_byteSize, resource.m_byteAlignment, resource.m_firstUse, resource.m_lastUse);
+
+    planner.Plan();
+    ValidatePlan(planner, resources);
+}
+
+
+TEST(MemoryAliasingPlanner, PassChain)
+{
+    // Every pass reads the output of the previous one, which is the most common pattern in post-processing chains.
+    constexpr uint32_t kPassCount = 32;
+    constexpr uint64_t kTargetSize = 8 * 1024 * 1024;
+
+    festd::vector<TestResource> resources;
+    for (uint32_t passIndex = 0; passIndex < kPassCount; ++passIndex)
+        resources.push_back({ kTargetSize, 65536, passIndex, passIndex + 1 });
+
+    Memory::MemoryAliasingPlanner planner;
+    for (const TestResource& resource : resources)
+        planner.AddResource(resource.m_byteSize, resource.m_byteAlignment, resource.m_firstUse, resource.m_lastUse);
+
+    planner.Plan();
+    ValidatePlan(planner, resources);
+    EXPECT_EQ(planner.GetByteSize(), 2 * kTargetSize);
+    EXPECT_EQ(planner.GetUnaliasedByteSize(), kPassCount * kTargetSize);
+}
+
+
+TEST(MemoryAliasingPlanner, RandomGraphs)
+{
+    std::mt19937 random{ 42 };
+    std::uniform_int_distribution<uint32_t> sizeDistribution{ 1, 4096 };
+    std::uniform_int_distribution<uint32_t> alignmentDistribution{ 0, 16 };
+    std::uniform_int_distribution<uint32_t> lifetimeDistribution{ 0, 8 };
+
+    Memory::MemoryAliasingPlanner planner;
+    for (uint32_t graphIndex = 0; graphIndex < 64; ++graphIndex)
+    {
+        constexpr uint32_t kPassCount = 48;
+
+        festd::vector<TestResource> resources;
+        for (uint32_t resourceIndex = 0; resourceIndex < 96; ++resourceIndex)
+        {
+            TestResource& resource = resources.push_back();
+            resource.m_byteSize = sizeDistribution(random) * UINT64_C(256);
+            resource.m_byteAlignment = UINT64_C(1) << alignmentDistribution(random);
+            resource.m_firstUse = random() % kPassCount;
+            resource.m_lastUse = Math::Min(resource.m_firstUse + lifetimeDistribution(random), kPassCount - 1);
+        }
+
+        planner.Clear();
+        for (const TestResource& resource : resources)
+            planner.AddResource(resource.m_byteSize, resource.m_byteAlignment, resource.m_firstUse, resource.m_lastUse);
+
+        planner.Plan();
+        ValidatePlan(planner, resources);
+    }
+}
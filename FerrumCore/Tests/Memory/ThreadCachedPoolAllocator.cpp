@@ -0,0 +1,212 @@
+﻿#include <FeCore/Base/Platform.h>
+#include <FeCore/Memory/PoolAllocator.h>
+#include <FeCore/Memory/ThreadCachedPoolAllocator.h>
+#include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <FeCore/Time/BaseTime.h>
+#include <festd/vector.h>
+#include <gtest/gtest.h>
+#include <mimalloc.h>
+
+using namespace FE;
+
+namespace
+{
+    constexpr uint32_t kBenchmarkIterationCount = 64;
+    constexpr uint32_t kBenchmarkBatchSize = 256;
+    constexpr size_t kBenchmarkByteSize = 64;
+
+
+    struct BenchmarkContext final
+    {
+        std::pmr::memory_resource* m_allocator = nullptr;
+        void** m_handoff = nullptr;
+        const std::atomic<bool>* m_started = nullptr;
+        uint32_t m_iterationCount = 0;
+    };
+
+
+    void AllocateAndFreeBatches(const uintptr_t userData)
+    {
+        const BenchmarkContext& context = *reinterpret_cast<const BenchmarkContext*>(userData);
+
+        // Don't measure the thread creation.
+        while (!context.m_started->load(std::memory_order_acquire))
+            _mm_pause();
+
+        void* allocations[kBenchmarkBatchSize];
+        for (uint32_t iteration = 0; iteration < context.m_iterationCount; ++iteration)
+        {
+            for (void*& ptr : allocations)
+            {
+                ptr = context.m_allocator->allocate(kBenchmarkByteSize, Memory::kDefaultAlignment);
+                *static_cast<uint32_t*>(ptr) = iteration;
+            }
+
+            for (void* ptr : allocations)
+                context.m_allocator->deallocate(ptr, kBenchmarkByteSize, Memory::kDefaultAlignment);
+        }
+
+        // The last batch is freed by the main thread to exercise the cross-thread frees.
+        for (uint32_t allocationIndex = 0; allocationIndex < kBenchmarkBatchSize; ++allocationIndex)
+            context.m_handoff[allocationIndex] = context.m_allocator->allocate(kBenchmarkByteSize, Memory::kDefaultAlignment);
+    }
+
+
+    double RunBenchmark(std::pmr::memory_resource* allocator, const uint32_t threadCount,
+                        const uint32_t iterationCount = kBenchmarkIterationCount)
+    {
+        festd::vector<void*> handoff;
+        handoff.resize(threadCount * kBenchmarkBatchSize);
+
+        BenchmarkContext contexts[16];
+        Threading::ThreadHandle threads[16];
+        std::atomic<bool> started = false;
+
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            contexts[threadIndex].m_allocator = allocator;
+            contexts[threadIndex].m_handoff = handoff.data() + threadIndex * kBenchmarkBatchSize;
+            contexts[threadIndex].m_started = &started;
+            contexts[threadIndex].m_iterationCount = iterationCount;
+
+            const auto threadName = Fmt::FixedFormat("Allocator {}", threadIndex);
+            const auto userData = reinterpret_cast<uintptr_t>(&contexts[threadIndex]);
+            threads[threadIndex] = Threading::CreateThread(threadName, AllocateAndFreeBatches, userData);
+        }
+
+        const uint64_t startTicks = Platform::GetTicks();
+        started.store(true, std::memory_order_release);
+
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+            Threading::CloseThread(threads[threadIndex]);
+
+        for (void* ptr : handoff)
+            allocator->deallocate(ptr, kBenchmarkByteSize, Memory::kDefaultAlignment);
+
+        const uint64_t endTicks = Platform::GetTicks();
+        return static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+    }
+
+
+    //! @brief Calls mimalloc directly, since Memory::DefaultAllocate goes through the debug heap in development builds.
+    struct MimallocMemoryResource final : public std::pmr::memory_resource
+    {
+    protected:
+        void* do_allocate(const size_t byteSize, const size_t byteAlignment) override
+        {
+            return mi_malloc_aligned(byteSize, byteAlignment);
+        }
+
+        void do_deallocate(void* ptr, size_t, size_t) override
+        {
+            mi_free(ptr);
+        }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace
+
+
+TEST(ThreadCachedPoolAllocator, SizeClasses)
+{
+    using Allocator = Memory::ThreadCachedPoolAllocator;
+    EXPECT_EQ(Allocator::GetSizeClassByteSize(Allocator::kSizeClassCount - 1), Allocator::kMaxByteSize);
+
+    for (size_t byteSize = 0; byteSize <= Allocator::kMaxByteSize; ++byteSize)
+    {
+        const uint32_t sizeClass = Allocator::GetSizeClass(byteSize);
+        ASSERT_LT(sizeClass, Allocator::kSizeClassCount);
+        EXPECT_GE(Allocator::GetSizeClassByteSize(sizeClass), byteSize);
+        EXPECT_EQ(Allocator::GetSizeClassByteSize(sizeClass) % Memory::kDefaultAlignment, 0u);
+        if (sizeClass > 0)
+        {
+            EXPECT_LT(Allocator::GetSizeClassByteSize(sizeClass - 1), byteSize);
+        }
+    }
+}
+
+
+TEST(ThreadCachedPoolAllocator, AllocateAndFree)
+{
+    Memory::ThreadCachedPoolAllocator allocator{ "TestAllocator", Memory::Tag::kUntagged, 1024 * 1024 };
+
+    festd::vector<std::pair<uint8_t*, size_t>> allocations;
+    for (uint32_t allocationIndex = 0; allocationIndex < 4096; ++allocationIndex)
+    {
+        const size_t byteSize = 1 + (allocationIndex * 37) % 4096;
+        auto* ptr = static_cast<uint8_t*>(allocator.allocate(byteSize, Memory::kDefaultAlignment));
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % Memory::kDefaultAlignment, 0u);
+        memset(ptr, static_cast<int32_t>(allocationIndex), byteSize);
+        allocations.push_back({ ptr, byteSize });
+    }
+
+    // The reserved megabyte is not enough for all of these, so some of them come from the default allocator.
+    EXPECT_EQ(allocator.GetPageCount(), 16u);
+
+    for (uint32_t allocationIndex = 0; allocationIndex < allocations.size(); ++allocationIndex)
+    {
+        const auto [ptr, byteSize] = allocations[allocationIndex];
+        EXPECT_EQ(ptr[0], static_cast<uint8_t>(allocationIndex));
+        EXPECT_EQ(ptr[byteSize - 1], static_cast<uint8_t>(allocationIndex));
+
+        // The size is not required, the same way Memory::Delete() doesn't pass it by default.
+        allocator.deallocate(ptr, 0);
+    }
+
+    // Freed blocks are reused.
+    void* ptr = allocator.allocate(16);
+    EXPECT_EQ(allocator.GetPageCount(), 16u);
+    allocator.deallocate(ptr, 16);
+}
+
+
+TEST(ThreadCachedPoolAllocator, ReusesCachesOfExitedThreads)
+{
+    Memory::ThreadCachedPoolAllocator allocator{ "ThreadCachedAllocator", Memory::Tag::kUntagged };
+
+    // The first runs spread the blocks over the caches, after that the threads reuse the blocks of the exited ones.
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterationCount = 2;
+
+    RunBenchmark(&allocator, kThreadCount, kIterationCount);
+    RunBenchmark(&allocator, kThreadCount, kIterationCount);
+    const uint32_t pageCount = allocator.GetPageCount();
+
+    for (uint32_t runIndex = 0; runIndex < 4; ++runIndex)
+        RunBenchmark(&allocator, kThreadCount, kIterationCount);
+
+    EXPECT_EQ(allocator.GetPageCount(), pageCount);
+}
+
+
+//! @brief Throughput comparison with the other allocators, run with --gtest_also_run_disabled_tests.
+//!
+//! The pool allocators report every allocation to Tracy, so build without TRACY_ENABLE to compare them with mimalloc.
+TEST(ThreadCachedPoolAllocator, DISABLED_Benchmark)
+{
+    const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
+    const uint32_t maxThreadCount = Math::Clamp(cpuInfo.m_logicalCores, 2u, 16u);
+
+    Memory::ThreadCachedPoolAllocator threadCachedAllocator{ "ThreadCachedAllocator", Memory::Tag::kUntagged };
+    Memory::SpinLockedPoolAllocator spinLockedAllocator{ "SpinLockedAllocator", kBenchmarkByteSize };
+    MimallocMemoryResource mimallocAllocator;
+
+    for (uint32_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        const double threadCachedSeconds = RunBenchmark(&threadCachedAllocator, threadCount);
+        const double spinLockedSeconds = RunBenchmark(&spinLockedAllocator, threadCount);
+        const double mimallocSeconds = RunBenchmark(&mimallocAllocator, threadCount);
+
+        const double allocationCount = threadCount * (kBenchmarkIterationCount + 1) * kBenchmarkBatchSize;
+        printf("[ ThreadCachedPoolAllocator ] %2u threads: thread-cached %.2f, spin-locked %.2f, mimalloc %.2f M allocations/s\n",
+               threadCount,
+               allocationCount / threadCachedSeconds / 1e6,
+               allocationCount / spinLockedSeconds / 1e6,
+               allocationCount / mimallocSeconds / 1e6);
+    }
+}
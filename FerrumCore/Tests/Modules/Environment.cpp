@@ -1,10 +1,78 @@
-﻿#include <FeCore/Modules/Environment.h>
+﻿#include <FeCore/Base/Platform.h>
+#include <FeCore/Modules/Environment.h>
 #include <FeCore/Strings/Format.h>
+#include <FeCore/Threading/Thread.h>
+#include <FeCore/Time/BaseTime.h>
 #include <Tests/Common/TestCommon.h>
 #include <festd/vector.h>
 
 using namespace FE;
 
+namespace
+{
+    using NameString = festd::basic_fixed_string<32>;
+
+
+    struct NameContentionContext final
+    {
+        const festd::vector<NameString>* m_strings = nullptr;
+        festd::vector<Env::Name> m_names;
+        uint32_t m_threadIndex = 0;
+        uint32_t m_roundCount = 0;
+    };
+
+
+    void InternNames(const uintptr_t userData)
+    {
+        NameContentionContext& context = *reinterpret_cast<NameContentionContext*>(userData);
+        const festd::vector<NameString>& strings = *context.m_strings;
+        const uint32_t stringCount = static_cast<uint32_t>(strings.size());
+
+        context.m_names.resize(stringCount);
+        for (uint32_t round = 0; round < context.m_roundCount; ++round)
+        {
+            // Every thread starts at a different position, so that some of them create the names
+            // while the others look up the names that have already been created.
+            for (uint32_t i = 0; i < stringCount; ++i)
+            {
+                const uint32_t stringIndex = (i + context.m_threadIndex * stringCount / 8) % stringCount;
+                const NameString& str = strings[stringIndex];
+                context.m_names[stringIndex] = Env::Name{ std::string_view{ str.data(), str.size() } };
+            }
+        }
+    }
+
+
+    double RunNameContention(const festd::vector<NameString>& strings, const uint32_t threadCount,
+                             festd::vector<NameContentionContext>& contexts)
+    {
+        constexpr uint32_t kRoundCount = 4;
+
+        contexts.resize(threadCount);
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            contexts[threadIndex].m_strings = &strings;
+            contexts[threadIndex].m_threadIndex = threadIndex;
+            contexts[threadIndex].m_roundCount = kRoundCount;
+        }
+
+        festd::vector<Threading::ThreadHandle> threads;
+        const uint64_t startTicks = Platform::GetTicks();
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            const auto threadName = Fmt::FixedFormat("Name Intern {}", threadIndex);
+            const auto userData = reinterpret_cast<uintptr_t>(&contexts[threadIndex]);
+            threads.push_back(Threading::CreateThread(threadName, InternNames, userData));
+        }
+
+        for (Threading::ThreadHandle& thread : threads)
+            Threading::CloseThread(thread);
+
+        const uint64_t endTicks = Platform::GetTicks();
+        return static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+    }
+} // namespace
+
 TEST(EnvironmentTest, EnvName)
 {
     const Env::Name empty;
@@ -34,3 +102,83 @@ TEST(EnvironmentTest, EnvName)
     EXPECT_EQ(test4.size(), 7);
     EXPECT_EQ(test4, festd::string_view{ "name123" });
 }
+
+
+TEST(EnvironmentTest, EnvNameMany)
+{
+    constexpr uint32_t kNameCount = 64 * 1024;
+
+    festd::vector<Env::Name> names;
+    for (uint32_t nameIndex = 0; nameIndex < kNameCount; ++nameIndex)
+        names.push_back(Fmt::FormatName("EnvNameMany_{}", nameIndex));
+
+    for (uint32_t nameIndex = 0; nameIndex < kNameCount; ++nameIndex)
+    {
+        const auto str = Fmt::FixedFormat("EnvNameMany_{}", nameIndex);
+        const std::string_view view{ str.data(), str.size() };
+        ASSERT_EQ(names[nameIndex], festd::string_view{ view });
+
+        Env::Name existing;
+        ASSERT_TRUE(Env::Name::TryGetExisting(view, existing));
+        ASSERT_EQ(existing, names[nameIndex]);
+    }
+
+    Env::Name missing;
+    EXPECT_FALSE(Env::Name::TryGetExisting("EnvNameMany_missing", missing));
+    EXPECT_FALSE(missing);
+}
+
+
+TEST(EnvironmentTest, EnvNameConcurrentCreation)
+{
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kNameCount = 4 * 1024;
+
+    festd::vector<NameString> strings;
+    strings.reserve(kNameCount);
+    for (uint32_t nameIndex = 0; nameIndex < kNameCount; ++nameIndex)
+        strings.push_back(Fmt::FixedFormatSized<32>("EnvNameConcurrent_{}", nameIndex));
+
+    festd::vector<NameContentionContext> contexts;
+    RunNameContention(strings, kThreadCount, contexts);
+
+    // All the threads must agree on the handles.
+    for (uint32_t nameIndex = 0; nameIndex < kNameCount; ++nameIndex)
+    {
+        const Env::Name name = contexts[0].m_names[nameIndex];
+        const NameString& str = strings[nameIndex];
+        ASSERT_EQ(name, (festd::string_view{ str.data(), str.size() }));
+
+        for (const NameContentionContext& context : contexts)
+            ASSERT_EQ(context.m_names[nameIndex], name);
+    }
+}
+
+
+//! @brief Prints the name creation throughput for different thread counts, run with --gtest_also_run_disabled_tests.
+TEST(EnvironmentTest, DISABLED_EnvNameContention)
+{
+    constexpr uint32_t kNameCount = 16 * 1024;
+
+    const Platform::CpuInfo cpuInfo = Platform::GetCpuInfo();
+    const uint32_t maxThreadCount = Math::Clamp(cpuInfo.m_logicalCores, 2u, 32u);
+
+    festd::vector<uint32_t> threadCounts;
+    for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+        threadCounts.push_back(threadCount);
+    threadCounts.push_back(maxThreadCount);
+
+    for (const uint32_t threadCount : threadCounts)
+    {
+        // Use a new set of strings for every run, so that the names are created concurrently and not only looked up.
+        festd::vector<NameString> strings;
+        strings.reserve(kNameCount);
+        for (uint32_t nameIndex = 0; nameIndex < kNameCount; ++nameIndex)
+            strings.push_back(Fmt::FixedFormatSized<32>("EnvNameContention_{}_{}", threadCount, nameIndex));
+
+        festd::vector<NameContentionContext> contexts;
+        const double seconds = RunNameContention(strings, threadCount, contexts);
+        const double namesPerSecond = static_cast<double>(kNameCount) * contexts[0].m_roundCount * threadCount / seconds;
+        printf("[ Env::Name ] %2u threads: %.3f ms, %.2f M names/s\n", threadCount, seconds * 1000.0, namesPerSecond / 1e6);
+    }
+}
@@ -23,7 +23,11 @@ public:
 TEST(RTTI, TypeName)
 {
     Foo foo;
+#if FE_COMPILER_MSVC || FE_COMPILER_MS_CLANG
     auto expectedName = "class Foo";
+#else
+    auto expectedName = "Foo";
+#endif
     ASSERT_EQ(foo.FeRTTI_GetName(), expectedName);
     ASSERT_EQ(Foo::FeRTTI_GetSName(), expectedName);
 }
@@ -0,0 +1,134 @@
+#include <FeCore/Base/Platform.h>
+#include <FeCore/Compression/Compression.h>
+#include <FeCore/Memory/Memory.h>
+#include <FeCore/Time/BaseTime.h>
+#include <FeCore/Utils/Crc32.h>
+#include <Tests/Common/TestCommon.h>
+#include <festd/vector.h>
+
+using namespace FE;
+
+namespace
+{
+    festd::vector<std::byte> GenerateTestData(const uint32_t byteSize)
+    {
+        // Somewhat compressible data: a repeating pattern with some noise.
+        festd::vector<std::byte> data(byteSize);
+        uint32_t state = 0x12345678;
+        for (uint32_t byteIndex = 0; byteIndex < byteSize; ++byteIndex)
+        {
+            state = state * 1664525 + 1013904223;
+            const uint32_t noise = (state >> 24) < 32 ? state >> 16 : 0;
+            data[byteIndex] = static_cast<std::byte>((byteIndex % 251) ^ noise);
+        }
+
+        return data;
+    }
+
+
+    //! @brief Decompress all pages of a block, optionally combining the per-page CRCs like the async I/O does.
+    bool DecompressBlock(const std::byte* block, std::byte* destination, const bool verify, uint32_t& crc)
+    {
+        Compression::BlockHeader blockHeader;
+        memcpy(&blockHeader, block, sizeof(blockHeader));
+
+        const auto decompressor = Compression::Decompressor::Create(Compression::DecodeMagic(blockHeader.m_magic));
+
+        const std::byte* page = block + sizeof(Compression::BlockHeader);
+        for (;;)
+        {
+            Compression::PageHeader pageHeader;
+            memcpy(&pageHeader, page, sizeof(pageHeader));
+            page += sizeof(Compression::PageHeader);
+
+            // The test data always fills the block, so the tail page is full too.
+            const size_t pageByteSize = blockHeader.m_uncompressedPageSize;
+            const auto result = decompressor.Decompress(page, pageHeader.m_compressedSize, destination, pageByteSize);
+            if (result.m_result != Compression::ResultCode::kSuccess || result.m_decompressedSize != pageByteSize)
+                return false;
+
+            if (verify)
+                crc = Crc32::Combine(crc, Crc32::Compute(destination, pageByteSize), pageByteSize);
+
+            destination += pageByteSize;
+            if (pageHeader.m_nextPageOffset == kInvalidIndex)
+                return true;
+
+            page += pageHeader.m_nextPageOffset;
+        }
+    }
+} // namespace
+
+
+TEST(Crc32, Combine)
+{
+    const festd::vector data = GenerateTestData(64 * 1024 + 13);
+    constexpr uint32_t kSeed = 0xdeadbeef;
+
+    const uint32_t expectedCrc = Crc32::Compute(data.data(), data.size(), kSeed);
+    for (const uint32_t splitOffset : { 0u, 1u, 7u, 4096u, 65536u, data.size() })
+    {
+        const uint32_t headCrc = Crc32::Compute(data.data(), splitOffset, kSeed);
+        const uint32_t tailCrc = Crc32::Compute(data.data() + splitOffset, data.size() - splitOffset);
+        EXPECT_EQ(Crc32::Combine(headCrc, tailCrc, data.size() - splitOffset), expectedCrc);
+    }
+}
+
+
+TEST(Crc32, BlockVerification)
+{
+    const festd::vector data = GenerateTestData(Compression::kBlockSize);
+    const auto compressor = Compression::Compressor::Create(Compression::Method::kGDeflate);
+
+    festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(data.size())));
+    Crc32 compressionCrc;
+    ASSERT_TRUE(compressor.Compress(compressionCrc, data.data(), data.size(), compressed.data(), compressed.size()));
+
+    festd::vector<std::byte> decompressed(Compression::kBlockSize);
+
+    uint32_t crc = 0;
+    ASSERT_TRUE(DecompressBlock(compressed.data(), decompressed.data(), true, crc));
+    EXPECT_EQ(crc, compressionCrc.m_current);
+    EXPECT_EQ(memcmp(decompressed.data(), data.data(), data.size()), 0);
+
+    // Flip a bit in the middle of the original data, the CRC must not match anymore.
+    festd::vector corrupted = data;
+    corrupted[corrupted.size() / 2] ^= std::byte{ 0x10 };
+    EXPECT_NE(Crc32::Compute(corrupted.data(), corrupted.size()), compressionCrc.m_current);
+}
+
+
+//! @brief Prints the cost of verifying the block CRC while decompressing, run with --gtest_also_run_disabled_tests.
+TEST(Crc32, DISABLED_VerificationOverhead)
+{
+    constexpr uint32_t kIterationCount = 32;
+
+    const festd::vector data = GenerateTestData(Compression::kBlockSize);
+    const auto compressor = Compression::Compressor::Create(Compression::Method::kGDeflate);
+
+    festd::vector<std::byte> compressed(static_cast<uint32_t>(compressor.GetBounds(data.size())));
+    Crc32 compressionCrc;
+    ASSERT_TRUE(compressor.Compress(compressionCrc, data.data(), data.size(), compressed.data(), compressed.size()));
+
+    festd::vector<std::byte> decompressed(Compression::kBlockSize);
+
+    // Interleave the runs with and without verification, so that both are affected by the noise equally.
+    double seconds[2] = {};
+    for (uint32_t iterationIndex = 0; iterationIndex < kIterationCount; ++iterationIndex)
+    {
+        for (const bool verify : { false, true })
+        {
+            uint32_t crc = 0;
+            const uint64_t startTicks = Platform::GetTicks();
+            EXPECT_TRUE(DecompressBlock(compressed.data(), decompressed.data(), verify, crc));
+            const uint64_t endTicks = Platform::GetTicks();
+            seconds[verify] += static_cast<double>(endTicks - startTicks) * Platform::GetSecondsPerTick();
+        }
+    }
+
+    const double blockMegabytes = kIterationCount * static_cast<double>(Compression::kBlockSize) / (1024.0 * 1024.0);
+    printf("[ Crc32 ] GDeflate decompression: %.1f MB/s, with verification: %.1f MB/s (%.1f%% overhead)\n",
+           blockMegabytes / seconds[0],
+           blockMegabytes / seconds[1],
+           (seconds[1] / seconds[0] - 1.0) * 100.0);
+}
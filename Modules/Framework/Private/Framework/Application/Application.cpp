@@ -130,6 +130,7 @@ namespace FE::Framework
 
         DI::IServiceProvider* serviceProvider = Env::GetServiceProvider();
         m_jobSystem = serviceProvider->ResolveRequired<IJobSystem>();
+        m_frameAllocator = serviceProvider->ResolveRequired<Memory::FrameAllocator>();
     }
 
 
@@ -179,6 +180,10 @@ namespace FE::Framework
             FrameMark;
 
             FE_PROFILER_ZONE_NAMED("Frame");
+
+            // The previous frame has been waited for, so its allocations can be recycled.
+            m_application->m_frameAllocator->BeginFrame();
+
             app->PollEvents();
             if (app->IsCloseRequested())
                 break;
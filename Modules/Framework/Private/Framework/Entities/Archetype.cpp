@@ -93,19 +93,28 @@ namespace FE::Framework
 
             m_entityByteSize += desc.m_byteSize;
             m_componentTypeIDs.push_back(info->m_typeID);
+            m_signature.Add(info->m_typeID);
         }
     }
 
 
     Archetype::~Archetype()
     {
+        auto* allocator = Env::GetStaticAllocator(Memory::StaticAllocatorType::kDefault);
         for (const ArchetypeChunk* chunk : m_chunks)
+        {
+            allocator->deallocate(chunk->m_data, chunk->m_byteSize);
+            Memory::TrackFree(Memory::Tag::kECS, chunk->m_byteSize);
             GArchetypeChunkPool.Delete(chunk);
+        }
     }
 
 
     bool Archetype::MatchesAll(const festd::span<const ComponentTypeID> includedComponentTypes) const
     {
+        if (!m_signature.MayContainAll(ComponentSignature::Create(includedComponentTypes)))
+            return false;
+
         for (const ComponentTypeID typeID : includedComponentTypes)
         {
             const auto it = festd::find(m_componentTypeIDs, typeID);
@@ -117,8 +126,11 @@ namespace FE::Framework
     }
 
 
-    bool Archetype::MatchesAny(festd::span<const ComponentTypeID> includedComponentTypes) const
+    bool Archetype::MatchesAny(const festd::span<const ComponentTypeID> includedComponentTypes) const
     {
+        if (!m_signature.MayContainAny(ComponentSignature::Create(includedComponentTypes)))
+            return false;
+
         for (const ComponentTypeID typeID : includedComponentTypes)
         {
             const auto it = festd::find(m_componentTypeIDs, typeID);
@@ -144,6 +156,7 @@ namespace FE::Framework
 
         auto* allocator = Env::GetStaticAllocator(Memory::StaticAllocatorType::kDefault);
         m_data = static_cast<std::byte*>(allocator->allocate(byteSize));
+        Memory::TrackAllocation(Memory::Tag::kECS, byteSize);
 
         const uint32_t bytesPerEntity = archetype->m_entityByteSize + sizeof(uint16_t);
         const uint32_t bitsPerEntity = bytesPerEntity * 8 + 1;
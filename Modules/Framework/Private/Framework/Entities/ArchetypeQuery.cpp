@@ -0,0 +1,120 @@
+#include <Framework/Entities/Archetype.h>
+#include <Framework/Entities/ArchetypeQuery.h>
+
+namespace FE::Framework
+{
+    namespace
+    {
+        template<class TVector>
+        void CopySorted(TVector& destination, const festd::span<const ComponentTypeID> componentTypes)
+        {
+            destination.assign(componentTypes.begin(), componentTypes.end());
+            festd::sort(destination, [](const ComponentTypeID lhs, const ComponentTypeID rhs) {
+                return lhs.m_value < rhs.m_value;
+            });
+        }
+
+
+        template<class TVector>
+        bool IsSameSet(const TVector& sortedComponentTypes, const festd::span<const ComponentTypeID> componentTypes)
+        {
+            if (sortedComponentTypes.size() != componentTypes.size())
+                return false;
+
+            TVector sorted;
+            CopySorted(sorted, componentTypes);
+            for (uint32_t typeIndex = 0; typeIndex < sorted.size(); ++typeIndex)
+            {
+                if (sorted[typeIndex] != sortedComponentTypes[typeIndex])
+                    return false;
+            }
+
+            return true;
+        }
+
+
+        template<class TVector>
+        void UpdateHash(Hasher& hasher, const TVector& componentTypes)
+        {
+            hasher.UpdateRaw(componentTypes.size());
+            for (const ComponentTypeID typeID : componentTypes)
+                hasher.UpdateRaw(typeID.m_value);
+        }
+    } // namespace
+
+
+    ArchetypeQuery::ArchetypeQuery(const festd::span<const ComponentTypeID> includedComponentTypes,
+                                   const festd::span<const ComponentTypeID> excludedComponentTypes)
+        : m_includedSignature(ComponentSignature::Create(includedComponentTypes))
+        , m_excludedSignature(ComponentSignature::Create(excludedComponentTypes))
+    {
+        CopySorted(m_includedComponentTypes, includedComponentTypes);
+        CopySorted(m_excludedComponentTypes, excludedComponentTypes);
+    }
+
+
+    uint64_t ArchetypeQuery::ComputeHash(const festd::span<const ComponentTypeID> includedComponentTypes,
+                                         const festd::span<const ComponentTypeID> excludedComponentTypes)
+    {
+        festd::inline_vector<ComponentTypeID, 8> included;
+        festd::inline_vector<ComponentTypeID, 4> excluded;
+        CopySorted(included, includedComponentTypes);
+        CopySorted(excluded, excludedComponentTypes);
+
+        Hasher hasher;
+        UpdateHash(hasher, included);
+        UpdateHash(hasher, excluded);
+        return hasher.Finalize();
+    }
+
+
+    bool ArchetypeQuery::Equals(const festd::span<const ComponentTypeID> includedComponentTypes,
+                                const festd::span<const ComponentTypeID> excludedComponentTypes) const
+    {
+        return IsSameSet(m_includedComponentTypes, includedComponentTypes)
+            && IsSameSet(m_excludedComponentTypes, excludedComponentTypes);
+    }
+
+
+    bool ArchetypeQuery::Matches(const Archetype* archetype) const
+    {
+        if (!archetype->m_signature.MayContainAll(m_includedSignature))
+            return false;
+
+        for (const ComponentTypeID typeID : m_includedComponentTypes)
+        {
+            if (festd::find(archetype->m_componentTypeIDs, typeID) == archetype->m_componentTypeIDs.end())
+                return false;
+        }
+
+        if (!archetype->m_signature.MayContainAny(m_excludedSignature))
+            return true;
+
+        for (const ComponentTypeID typeID : m_excludedComponentTypes)
+        {
+            if (festd::find(archetype->m_componentTypeIDs, typeID) != archetype->m_componentTypeIDs.end())
+                return false;
+        }
+
+        return true;
+    }
+
+
+    bool ArchetypeQuery::RegisterArchetype(const Archetype* archetype)
+    {
+        if (!Matches(archetype))
+            return false;
+
+        FE_AssertDebug(festd::find(m_archetypes, archetype) == m_archetypes.end());
+        m_archetypes.push_back(archetype);
+        return true;
+    }
+
+
+    void ArchetypeQuery::UnregisterArchetype(const Archetype* archetype)
+    {
+        const auto it = festd::find(m_archetypes, archetype);
+        if (it != m_archetypes.end())
+            m_archetypes.erase_unsorted(it);
+    }
+} // namespace FE::Framework
@@ -1,4 +1,4 @@
-#include <FeCore/Jobs/Job.h>
+#include <FeCore/Jobs/ParallelFor.h>
 #include <FeCore/Memory/FiberTempAllocator.h>
 #include <Framework/Entities/Archetype.h>
 #include <Framework/Entities/Entity.h>
@@ -7,33 +7,6 @@
 
 namespace FE::Framework
 {
-    namespace
-    {
-        struct DeferredActionJob final : public Job
-        {
-            void Execute() override
-            {
-                for (Entity* entity : m_entities)
-                    entity->ExecuteDeferredActions();
-            }
-
-            festd::span<Entity*> m_entities;
-        };
-
-
-        struct LocalSystemUpdateJob final : public Job
-        {
-            void Execute() override
-            {
-                for (Entity* entity : m_entities)
-                    entity->UpdateLocalSystems(*m_context);
-            }
-
-            festd::span<Entity*> m_entities;
-            const EntityUpdateContext* m_context;
-        };
-    } // namespace
-
     void EntityRegistry::RequestLoad()
     {
         FE_Verify(m_state.exchange(State::kLoading) == State::kUnloaded);
@@ -172,45 +145,18 @@ namespace FE::Framework
 
     void EntityRegistry::Update(const EntityUpdateContext& context)
     {
-        Memory::FiberTempAllocator temp;
-        SegmentedVector<DeferredActionJob> deferredActionJobs{ &temp };
-        SegmentedVector<LocalSystemUpdateJob> localSystemUpdateJobs{ &temp };
+        const uint32_t entityCount = m_entitiesUnsorted.size();
 
-        const uint32_t entitySegmentCount = m_entitiesUnsorted.segment_count();
-        Entity*** entitySegments = m_entitiesUnsorted.segments();
-        for (uint32_t segmentIndex = 0; segmentIndex < entitySegmentCount; ++segmentIndex)
-        {
-            constexpr uint32_t kEntitiesPerSegment = SegmentedVector<Entity*>::kElementsPerSegment;
-            constexpr uint32_t kMaxEntitiesPerJob = 32;
-
-            const uint32_t entityCount =
-                Math::Min(kEntitiesPerSegment, m_entitiesUnsorted.size() - segmentIndex * kEntitiesPerSegment);
-
-            Entity** segment = entitySegments[segmentIndex];
-            for (uint32_t startIndex = 0; startIndex < entityCount; startIndex += kMaxEntitiesPerJob)
-            {
-                const uint32_t endIndex = Math::Min(startIndex + kMaxEntitiesPerJob, entityCount);
-                const festd::span entities{ segment + startIndex, endIndex - startIndex };
-
-                auto& deferredActionJob = deferredActionJobs.push_back();
-                deferredActionJob.m_entities = entities;
-
-                auto& localSystemUpdateJob = localSystemUpdateJobs.push_back();
-                localSystemUpdateJob.m_entities = entities;
-                localSystemUpdateJob.m_context = &context;
-            }
-        }
+        const auto executeDeferredActions = [this](const uint32_t entityIndex) {
+            m_entitiesUnsorted[entityIndex]->ExecuteDeferredActions();
+        };
 
-        Rc waitGroup = WaitGroup::Create(deferredActionJobs.size());
-        for (DeferredActionJob& job : deferredActionJobs)
-            job.ScheduleForeground(context.m_jobSystem, waitGroup.Get());
-        waitGroup->Wait();
+        const auto updateLocalSystems = [this, &context](const uint32_t entityIndex) {
+            m_entitiesUnsorted[entityIndex]->UpdateLocalSystems(context);
+        };
 
+        ParallelFor(context.m_jobSystem, entityCount, executeDeferredActions, 0, Job::kForegroundAffinityMask);
         m_deferredActionsAllocator.Clear();
-
-        waitGroup = WaitGroup::Create(localSystemUpdateJobs.size());
-        for (LocalSystemUpdateJob& job : localSystemUpdateJobs)
-            job.ScheduleForeground(context.m_jobSystem, waitGroup.Get());
-        waitGroup->Wait();
+        ParallelFor(context.m_jobSystem, entityCount, updateLocalSystems, 0, Job::kForegroundAffinityMask);
     }
 } // namespace FE::Framework
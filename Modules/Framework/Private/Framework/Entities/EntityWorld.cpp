@@ -1,6 +1,7 @@
 #include <FeCore/Jobs/IJobSystem.h>
 #include <FeCore/Memory/FiberTempAllocator.h>
 #include <FeCore/Memory/PoolAllocator.h>
+#include <Framework/Entities/ArchetypeQuery.h>
 #include <Framework/Entities/EntityRegistry.h>
 #include <Framework/Entities/EntityWorld.h>
 #include <Framework/Entities/EntityWorldSystem.h>
@@ -70,6 +71,36 @@ namespace FE::Framework
     }
 
 
+    const ArchetypeQuery* EntityWorld::GetArchetypeQuery(const festd::span<const ComponentTypeID> includedComponentTypes,
+                                                         const festd::span<const ComponentTypeID> excludedComponentTypes)
+    {
+        std::lock_guard lock{ m_lock };
+
+        // On a hash collision probe the next keys until we find the same query or an empty slot.
+        uint64_t hash = ArchetypeQuery::ComputeHash(includedComponentTypes, excludedComponentTypes);
+        auto [iter, inserted] = m_archetypeQueries.insert({ hash, nullptr });
+        while (!inserted)
+        {
+            if (iter->second->Equals(includedComponentTypes, excludedComponentTypes))
+                return iter->second;
+
+            std::tie(iter, inserted) = m_archetypeQueries.insert({ ++hash, nullptr });
+        }
+
+        auto* query = Memory::DefaultNew<ArchetypeQuery>(includedComponentTypes, excludedComponentTypes);
+        iter->second = query;
+
+        // Only add the archetypes that have already been registered, the rest will be added during the next update.
+        for (const EntityRegistry* registry : m_registries)
+        {
+            for (uint32_t archetypeIndex = 0; archetypeIndex < registry->m_prevArchetypeCount; ++archetypeIndex)
+                query->RegisterArchetype(registry->m_archetypes[archetypeIndex]);
+        }
+
+        return query;
+    }
+
+
     void EntityWorld::AddSystem(EntityWorldSystem* system)
     {
         std::lock_guard lock{ m_lock };
@@ -105,6 +136,15 @@ namespace FE::Framework
             switch (registry->GetState())
             {
             case EntityRegistry::State::kUnloaded:
+                for (uint32_t archetypeIndex = 0; archetypeIndex < registry->m_prevArchetypeCount; ++archetypeIndex)
+                {
+                    const Archetype* archetype = registry->m_archetypes[archetypeIndex];
+                    for (const auto& [hash, query] : m_archetypeQueries)
+                        query->UnregisterArchetype(archetype);
+                    for (EntityWorldSystem* system : m_worldSystems)
+                        system->UnregisterArchetype(archetype);
+                }
+
                 Memory::Delete(&GEntityRegistryPool, registry, sizeof(EntityRegistry));
                 festd::swap(m_registries[registryIndex], m_registries.back());
                 m_registries.pop_back();
@@ -131,15 +171,28 @@ namespace FE::Framework
         SegmentedVector<const Archetype*> newArchetypes{ &temp };
 
         for (EntityRegistry* registry : m_registries)
-        {
             registry->Update(m_updateContext);
-            for (uint32_t archetypeIndex = registry->m_prevArchetypeCount; archetypeIndex < registry->m_archetypes.size();
-                 ++archetypeIndex)
+
+        {
+            // GetArchetypeQuery() reads the archetype counts under the lock, so a new query
+            // registers every archetype exactly once: either there or below.
+            std::lock_guard lock{ m_lock };
+            for (EntityRegistry* registry : m_registries)
             {
-                newArchetypes.push_back(registry->m_archetypes[archetypeIndex]);
+                for (uint32_t archetypeIndex = registry->m_prevArchetypeCount; archetypeIndex < registry->m_archetypes.size();
+                     ++archetypeIndex)
+                {
+                    newArchetypes.push_back(registry->m_archetypes[archetypeIndex]);
+                }
+
+                registry->m_prevArchetypeCount = registry->m_archetypes.size();
             }
 
-            registry->m_prevArchetypeCount = registry->m_archetypes.size();
+            for (const auto& [hash, query] : m_archetypeQueries)
+            {
+                for (const Archetype* archetype : newArchetypes)
+                    query->RegisterArchetype(archetype);
+            }
         }
 
         for (EntityWorldSystem* system : m_worldSystems)
@@ -167,6 +220,10 @@ namespace FE::Framework
         }
         m_worldSystems.clear();
 
+        for (const auto& [hash, query] : m_archetypeQueries)
+            Memory::DefaultDelete(query);
+        m_archetypeQueries.clear();
+
         std::lock_guard lock{ GEntityWorldListLock };
         festd::intrusive_list<EntityWorld>::remove(*this);
         GFreeEntityWorldIDs |= (UINT32_C(1) << m_ID);
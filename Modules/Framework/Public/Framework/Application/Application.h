@@ -1,6 +1,7 @@
 #pragma once
 #include <FeCore/DI/BaseDI.h>
 #include <FeCore/Jobs/Job.h>
+#include <FeCore/Memory/FrameAllocator.h>
 #include <Framework/Application/Core/PlatformApplication.h>
 #include <Framework/Application/Core/PlatformWindow.h>
 #include <festd/unordered_map.h>
@@ -54,6 +55,12 @@ namespace FE::Framework
 
         struct FrameJob final : public Job
         {
+            // The frame job runs the whole frame, including the calls into the graphics driver.
+            FrameJob()
+                : Job(JobStackSize::kLarge)
+            {
+            }
+
             void Execute() override;
 
             Application* m_application = nullptr;
@@ -69,6 +76,7 @@ namespace FE::Framework
         Rc<Core::PlatformApplication> m_platformApplication;
         Rc<Core::PlatformWindow> m_mainWindow;
         Rc<IJobSystem> m_jobSystem;
+        Rc<Memory::FrameAllocator> m_frameAllocator;
         Rc<WaitGroup> m_exitWaitGroup;
         FrameJob m_frameJob;
         int32_t m_exitCode = 0;
@@ -29,6 +29,7 @@ namespace FE::Framework
         festd::vector<const EntityComponentInfo*> m_componentTypes;
         festd::vector<ComponentTypeID> m_componentTypeIDs;
         festd::vector<ArchetypeComponentDesc> m_components;
+        ComponentSignature m_signature;
 
         uint32_t m_entityByteSize = 0;
 
@@ -0,0 +1,70 @@
+#pragma once
+#include <Framework/Entities/Base.h>
+#include <festd/vector.h>
+
+namespace FE::Framework
+{
+    //! @brief A cached list of archetypes that contain a set of component types.
+    //!
+    //! The component sets are converted to bit signatures once when the query is created, so that matching a new archetype
+    //! against the query is usually a few bitwise operations. The list of matching archetypes is updated incrementally
+    //! when archetypes are registered, so iterating over it doesn't require any matching at all.
+    struct ArchetypeQuery final
+    {
+        ArchetypeQuery() = default;
+
+        //! @brief Create a query.
+        //!
+        //! @param includedComponentTypes The component types that a matching archetype must contain.
+        //! @param excludedComponentTypes The component types that a matching archetype must not contain.
+        ArchetypeQuery(festd::span<const ComponentTypeID> includedComponentTypes,
+                       festd::span<const ComponentTypeID> excludedComponentTypes = {});
+
+        template<class... TComponents>
+        static ArchetypeQuery Create()
+        {
+            constexpr ComponentTypeID includedComponentTypes[] = { ComponentTypeID::Create<TComponents>()... };
+            return ArchetypeQuery{ includedComponentTypes };
+        }
+
+        //! @brief Compute a hash that identifies the query regardless of the order of the component types.
+        static uint64_t ComputeHash(festd::span<const ComponentTypeID> includedComponentTypes,
+                                    festd::span<const ComponentTypeID> excludedComponentTypes);
+
+        //! @brief Check if the query was created from the same component sets regardless of the order of the component types.
+        [[nodiscard]] bool Equals(festd::span<const ComponentTypeID> includedComponentTypes,
+                                  festd::span<const ComponentTypeID> excludedComponentTypes) const;
+
+        [[nodiscard]] bool Matches(const Archetype* archetype) const;
+
+        //! @brief Add the archetype to the list if it matches the query.
+        //!
+        //! @return True if the archetype matches the query.
+        bool RegisterArchetype(const Archetype* archetype);
+
+        //! @brief Remove the archetype from the list if it was previously registered.
+        void UnregisterArchetype(const Archetype* archetype);
+
+        [[nodiscard]] festd::span<const Archetype* const> GetArchetypes() const
+        {
+            return m_archetypes;
+        }
+
+        [[nodiscard]] auto begin() const
+        {
+            return m_archetypes.begin();
+        }
+
+        [[nodiscard]] auto end() const
+        {
+            return m_archetypes.end();
+        }
+
+    private:
+        ComponentSignature m_includedSignature;
+        ComponentSignature m_excludedSignature;
+        festd::inline_vector<ComponentTypeID, 8> m_includedComponentTypes;
+        festd::inline_vector<ComponentTypeID, 4> m_excludedComponentTypes;
+        festd::vector<const Archetype*> m_archetypes;
+    };
+} // namespace FE::Framework
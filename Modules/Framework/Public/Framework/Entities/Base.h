@@ -1,6 +1,7 @@
 #pragma once
 #include <FeCore/Base/BaseTypes.h>
 #include <FeCore/Base/Hash.h>
+#include <festd/span.h>
 
 namespace FE::Framework
 {
@@ -16,6 +17,7 @@ namespace FE::Framework
 
     struct Archetype;
     struct ArchetypeChunk;
+    struct ArchetypeQuery;
 
 
     struct ComponentTypeID final : public TypedHandle<ComponentTypeID, uint64_t>
@@ -34,6 +36,55 @@ namespace FE::Framework
     };
 
 
+    //! @brief A fixed-size bit signature of a set of component types.
+    //!
+    //! Every component type is hashed into a single bit, so different types can share a bit. A signature can prove that
+    //! a component set does not contain a type, but a positive result must be confirmed by comparing the type IDs.
+    struct ComponentSignature final
+    {
+        static constexpr uint32_t kWordCount = 4;
+        static constexpr uint32_t kBitCount = kWordCount * 64;
+
+        uint64_t m_words[kWordCount] = {};
+
+        constexpr void Add(const ComponentTypeID typeID)
+        {
+            const uint64_t hash = typeID.m_value ^ (typeID.m_value >> 32);
+            const uint32_t bitIndex = static_cast<uint32_t>(hash % kBitCount);
+            m_words[bitIndex / 64] |= UINT64_C(1) << (bitIndex % 64);
+        }
+
+        //! @brief Check if all the bits of the other signature are set in this one.
+        [[nodiscard]] constexpr bool MayContainAll(const ComponentSignature& other) const
+        {
+            uint64_t missingBits = 0;
+            for (uint32_t wordIndex = 0; wordIndex < kWordCount; ++wordIndex)
+                missingBits |= other.m_words[wordIndex] & ~m_words[wordIndex];
+
+            return missingBits == 0;
+        }
+
+        //! @brief Check if any of the bits of the other signature are set in this one.
+        [[nodiscard]] constexpr bool MayContainAny(const ComponentSignature& other) const
+        {
+            uint64_t commonBits = 0;
+            for (uint32_t wordIndex = 0; wordIndex < kWordCount; ++wordIndex)
+                commonBits |= other.m_words[wordIndex] & m_words[wordIndex];
+
+            return commonBits != 0;
+        }
+
+        [[nodiscard]] static constexpr ComponentSignature Create(const festd::span<const ComponentTypeID> componentTypes)
+        {
+            ComponentSignature signature;
+            for (const ComponentTypeID typeID : componentTypes)
+                signature.Add(typeID);
+
+            return signature;
+        }
+    };
+
+
     inline constexpr uint32_t kMaxComponentsPerEntity = 512;
 
     inline constexpr uint32_t kEntityWorldIDBits = 4;
@@ -3,6 +3,7 @@
 #include <Framework/Entities/EntityUpdateContext.h>
 #include <festd/bit_vector.h>
 #include <festd/intrusive_list.h>
+#include <festd/unordered_map.h>
 #include <festd/vector.h>
 
 namespace FE::Framework
@@ -60,6 +61,23 @@ namespace FE::Framework
             return m_registries[0];
         }
 
+        //! @brief Get a query that lists the archetypes of all registries in this world that match a component set.
+        //!
+        //! Queries are cached: calls with the same component sets return the same object. The returned query is owned
+        //! by the world and is updated with the new archetypes every frame before the world systems are updated.
+        //!
+        //! @param includedComponentTypes The component types that a matching archetype must contain.
+        //! @param excludedComponentTypes The component types that a matching archetype must not contain.
+        [[nodiscard]] const ArchetypeQuery* GetArchetypeQuery(festd::span<const ComponentTypeID> includedComponentTypes,
+                                                              festd::span<const ComponentTypeID> excludedComponentTypes = {});
+
+        template<class... TComponents>
+        [[nodiscard]] const ArchetypeQuery* GetArchetypeQuery()
+        {
+            constexpr ComponentTypeID includedComponentTypes[] = { ComponentTypeID::Create<TComponents>()... };
+            return GetArchetypeQuery(includedComponentTypes);
+        }
+
         void AddSystem(EntityWorldSystem* system);
         void RemoveSystem(EntityWorldSystem* system);
 
@@ -73,6 +91,7 @@ namespace FE::Framework
 
         Threading::SpinLock m_lock;
         festd::vector<EntityWorldSystem*> m_worldSystems;
+        festd::unordered_dense_map<uint64_t, ArchetypeQuery*> m_archetypeQueries;
 
         festd::inline_vector<EntityRegistry*> m_registries;
         festd::inline_vector<uint32_t> m_registryIDs;
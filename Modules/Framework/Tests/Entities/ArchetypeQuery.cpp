@@ -0,0 +1,200 @@
+#include <FeCore/Base/Platform.h>
+#include <FeCore/Time/BaseTime.h>
+#include <Framework/Entities/Archetype.h>
+#include <Framework/Entities/ArchetypeQuery.h>
+#include <Framework/Entities/EntityComponentRegistry.h>
+#include <festd/vector.h>
+#include <gtest/gtest.h>
+
+using namespace FE;
+using namespace FE::Framework;
+
+namespace
+{
+    constexpr uint32_t kComponentTypeCount = 12;
+
+
+    template<uint32_t TIndex>
+    struct TestComponent final
+    {
+        uint32_t m_values[TIndex + 1];
+    };
+
+
+    template<uint32_t... TIndices>
+    void RegisterComponents(ComponentTypeID* componentTypes, std::integer_sequence<uint32_t, TIndices...>)
+    {
+        EntityComponentRegistry& registry = EntityComponentRegistry::Get();
+        ((componentTypes[TIndices] = registry.RegisterComponent<TestComponent<TIndices>>()), ...);
+    }
+
+
+    struct ArchetypeSet final
+    {
+        ComponentTypeID m_componentTypes[kComponentTypeCount];
+        festd::vector<Archetype*> m_archetypes;
+
+        ArchetypeSet()
+        {
+            RegisterComponents(m_componentTypes, std::make_integer_sequence<uint32_t, kComponentTypeCount>{});
+        }
+
+        ~ArchetypeSet()
+        {
+            for (const Archetype* archetype : m_archetypes)
+                Archetype::Destroy(archetype);
+        }
+
+        //! @brief Create an archetype with the component types selected by the bits of the mask.
+        Archetype* Create(const uint32_t componentMask)
+        {
+            festd::inline_vector<ComponentTypeID, kComponentTypeCount> componentTypes;
+            for (uint32_t typeIndex = 0; typeIndex < kComponentTypeCount; ++typeIndex)
+            {
+                if (componentMask & (1u << typeIndex))
+                    componentTypes.push_back(m_componentTypes[typeIndex]);
+            }
+
+            Archetype* archetype = Archetype::Create(nullptr, componentTypes);
+            m_archetypes.push_back(archetype);
+            return archetype;
+        }
+    };
+} // namespace
+
+
+TEST(ArchetypeQuery, Matches)
+{
+    ArchetypeSet set;
+    const ComponentTypeID* types = set.m_componentTypes;
+
+    const Archetype* archetype01 = set.Create(0b0011);
+    const Archetype* archetype012 = set.Create(0b0111);
+    const Archetype* archetype13 = set.Create(0b1010);
+    const Archetype* archetype2 = set.Create(0b0100);
+
+    const ComponentTypeID included[] = { types[1] };
+    const ComponentTypeID excluded[] = { types[2] };
+    ArchetypeQuery query{ included, excluded };
+
+    EXPECT_TRUE(query.Matches(archetype01));
+    EXPECT_FALSE(query.Matches(archetype012));
+    EXPECT_TRUE(query.Matches(archetype13));
+    EXPECT_FALSE(query.Matches(archetype2));
+
+    for (const Archetype* archetype : set.m_archetypes)
+        EXPECT_EQ(query.RegisterArchetype(archetype), query.Matches(archetype));
+
+    ASSERT_EQ(query.GetArchetypes().size(), 2u);
+    EXPECT_EQ(query.GetArchetypes()[0], archetype01);
+    EXPECT_EQ(query.GetArchetypes()[1], archetype13);
+
+    query.UnregisterArchetype(archetype01);
+    query.UnregisterArchetype(archetype2);
+    ASSERT_EQ(query.GetArchetypes().size(), 1u);
+    EXPECT_EQ(query.GetArchetypes()[0], archetype13);
+
+    // A query without included types matches everything that doesn't have the excluded ones.
+    ArchetypeQuery excludeOnlyQuery{ {}, excluded };
+    EXPECT_TRUE(excludeOnlyQuery.Matches(archetype01));
+    EXPECT_FALSE(excludeOnlyQuery.Matches(archetype2));
+}
+
+
+TEST(ArchetypeQuery, Equals)
+{
+    ArchetypeSet set;
+    const ComponentTypeID* types = set.m_componentTypes;
+
+    const ComponentTypeID included[] = { types[0], types[3], types[5] };
+    const ComponentTypeID includedShuffled[] = { types[5], types[0], types[3] };
+    const ComponentTypeID includedOther[] = { types[0], types[3], types[6] };
+    const ComponentTypeID excluded[] = { types[7] };
+
+    const ArchetypeQuery query{ included, excluded };
+    EXPECT_TRUE(query.Equals(includedShuffled, excluded));
+    EXPECT_FALSE(query.Equals(includedOther, excluded));
+    EXPECT_FALSE(query.Equals(included, {}));
+    EXPECT_FALSE(query.Equals(excluded, included));
+
+    EXPECT_EQ(ArchetypeQuery::ComputeHash(included, excluded), ArchetypeQuery::ComputeHash(includedShuffled, excluded));
+    EXPECT_NE(ArchetypeQuery::ComputeHash(included, excluded), ArchetypeQuery::ComputeHash(excluded, included));
+}
+
+
+TEST(ArchetypeQuery, RegisterMany)
+{
+    // Every subset of the component types, i.e. 4096 archetypes.
+    ArchetypeSet set;
+    for (uint32_t componentMask = 1; componentMask < (1u << kComponentTypeCount); ++componentMask)
+        set.Create(componentMask);
+
+    const ComponentTypeID included[] = { set.m_componentTypes[2], set.m_componentTypes[5], set.m_componentTypes[9] };
+    const ComponentTypeID excluded[] = { set.m_componentTypes[0] };
+
+    ArchetypeQuery query{ included, excluded };
+    for (const Archetype* archetype : set.m_archetypes)
+        query.RegisterArchetype(archetype);
+
+    festd::vector<const Archetype*> linearArchetypes;
+    for (const Archetype* archetype : set.m_archetypes)
+    {
+        if (archetype->MatchesAll(included) && !archetype->MatchesAny(excluded))
+            linearArchetypes.push_back(archetype);
+    }
+
+    ASSERT_EQ(query.GetArchetypes().size(), 1u << (kComponentTypeCount - 4));
+    ASSERT_EQ(query.GetArchetypes().size(), linearArchetypes.size());
+    for (uint32_t archetypeIndex = 0; archetypeIndex < linearArchetypes.size(); ++archetypeIndex)
+        EXPECT_EQ(query.GetArchetypes()[archetypeIndex], linearArchetypes[archetypeIndex]);
+}
+
+
+//! @brief Compares the cached query with matching every archetype each frame, run with --gtest_also_run_disabled_tests.
+TEST(ArchetypeQuery, DISABLED_Benchmark)
+{
+    constexpr uint32_t kFrameCount = 64;
+
+    ArchetypeSet set;
+    for (uint32_t componentMask = 1; componentMask < (1u << kComponentTypeCount); ++componentMask)
+        set.Create(componentMask);
+
+    const ComponentTypeID included[] = { set.m_componentTypes[2], set.m_componentTypes[5], set.m_componentTypes[9] };
+    const ComponentTypeID excluded[] = { set.m_componentTypes[0] };
+
+    ArchetypeQuery query{ included, excluded };
+    for (const Archetype* archetype : set.m_archetypes)
+        query.RegisterArchetype(archetype);
+
+    uint64_t linearCount = 0;
+    uint64_t cachedCount = 0;
+
+    // Resolve the archetypes every frame like a system without a cached query would do.
+    const uint64_t linearStartTicks = Platform::GetTicks();
+    for (uint32_t frameIndex = 0; frameIndex < kFrameCount; ++frameIndex)
+    {
+        for (const Archetype* archetype : set.m_archetypes)
+        {
+            if (archetype->MatchesAll(included) && !archetype->MatchesAny(excluded))
+                linearCount += archetype->m_componentTypes.size();
+        }
+    }
+
+    const uint64_t cachedStartTicks = Platform::GetTicks();
+    for (uint32_t frameIndex = 0; frameIndex < kFrameCount; ++frameIndex)
+    {
+        for (const Archetype* archetype : query)
+            cachedCount += archetype->m_componentTypes.size();
+    }
+
+    const uint64_t endTicks = Platform::GetTicks();
+    EXPECT_EQ(linearCount, cachedCount);
+
+    const double secondsPerTick = Platform::GetSecondsPerTick();
+    const double linearMicroseconds = static_cast<double>(cachedStartTicks - linearStartTicks) * secondsPerTick * 1e6;
+    const double cachedMicroseconds = static_cast<double>(endTicks - cachedStartTicks) * secondsPerTick * 1e6;
+    printf("[ ArchetypeQuery ] %u archetypes, per frame: linear matching %.2f us, cached query %.2f us\n",
+           set.m_archetypes.size(),
+           linearMicroseconds / kFrameCount,
+           cachedMicroseconds / kFrameCount);
+}
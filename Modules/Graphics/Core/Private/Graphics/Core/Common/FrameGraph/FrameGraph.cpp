@@ -68,6 +68,7 @@ namespace FE::Graphics::Common
 
         Memory::FiberTempAllocator temp;
 
+        // A pass is referenced by the resources it writes to, a resource is referenced by the passes that read from it.
         for (PassData& pass : m_passes)
         {
             const ResourceAccess* access = pass.m_accessesListHead;
@@ -85,14 +86,18 @@ namespace FE::Graphics::Common
 
                 access = access->m_next;
             }
+
+            // A pass that doesn't write to anything can only have side effects that the graph doesn't know about.
+            if (pass.m_refCount == 0)
+                pass.m_refCount = 1;
         }
 
         SegmentedVector<const ResourceData*> resourceStack{ &temp };
 
+        // Imported resources are used outside the graph, so they are never culled along with the passes writing to them.
         for (ResourceData& resource : m_resources)
         {
-            resource.m_refCount = 1000; // TODO: hack to prevent culling until it's fixed
-            if (resource.m_refCount == 0)
+            if (resource.m_refCount == 0 && !resource.m_isImported)
                 resourceStack.push_back(&resource);
         }
 
@@ -101,23 +106,50 @@ namespace FE::Graphics::Common
             const ResourceData* resource = resourceStack.back();
             resourceStack.pop_back();
 
-            if (resource->m_isImported)
-                continue;
+            for (PassData& pass : m_passes)
+            {
+                const ResourceAccess* writeAccess = pass.m_accessesListHead;
+                while (writeAccess)
+                {
+                    if (writeAccess->m_isWriteAccess && writeAccess->m_resourceIndex == resource->m_resourceIndex)
+                    {
+                        FE_AssertDebug(pass.m_refCount > 0);
+                        if (--pass.m_refCount == 0)
+                        {
+                            const ResourceAccess* readAccess = pass.m_accessesListHead;
+                            while (readAccess)
+                            {
+                                if (!readAccess->m_isWriteAccess)
+                                {
+                                    auto& readResource = m_resources[readAccess->m_resourceIndex];
+                                    if (--readResource.m_refCount == 0 && !readResource.m_isImported)
+                                        resourceStack.push_back(&readResource);
+                                }
+
+                                readAccess = readAccess->m_next;
+                            }
+                        }
+                    }
+
+                    writeAccess = writeAccess->m_next;
+                }
+            }
+        }
 
-            auto& creatorPass = m_passes[resource->m_creatorPassIndex];
-            --creatorPass.m_refCount;
+        for (uint32_t passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+        {
+            const PassData& pass = m_passes[passIndex];
+            if (pass.m_refCount == 0)
+                continue;
 
-            const ResourceAccess* access = creatorPass.m_accessesListHead;
+            const ResourceAccess* access = pass.m_accessesListHead;
             while (access)
             {
-                if (!access->m_isWriteAccess)
-                {
-                    auto& readResource = m_resources[access->m_resourceIndex];
-                    --readResource.m_refCount;
-                    if (readResource.m_refCount == 0)
-                        resourceStack.push_back(&readResource);
-                }
+                auto& resource = m_resources[access->m_resourceIndex];
+                if (resource.m_firstUsePassIndex == kInvalidIndex)
+                    resource.m_firstUsePassIndex = passIndex;
 
+                resource.m_lastUsePassIndex = passIndex;
                 access = access->m_next;
             }
         }
@@ -142,7 +174,6 @@ namespace FE::Graphics::Common
             depthTargetData.m_creatorPassIndex = kInvalidIndex;
             depthTargetData.m_resource = m_resourcePool->CreateRenderTarget(depthTargetData.m_name, depthTargetDesc);
             depthTargetData.m_isImported = true;
-            depthTargetData.m_refCount = 1;
             m_resources.push_back(depthTargetData);
 
             m_currentDepthStencilHandle = Core::RenderTargetHandle::Create(0, 0, 0);
@@ -169,24 +200,43 @@ namespace FE::Graphics::Common
                 continue;
             }
 
-            if (resource.m_refCount > 0)
+            // A resource that isn't read by anyone is still needed if a pass that wasn't culled writes to it.
+            if (resource.m_firstUsePassIndex == kInvalidIndex)
+                continue;
+
+            switch (resource.m_resourceType)
             {
-                switch (resource.m_resourceType)
-                {
-                default:
-                case Core::ResourceType::kTexture:
-                case Core::ResourceType::kUnknown:
-                    FE_DebugBreak();
-                    [[fallthrough]];
-
-                case Core::ResourceType::kBuffer:
-                    resource.m_resource = m_resourcePool->CreateBuffer(resource.m_name, resource.m_bufferDesc);
-                    break;
-
-                case Core::ResourceType::kRenderTarget:
-                    resource.m_resource = m_resourcePool->CreateRenderTarget(resource.m_name, resource.m_imageDesc);
-                    break;
-                }
+            default:
+            case Core::ResourceType::kTexture:
+            case Core::ResourceType::kUnknown:
+                FE_DebugBreak();
+                [[fallthrough]];
+
+            case Core::ResourceType::kBuffer:
+                resource.m_transientIndex = m_resourcePool->AddTransientBuffer(
+                    resource.m_name, resource.m_bufferDesc, resource.m_firstUsePassIndex, resource.m_lastUsePassIndex);
+                break;
+
+            case Core::ResourceType::kRenderTarget:
+                resource.m_transientIndex = m_resourcePool->AddTransientRenderTarget(
+                    resource.m_name, resource.m_imageDesc, resource.m_firstUsePassIndex, resource.m_lastUsePassIndex);
+                break;
+            }
+        }
+
+        m_resourcePool->AllocateTransientResources();
+
+        m_transientResourceIndices.clear();
+        for (auto& resource : m_resources)
+        {
+            if (resource.m_transientIndex != kInvalidIndex)
+            {
+                // The contents of a transient resource are undefined when it takes over its memory from the previous occupant.
+                resource.m_resource = m_resourcePool->GetTransientResource(resource.m_transientIndex);
+                resource.m_accessState = 0;
+
+                FE_AssertDebug(resource.m_transientIndex == m_transientResourceIndices.size());
+                m_transientResourceIndices.push_back(resource.m_resourceIndex);
             }
         }
 
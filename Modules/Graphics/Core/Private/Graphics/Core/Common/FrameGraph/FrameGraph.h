@@ -73,6 +73,9 @@ namespace FE::Graphics::Common
             uint32_t m_accessState = 0;
             uint32_t m_creatorPassIndex = kInvalidIndex;
             uint32_t m_lastUserPassIndex = kInvalidIndex;
+            uint32_t m_firstUsePassIndex = kInvalidIndex; //!< The first pass that accesses the resource and was not culled.
+            uint32_t m_lastUsePassIndex = kInvalidIndex;  //!< The last pass that accesses the resource and was not culled.
+            uint32_t m_transientIndex = kInvalidIndex;
 
             ResourceData(const uint32_t resourceIndex, const Core::BufferDesc& desc)
                 : m_bufferDesc(desc)
@@ -114,6 +117,7 @@ namespace FE::Graphics::Common
 
         SegmentedVector<PassData> m_passes;
         SegmentedVector<ResourceData> m_resources;
+        festd::vector<uint32_t> m_transientResourceIndices; //!< Maps transient resource indices to indices in m_resources.
         FrameGraphResourcePool* m_resourcePool = nullptr;
 
         Rc<Core::Viewport> m_viewport;
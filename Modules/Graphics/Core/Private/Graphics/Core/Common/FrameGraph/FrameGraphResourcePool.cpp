@@ -12,7 +12,8 @@ namespace FE::Graphics::Common
     {
         FE_PROFILER_ZONE();
 
-        // TODO: Clean up old resources
+        m_transientResourceInfos.clear();
+        m_transientLayoutHash = 0;
     }
 
 
@@ -32,18 +33,202 @@ namespace FE::Graphics::Common
     }
 
 
-    Core::Buffer* FrameGraphResourcePool::CreateBuffer(const Env::Name name, const Core::BufferDesc& desc)
+    uint32_t FrameGraphResourcePool::AddTransientRenderTarget(const Env::Name name, const Core::ImageDesc& desc,
+                                                              const uint32_t firstPassIndex, const uint32_t lastPassIndex)
+    {
+        TransientResourceInfo info;
+        info.m_imageDesc = desc;
+        info.m_name = name;
+        info.m_resourceType = Core::ResourceType::kRenderTarget;
+        info.m_firstPassIndex = firstPassIndex;
+        info.m_lastPassIndex = lastPassIndex;
+        return AddTransientResource(info, desc.GetHash());
+    }
+
+
+    uint32_t FrameGraphResourcePool::AddTransientBuffer(const Env::Name name, const Core::BufferDesc& desc,
+                                                        const uint32_t firstPassIndex, const uint32_t lastPassIndex)
+    {
+        FE_Assert(desc.m_usage == Core::ResourceUsage::kDeviceOnly, "Frame graph buffers must be device-only");
+
+        TransientResourceInfo info;
+        info.m_bufferDesc = desc;
+        info.m_name = name;
+        info.m_resourceType = Core::ResourceType::kBuffer;
+        info.m_firstPassIndex = firstPassIndex;
+        info.m_lastPassIndex = lastPassIndex;
+        return AddTransientResource(info, desc.GetHash());
+    }
+
+
+    void FrameGraphResourcePool::AllocateTransientResources()
     {
         FE_PROFILER_ZONE();
 
-        const uint64_t descHash = desc.GetHash();
+        // The frame graph is usually the same from frame to frame, so we can skip planning and keep the old resources.
+        if (m_transientLayoutHash == m_allocatedTransientLayoutHash
+            && m_transientResources.size() == m_transientResourceInfos.size())
+            return;
+
+        // The old resources are still referenced by the frames in flight. They will be destroyed by the device
+        // once the GPU is done with them and keep their heaps alive until then.
+        m_transientResources.clear();
+
+        for (TransientHeap& heap : m_transientHeaps)
+        {
+            heap.m_planner.Clear();
+            heap.m_alignment = 0;
+        }
+
+        for (TransientResourceInfo& info : m_transientResourceInfos)
+        {
+            const Core::MemoryRequirements& requirements = GetMemoryRequirements(info);
+            info.m_heapIndex = GetTransientHeapIndex(info.m_resourceType, requirements.m_memoryTypeBits);
+            info.m_byteSize = requirements.m_byteSize;
+
+            TransientHeap& heap = m_transientHeaps[info.m_heapIndex];
+            heap.m_alignment = Math::Max(heap.m_alignment, requirements.m_alignment);
+            info.m_plannerIndex = heap.m_planner.AddResource(
+                requirements.m_byteSize, requirements.m_alignment, info.m_firstPassIndex, info.m_lastPassIndex);
+        }
+
+        for (TransientHeap& heap : m_transientHeaps)
+        {
+            heap.m_planner.Plan();
+
+            const uint64_t byteSize = heap.m_planner.GetByteSize();
+            if (byteSize == 0)
+            {
+                heap.m_heap.Reset();
+                continue;
+            }
+
+            if (heap.m_heap)
+            {
+                const Core::MemoryRequirements& heapDesc = heap.m_heap->GetDesc();
+                if (heapDesc.m_byteSize >= byteSize && heapDesc.m_alignment >= heap.m_alignment)
+                    continue;
+            }
+
+            Core::MemoryRequirements heapRequirements;
+            heapRequirements.m_byteSize = byteSize;
+            heapRequirements.m_alignment = heap.m_alignment;
+            heapRequirements.m_memoryTypeBits = heap.m_memoryTypeBits;
+            heap.m_heap = m_resourcePool->CreateMemoryHeap("FrameGraphTransientHeap", heapRequirements);
+        }
+
+        m_transientResources.reserve(m_transientResourceInfos.size());
+        for (const TransientResourceInfo& info : m_transientResourceInfos)
+        {
+            const TransientHeap& heap = m_transientHeaps[info.m_heapIndex];
+            const uint64_t offset = heap.m_planner.GetOffset(info.m_plannerIndex);
+
+            switch (info.m_resourceType)
+            {
+            default:
+            case Core::ResourceType::kTexture:
+            case Core::ResourceType::kUnknown:
+                FE_DebugBreak();
+                [[fallthrough]];
+
+            case Core::ResourceType::kBuffer:
+                m_transientResources.push_back(
+                    m_resourcePool->CreatePlacedBuffer(info.m_name, info.m_bufferDesc, heap.m_heap.Get(), offset));
+                break;
+
+            case Core::ResourceType::kRenderTarget:
+                m_transientResources.push_back(
+                    m_resourcePool->CreatePlacedRenderTarget(info.m_name, info.m_imageDesc, heap.m_heap.Get(), offset));
+                break;
+            }
+        }
+
+        CalculateAliasing();
+        m_allocatedTransientLayoutHash = m_transientLayoutHash;
+    }
 
-        if (const auto iter = m_buffersMap.find(descHash); iter != m_buffersMap.end())
-            return iter->second.Get();
 
-        Core::Buffer* result = m_resourcePool->CreateBuffer(name, desc);
-        m_buffersMap[descHash] = result;
+    uint32_t FrameGraphResourcePool::AddTransientResource(const TransientResourceInfo& info, const uint64_t descHash)
+    {
+        const uint64_t layout[] = {
+            descHash,
+            info.m_name.GetHash(),
+            festd::to_underlying(info.m_resourceType),
+            info.m_firstPassIndex,
+            info.m_lastPassIndex,
+        };
+
+        m_transientLayoutHash = DefaultHashWithSeed(m_transientLayoutHash, layout, sizeof(layout));
+        m_transientResourceInfos.push_back(info);
+        return m_transientResourceInfos.size() - 1;
+    }
 
-        return result;
+
+    const Core::MemoryRequirements& FrameGraphResourcePool::GetMemoryRequirements(const TransientResourceInfo& info)
+    {
+        const bool isBuffer = info.m_resourceType == Core::ResourceType::kBuffer;
+        const uint64_t descHash = isBuffer ? info.m_bufferDesc.GetHash() : info.m_imageDesc.GetHash();
+        const uint64_t key = DefaultHashWithSeed(festd::to_underlying(info.m_resourceType), &descHash, sizeof(descHash));
+
+        if (const auto iter = m_memoryRequirementsCache.find(key); iter != m_memoryRequirementsCache.end())
+            return iter->second;
+
+        const Core::MemoryRequirements requirements = isBuffer
+            ? m_resourcePool->GetBufferMemoryRequirements(info.m_bufferDesc)
+            : m_resourcePool->GetRenderTargetMemoryRequirements(info.m_imageDesc);
+
+        return m_memoryRequirementsCache[key] = requirements;
+    }
+
+
+    uint32_t FrameGraphResourcePool::GetTransientHeapIndex(const Core::ResourceType resourceType, const uint32_t memoryTypeBits)
+    {
+        for (uint32_t heapIndex = 0; heapIndex < m_transientHeaps.size(); ++heapIndex)
+        {
+            const TransientHeap& heap = m_transientHeaps[heapIndex];
+            if (heap.m_resourceType == resourceType && heap.m_memoryTypeBits == memoryTypeBits)
+                return heapIndex;
+        }
+
+        TransientHeap& heap = m_transientHeaps.push_back();
+        heap.m_resourceType = resourceType;
+        heap.m_memoryTypeBits = memoryTypeBits;
+        return m_transientHeaps.size() - 1;
+    }
+
+
+    void FrameGraphResourcePool::CalculateAliasing()
+    {
+        FE_PROFILER_ZONE();
+
+        m_transientAliasingRanges.clear();
+        m_transientAliasedIndices.clear();
+        m_transientAliasingRanges.reserve(m_transientResourceInfos.size());
+
+        // A resource aliases every resource of the same heap that overlaps its memory and is no longer used
+        // by the time the resource is first used. All of them must be done with the memory before the handoff.
+        for (const TransientResourceInfo& info : m_transientResourceInfos)
+        {
+            const TransientHeap& heap = m_transientHeaps[info.m_heapIndex];
+            const uint64_t begin = heap.m_planner.GetOffset(info.m_plannerIndex);
+            const uint64_t end = begin + info.m_byteSize;
+
+            AliasingRange& range = m_transientAliasingRanges.push_back();
+            range.m_begin = m_transientAliasedIndices.size();
+
+            for (uint32_t otherIndex = 0; otherIndex < m_transientResourceInfos.size(); ++otherIndex)
+            {
+                const TransientResourceInfo& other = m_transientResourceInfos[otherIndex];
+                if (other.m_heapIndex != info.m_heapIndex || other.m_lastPassIndex >= info.m_firstPassIndex)
+                    continue;
+
+                const uint64_t otherBegin = heap.m_planner.GetOffset(other.m_plannerIndex);
+                const uint64_t otherEnd = otherBegin + other.m_byteSize;
+                if (otherBegin < end && begin < otherEnd)
+                    m_transientAliasedIndices.push_back(otherIndex);
+            }
+
+            range.m_count = m_transientAliasedIndices.size() - range.m_begin;
+        }
     }
 } // namespace FE::Graphics::Common
@@ -1,12 +1,18 @@
 #pragma once
 #include <FeCore/Containers/SegmentedVector.h>
+#include <FeCore/Memory/MemoryAliasingPlanner.h>
 #include <Graphics/Core/Buffer.h>
 #include <Graphics/Core/RenderTarget.h>
 #include <Graphics/Core/ResourcePool.h>
+#include <festd/span.h>
 #include <festd/unordered_map.h>
 
 namespace FE::Graphics::Common
 {
+    //! @brief Owns the memory of the frame graph resources.
+    //!
+    //! Transient resources are placed into shared memory heaps. Resources whose lifetimes don't overlap
+    //! alias the same memory. The resources and their placement are reused while the frame graph stays the same.
     struct FrameGraphResourcePool final : public Memory::RefCountedObjectBase
     {
         FrameGraphResourcePool(Core::ResourcePool* pool);
@@ -16,13 +22,93 @@ namespace FE::Graphics::Common
 
         void Reset();
 
+        //! @brief Create a render target that doesn't share memory with any other resources and lives across frames.
         Core::RenderTarget* CreateRenderTarget(Env::Name name, const Core::ImageDesc& desc);
-        Core::Buffer* CreateBuffer(Env::Name name, const Core::BufferDesc& desc);
+
+        //! @brief Add a transient render target used by the passes in the range [firstPassIndex, lastPassIndex].
+        //!
+        //! @return The index of the resource to use with GetTransientResource().
+        uint32_t AddTransientRenderTarget(Env::Name name, const Core::ImageDesc& desc, uint32_t firstPassIndex,
+                                          uint32_t lastPassIndex);
+
+        //! @brief Add a transient buffer used by the passes in the range [firstPassIndex, lastPassIndex].
+        //!
+        //! @return The index of the resource to use with GetTransientResource().
+        uint32_t AddTransientBuffer(Env::Name name, const Core::BufferDesc& desc, uint32_t firstPassIndex,
+                                    uint32_t lastPassIndex);
+
+        //! @brief Create all the transient resources added since the last call to Reset().
+        void AllocateTransientResources();
+
+        [[nodiscard]] Core::Resource* GetTransientResource(const uint32_t resourceIndex) const
+        {
+            return m_transientResources[resourceIndex].Get();
+        }
+
+        //! @brief Get the transient resources that occupied the memory of a resource before its first use in the frame.
+        //!
+        //! @return The indices of the resources to use with GetTransientResource().
+        [[nodiscard]] festd::span<const uint32_t> GetAliasedResources(const uint32_t resourceIndex) const
+        {
+            const AliasingRange& range = m_transientAliasingRanges[resourceIndex];
+            return festd::span{ m_transientAliasedIndices.data() + range.m_begin, range.m_count };
+        }
 
     private:
+        struct TransientResourceInfo final
+        {
+            union
+            {
+                Core::BufferDesc m_bufferDesc;
+                Core::ImageDesc m_imageDesc;
+            };
+
+            Env::Name m_name;
+            Core::ResourceType m_resourceType = Core::ResourceType::kUnknown;
+            uint32_t m_firstPassIndex = kInvalidIndex;
+            uint32_t m_lastPassIndex = kInvalidIndex;
+            uint32_t m_heapIndex = kInvalidIndex;
+            uint32_t m_plannerIndex = kInvalidIndex;
+            uint64_t m_byteSize = 0;
+
+            TransientResourceInfo()
+                : m_imageDesc()
+            {
+            }
+        };
+
+        struct AliasingRange final
+        {
+            uint32_t m_begin = 0;
+            uint32_t m_count = 0;
+        };
+
+        //! @brief Resources of the same type that can be placed into the same memory type share a heap.
+        struct TransientHeap final
+        {
+            Core::ResourceType m_resourceType = Core::ResourceType::kUnknown;
+            uint32_t m_memoryTypeBits = 0;
+            uint64_t m_alignment = 0;
+            Memory::MemoryAliasingPlanner m_planner;
+            Rc<Core::MemoryHeap> m_heap;
+        };
+
         festd::unordered_dense_map<uint64_t, Rc<Core::RenderTarget>> m_imagesMap;
-        festd::unordered_dense_map<uint64_t, Rc<Core::Buffer>> m_buffersMap;
+
+        festd::unordered_dense_map<uint64_t, Core::MemoryRequirements> m_memoryRequirementsCache;
+        festd::vector<TransientResourceInfo> m_transientResourceInfos;
+        festd::vector<Rc<Core::Resource>> m_transientResources;
+        festd::vector<AliasingRange> m_transientAliasingRanges;
+        festd::vector<uint32_t> m_transientAliasedIndices;
+        SegmentedVector<TransientHeap> m_transientHeaps;
+        uint64_t m_transientLayoutHash = 0;
+        uint64_t m_allocatedTransientLayoutHash = 0;
 
         Core::ResourcePool* m_resourcePool = nullptr;
+
+        uint32_t AddTransientResource(const TransientResourceInfo& info, uint64_t descHash);
+        const Core::MemoryRequirements& GetMemoryRequirements(const TransientResourceInfo& info);
+        uint32_t GetTransientHeapIndex(Core::ResourceType resourceType, uint32_t memoryTypeBits);
+        void CalculateAliasing();
     };
 } // namespace FE::Graphics::Common
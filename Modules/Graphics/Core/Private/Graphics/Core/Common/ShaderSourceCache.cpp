@@ -49,7 +49,8 @@ namespace FE::Graphics::Core
                     request.m_callback = this;
                     request.m_path = entry.m_path;
                     request.m_userData0 = shaderName.GetHandle();
-                    request.m_overallocateBytes = 1;
+                    request.m_memoryMapped = true;
+                    request.m_zeroCopy = true;
                     m_asyncIO->ReadAsync(request);
                 }
 
@@ -125,7 +126,6 @@ namespace FE::Graphics::Core
         file->m_sourceSize = result.m_request->m_readBufferSize;
         file->m_sourceAllocator = result.m_request->m_allocator;
         file->m_stage = stage;
-        file->m_source[file->m_sourceSize] = '\0';
 
         const auto shaderName = Env::Name::CreateFromHandle(static_cast<uint32_t>(result.m_request->m_userData0));
 
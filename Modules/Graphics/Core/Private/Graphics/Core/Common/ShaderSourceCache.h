@@ -20,7 +20,7 @@ namespace FE::Graphics::Core
         friend ShaderSourceCache;
 
         ShaderSourceCache* m_sourceCache = nullptr;
-        std::pmr::memory_resource* m_sourceAllocator = nullptr;
+        std::pmr::memory_resource* m_sourceAllocator = nullptr; //!< Keeps the source file mapped until it is deallocated.
         char* m_source = nullptr;
         uint32_t m_sourceSize = 0;
         ShaderStage m_stage = ShaderStage::kUndefined;
@@ -63,7 +63,7 @@ namespace FE::Graphics::Core
     inline festd::string_view ShaderSourceFile::GetSource() const
     {
         FE_Assert(!m_sourceCache->IsLoading());
-        return m_source;
+        return festd::string_view{ m_source, m_sourceSize };
     }
 
 
@@ -119,23 +119,7 @@ namespace FE::Graphics::Vulkan
 
             FinalizeFinishedProcessors();
 
-            if (m_requestCache.empty())
-            {
-                auto* item = static_cast<Core::AsyncCopyCommandList*>(m_requestQueue.DequeueAll());
-                while (item)
-                {
-                    m_requestCache.push_back(item);
-                    item = static_cast<Core::AsyncCopyCommandList*>(item->m_next);
-                }
-            }
-
-            Core::AsyncCopyCommandList* item = nullptr;
-            if (!m_requestCache.empty())
-            {
-                item = m_requestCache.back();
-                m_requestCache.pop_back();
-            }
-
+            auto* item = static_cast<Core::AsyncCopyCommandList*>(m_requestQueue.TryDequeue());
             if (item)
             {
                 ProcessingItem* processingItem = m_processingItemPool.New();
@@ -152,7 +136,7 @@ namespace FE::Graphics::Vulkan
 
                 ProcessCommandList(processingItem);
             }
-            else if (m_requestCache.empty() && m_processingItems.empty())
+            else if (m_processingItems.empty())
             {
                 // Block producers to ensure no one adds new requests before we go idle.
                 std::unique_lock lock{ m_suspendLock };
@@ -585,7 +569,6 @@ namespace FE::Graphics::Vulkan
 
         m_suspendEvent.Wait();
         FE_Assert(m_requestQueue.Empty());
-        FE_Assert(m_requestCache.empty());
         VerifyVulkan(vkQueueWaitIdle(m_queue));
     }
 } // namespace FE::Graphics::Vulkan
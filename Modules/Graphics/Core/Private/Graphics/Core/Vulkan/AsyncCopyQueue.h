@@ -64,8 +64,7 @@ namespace FE::Graphics::Vulkan
         festd::inline_ring_buffer<ProcessingItem*, 32> m_processingItems;
         Memory::Pool<ProcessingItem> m_processingItemPool{ "AsyncCopyProcessingItemPool" };
 
-        ConcurrentOnceConsumedQueue m_requestQueue;
-        festd::inline_vector<Core::AsyncCopyCommandList*> m_requestCache;
+        MPSCQueue m_requestQueue;
         Memory::LinearAllocator m_threadTempAllocator;
     };
 } // namespace FE::Graphics::Vulkan
@@ -54,14 +54,8 @@ namespace FE::Graphics::Vulkan
     }
 
 
-    void Buffer::InitInternal(const VmaAllocator allocator, const Env::Name name, const Core::BufferDesc& desc)
+    VkBufferCreateInfo Buffer::MakeCreateInfo(const Core::BufferDesc& desc)
     {
-        FE_PROFILER_ZONE();
-
-        m_name = name;
-        m_desc = desc;
-        m_vmaAllocator = allocator;
-
         VkBufferCreateInfo bufferCI{};
         bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         bufferCI.size = desc.m_size;
@@ -92,6 +86,20 @@ namespace FE::Graphics::Vulkan
             bufferCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
         }
 
+        return bufferCI;
+    }
+
+
+    void Buffer::InitInternal(const VmaAllocator allocator, const Env::Name name, const Core::BufferDesc& desc)
+    {
+        FE_PROFILER_ZONE();
+
+        m_name = name;
+        m_desc = desc;
+        m_vmaAllocator = allocator;
+
+        const VkBufferCreateInfo bufferCI = MakeCreateInfo(desc);
+
         VmaAllocationCreateInfo allocationCI{};
         allocationCI.usage = VMA_MEMORY_USAGE_AUTO;
 
@@ -117,6 +125,29 @@ namespace FE::Graphics::Vulkan
         VerifyVulkan(vmaCreateBuffer(allocator, &bufferCI, &allocationCI, &m_nativeBuffer, &m_vmaAllocation, nullptr));
         vmaSetAllocationName(allocator, m_vmaAllocation, m_name.c_str());
 
+        SetDebugName();
+    }
+
+
+    void Buffer::InitInternal(const Env::Name name, const Core::BufferDesc& desc, MemoryHeap* heap, const uint64_t offset)
+    {
+        FE_PROFILER_ZONE();
+
+        FE_Assert(desc.m_usage == Core::ResourceUsage::kDeviceOnly, "Placed buffers cannot be mapped");
+
+        m_name = name;
+        m_desc = desc;
+        m_memoryHeap = heap;
+
+        const VkBufferCreateInfo bufferCI = MakeCreateInfo(desc);
+        VerifyVulkan(vmaCreateAliasingBuffer2(heap->GetAllocator(), heap->GetNative(), offset, &bufferCI, &m_nativeBuffer));
+
+        SetDebugName();
+    }
+
+
+    void Buffer::SetDebugName() const
+    {
         VkDebugUtilsObjectNameInfoEXT nameInfo{};
         nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
         nameInfo.objectType = VK_OBJECT_TYPE_BUFFER;
@@ -128,9 +159,12 @@ namespace FE::Graphics::Vulkan
 
     Buffer::~Buffer()
     {
-        if (m_vmaAllocator != nullptr)
+        if (m_memoryHeap)
+            vkDestroyBuffer(NativeCast(m_device), m_nativeBuffer, nullptr);
+        else if (m_vmaAllocator != nullptr)
             vmaDestroyBuffer(m_vmaAllocator, m_nativeBuffer, m_vmaAllocation);
 
+        m_memoryHeap.Reset();
         m_vmaAllocator = VK_NULL_HANDLE;
         m_vmaAllocation = VK_NULL_HANDLE;
         m_nativeBuffer = VK_NULL_HANDLE;
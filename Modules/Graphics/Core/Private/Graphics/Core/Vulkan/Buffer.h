@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <Graphics/Core/Buffer.h>
 #include <Graphics/Core/Vulkan/Base/Config.h>
+#include <Graphics/Core/Vulkan/MemoryHeap.h>
 
 namespace FE::Graphics::Vulkan
 {
@@ -18,6 +19,9 @@ namespace FE::Graphics::Vulkan
         }
 
         void InitInternal(VmaAllocator allocator, Env::Name name, const Core::BufferDesc& desc);
+        void InitInternal(Env::Name name, const Core::BufferDesc& desc, MemoryHeap* heap, uint64_t offset);
+
+        static VkBufferCreateInfo MakeCreateInfo(const Core::BufferDesc& desc);
 
         void* Map() override;
         void Unmap() override;
@@ -27,10 +31,13 @@ namespace FE::Graphics::Vulkan
     private:
         explicit Buffer(Core::Device* device);
 
+        void SetDebugName() const;
+
         Core::BufferDesc m_desc;
         VkBuffer m_nativeBuffer = VK_NULL_HANDLE;
         VmaAllocation m_vmaAllocation = VK_NULL_HANDLE;
         VmaAllocator m_vmaAllocator = VK_NULL_HANDLE;
+        Rc<MemoryHeap> m_memoryHeap;
     };
 
 
@@ -157,6 +157,11 @@ namespace FE::Graphics::Vulkan
                 continue;
             }
 
+            // A transient resource that wasn't accessed yet takes over its memory from the resources placed there before.
+            const bool isFirstUse = resource.m_transientIndex != kInvalidIndex && resource.m_accessState == 0;
+            const festd::span<const uint32_t> aliasedResources =
+                isFirstUse ? m_resourcePool->GetAliasedResources(resource.m_transientIndex) : festd::span<const uint32_t>{};
+
             switch (resource.m_resourceType)
             {
             default:
@@ -176,7 +181,21 @@ namespace FE::Graphics::Vulkan
                     barrier.m_sourceQueueKind = Core::HardwareQueueKindFlags::kGraphics;
                     barrier.m_destQueueKind = Core::HardwareQueueKindFlags::kGraphics;
 
-                    barriers.AddBarrier(barrier);
+                    if (isFirstUse)
+                    {
+                        festd::inline_vector<Core::BufferAccessType> previousAccesses;
+                        for (const uint32_t aliasedIndex : aliasedResources)
+                        {
+                            const auto& aliasedResource = m_resources[m_transientResourceIndices[aliasedIndex]];
+                            previousAccesses.push_back(static_cast<Core::BufferAccessType>(aliasedResource.m_accessState));
+                        }
+
+                        barriers.AddAliasingBarrier(barrier, previousAccesses);
+                    }
+                    else
+                    {
+                        barriers.AddBarrier(barrier);
+                    }
                 }
                 break;
 
@@ -192,7 +211,21 @@ namespace FE::Graphics::Vulkan
                     barrier.m_sourceQueueKind = Core::HardwareQueueKindFlags::kGraphics;
                     barrier.m_destQueueKind = Core::HardwareQueueKindFlags::kGraphics;
 
-                    barriers.AddBarrier(barrier);
+                    if (isFirstUse)
+                    {
+                        festd::inline_vector<Core::ImageAccessType> previousAccesses;
+                        for (const uint32_t aliasedIndex : aliasedResources)
+                        {
+                            const auto& aliasedResource = m_resources[m_transientResourceIndices[aliasedIndex]];
+                            previousAccesses.push_back(static_cast<Core::ImageAccessType>(aliasedResource.m_accessState));
+                        }
+
+                        barriers.AddAliasingBarrier(barrier, previousAccesses);
+                    }
+                    else
+                    {
+                        barriers.AddBarrier(barrier);
+                    }
                 }
                 break;
             }
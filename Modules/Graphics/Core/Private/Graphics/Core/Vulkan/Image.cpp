@@ -101,16 +101,10 @@ namespace FE::Graphics::Vulkan
     }
 
 
-    void Image::InitInternal(const VkDevice device, const char* name, const VmaAllocator allocator, const VkImageUsageFlags usage,
-                             const Core::ImageDesc& desc)
+    VkImageCreateInfo Image::MakeCreateInfo(const VkImageUsageFlags usage, const Core::ImageDesc& desc)
     {
-        FE_PROFILER_ZONE();
-
         using Core::ImageDimension;
 
-        m_desc = desc;
-        m_vmaAllocator = allocator;
-
         VkImageCreateInfo imageCI{};
         imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageCI.usage = usage;
@@ -146,6 +140,19 @@ namespace FE::Graphics::Vulkan
         imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         imageCI.samples = GetVKSampleCountFlags(desc.m_sampleCount);
         imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        return imageCI;
+    }
+
+
+    void Image::InitInternal(const VkDevice device, const char* name, const VmaAllocator allocator, const VkImageUsageFlags usage,
+                             const Core::ImageDesc& desc)
+    {
+        FE_PROFILER_ZONE();
+
+        m_desc = desc;
+        m_vmaAllocator = allocator;
+
+        const VkImageCreateInfo imageCI = MakeCreateInfo(usage, desc);
 
         VmaAllocationCreateInfo allocationCI{};
         allocationCI.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
@@ -154,14 +161,35 @@ namespace FE::Graphics::Vulkan
         VerifyVulkan(vmaCreateImage(allocator, &imageCI, &allocationCI, &m_nativeImage, &m_vmaAllocation, nullptr));
         vmaSetAllocationName(allocator, m_vmaAllocation, name);
 
+        SetDebugName(device, name);
+        InitView(device);
+    }
+
+
+    void Image::InitInternal(const VkDevice device, const char* name, MemoryHeap* heap, const uint64_t offset,
+                             const VkImageUsageFlags usage, const Core::ImageDesc& desc)
+    {
+        FE_PROFILER_ZONE();
+
+        m_desc = desc;
+        m_memoryHeap = heap;
+
+        const VkImageCreateInfo imageCI = MakeCreateInfo(usage, desc);
+        VerifyVulkan(vmaCreateAliasingImage2(heap->GetAllocator(), heap->GetNative(), offset, &imageCI, &m_nativeImage));
+
+        SetDebugName(device, name);
+        InitView(device);
+    }
+
+
+    void Image::SetDebugName(const VkDevice device, const char* name) const
+    {
         VkDebugUtilsObjectNameInfoEXT nameInfo{};
         nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
         nameInfo.objectType = VK_OBJECT_TYPE_IMAGE;
         nameInfo.objectHandle = reinterpret_cast<uint64_t>(m_nativeImage);
         nameInfo.pObjectName = name;
         VerifyVulkan(vkSetDebugUtilsObjectNameEXT(device, &nameInfo));
-
-        InitView(device);
     }
 
 
@@ -175,9 +203,12 @@ namespace FE::Graphics::Vulkan
         if (m_view != VK_NULL_HANDLE)
             vkDestroyImageView(device, m_view, nullptr);
 
-        if (m_vmaAllocator != nullptr)
+        if (m_memoryHeap)
+            vkDestroyImage(device, m_nativeImage, nullptr);
+        else if (m_vmaAllocator != nullptr)
             vmaDestroyImage(m_vmaAllocator, m_nativeImage, m_vmaAllocation);
 
+        m_memoryHeap.Reset();
         m_vmaAllocator = VK_NULL_HANDLE;
         m_vmaAllocation = VK_NULL_HANDLE;
         m_nativeImage = VK_NULL_HANDLE;
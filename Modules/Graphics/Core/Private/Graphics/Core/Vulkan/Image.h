@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <Graphics/Core/ImageBase.h>
 #include <Graphics/Core/Vulkan/Base/Config.h>
+#include <Graphics/Core/Vulkan/MemoryHeap.h>
 #include <festd/vector.h>
 
 namespace FE::Graphics::Vulkan
@@ -52,16 +53,22 @@ namespace FE::Graphics::Vulkan
 
         [[nodiscard]] VkImageView GetSubresourceView(VkDevice device, const Core::ImageSubresource& subresource) const;
 
+        static VkImageCreateInfo MakeCreateInfo(VkImageUsageFlags usage, const Core::ImageDesc& desc);
+
     protected:
         void InitInternal(VkDevice device, const char* name, VmaAllocator allocator, VkImageUsageFlags usage,
                           const Core::ImageDesc& desc);
+        void InitInternal(VkDevice device, const char* name, MemoryHeap* heap, uint64_t offset, VkImageUsageFlags usage,
+                          const Core::ImageDesc& desc);
 
         void InitView(VkDevice device);
+        void SetDebugName(VkDevice device, const char* name) const;
 
         VkImage m_nativeImage = VK_NULL_HANDLE;
         VmaAllocation m_vmaAllocation = VK_NULL_HANDLE;
         VmaAllocator m_vmaAllocator = VK_NULL_HANDLE;
         VkImageView m_view = VK_NULL_HANDLE;
+        Rc<MemoryHeap> m_memoryHeap;
 
         struct ViewCacheEntry final
         {
@@ -0,0 +1,58 @@
+﻿#include <Graphics/Core/Vulkan/Base/BaseTypes.h>
+#include <Graphics/Core/Vulkan/Device.h>
+#include <Graphics/Core/Vulkan/MemoryHeap.h>
+
+namespace FE::Graphics::Vulkan
+{
+    FE_DECLARE_VULKAN_OBJECT_POOL(MemoryHeap);
+
+
+    MemoryHeap* MemoryHeap::Create(Core::Device* device)
+    {
+        FE_PROFILER_ZONE();
+
+        return Rc<MemoryHeap>::Allocate(&GMemoryHeapPool, [device](void* memory) {
+            return new (memory) MemoryHeap(device);
+        });
+    }
+
+
+    MemoryHeap::MemoryHeap(Core::Device* device)
+    {
+        m_device = device;
+    }
+
+
+    void MemoryHeap::Init(const VmaAllocator allocator, const Env::Name name, const Core::MemoryRequirements& requirements)
+    {
+        FE_PROFILER_ZONE();
+
+        FE_Assert(m_vmaAllocation == VK_NULL_HANDLE);
+
+        m_desc = requirements;
+        m_vmaAllocator = allocator;
+
+        VkMemoryRequirements memoryRequirements;
+        memoryRequirements.size = requirements.m_byteSize;
+        memoryRequirements.alignment = requirements.m_alignment;
+        memoryRequirements.memoryTypeBits = requirements.m_memoryTypeBits;
+
+        // The heaps are usually large and live for a long time, so they get their own device memory blocks.
+        VmaAllocationCreateInfo allocationCI{};
+        allocationCI.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        allocationCI.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VerifyVulkan(vmaAllocateMemory(allocator, &memoryRequirements, &allocationCI, &m_vmaAllocation, nullptr));
+        vmaSetAllocationName(allocator, m_vmaAllocation, name.c_str());
+    }
+
+
+    MemoryHeap::~MemoryHeap()
+    {
+        if (m_vmaAllocation != VK_NULL_HANDLE)
+            vmaFreeMemory(m_vmaAllocator, m_vmaAllocation);
+
+        m_vmaAllocator = VK_NULL_HANDLE;
+        m_vmaAllocation = VK_NULL_HANDLE;
+    }
+} // namespace FE::Graphics::Vulkan
@@ -0,0 +1,41 @@
+﻿#pragma once
+#include <Graphics/Core/MemoryHeap.h>
+#include <Graphics/Core/Vulkan/Base/Config.h>
+
+namespace FE::Graphics::Vulkan
+{
+    struct MemoryHeap final : public Core::MemoryHeap
+    {
+        FE_RTTI_Class(MemoryHeap, "C919C90E-CD7A-49CD-B417-4709DD102712");
+
+        ~MemoryHeap() override;
+
+        static MemoryHeap* Create(Core::Device* device);
+
+        void Init(VmaAllocator allocator, Env::Name name, const Core::MemoryRequirements& requirements);
+
+        [[nodiscard]] const Core::MemoryRequirements& GetDesc() const override
+        {
+            return m_desc;
+        }
+
+        [[nodiscard]] VmaAllocator GetAllocator() const
+        {
+            return m_vmaAllocator;
+        }
+
+        [[nodiscard]] VmaAllocation GetNative() const
+        {
+            return m_vmaAllocation;
+        }
+
+    private:
+        explicit MemoryHeap(Core::Device* device);
+
+        Core::MemoryRequirements m_desc;
+        VmaAllocation m_vmaAllocation = VK_NULL_HANDLE;
+        VmaAllocator m_vmaAllocator = VK_NULL_HANDLE;
+    };
+
+    FE_ENABLE_NATIVE_CAST(MemoryHeap);
+} // namespace FE::Graphics::Vulkan
@@ -12,6 +12,12 @@ namespace FE::Graphics::Vulkan
     template<class TPipeline>
     struct PipelineFactory::AsyncCompilationJob final : public Job
     {
+        // Pipeline compilation happens in the driver, which can use a lot of stack.
+        AsyncCompilationJob()
+            : Job(JobStackSize::kLarge)
+        {
+        }
+
         void Execute() override
         {
             FE_PROFILER_ZONE();
@@ -30,8 +36,7 @@ namespace FE::Graphics::Vulkan
                                      Logger* logger)
         : m_graphicsPipelinePool("GraphicsPipelinePool", sizeof(GraphicsPipeline))
         , m_computePipelinePool("ComputePipelinePool", sizeof(ComputePipeline))
-        , m_jobPool("PipelineAsyncCompilationJobPool",
-                    Math::Max(sizeof(AsyncCompilationJob<GraphicsPipeline>), sizeof(AsyncCompilationJob<ComputePipeline>)))
+        , m_jobPool("PipelineAsyncCompilationJobPool", Memory::Tag::kGraphics, 4 * 1024 * 1024)
         , m_bindlessManager(bindlessManager)
         , m_jobSystem(jobSystem)
         , m_logger(logger)
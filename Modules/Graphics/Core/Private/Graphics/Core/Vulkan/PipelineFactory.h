@@ -1,6 +1,7 @@
 #pragma once
 #include <FeCore/Jobs/IJobSystem.h>
 #include <FeCore/Memory/PoolAllocator.h>
+#include <FeCore/Memory/ThreadCachedPoolAllocator.h>
 #include <Graphics/Core/PipelineFactory.h>
 #include <Graphics/Core/Vulkan/Base/Config.h>
 #include <festd/unordered_map.h>
@@ -30,7 +31,7 @@ namespace FE::Graphics::Vulkan
         Rc<ShaderLibrary> m_shaderLibrary;
         Memory::PoolAllocator m_graphicsPipelinePool;
         Memory::PoolAllocator m_computePipelinePool;
-        Memory::SpinLockedPoolAllocator m_jobPool;
+        Memory::ThreadCachedPoolAllocator m_jobPool;
         BindlessManager* m_bindlessManager = nullptr;
         IJobSystem* m_jobSystem = nullptr;
         Logger* m_logger = nullptr;
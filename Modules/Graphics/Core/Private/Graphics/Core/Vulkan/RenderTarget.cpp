@@ -21,10 +21,8 @@ namespace FE::Graphics::Vulkan
     }
 
 
-    void RenderTarget::InitInternal(const VmaAllocator allocator, const Env::Name name, const Core::ImageDesc& desc)
+    VkImageUsageFlags RenderTarget::GetUsageFlags(const Core::ImageDesc& desc)
     {
-        m_name = name;
-
         const Core::FormatInfo formatInfo{ desc.m_imageFormat };
         VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
 
@@ -46,8 +44,23 @@ namespace FE::Graphics::Vulkan
         }
 
         FE_Assert(!formatInfo.m_isBlockCompressed);
+        return usage;
+    }
+
+
+    void RenderTarget::InitInternal(const VmaAllocator allocator, const Env::Name name, const Core::ImageDesc& desc)
+    {
+        m_name = name;
+
+        Image::InitInternal(NativeCast(m_device), name.c_str(), allocator, GetUsageFlags(desc), desc);
+    }
+
+
+    void RenderTarget::InitInternal(const Env::Name name, const Core::ImageDesc& desc, MemoryHeap* heap, const uint64_t offset)
+    {
+        m_name = name;
 
-        Image::InitInternal(NativeCast(m_device), name.c_str(), allocator, usage, desc);
+        Image::InitInternal(NativeCast(m_device), name.c_str(), heap, offset, GetUsageFlags(desc), desc);
     }
 
 
@@ -16,6 +16,9 @@ namespace FE::Graphics::Vulkan
 
         void InitInternal(VmaAllocator allocator, Env::Name name, const Core::ImageDesc& desc);
         void InitInternal(Env::Name name, const Core::ImageDesc& desc, VkImage image);
+        void InitInternal(Env::Name name, const Core::ImageDesc& desc, MemoryHeap* heap, uint64_t offset);
+
+        static VkImageUsageFlags GetUsageFlags(const Core::ImageDesc& desc);
 
         const Core::ImageDesc& GetDesc() const override;
 
@@ -88,16 +88,57 @@ namespace FE::Graphics::Vulkan
 
 
     void ResourceBarrierBatcher::AddBarrier(const BufferBarrierDesc& desc)
+    {
+        AddBarrierImpl(desc, VK_ACCESS_2_NONE);
+    }
+
+
+    void ResourceBarrierBatcher::AddBarrier(const ImageBarrierDesc& desc)
+    {
+        AddBarrierImpl(desc, VK_ACCESS_2_NONE);
+    }
+
+
+    void ResourceBarrierBatcher::AddAliasingBarrier(const BufferBarrierDesc& desc,
+                                                    const festd::span<const Core::BufferAccessType> previousAccesses)
+    {
+        FE_Assert(desc.m_sourceAccess == Core::BufferAccessType::kUndefined);
+
+        VkAccessFlags2 aliasedAccessFlags = VK_ACCESS_2_NONE;
+        for (const Core::BufferAccessType access : previousAccesses)
+            aliasedAccessFlags |= ConvertBufferAccessFlags(access);
+
+        AddBarrierImpl(desc, aliasedAccessFlags);
+    }
+
+
+    void ResourceBarrierBatcher::AddAliasingBarrier(const ImageBarrierDesc& desc,
+                                                    const festd::span<const Core::ImageAccessType> previousAccesses)
+    {
+        FE_Assert(desc.m_sourceAccess == Core::ImageAccessType::kUndefined);
+
+        VkAccessFlags2 aliasedAccessFlags = VK_ACCESS_2_NONE;
+        for (const Core::ImageAccessType access : previousAccesses)
+            aliasedAccessFlags |= ConvertImageAccessFlags(access).m_accessFlags;
+
+        AddBarrierImpl(desc, aliasedAccessFlags);
+    }
+
+
+    void ResourceBarrierBatcher::AddBarrierImpl(const BufferBarrierDesc& desc, const VkAccessFlags2 aliasedAccessFlags)
     {
         FE_PROFILER_ZONE();
 
         const uint64_t hash = desc.GetHash();
 
         bool needFlush = false;
-        for (auto& [barrierDesc, barrierHash] : m_bufferBarriers)
+        for (auto& [barrierDesc, barrierHash, barrierAliasedAccessFlags] : m_bufferBarriers)
         {
             if (barrierHash == hash)
+            {
+                barrierAliasedAccessFlags |= aliasedAccessFlags;
                 return;
+            }
 
             if (barrierDesc.m_buffer == desc.m_buffer)
             {
@@ -109,21 +150,24 @@ namespace FE::Graphics::Vulkan
         if (needFlush)
             Flush();
 
-        m_bufferBarriers.push_back({ desc, hash });
+        m_bufferBarriers.push_back({ desc, hash, aliasedAccessFlags });
     }
 
 
-    void ResourceBarrierBatcher::AddBarrier(const ImageBarrierDesc& desc)
+    void ResourceBarrierBatcher::AddBarrierImpl(const ImageBarrierDesc& desc, const VkAccessFlags2 aliasedAccessFlags)
     {
         FE_PROFILER_ZONE();
 
         const uint64_t hash = desc.GetHash();
 
         bool needFlush = false;
-        for (auto& [barrierDesc, barrierHash] : m_imageBarriers)
+        for (auto& [barrierDesc, barrierHash, barrierAliasedAccessFlags] : m_imageBarriers)
         {
             if (barrierHash == hash)
+            {
+                barrierAliasedAccessFlags |= aliasedAccessFlags;
                 return;
+            }
 
             if (barrierDesc.m_image == desc.m_image)
             {
@@ -135,7 +179,7 @@ namespace FE::Graphics::Vulkan
         if (needFlush)
             Flush();
 
-        m_imageBarriers.push_back({ desc, hash });
+        m_imageBarriers.push_back({ desc, hash, aliasedAccessFlags });
     }
 
 
@@ -148,12 +192,12 @@ namespace FE::Graphics::Vulkan
 
         festd::inline_vector<VkBufferMemoryBarrier2> nativeBufferBarriers;
         nativeBufferBarriers.reserve(m_bufferBarriers.size());
-        for (const auto [barrierDesc, hash] : m_bufferBarriers)
+        for (const auto [barrierDesc, hash, aliasedAccessFlags] : m_bufferBarriers)
         {
             VkBufferMemoryBarrier2& barrier = nativeBufferBarriers.emplace_back();
             barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
             barrier.buffer = barrierDesc.m_buffer;
-            barrier.srcAccessMask = ConvertBufferAccessFlags(barrierDesc.m_sourceAccess);
+            barrier.srcAccessMask = ConvertBufferAccessFlags(barrierDesc.m_sourceAccess) | aliasedAccessFlags;
             barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
             barrier.dstAccessMask = ConvertBufferAccessFlags(barrierDesc.m_destAccess);
             barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
@@ -175,14 +219,14 @@ namespace FE::Graphics::Vulkan
 
         festd::inline_vector<VkImageMemoryBarrier2> nativeImageBarriers;
         nativeImageBarriers.reserve(m_imageBarriers.size());
-        for (const auto [barrierDesc, hash] : m_imageBarriers)
+        for (const auto [barrierDesc, hash, aliasedAccessFlags] : m_imageBarriers)
         {
             VkImageMemoryBarrier2& barrier = nativeImageBarriers.emplace_back();
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
             barrier.image = barrierDesc.m_image;
 
             const auto [srcAccessFlags, oldLayout] = ConvertImageAccessFlags(barrierDesc.m_sourceAccess);
-            barrier.srcAccessMask = srcAccessFlags;
+            barrier.srcAccessMask = srcAccessFlags | aliasedAccessFlags;
             barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
             barrier.oldLayout = oldLayout;
 
@@ -3,6 +3,7 @@
 #include <Graphics/Core/ImageBase.h>
 #include <Graphics/Core/Vulkan/Base/Config.h>
 #include <Graphics/Core/Vulkan/Device.h>
+#include <festd/span.h>
 
 namespace FE::Graphics::Vulkan
 {
@@ -68,6 +69,13 @@ namespace FE::Graphics::Vulkan
         void AddBarrier(const BufferBarrierDesc& desc);
         void AddBarrier(const ImageBarrierDesc& desc);
 
+        //! @brief Add a barrier for a resource that takes over memory from the resources previously placed there.
+        //!
+        //! The source access of the barrier must be undefined: the contents of the resource are discarded. The accesses of
+        //! the previous occupants are added to the source scope, so that they finish before the memory is reused.
+        void AddAliasingBarrier(const BufferBarrierDesc& desc, festd::span<const Core::BufferAccessType> previousAccesses);
+        void AddAliasingBarrier(const ImageBarrierDesc& desc, festd::span<const Core::ImageAccessType> previousAccesses);
+
         void Flush();
 
     private:
@@ -75,12 +83,14 @@ namespace FE::Graphics::Vulkan
         {
             BufferBarrierDesc m_desc;
             uint64_t m_hash = 0;
+            VkAccessFlags2 m_aliasedAccessFlags = 0;
         };
 
         struct ImageBarrierWithHash final
         {
             ImageBarrierDesc m_desc;
             uint64_t m_hash = 0;
+            VkAccessFlags2 m_aliasedAccessFlags = 0;
         };
 
         Device* m_device = nullptr;
@@ -88,5 +98,8 @@ namespace FE::Graphics::Vulkan
 
         festd::inline_vector<BufferBarrierWithHash> m_bufferBarriers;
         festd::inline_vector<ImageBarrierWithHash> m_imageBarriers;
+
+        void AddBarrierImpl(const BufferBarrierDesc& desc, VkAccessFlags2 aliasedAccessFlags);
+        void AddBarrierImpl(const ImageBarrierDesc& desc, VkAccessFlags2 aliasedAccessFlags);
     };
 } // namespace FE::Graphics::Vulkan
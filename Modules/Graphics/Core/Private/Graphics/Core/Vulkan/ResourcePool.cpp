@@ -1,6 +1,7 @@
 #include <Graphics/Core/Vulkan/Buffer.h>
 #include <Graphics/Core/Vulkan/Device.h>
 #include <Graphics/Core/Vulkan/DeviceFactory.h>
+#include <Graphics/Core/Vulkan/MemoryHeap.h>
 #include <Graphics/Core/Vulkan/RenderTarget.h>
 #include <Graphics/Core/Vulkan/ResourcePool.h>
 #include <Graphics/Core/Vulkan/Texture.h>
@@ -73,4 +74,81 @@ namespace FE::Graphics::Vulkan
         buffer->InitInternal(m_vmaAllocator, name, desc);
         return buffer;
     }
+
+
+    Core::MemoryRequirements ResourcePool::GetRenderTargetMemoryRequirements(const Core::ImageDesc& desc)
+    {
+        FE_PROFILER_ZONE();
+
+        // We don't require VK_KHR_maintenance4, so we have to create a temporary image to query the requirements.
+        const VkDevice device = NativeCast(m_device);
+        const VkImageCreateInfo imageCI = Image::MakeCreateInfo(RenderTarget::GetUsageFlags(desc), desc);
+
+        VkImage image = VK_NULL_HANDLE;
+        VerifyVulkan(vkCreateImage(device, &imageCI, nullptr, &image));
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+        vkDestroyImage(device, image, nullptr);
+
+        Core::MemoryRequirements result;
+        result.m_byteSize = memoryRequirements.size;
+        result.m_alignment = memoryRequirements.alignment;
+        result.m_memoryTypeBits = memoryRequirements.memoryTypeBits;
+        return result;
+    }
+
+
+    Core::MemoryRequirements ResourcePool::GetBufferMemoryRequirements(const Core::BufferDesc& desc)
+    {
+        FE_PROFILER_ZONE();
+
+        const VkDevice device = NativeCast(m_device);
+        const VkBufferCreateInfo bufferCI = Buffer::MakeCreateInfo(desc);
+
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VerifyVulkan(vkCreateBuffer(device, &bufferCI, nullptr, &buffer));
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+        vkDestroyBuffer(device, buffer, nullptr);
+
+        Core::MemoryRequirements result;
+        result.m_byteSize = memoryRequirements.size;
+        result.m_alignment = memoryRequirements.alignment;
+        result.m_memoryTypeBits = memoryRequirements.memoryTypeBits;
+        return result;
+    }
+
+
+    Core::MemoryHeap* ResourcePool::CreateMemoryHeap(const Env::Name name, const Core::MemoryRequirements& requirements)
+    {
+        FE_PROFILER_ZONE();
+
+        MemoryHeap* heap = MemoryHeap::Create(m_device);
+        heap->Init(m_vmaAllocator, name, requirements);
+        return heap;
+    }
+
+
+    Core::RenderTarget* ResourcePool::CreatePlacedRenderTarget(const Env::Name name, const Core::ImageDesc& desc,
+                                                               Core::MemoryHeap* heap, const uint64_t offset)
+    {
+        FE_PROFILER_ZONE();
+
+        RenderTarget* renderTarget = RenderTarget::Create(m_device);
+        renderTarget->InitInternal(name, desc, ImplCast(heap), offset);
+        return renderTarget;
+    }
+
+
+    Core::Buffer* ResourcePool::CreatePlacedBuffer(const Env::Name name, const Core::BufferDesc& desc, Core::MemoryHeap* heap,
+                                                   const uint64_t offset)
+    {
+        FE_PROFILER_ZONE();
+
+        Buffer* buffer = Buffer::Create(m_device);
+        buffer->InitInternal(name, desc, ImplCast(heap), offset);
+        return buffer;
+    }
 } // namespace FE::Graphics::Vulkan
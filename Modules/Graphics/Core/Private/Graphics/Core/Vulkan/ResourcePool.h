@@ -16,6 +16,15 @@ namespace FE::Graphics::Vulkan
         Core::RenderTarget* CreateRenderTarget(Env::Name name, const Core::ImageDesc& desc) override;
         Core::Buffer* CreateBuffer(Env::Name name, const Core::BufferDesc& desc) override;
 
+        Core::MemoryRequirements GetRenderTargetMemoryRequirements(const Core::ImageDesc& desc) override;
+        Core::MemoryRequirements GetBufferMemoryRequirements(const Core::BufferDesc& desc) override;
+
+        Core::MemoryHeap* CreateMemoryHeap(Env::Name name, const Core::MemoryRequirements& requirements) override;
+        Core::RenderTarget* CreatePlacedRenderTarget(Env::Name name, const Core::ImageDesc& desc, Core::MemoryHeap* heap,
+                                                     uint64_t offset) override;
+        Core::Buffer* CreatePlacedBuffer(Env::Name name, const Core::BufferDesc& desc, Core::MemoryHeap* heap,
+                                         uint64_t offset) override;
+
         [[nodiscard]] VmaAllocator GetAllocator() const
         {
             return m_vmaAllocator;
@@ -9,6 +9,12 @@ namespace FE::Graphics::Vulkan
 {
     struct ShaderLibrary::CompilationTask final : public Job
     {
+        // The shader compiler is recursive and can use a lot of stack.
+        CompilationTask()
+            : Job(JobStackSize::kLarge)
+        {
+        }
+
         void Execute() override;
 
         ShaderLibrary* m_parent = nullptr;
@@ -72,7 +72,7 @@ namespace FE::Graphics::Core
     } // namespace InternalAsyncCopyCommands
 
 
-    struct AsyncCopyCommandList final : public ConcurrentOnceConsumedQueue::Node
+    struct AsyncCopyCommandList final : public MPSCQueue::Node
     {
         Memory::SegmentedBuffer m_buffer;
         WaitGroup* m_signalWaitGroup;
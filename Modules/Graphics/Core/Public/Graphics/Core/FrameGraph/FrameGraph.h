@@ -122,7 +122,8 @@ namespace FE::Graphics::Core
         friend FrameGraphPassBuilder;
 
         FrameGraph()
-            : m_linearAllocator(UINT64_C(64 * 1024), Env::GetStaticAllocator(Memory::StaticAllocatorType::kVirtual))
+            : m_pageAllocator(Memory::Tag::kFrameGraph)
+            , m_linearAllocator(UINT64_C(64 * 1024), &m_pageAllocator)
             , m_blackboard(&m_linearAllocator)
             , m_passProducers(&m_linearAllocator)
         {
@@ -154,6 +155,7 @@ namespace FE::Graphics::Core
         virtual uint32_t ReadResource(uint32_t passIndex, uint32_t resourceIndex, uint32_t flags) = 0;
         virtual uint32_t WriteResource(uint32_t passIndex, uint32_t resourceIndex, uint32_t flags) = 0;
 
+        Memory::TaggedMemoryResource m_pageAllocator;
         Memory::LinearAllocator m_linearAllocator;
         FrameGraphBlackboard m_blackboard;
         SegmentedVector<PassProducer*> m_passProducers;
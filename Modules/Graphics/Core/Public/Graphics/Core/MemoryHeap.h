@@ -0,0 +1,25 @@
+﻿#pragma once
+#include <Graphics/Core/DeviceObject.h>
+
+namespace FE::Graphics::Core
+{
+    //! @brief Describes the memory that a resource needs to be placed into a MemoryHeap.
+    struct MemoryRequirements final
+    {
+        uint64_t m_byteSize = 0;
+        uint64_t m_alignment = 0;
+        uint32_t m_memoryTypeBits = 0; //!< Backend-specific mask of the memory types the resource can be placed into.
+    };
+
+
+    //! @brief A block of device memory that resources can be placed into at arbitrary offsets.
+    //!
+    //! Resources placed into overlapping ranges of the same heap alias each other's memory. It is up to the user
+    //! to make sure they are never used at the same time. Placed resources keep a reference to their heap.
+    struct MemoryHeap : public DeviceObject
+    {
+        FE_RTTI_Class(MemoryHeap, "E17E1BAA-8BC5-4A56-8442-48AEE7ED83EE");
+
+        [[nodiscard]] virtual const MemoryRequirements& GetDesc() const = 0;
+    };
+} // namespace FE::Graphics::Core
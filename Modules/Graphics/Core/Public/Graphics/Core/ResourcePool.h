@@ -1,5 +1,6 @@
 #pragma once
 #include <Graphics/Core/Buffer.h>
+#include <Graphics/Core/MemoryHeap.h>
 #include <Graphics/Core/RenderTarget.h>
 #include <Graphics/Core/Texture.h>
 
@@ -14,5 +15,21 @@ namespace FE::Graphics::Core
         virtual Texture* CreateTexture(Env::Name name, const ImageDesc& desc) = 0;
         virtual RenderTarget* CreateRenderTarget(Env::Name name, const ImageDesc& desc) = 0;
         virtual Buffer* CreateBuffer(Env::Name name, const BufferDesc& desc) = 0;
+
+        virtual MemoryRequirements GetRenderTargetMemoryRequirements(const ImageDesc& desc) = 0;
+        virtual MemoryRequirements GetBufferMemoryRequirements(const BufferDesc& desc) = 0;
+
+        //! @brief Allocate device-local memory for placed resources.
+        //!
+        //! @param name         The name of the heap, used for debugging.
+        //! @param requirements The size of the heap, the alignment of its base address and the allowed memory types.
+        virtual MemoryHeap* CreateMemoryHeap(Env::Name name, const MemoryRequirements& requirements) = 0;
+
+        //! @brief Create a render target in the memory of the provided heap without allocating any memory for it.
+        virtual RenderTarget* CreatePlacedRenderTarget(Env::Name name, const ImageDesc& desc, MemoryHeap* heap,
+                                                       uint64_t offset) = 0;
+
+        //! @brief Create a device-only buffer in the memory of the provided heap without allocating any memory for it.
+        virtual Buffer* CreatePlacedBuffer(Env::Name name, const BufferDesc& desc, MemoryHeap* heap, uint64_t offset) = 0;
     };
 } // namespace FE::Graphics::Core
@@ -26,28 +26,55 @@ namespace FE::Graphics
     }
 
 
-    ModelAsset* ModelAssetManager::Load(const Env::Name assetName)
+    Rc<ModelAsset> ModelAssetManager::Load(const Env::Name assetName)
     {
         FE_PROFILER_ZONE();
 
-        std::lock_guard lock{ m_lock };
+        // Failed assets are not reused, so that the caller can retry loading after fixing the file.
+        // The check is done under the cache lock, so a concurrent Load can't remove the asset that replaced the failed one.
+        m_assetCache.RemoveIf(assetName, [](const ModelAsset* cachedAsset) {
+            return cachedAsset->m_status.load(std::memory_order_acquire) == AssetLoadingStatus::kFailed;
+        });
+
+        bool created;
+        ModelAsset* asset = m_assetCache.FindOrCreate(
+            assetName,
+            [this] {
+                return Rc<ModelAsset>::New(&m_assetPool);
+            },
+            created);
+
+        // The asset is either resident or already being loaded.
+        if (!created)
+            return asset;
 
-        Request* request = m_requestPool.New();
-        request->m_asset = Rc<ModelAsset>::New(m_assetPool.GetAllocator());
+        auto* request = Memory::New<Request>(&m_requestPool);
+        request->m_asset = asset;
         request->m_stage = LoadingStage::kHeaders;
         request->m_asset->m_name = assetName;
         request->m_asset->m_completionWaitGroup = WaitGroup::Create();
 
         IO::AsyncBlockReadRequest readRequest;
         readRequest.m_path = IO::GetAbsolutePath(festd::string_view(assetName));
+        readRequest.m_memoryMapped = true; // The LOD requests reuse the stream, so the meshlets are read from the mapping too.
         readRequest.m_callback = this;
+        readRequest.m_allocator = &m_readBufferAllocator;
         readRequest.m_userData0 = reinterpret_cast<uintptr_t>(request);
+        readRequest.m_verifyIntegrity = true;
         m_asyncIO->ReadAsync(readRequest);
 
         return request->m_asset.Get();
     }
 
 
+    void ModelAssetManager::SetCacheByteBudget(const uint64_t byteBudget)
+    {
+        FE_PROFILER_ZONE();
+
+        m_assetCache.SetByteBudget(byteBudget);
+    }
+
+
     void ModelAssetManager::AsyncIOCallback(const IO::AsyncBlockReadResult& result)
     {
         FE_PROFILER_ZONE();
@@ -55,11 +82,11 @@ namespace FE::Graphics
         IO::AsyncBlockReadRequest* readRequest = result.m_request;
         auto* request = reinterpret_cast<Request*>(readRequest->m_userData0);
 
-        if (result.m_controller->GetStatus() == IO::AsyncOperationStatus::kFailed)
+        if (result.m_result != IO::ResultCode::kSuccess)
         {
             request->m_asset->m_status.store(AssetLoadingStatus::kFailed, std::memory_order_release);
             request->m_asset->m_completionWaitGroup->Signal();
-            m_requestPool.Delete(request);
+            Memory::Delete(&m_requestPool, request, sizeof(Request));
             return;
         }
 
@@ -90,7 +117,7 @@ namespace FE::Graphics
         {
             request->m_asset->m_status.store(AssetLoadingStatus::kFailed, std::memory_order_release);
             request->m_asset->m_completionWaitGroup->Signal();
-            m_requestPool.Delete(request);
+            Memory::Delete(&m_requestPool, request, sizeof(Request));
         }
     }
 
@@ -163,6 +190,7 @@ namespace FE::Graphics
 
             IO::AsyncBlockReadRequest lodRequest;
             lodRequest.m_callback = this;
+            lodRequest.m_allocator = &m_readBufferAllocator;
             lodRequest.m_userData0 = reinterpret_cast<uintptr_t>(request);
             lodRequest.m_userData1 = (static_cast<uintptr_t>(lodIndex) << 32) | dataSize;
             lodRequest.m_stream = stream;
@@ -200,9 +228,16 @@ namespace FE::Graphics
             if (request->m_loadedLods == request->m_asset->m_lodCount)
             {
                 Memory::DefaultFree(request->m_lodLoadedBlockCount);
+
+                uint64_t assetByteSize = 0;
+                for (const Rc<Core::Buffer>& buffer : request->m_asset->m_geometryBuffers)
+                    assetByteSize += buffer->GetDesc().m_size;
+
+                m_assetCache.SetByteSize(request->m_asset->m_name, assetByteSize);
+
                 request->m_asset->m_status.store(AssetLoadingStatus::kCompletelyLoaded, std::memory_order_release);
                 request->m_asset->m_completionWaitGroup->Signal();
-                m_requestPool.Delete(request);
+                Memory::Delete(&m_requestPool, request, sizeof(Request));
             }
             else if (request->m_loadedLods == 1)
             {
@@ -1,4 +1,5 @@
 #pragma once
+#include <FeCore/Containers/RefCountedCache.h>
 #include <FeCore/IO/IAsyncStreamIO.h>
 #include <FeCore/Jobs/Job.h>
 #include <FeCore/Memory/PoolAllocator.h>
@@ -18,7 +19,8 @@ namespace FE::Graphics
         ModelAssetManager(Logger* logger, IJobSystem* jobSystem, IO::IAsyncStreamIO* asyncIO, Core::ResourcePool* resourcePool,
                           Core::AsyncCopyQueue* asyncCopy);
 
-        ModelAsset* Load(Env::Name assetName) override;
+        Rc<ModelAsset> Load(Env::Name assetName) override;
+        void SetCacheByteBudget(uint64_t byteBudget) override;
 
     private:
         enum class LoadingStage : uint32_t
@@ -48,9 +50,13 @@ namespace FE::Graphics
         Core::ResourcePool* m_resourcePool;
         Core::AsyncCopyQueue* m_asyncCopy;
 
-        Threading::SpinLock m_lock;
-        Memory::Pool<ModelAsset> m_assetPool{ "ModelAssetPool" };
-        Memory::Pool<Request> m_requestPool{ "ModelRequestPool" };
+        static constexpr uint64_t kDefaultCacheByteBudget = 512 * 1024 * 1024;
+
+        // The pools are used from the I/O and job threads, the assets are freed by whichever thread releases them last.
+        Memory::SpinLockedPoolAllocator m_assetPool{ "ModelAssetPool", sizeof(ModelAsset) };
+        Memory::TaggedMemoryResource m_readBufferAllocator{ Memory::Tag::kAssets };
+        RefCountedCache<ModelAsset> m_assetCache{ kDefaultCacheByteBudget };
+        Memory::SpinLockedPoolAllocator m_requestPool{ "ModelRequestPool", sizeof(Request) };
 
         static constexpr uint32_t kAsyncCopyCommandSegmentSize = 1024;
         Memory::SpinLockedPoolAllocator m_asyncCopyCommandPagePool{ "AsyncCopyCommandPagePool", kAsyncCopyCommandSegmentSize };
@@ -25,14 +25,30 @@ namespace FE::Graphics
     }
 
 
-    TextureAsset* TextureAssetManager::Load(const Env::Name assetName)
+    Rc<TextureAsset> TextureAssetManager::Load(const Env::Name assetName)
     {
         FE_PROFILER_ZONE();
 
-        std::lock_guard lock{ m_lock };
-
-        Request* request = m_requestPool.New();
-        request->m_asset = Rc<TextureAsset>::New(m_assetPool.GetAllocator());
+        // Failed assets are not reused, so that the caller can retry loading after fixing the file.
+        // The check is done under the cache lock, so a concurrent Load can't remove the asset that replaced the failed one.
+        m_assetCache.RemoveIf(assetName, [](const TextureAsset* cachedAsset) {
+            return cachedAsset->m_status.load(std::memory_order_acquire) == AssetLoadingStatus::kFailed;
+        });
+
+        bool created;
+        TextureAsset* asset = m_assetCache.FindOrCreate(
+            assetName,
+            [this] {
+                return Rc<TextureAsset>::New(&m_assetPool);
+            },
+            created);
+
+        // The asset is either resident or already being loaded.
+        if (!created)
+            return asset;
+
+        auto* request = Memory::New<Request>(&m_requestPool);
+        request->m_asset = asset;
         request->m_stage = LoadingStage::kHeader;
         request->m_asset->m_name = assetName;
         request->m_asset->m_completionWaitGroup = WaitGroup::Create();
@@ -40,13 +56,23 @@ namespace FE::Graphics
         IO::AsyncBlockReadRequest readRequest;
         readRequest.m_path = IO::GetAbsolutePath(festd::string_view(assetName));
         readRequest.m_callback = this;
+        readRequest.m_allocator = &m_readBufferAllocator;
         readRequest.m_userData0 = reinterpret_cast<uintptr_t>(request);
+        readRequest.m_verifyIntegrity = true;
         m_asyncIO->ReadAsync(readRequest);
 
         return request->m_asset.Get();
     }
 
 
+    void TextureAssetManager::SetCacheByteBudget(const uint64_t byteBudget)
+    {
+        FE_PROFILER_ZONE();
+
+        m_assetCache.SetByteBudget(byteBudget);
+    }
+
+
     void TextureAssetManager::MipFinalizerJob::Execute()
     {
         FE_PROFILER_ZONE_NAMED("FinalizeMipChain");
@@ -60,9 +86,11 @@ namespace FE::Graphics
 
         if (loadedMipCount == m_request->m_mipChains.size())
         {
+            m_manager->m_assetCache.SetByteSize(m_request->m_asset->m_name, m_request->m_byteSize);
+
             m_request->m_asset->m_status.store(AssetLoadingStatus::kCompletelyLoaded, std::memory_order_release);
             m_request->m_asset->m_completionWaitGroup->Signal();
-            m_manager->m_requestPool.Delete(m_request);
+            Memory::Delete(&m_manager->m_requestPool, m_request, sizeof(Request));
         }
         else if (loadedMipCount == 1)
         {
@@ -73,7 +101,7 @@ namespace FE::Graphics
             FE_AssertDebug(m_request->m_asset->m_status.load(std::memory_order_relaxed) == AssetLoadingStatus::kHasLoadedLods);
         }
 
-        m_manager->m_mipFinalizerJobPool.Delete(this);
+        Memory::Delete(&m_manager->m_mipFinalizerJobPool, this, sizeof(MipFinalizerJob));
 
         const uint32_t allocSize = m_request->m_mipChains[m_mipChainIndex].m_loadedBlockCount * Compression::kBlockSize;
         if (m_bufferAllocator)
@@ -88,11 +116,11 @@ namespace FE::Graphics
         IO::AsyncBlockReadRequest* readRequest = result.m_request;
         auto* request = reinterpret_cast<Request*>(readRequest->m_userData0);
 
-        if (result.m_controller->GetStatus() == IO::AsyncOperationStatus::kFailed)
+        if (result.m_result != IO::ResultCode::kSuccess)
         {
             request->m_asset->m_status.store(AssetLoadingStatus::kFailed, std::memory_order_release);
             request->m_asset->m_completionWaitGroup->Signal();
-            m_requestPool.Delete(request);
+            Memory::Delete(&m_requestPool, request, sizeof(Request));
             return;
         }
 
@@ -122,7 +150,7 @@ namespace FE::Graphics
         {
             request->m_asset->m_status.store(AssetLoadingStatus::kFailed, std::memory_order_release);
             request->m_asset->m_completionWaitGroup->Signal();
-            m_requestPool.Delete(request);
+            Memory::Delete(&m_requestPool, request, sizeof(Request));
         }
     }
 
@@ -182,6 +210,8 @@ namespace FE::Graphics
                 mipChainByteSize += formatInfo.CalculateMipByteSize(request->m_header.m_desc.GetSize(), mipSlice);
             }
 
+            request->m_byteSize += mipChainByteSize;
+
             if (reader.AvailableSpace() > 0)
             {
                 // The least detailed mip chain might be in the same block as the header.
@@ -195,6 +225,7 @@ namespace FE::Graphics
             {
                 IO::AsyncBlockReadRequest mipBlockReadRequest;
                 mipBlockReadRequest.m_callback = this;
+                mipBlockReadRequest.m_allocator = &m_readBufferAllocator;
                 mipBlockReadRequest.m_userData0 = reinterpret_cast<uintptr_t>(request);
                 mipBlockReadRequest.m_userData1 = i;
                 mipBlockReadRequest.m_stream = stream;
@@ -237,7 +268,7 @@ namespace FE::Graphics
             copyCommandListBuilder.Build(&m_asyncCopyCommandListPool, uploadWaitGroup.Get());
         m_asyncCopy->ExecuteCommandList(copyCommandList);
 
-        auto* mipJob = m_mipFinalizerJobPool.New();
+        auto* mipJob = Memory::New<MipFinalizerJob>(&m_mipFinalizerJobPool);
         mipJob->m_manager = this;
         mipJob->m_uploadWaitGroup = uploadWaitGroup;
         mipJob->m_request = request;
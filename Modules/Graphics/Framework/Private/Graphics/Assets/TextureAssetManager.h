@@ -1,4 +1,5 @@
 #pragma once
+#include <FeCore/Containers/RefCountedCache.h>
 #include <FeCore/IO/IAsyncStreamIO.h>
 #include <FeCore/Jobs/Job.h>
 #include <FeCore/Memory/PoolAllocator.h>
@@ -21,7 +22,8 @@ namespace FE::Graphics
         TextureAssetManager(Logger* logger, IJobSystem* jobSystem, IO::IAsyncStreamIO* asyncIO, Core::ResourcePool* resourcePool,
                             Core::AsyncCopyQueue* asyncCopy);
 
-        TextureAsset* Load(Env::Name assetName) override;
+        Rc<TextureAsset> Load(Env::Name assetName) override;
+        void SetCacheByteBudget(uint64_t byteBudget) override;
 
     private:
         enum class LoadingStage : uint32_t
@@ -44,6 +46,7 @@ namespace FE::Graphics
             festd::fixed_bit_vector<Core::Limits::Image::kMaxMipCount> m_loadedMipChainsMask;
             Threading::SpinLock m_loadedMipChainsMaskLock;
             LoadingStage m_stage;
+            uint64_t m_byteSize = 0;
         };
 
         struct MipFinalizerJob final : public Job
@@ -72,10 +75,14 @@ namespace FE::Graphics
         Core::ResourcePool* m_resourcePool;
         Core::AsyncCopyQueue* m_asyncCopy;
 
-        Threading::SpinLock m_lock;
-        Memory::Pool<TextureAsset> m_assetPool{ "TextureAssetPool" };
-        Memory::Pool<Request> m_requestPool{ "TextureRequestPool" };
-        Memory::Pool<MipFinalizerJob> m_mipFinalizerJobPool{ "MipFinalizerJobPool" };
+        static constexpr uint64_t kDefaultCacheByteBudget = 512 * 1024 * 1024;
+
+        // The pools are used from the I/O and job threads, the assets are freed by whichever thread releases them last.
+        Memory::SpinLockedPoolAllocator m_assetPool{ "TextureAssetPool", sizeof(TextureAsset) };
+        Memory::TaggedMemoryResource m_readBufferAllocator{ Memory::Tag::kAssets };
+        RefCountedCache<TextureAsset> m_assetCache{ kDefaultCacheByteBudget };
+        Memory::SpinLockedPoolAllocator m_requestPool{ "TextureRequestPool", sizeof(Request) };
+        Memory::SpinLockedPoolAllocator m_mipFinalizerJobPool{ "MipFinalizerJobPool", sizeof(MipFinalizerJob) };
 
         static constexpr uint32_t kAsyncCopyCommandSegmentSize = 1024;
         Memory::SpinLockedPoolAllocator m_asyncCopyCommandPagePool{ "AsyncCopyCommandPagePool", kAsyncCopyCommandSegmentSize };
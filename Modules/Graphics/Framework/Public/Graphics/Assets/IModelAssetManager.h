@@ -37,6 +37,13 @@ namespace FE::Graphics
     {
         FE_RTTI_Class(IModelAssetManager, "8E721D85-B882-48E9-AD6E-2AC80A52632E");
 
-        virtual ModelAsset* Load(Env::Name assetName) = 0;
+        //! @brief Get an asset by name, starting to load it if it's not resident yet.
+        //!
+        //! Assets are cached: loading an asset that is already resident or being loaded returns the existing object.
+        //! The cache can evict an asset as soon as it is not referenced anywhere else, so hold on to the returned reference.
+        virtual Rc<ModelAsset> Load(Env::Name assetName) = 0;
+
+        //! @brief Set the total size of the cached assets after which the unused ones start being evicted.
+        virtual void SetCacheByteBudget(uint64_t byteBudget) = 0;
     };
 } // namespace FE::Graphics
@@ -7,6 +7,7 @@
 #include <FeCore/Time/DateTime.h>
 #include <Framework/Application/Application.h>
 #include <Framework/Entities/Archetype.h>
+#include <Framework/Entities/ArchetypeQuery.h>
 #include <Framework/Entities/Entity.h>
 #include <Framework/Entities/EntityRegistry.h>
 #include <Framework/Entities/EntitySystem.h>
@@ -105,20 +106,17 @@ namespace
     {
         void RegisterArchetype(const Framework::Archetype* archetype) override
         {
-            if (archetype->MatchesAll<TestPositionComponent, TestTransformComponent>())
-                m_archetypes.push_back(archetype);
+            m_query.RegisterArchetype(archetype);
         }
 
         void UnregisterArchetype(const Framework::Archetype* archetype) override
         {
-            const auto it = festd::find(m_archetypes, archetype);
-            if (it != m_archetypes.end())
-                m_archetypes.erase_unsorted(it);
+            m_query.UnregisterArchetype(archetype);
         }
 
         void Update([[maybe_unused]] const Framework::EntityUpdateContext& context) override
         {
-            for (const Framework::Archetype* archetype : m_archetypes)
+            for (const Framework::Archetype* archetype : m_query)
             {
                 for (const Framework::ArchetypeChunk* chunk : archetype->m_chunks)
                 {
@@ -140,7 +138,7 @@ namespace
             }
         }
 
-        festd::vector<const Framework::Archetype*> m_archetypes;
+        Framework::ArchetypeQuery m_query = Framework::ArchetypeQuery::Create<TestPositionComponent, TestTransformComponent>();
     };
 
 
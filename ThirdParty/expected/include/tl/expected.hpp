@@ -20,6 +20,7 @@
 #define TL_EXPECTED_VERSION_MINOR 1
 #define TL_EXPECTED_VERSION_PATCH 0
 
+#include <cstdlib>
 #include <exception>
 #include <functional>
 #include <type_traits>
@@ -214,6 +215,7 @@ template <typename E>
 [[noreturn]] TL_EXPECTED_11_CONSTEXPR void throw_exception(E &&e) {
   (void)e;
   FE_DebugBreak(); // [Ferrum] I want to use DebugBreak here instead of assume(0)
+  std::abort();    // [Ferrum] FE_DebugBreak() is not noreturn on every compiler
 }
 
 #ifndef TL_TRAITS_MUTEX
@@ -117,10 +117,14 @@ static void VmCommit(void* ptr, size_t size)
 
 static void VmDecommit(void* ptr, size_t size)
 {
-  int result = madvise(ptr, size, MADV_DONTNEED);
-  ASSERT_FATAL(0 == result, "madvise() failed");
-  result = mprotect(ptr, size, PROT_NONE);
-  ASSERT_FATAL(0 == result, "Failed to decommit memory");
+  //
+  // [Ferrum] madvise() + mprotect() leaves a separate mapping behind for every block that has ever been committed,
+  // they can't be merged with their neighbors. The process hits vm.max_map_count after a few tens of thousands
+  // of allocations. Mapping fresh pages over the range drops the contents the same way, but the new mapping can be
+  // merged with the adjacent inaccessible ones.
+  //
+  void* result = mmap(ptr, size, PROT_NONE, MAP_ANON|MAP_PRIVATE|MAP_FIXED, -1, 0);
+  ASSERT_FATAL(result == ptr, "Failed to decommit memory");
 }
 
 static DebugHeapAtomicType AtomicInc32(DebugHeapAtomicType *var)
@@ -282,7 +286,7 @@ DebugHeap* DebugHeapInit(size_t mem_size_bytes)
 
 void DebugHeapDestroy(DebugHeap* heap)
 {
-  VmFree(heap, heap->m_PageCount * kPageSize);
+  VmFree(heap, (size_t) heap->m_PageCount * kPageSize); // [Ferrum] Avoid 32-bit overflow, munmap() fails on size 0
 }
 
 static void* AllocFromFreeList(DebugHeap* heap, size_t page_req, uint32_t callstackHandle)
@@ -373,8 +377,11 @@ static void* FinalizeAlloc(void* ptr_in, size_t user_size, size_t pages_allocate
   // Commit pages in user-accessible section.
   VmCommit(ptr, (pages_allocated - 1) * kPageSize);
 
-  // Decommit guard page to force crashes for stepping over bounds
-  VmDecommit(ptr + (pages_allocated - 1) * kPageSize, kPageSize);
+  // [Ferrum] The guard page is already inaccessible: all the pages in the free blocks are either reserved
+  // or decommitted when their block is freed. Decommitting it again only costs a system call.
+  //
+  // // Decommit guard page to force crashes for stepping over bounds
+  // VmDecommit(ptr + (pages_allocated - 1) * kPageSize, kPageSize);
 
   // Align user allocation towards end of page, respecting user alignment.
 
@@ -1,5 +1,6 @@
 #include "App.h"
 #include "ModelProcessor.h"
+#include "PakProcessor.h"
 #include "TextureProcessor.h"
 
 #include <FeCore/IO/IStreamFactory.h>
@@ -27,6 +28,19 @@ namespace FE::AssetBuilder
     {
         DI::IServiceProvider* serviceProvider = Env::GetServiceProvider();
         IO::IStreamFactory* streamFactory = serviceProvider->ResolveRequired<IO::IStreamFactory>();
+        IJobSystem* jobSystem = serviceProvider->ResolveRequired<IJobSystem>();
+
+        // AssetBuilder --pack <directory>: pack the assets built into the directory into <directory>.pak.
+        if (const auto packDirectory = CommandLine::GetValue("--pack"))
+        {
+            PakProcessSettings settings;
+            settings.m_logger = m_logger.Get();
+            settings.m_inputDirectory = IO::GetAbsolutePath(*packDirectory);
+            settings.m_outputFile = settings.m_inputDirectory;
+            settings.m_outputFile.append(".pak");
+            ProcessPak(settings);
+            return nullptr;
+        }
 
         const auto args = CommandLine::Get();
         for (const festd::string_view arg : args)
@@ -51,6 +65,7 @@ namespace FE::AssetBuilder
             {
                 TextureProcessSettings settings;
                 settings.m_logger = m_logger.Get();
+                settings.m_jobSystem = jobSystem;
                 settings.m_streamFactory = streamFactory;
                 settings.m_inputFile = fullInputPath;
                 settings.m_outputFile = outputPath;
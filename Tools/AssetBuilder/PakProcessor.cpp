@@ -0,0 +1,53 @@
+#include "PakProcessor.h"
+
+#include <FeCore/IO/PakArchive.h>
+
+namespace FE
+{
+    namespace
+    {
+        constexpr festd::string_view kPackedFilePattern = "*.fmd;*.ftx";
+    } // namespace
+
+
+    bool AssetBuilder::ProcessPak(const PakProcessSettings& settings)
+    {
+        settings.m_logger->LogInfo("Packing directory '{}' into '{}'", settings.m_inputDirectory, settings.m_outputFile);
+
+        const festd::string_view rootDirectory = settings.m_inputDirectory;
+
+        IO::PakWriter writer;
+        uint32_t fileCount = 0;
+        const IO::ResultCode traverseResult =
+            IO::Directory::TraverseRecursively(rootDirectory, kPackedFilePattern, [&](const IO::DirectoryEntry& entry) {
+                if (Bit::AnySet(entry.m_attributes, IO::FileAttributeFlags::kDirectory))
+                    return true;
+
+                // The assets are looked up by their paths relative to the asset directory.
+                const char* pathBegin = entry.m_path.data();
+                const char* pathEnd = pathBegin + entry.m_path.size();
+                const festd::string_view entryName{ pathBegin + rootDirectory.size() + 1, pathEnd };
+                writer.AddFile(entryName, festd::string_view{ pathBegin, pathEnd });
+                ++fileCount;
+                return true;
+            });
+
+        if (traverseResult != IO::ResultCode::kSuccess)
+        {
+            settings.m_logger->LogError(
+                "Failed to enumerate directory '{}': {}", settings.m_inputDirectory, IO::GetResultDesc(traverseResult));
+            return false;
+        }
+
+        const IO::ResultCode writeResult = writer.Write(settings.m_outputFile);
+        if (writeResult != IO::ResultCode::kSuccess)
+        {
+            settings.m_logger->LogError(
+                "Failed to write archive '{}': {}", settings.m_outputFile, IO::GetResultDesc(writeResult));
+            return false;
+        }
+
+        settings.m_logger->LogInfo("Packed {} files", fileCount);
+        return true;
+    }
+} // namespace FE
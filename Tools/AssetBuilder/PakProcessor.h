@@ -0,0 +1,19 @@
+#pragma once
+#include <FeCore/IO/BaseIO.h>
+#include <FeCore/IO/Path.h>
+#include <FeCore/Logging/Logger.h>
+
+namespace FE::AssetBuilder
+{
+    struct PakProcessSettings final
+    {
+        Logger* m_logger = nullptr;
+
+        IO::Path m_inputDirectory; //!< The directory with the built assets, the entry paths are relative to it.
+        IO::Path m_outputFile;
+    };
+
+
+    //! @brief Pack all the built assets (models and textures) from a directory into a single pak archive.
+    bool ProcessPak(const PakProcessSettings& settings);
+} // namespace FE::AssetBuilder
@@ -2,8 +2,11 @@
 #include "Utils.h"
 
 #include <FeCore/Compression/Compression.h>
+#include <FeCore/Containers/SegmentedVector.h>
 #include <FeCore/IO/IStreamFactory.h>
+#include <FeCore/Jobs/Job.h>
 #include <FeCore/Math/Color.h>
+#include <FeCore/Memory/FiberTempAllocator.h>
 #include <FeCore/Memory/SegmentedBuffer.h>
 #include <Graphics/Assets/TextureAssetFormat.h>
 #include <Graphics/Core/Base/Limits.h>
@@ -31,18 +34,14 @@ namespace FE
 {
     namespace
     {
-        std::byte* CompressTextureBC7(const float* sourceData, const uint32_t width, const uint32_t height)
+        //! @brief Compress a range of 4x4 block rows of an image to BC7.
+        void CompressBlockRowsBC7(const float* sourceData, const uint32_t width, const uint32_t height,
+                                  const uint32_t firstBlockRow, const uint32_t blockRowCount, const void* options,
+                                  std::byte* compressedData)
         {
             const uint32_t blockCountX = Math::CeilDivide(width, 4);
-            const uint32_t blockCountY = Math::CeilDivide(height, 4);
 
-            void* options;
-            CreateOptionsBC7(&options);
-            SetMaskBC7(options, 1 << 6);
-            SetQualityBC7(options, 0.3f);
-
-            auto* compressedData = static_cast<std::byte*>(Memory::DefaultAllocate(blockCountX * blockCountY * 16));
-            for (uint32_t yb = 0; yb < blockCountY; ++yb)
+            for (uint32_t yb = firstBlockRow; yb < firstBlockRow + blockRowCount; ++yb)
             {
                 for (uint32_t xb = 0; xb < blockCountX; ++xb)
                 {
@@ -87,8 +86,83 @@ namespace FE
                     _mm_store_ps(reinterpret_cast<float*>(compressedData + (yb * blockCountX + xb) * 16), block);
                 }
             }
+        }
+
+
+        struct CompressBC7TileJob final : public Job
+        {
+            const float* m_sourceData = nullptr;
+            uint32_t m_width = 0;
+            uint32_t m_height = 0;
+            uint32_t m_firstBlockRow = 0;
+            uint32_t m_blockRowCount = 0;
+            const void* m_options = nullptr;
+            std::byte* m_compressedData = nullptr;
+
+            void Execute() override
+            {
+                FE_PROFILER_ZONE();
+
+                CompressBlockRowsBC7(
+                    m_sourceData, m_width, m_height, m_firstBlockRow, m_blockRowCount, m_options, m_compressedData);
+            }
+        };
+
+
+        //! @brief Compress all the mips to BC7.
+        //!
+        //! Every mip is split into tiles of block rows. All the tiles of all the mips are compressed in parallel.
+        //! The blocks are independent, so the result doesn't depend on the number of threads.
+        void CompressTextureBC7(const festd::span<float* const> mipData, const Vector2UInt size, IJobSystem* jobSystem,
+                                festd::fixed_vector<std::byte*, Core::Limits::Image::kMaxMipCount>& compressedMipData)
+        {
+            constexpr uint32_t kBlockRowsPerTile = 8;
+
+            void* options;
+            CreateOptionsBC7(&options);
+            SetMaskBC7(options, 1 << 6);
+            SetQualityBC7(options, 0.3f);
 
-            return compressedData;
+            Memory::FiberTempAllocator temp;
+            SegmentedVector<CompressBC7TileJob> jobs{ &temp };
+
+            for (uint32_t mipIndex = 0; mipIndex < mipData.size(); ++mipIndex)
+            {
+                const uint32_t width = Math::Max(1u, size.x >> mipIndex);
+                const uint32_t height = Math::Max(1u, size.y >> mipIndex);
+                const uint32_t blockCountX = Math::CeilDivide(width, 4);
+                const uint32_t blockCountY = Math::CeilDivide(height, 4);
+
+                auto* compressedData = static_cast<std::byte*>(Memory::DefaultAllocate(blockCountX * blockCountY * 16));
+                compressedMipData.push_back(compressedData);
+
+                for (uint32_t firstBlockRow = 0; firstBlockRow < blockCountY; firstBlockRow += kBlockRowsPerTile)
+                {
+                    CompressBC7TileJob& job = jobs.push_back();
+                    job.m_sourceData = mipData[mipIndex];
+                    job.m_width = width;
+                    job.m_height = height;
+                    job.m_firstBlockRow = firstBlockRow;
+                    job.m_blockRowCount = Math::Min(kBlockRowsPerTile, blockCountY - firstBlockRow);
+                    job.m_options = options;
+                    job.m_compressedData = compressedData;
+                }
+            }
+
+            if (jobSystem)
+            {
+                const Rc waitGroup = WaitGroup::Create(jobs.size());
+                for (CompressBC7TileJob& job : jobs)
+                    job.ScheduleForeground(jobSystem, waitGroup.Get());
+                waitGroup->Wait();
+            }
+            else
+            {
+                for (CompressBC7TileJob& job : jobs)
+                    job.Execute();
+            }
+
+            DestroyOptionsBC7(options);
         }
     } // namespace
 
@@ -225,29 +299,23 @@ namespace FE
                 Memory::DefaultFree(data);
         });
 
-        for (uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex)
+        if (formatInfo.m_isBlockCompressed)
         {
-            const uint32_t width = Math::Max(1u, outputSize.x >> mipIndex);
-            const uint32_t height = Math::Max(1u, outputSize.y >> mipIndex);
-
-            if (formatInfo.m_isBlockCompressed)
+            switch (settings.m_format)
             {
-                switch (settings.m_format)
-                {
-                default:
-                    // not implemented
-                    FE_DebugBreak();
-                    break;
-
-                case Core::Format::kBC7_UNORM:
-                    blockCompressedMipData.push_back(CompressTextureBC7(mipData[mipIndex], width, height));
-                    break;
-                }
+            default:
+                // not implemented
+                FE_DebugBreak();
+                break;
+
+            case Core::Format::kBC7_UNORM:
+                CompressTextureBC7(mipData, outputSize, settings.m_jobSystem, blockCompressedMipData);
+                break;
             }
-
-            settings.m_logger->LogInfo("Compressed mips [{}/{}]", mipIndex + 1, mipCount);
         }
 
+        settings.m_logger->LogInfo("Compressed {} mips", mipCount);
+
         for (float* data : mipData)
             Memory::DefaultFree(data);
         mipData.clear();
@@ -364,7 +432,7 @@ namespace FE
                 settings.m_logger->LogInfo("Compressed mip chains [1/{}]", mipChainInfo.size());
         }
 
-        CompressedBlockWriter compressedBlockWriter{ out, &compressor, crc32 };
+        CompressedBlockWriter compressedBlockWriter{ out, &compressor, crc32, settings.m_jobSystem };
         for (uint32_t mipChainIndex = 0; mipChainIndex < mipChainInfo.size(); ++mipChainIndex)
         {
             if (mipChainIndex == 0 && hasMipsInFirstBlock)
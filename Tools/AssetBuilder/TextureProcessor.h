@@ -1,6 +1,7 @@
 #pragma once
 #include <FeCore/IO/BaseIO.h>
 #include <FeCore/IO/Path.h>
+#include <FeCore/Jobs/IJobSystem.h>
 #include <FeCore/Logging/Logger.h>
 #include <FeCore/Math/Vector2.h>
 #include <Graphics/Core/ImageFormat.h>
@@ -11,6 +12,7 @@ namespace FE::AssetBuilder
     {
         IO::IStreamFactory* m_streamFactory = nullptr;
         Logger* m_logger = nullptr;
+        IJobSystem* m_jobSystem = nullptr; //!< Used to compress the texture in parallel. Can be null.
 
         IO::Path m_inputFile;
         IO::Path m_outputFile;
@@ -38,13 +38,21 @@ namespace FE
 
 
     AssetBuilder::CompressedBlockWriter::CompressedBlockWriter(IO::IStream* out, const Compression::Compressor* compressor,
-                                                               const Crc32 crc)
+                                                               const Crc32 crc, IJobSystem* jobSystem)
         : m_crc(crc)
         , m_out(out)
         , m_compressor(compressor)
+        , m_jobSystem(jobSystem)
     {
         m_tempUncompressedBuffer.resize(Compression::kBlockSize);
-        m_tempCompressedBuffer.resize(static_cast<uint32_t>(compressor->GetBounds(Compression::kBlockSize)));
+    }
+
+
+    AssetBuilder::CompressedBlockWriter::~CompressedBlockWriter()
+    {
+        // Make sure no jobs reference the writer after it's destroyed.
+        while (m_pendingBlockCount > 0)
+            WritePendingBlock();
     }
 
 
@@ -62,7 +70,7 @@ namespace FE
             bytesWritten += bytesToWrite;
 
             if (m_uncompressedDataSize == Compression::kBlockSize)
-                Flush();
+                SubmitBlock();
         }
     }
 
@@ -70,15 +78,77 @@ namespace FE
     void AssetBuilder::CompressedBlockWriter::Flush()
     {
         if (m_uncompressedDataSize > 0)
+            SubmitBlock();
+
+        while (m_pendingBlockCount > 0)
+            WritePendingBlock();
+    }
+
+
+    void AssetBuilder::CompressedBlockWriter::SubmitBlock()
+    {
+        if (m_pendingBlockCount == kMaxPendingBlocks)
+            WritePendingBlock();
+
+        const uint32_t blockIndex = (m_firstPendingBlockIndex + m_pendingBlockCount) % kMaxPendingBlocks;
+        BlockCompressionJob& job = m_pendingBlocks[blockIndex];
+        ++m_pendingBlockCount;
+
+        if (job.m_compressedData.empty())
+        {
+            job.m_uncompressedData.resize(Compression::kBlockSize);
+            job.m_compressedData.resize(static_cast<uint32_t>(m_compressor->GetBounds(Compression::kBlockSize)));
+        }
+
+        // The whole buffer is compressed even if the block is not full, so the tail of the last block
+        // contains the data of the previous one. We keep the buffer around to produce the same output.
+        memcpy(job.m_uncompressedData.data(), m_tempUncompressedBuffer.data(), m_tempUncompressedBuffer.size());
+        m_uncompressedDataSize = 0;
+
+        // The CRC is chained through the blocks. It is cheap compared to the compression, so we compute it here
+        // and let the job write the value that the block would have gotten if the blocks were compressed serially.
+        job.m_method = m_compressor->GetMethod();
+        job.m_level = m_compressor->GetLevel();
+        job.m_crc = m_crc;
+        m_crc.Update(job.m_uncompressedData.data(), job.m_uncompressedData.size());
+
+        if (m_jobSystem)
         {
-            FE_Verify(m_compressor->Compress(m_crc,
-                                             m_tempUncompressedBuffer.data(),
-                                             m_tempUncompressedBuffer.size(),
-                                             m_tempCompressedBuffer.data(),
-                                             m_tempCompressedBuffer.size()));
-
-            WriteCompactedPages(m_tempCompressedBuffer, m_out);
-            m_uncompressedDataSize = 0;
+            job.m_waitGroup = WaitGroup::Create();
+            job.ScheduleForeground(m_jobSystem, job.m_waitGroup.Get());
         }
+        else
+        {
+            job.Execute();
+        }
+    }
+
+
+    void AssetBuilder::CompressedBlockWriter::WritePendingBlock()
+    {
+        FE_Assert(m_pendingBlockCount > 0);
+
+        BlockCompressionJob& job = m_pendingBlocks[m_firstPendingBlockIndex];
+        if (job.m_waitGroup)
+        {
+            job.m_waitGroup->Wait();
+            job.m_waitGroup.Reset();
+        }
+
+        WriteCompactedPages(job.m_compressedData, m_out);
+
+        m_firstPendingBlockIndex = (m_firstPendingBlockIndex + 1) % kMaxPendingBlocks;
+        --m_pendingBlockCount;
+    }
+
+
+    void AssetBuilder::CompressedBlockWriter::BlockCompressionJob::Execute()
+    {
+        FE_PROFILER_ZONE();
+
+        // Compressors are not thread-safe, so every job needs its own.
+        const auto compressor = Compression::Compressor::Create(m_method, m_level);
+        FE_Verify(compressor.Compress(
+            m_crc, m_uncompressedData.data(), m_uncompressedData.size(), m_compressedData.data(), m_compressedData.size()));
     }
 } // namespace FE
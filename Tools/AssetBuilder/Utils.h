@@ -1,6 +1,7 @@
 #pragma once
 #include <FeCore/Compression/Compression.h>
 #include <FeCore/IO/IStream.h>
+#include <FeCore/Jobs/Job.h>
 #include <festd/span.h>
 #include <festd/vector.h>
 
@@ -9,15 +10,27 @@ namespace FE::AssetBuilder
     void WriteCompactedPages(festd::span<const std::byte> compressedBuffer, IO::IStream* out);
 
 
+    //! @brief Splits the data into blocks of Compression::kBlockSize bytes, compresses them and writes them to a stream.
+    //!
+    //! If a job system is provided, the blocks are compressed in parallel. They are still written to the stream
+    //! in order, so the output is identical to the one produced without a job system.
     struct CompressedBlockWriter final
     {
-        CompressedBlockWriter(IO::IStream* out, const Compression::Compressor* compressor, Crc32 crc);
+        CompressedBlockWriter(IO::IStream* out, const Compression::Compressor* compressor, Crc32 crc,
+                              IJobSystem* jobSystem = nullptr);
 
         CompressedBlockWriter(IO::IStream* out, const Compression::Compressor* compressor)
             : CompressedBlockWriter(out, compressor, {})
         {
         }
 
+        ~CompressedBlockWriter();
+
+        CompressedBlockWriter(const CompressedBlockWriter&) = delete;
+        CompressedBlockWriter& operator=(const CompressedBlockWriter&) = delete;
+        CompressedBlockWriter(CompressedBlockWriter&&) = delete;
+        CompressedBlockWriter& operator=(CompressedBlockWriter&&) = delete;
+
         void WriteBytes(const void* data, size_t size);
 
         template<class T>
@@ -26,14 +39,37 @@ namespace FE::AssetBuilder
             WriteBytes(&value, sizeof(T));
         }
 
+        //! @brief Finish the current block and wait until all the blocks are written to the stream.
         void Flush();
 
         Crc32 m_crc;
         IO::IStream* m_out;
         const Compression::Compressor* m_compressor;
+        IJobSystem* m_jobSystem;
 
         size_t m_uncompressedDataSize = 0;
         festd::vector<std::byte> m_tempUncompressedBuffer;
-        festd::vector<std::byte> m_tempCompressedBuffer;
+
+    private:
+        struct BlockCompressionJob final : public Job
+        {
+            void Execute() override;
+
+            Compression::Method m_method = Compression::Method::kNone;
+            int32_t m_level = 0;
+            Crc32 m_crc;
+            festd::vector<std::byte> m_uncompressedData;
+            festd::vector<std::byte> m_compressedData;
+            Rc<WaitGroup> m_waitGroup;
+        };
+
+        static constexpr uint32_t kMaxPendingBlocks = 32;
+
+        void SubmitBlock();
+        void WritePendingBlock();
+
+        festd::array<BlockCompressionJob, kMaxPendingBlocks> m_pendingBlocks;
+        uint32_t m_firstPendingBlockIndex = 0;
+        uint32_t m_pendingBlockCount = 0;
     };
 } // namespace FE::AssetBuilder
@@ -26,7 +26,7 @@ function(fe_configure_target TARGET)
             /W4 /WX /wd4324 /wd4201 /wd4127 /wd4373
             $<$<CONFIG:Debug>:/d2Obforceinline>)
     else()
-        target_compile_options(${TARGET} PRIVATE -fno-exceptions -Wall -Werror -mavx -ffast-math
+        target_compile_options(${TARGET} PRIVATE -fno-exceptions -Wall -Werror -mavx -mpclmul -ffast-math
 			-Wno-deprecated-builtins -Wno-language-extension-token)
     endif()
 endfunction()
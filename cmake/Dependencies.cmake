@@ -7,9 +7,13 @@ include(ThirdParty/tracy)
 include(ThirdParty/gtest)
 include(ThirdParty/memory)
 include(ThirdParty/hash)
-include(ThirdParty/vulkan)
-include(ThirdParty/dxc)
-include(ThirdParty/stb)
-include(ThirdParty/compressonator)
-include(ThirdParty/rapidjson)
-include(ThirdParty/assetbuild)
+
+# The graphics stack depends on prebuilt DXC binaries and the Win32 window backend.
+if (WIN32)
+    include(ThirdParty/vulkan)
+    include(ThirdParty/dxc)
+    include(ThirdParty/stb)
+    include(ThirdParty/compressonator)
+    include(ThirdParty/rapidjson)
+    include(ThirdParty/assetbuild)
+endif()
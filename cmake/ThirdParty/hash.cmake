@@ -1,6 +1,6 @@
 set(XXHASH_SOURCES
-    ${FE_THIRD_PARTY_DIR}/xxhash/xxhash.c
-    ${FE_THIRD_PARTY_DIR}/xxhash/xxhash.h
+    ${FE_THIRD_PARTY_DIR}/xxHash/xxhash.c
+    ${FE_THIRD_PARTY_DIR}/xxHash/xxhash.h
 )
 
 add_library(xxhash STATIC ${XXHASH_SOURCES})